@@ -136,6 +136,91 @@ def skeleton_checkpoint_lenet_distributed(cluster, executables, dir_name,
                  dt=diff_test, ncd=no_ckpt_dir, cd=ckpt_dir, p=path_prefix))
 
 
+def skeleton_checkpoint_lenet_memory(cluster, executables, dir_name,
+                                     compiler_name):
+    if compiler_name not in executables:
+        e = 'skeleton_checkpoint_lenet_memory: default_exes[%s] does not exist' % compiler_name
+        print('Skip - ' + e)
+        pytest.skip(e)
+    exe = executables[compiler_name]
+
+    # Memory checkpoints are copied to a partner on another node, so
+    # each of the two processes runs on its own node.
+    os.system('rm -rf mem_ckpt mem_ckpt_weights')
+    os.system('mkdir -p mem_ckpt_weights ckpt_lenet_memory')
+
+    # No restart, printing weights to files.
+    output_file_name = '%s/bamboo/unit_tests/output/checkpoint_lenet_memory_no_checkpoint_%s_output.txt' % (dir_name, compiler_name)
+    error_file_name  = '%s/bamboo/unit_tests/error/checkpoint_lenet_memory_no_checkpoint_%s_error.txt' % (dir_name, compiler_name)
+    command = tools.get_command(
+        cluster=cluster, executable=exe, num_nodes=2, num_processes=2,
+        dir_name=dir_name,
+        data_filedir_default='/p/lscratchh/brainusr/datasets/MNIST',
+        data_reader_name='mnist', model_folder='tests',
+        model_name='lenet_mnist_mem_ckpt', num_epochs=2, optimizer_name='sgd',
+        output_file_name=output_file_name, error_file_name=error_file_name)
+    return_code_nockpt = os.system(command)
+    if return_code_nockpt != 0:
+        sys.stderr.write('LeNet (no checkpoint) execution failed, exiting with error')
+        sys.exit(1)
+    no_ckpt_dir = 'ckpt_lenet_memory/no_ckpt_{c}'.format(c=compiler_name)
+    os.system('rm -rf mem_ckpt {c}'.format(c=no_ckpt_dir))
+    os.system('mv mem_ckpt_weights {c}'.format(c=no_ckpt_dir))
+    os.system('mkdir -p mem_ckpt_weights')
+
+    # Run to memory checkpoint, printing weights to files.
+    output_file_name = '%s/bamboo/unit_tests/output/checkpoint_lenet_memory_checkpoint_%s_output.txt' % (dir_name, compiler_name)
+    error_file_name  = '%s/bamboo/unit_tests/error/checkpoint_lenet_memory_checkpoint_%s_error.txt' % (dir_name, compiler_name)
+    command = tools.get_command(
+        cluster=cluster, executable=exe, num_nodes=2, num_processes=2,
+        dir_name=dir_name,
+        data_filedir_default='/p/lscratchh/brainusr/datasets/MNIST',
+        data_reader_name='mnist', model_folder='tests',
+        model_name='lenet_mnist_mem_ckpt', num_epochs=1, optimizer_name='sgd',
+        output_file_name=output_file_name, error_file_name=error_file_name)
+    return_code_ckpt_1 = os.system(command)
+    if return_code_ckpt_1 != 0:
+        sys.stderr.write('LeNet (checkpoint) execution failed, exiting with error')
+        sys.exit(1)
+
+    # Rank 0 loses its memory checkpoint and has to get it back from
+    # the partner copy held by rank 1.
+    os.system('rm -rf mem_ckpt/*.rank.0.epoch.* mem_ckpt/*.rank.0.*.memory.checkpoint')
+
+    # Pick up from the partner copy, printing weights to files.
+    output_file_name = '%s/bamboo/unit_tests/output/checkpoint_lenet_memory_restart_%s_output.txt' % (dir_name, compiler_name)
+    error_file_name  = '%s/bamboo/unit_tests/error/checkpoint_lenet_memory_restart_%s_error.txt' % (dir_name, compiler_name)
+    command = tools.get_command(
+        cluster=cluster, executable=exe, num_nodes=2, num_processes=2,
+        dir_name=dir_name,
+        data_filedir_default='/p/lscratchh/brainusr/datasets/MNIST',
+        data_reader_name='mnist', model_folder='tests',
+        model_name='lenet_mnist_mem_ckpt', num_epochs=2, optimizer_name='sgd',
+        output_file_name=output_file_name, error_file_name=error_file_name)
+    return_code_ckpt_2 = os.system(command)
+    if return_code_ckpt_2 != 0:
+        sys.stderr.write('LeNet execution (restart from memory checkpoint) failed, exiting with error')
+        sys.exit(1)
+    restart_test = os.system(
+        'grep -q "1 ranks rebuilt from partners" {o}'.format(o=output_file_name))
+
+    # Weights at the end of training must match the run without restart
+    ckpt_dir = 'ckpt_lenet_memory/ckpt_{c}'.format(c=compiler_name)
+    os.system('rm -rf mem_ckpt {c}'.format(c=ckpt_dir))
+    os.system('mv mem_ckpt_weights {c}'.format(c=ckpt_dir))
+    diff_test = os.system(
+        'for f in {c}/*-epoch1-*; do diff -q $f {ncd}/$(basename $f) || exit 1; done'.format(
+            c=ckpt_dir, ncd=no_ckpt_dir))
+    path_prefix = '{d}/bamboo/unit_tests'.format(d=dir_name)
+    if restart_test != 0:
+        raise AssertionError(
+            'restart_test={rt}\nThe restart did not rebuild rank 0 from its partner, see {o}'.format(
+                rt=restart_test, o=output_file_name))
+    if diff_test != 0:
+        raise AssertionError(
+            'diff_test={dt}\nCompare {ncd} and {cd} in {p}'.format(
+                dt=diff_test, ncd=no_ckpt_dir, cd=ckpt_dir, p=path_prefix))
+
 def test_unit_checkpoint_lenet_shared_clang6(cluster, exes, dirname):
     skeleton_checkpoint_lenet_shared(cluster, exes, dirname, 'clang6')
 
@@ -144,6 +229,10 @@ def test_unit_checkpoint_lenet_distributed_clang6(cluster, exes, dirname):
     skeleton_checkpoint_lenet_distributed(cluster, exes, dirname, 'clang6')
 
 
+def test_unit_checkpoint_lenet_memory_clang6(cluster, exes, dirname):
+    skeleton_checkpoint_lenet_memory(cluster, exes, dirname, 'clang6')
+
+
 def test_unit_checkpoint_lenet_shared_gcc7(cluster, exes, dirname):
     skeleton_checkpoint_lenet_shared(cluster, exes, dirname, 'gcc7')
 
@@ -152,6 +241,10 @@ def test_unit_checkpoint_lenet_distributed_gcc7(cluster, exes, dirname):
     skeleton_checkpoint_lenet_distributed(cluster, exes, dirname, 'gcc7')
 
 
+def test_unit_checkpoint_lenet_memory_gcc7(cluster, exes, dirname):
+    skeleton_checkpoint_lenet_memory(cluster, exes, dirname, 'gcc7')
+
+
 def test_unit_checkpoint_lenet_shared_intel19(cluster, exes, dirname):
     skeleton_checkpoint_lenet_shared(cluster, exes, dirname, 'intel19')
 
@@ -160,6 +253,10 @@ def test_unit_checkpoint_lenet_distributed_intel19(cluster, exes, dirname):
     skeleton_checkpoint_lenet_distributed(cluster, exes, dirname, 'intel19')
 
 
+def test_unit_checkpoint_lenet_memory_intel19(cluster, exes, dirname):
+    skeleton_checkpoint_lenet_memory(cluster, exes, dirname, 'intel19')
+
+
 # Run with python3 -m pytest -s test_unit_checkpoint.py -k 'test_unit_checkpoint_lenet_shared_exe' --exe=<executable>
 def test_unit_checkpoint_lenet_shared_exe(cluster, dirname, exe):
     if exe is None:
@@ -178,3 +275,13 @@ def test_unit_checkpoint_lenet_distributed_exe(cluster, dirname, exe):
         pytest.skip(e)
     exes = {'exe': exe}
     skeleton_checkpoint_lenet_distributed(cluster, exes, dirname, 'exe')
+
+
+# Run with python3 -m pytest -s test_unit_checkpoint.py -k 'test_unit_checkpoint_lenet_memory_exe' --exe=<executable>
+def test_unit_checkpoint_lenet_memory_exe(cluster, dirname, exe):
+    if exe is None:
+        e = 'test_unit_checkpoint_lenet_exe: Non-local testing'
+        print('Skip - ' + e)
+        pytest.skip(e)
+    exes = {'exe': exe}
+    skeleton_checkpoint_lenet_memory(cluster, exes, dirname, 'exe')
@@ -173,6 +173,14 @@ public:
   /** @brief Return this callback's name. */
   virtual std::string name() const = 0;
 
+  /** @brief Whether this callback reads layer outputs during
+   *         training.
+   *
+   *  Layer outputs are not moved into reduced precision storage
+   *  between forward and back prop if any callback reads them.
+   */
+  virtual bool reads_activations() const { return false; }
+
   ///@}
 
 protected:
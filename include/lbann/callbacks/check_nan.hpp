@@ -59,6 +59,7 @@ class check_nan : public callback_base {
   /** Check that weights are good. */
   void on_batch_end(model *m) override;
   std::string name() const override { return "check_nan"; }
+  bool reads_activations() const override { return true; }
 
 };
 
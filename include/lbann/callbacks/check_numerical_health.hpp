@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_CALLBACKS_CALLBACK_CHECK_NUMERICAL_HEALTH_HPP_INCLUDED
+#define LBANN_CALLBACKS_CALLBACK_CHECK_NUMERICAL_HEALTH_HPP_INCLUDED
+
+#include "lbann/callbacks/callback.hpp"
+#include "lbann/utils/numerical_health.hpp"
+
+#include <future>
+#include <string>
+#include <vector>
+
+namespace lbann {
+namespace callback {
+
+/** @brief Sampled check for NaNs, infinities, and large values.
+ *
+ *  A cheaper alternative to @c check_nan that can be left on in
+ *  production runs. Every batch_interval training steps, the local
+ *  activations and error signals of each layer are scanned in one
+ *  pass (see @c get_numerical_health). CPU tensors are scanned on the
+ *  I/O thread pool once the layer has finished and the results are
+ *  collected at the end of the step. Tensors whose buffers may change
+ *  before then (views, reduced precision activation storage, or
+ *  tensor placement) and GPU tensors are scanned immediately.
+ *
+ *  If a tensor has NaNs or infinities, or its largest absolute value
+ *  exceeds a threshold, the local tensors of the offending layer are
+ *  written to binary files and the rank is killed.
+ */
+class check_numerical_health : public callback_base {
+public:
+
+  /** @brief Construct a callback to check numerical health.
+   *
+   *  @param batch_interval Number of training steps between checks.
+   *  @param max_abs        Largest allowed absolute value. Not checked
+   *                        if non-positive.
+   *  @param synchronous    Scan all tensors immediately instead of on
+   *                        the I/O thread pool.
+   *  @param directory      Directory for binary dumps.
+   */
+  check_numerical_health(El::Int batch_interval,
+                         DataType max_abs,
+                         bool synchronous,
+                         std::string directory);
+  check_numerical_health(const check_numerical_health& other);
+  check_numerical_health& operator=(const check_numerical_health& other);
+  ~check_numerical_health() override;
+  check_numerical_health* copy() const override {
+    return new check_numerical_health(*this);
+  }
+  std::string name() const override { return "check numerical health"; }
+  bool reads_activations() const override { return true; }
+
+  using callback_base::on_forward_prop_end;
+  using callback_base::on_backward_prop_end;
+
+  void setup(model* m) override;
+  void on_batch_begin(model* m) override;
+  void on_forward_prop_end(model* m, Layer* l) override;
+  void on_backward_prop_end(model* m, Layer* l) override;
+  void on_batch_end(model* m) override;
+
+private:
+
+  /** Scan result for a layer tensor. */
+  struct tensor_check {
+    const Layer* layer = nullptr;
+    /** Whether the tensor is an error signal or an activation. */
+    bool error_signals = false;
+    int index = 0;
+    numerical_health health;
+  };
+
+  /** Number of training steps between checks. */
+  El::Int m_interval;
+  /** Largest allowed absolute value. */
+  DataType m_max_abs;
+  bool m_synchronous;
+  std::string m_directory;
+
+  /** Whether the current step is checked. */
+  bool m_active = false;
+  /** Scan results for the current step.
+   *  Capacity is reserved during setup so scans on the I/O thread
+   *  pool can write into entries while new ones are added.
+   */
+  std::vector<tensor_check> m_checks;
+  /** Scans running on the I/O thread pool. */
+  std::vector<std::future<void>> m_pending;
+
+  /** Scan a tensor, possibly on the I/O thread pool. */
+  void check_tensor(model& m, const Layer& l,
+                    const AbsDistMat& mat, bool error_signals, int index,
+                    bool defer);
+  /** Wait for scans on the I/O thread pool. */
+  void wait();
+  /** Dump the offending layer and throw if a tensor is unhealthy. */
+  void report(model& m, const tensor_check& check) const;
+
+};
+
+// Builder function
+std::unique_ptr<callback_base>
+build_check_numerical_health_callback_from_pbuf(
+  const google::protobuf::Message&, const std::shared_ptr<lbann_summary>&);
+
+} // namespace callback
+} // namespace lbann
+
+#endif  // LBANN_CALLBACKS_CALLBACK_CHECK_NUMERICAL_HEALTH_HPP_INCLUDED
@@ -61,6 +61,7 @@ class check_small : public callback_base {
   /** Check that weights are good. */
   void on_batch_end(model *m) override;
   std::string name() const override { return "check_small"; }
+  bool reads_activations() const override { return true; }
  private:
   /** Smallest allowable value. */
   static const DataType m_threshold;
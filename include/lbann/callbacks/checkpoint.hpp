@@ -31,10 +31,23 @@
 #include "lbann/callbacks/callback.hpp"
 #include "lbann/io/persist.hpp"
 
+#include <vector>
+
 namespace lbann {
 namespace callback {
 
-/** @brief Checkpoint at given interval in given directory */
+/** @brief Checkpoint at given interval in given directory
+ *
+ *  Checkpoints are written at up to three levels. Shared and
+ *  distributed checkpoints go to the filesystem. Memory checkpoints
+ *  are distributed checkpoints in a node-local memory filesystem
+ *  (e.g. /dev/shm), and each rank sends a copy of its checkpoint to
+ *  partner ranks on other nodes with non-blocking sends. The copies
+ *  are stored in the partners' memory filesystems, so they outlive
+ *  the job that wrote them. On restart, ranks whose memory checkpoint
+ *  was lost with their node get it back from a partner, and the most
+ *  recent of the three levels is loaded.
+ */
 class checkpoint : public callback_base {
  public:
 
@@ -42,7 +55,7 @@ class checkpoint : public callback_base {
    *
    *  It may be beneficial to the distributed checkpoints at a higher
    *  tempo than the shared checkpoints because they are less
-   *  expensive.
+   *  expensive. Memory checkpoints are cheaper still.
    *
    *  @param checkpoint_dir directory to save checkpoint files
    *  @param checkpoint_epochs interval to checkpoint
@@ -51,6 +64,15 @@ class checkpoint : public callback_base {
    *  @param per_rank_dir The directory into which to dump distributed checkpoints
    *  @param ckpt_dist_epochs The frequency of distributed checkpoints in epochs
    *  @param ckpt_dist_steps The frequence of distributed checkpoints in steps
+   *  @param ckpt_memory_steps The frequency of memory checkpoints in steps
+   *  @param memory_dir Node-local memory filesystem for memory checkpoints
+   *  @param num_partners Number of partner ranks holding a copy of each
+   *                      memory checkpoint
+   *  @param ckpt_dist_full_interval If positive, distributed checkpoints
+   *                      are compressed and only every
+   *                      ckpt_dist_full_interval-th one is full. The
+   *                      others store the changes since the last full
+   *                      one.
    */
   checkpoint(std::string checkpoint_dir,
              int checkpoint_epochs,
@@ -58,7 +80,11 @@ class checkpoint : public callback_base {
              int checkpoint_secs,
              std::string per_rank_dir,
              int ckpt_dist_epochs,
-             int ckpt_dist_steps) :
+             int ckpt_dist_steps,
+             int ckpt_memory_steps = 0,
+             std::string memory_dir = "/dev/shm",
+             int num_partners = 1,
+             int ckpt_dist_full_interval = 0) :
     callback_base(),
     m_checkpoint_dir(checkpoint_dir),
     m_checkpoint_epochs(checkpoint_epochs),
@@ -66,14 +92,20 @@ class checkpoint : public callback_base {
     m_checkpoint_secs(checkpoint_secs),
     m_per_rank_dir(per_rank_dir),
     m_ckpt_dist_epochs(ckpt_dist_epochs),
-    m_ckpt_dist_steps(ckpt_dist_steps) {}
-  checkpoint(const checkpoint&) = default;
-  checkpoint& operator=(const checkpoint&) = default;
+    m_ckpt_dist_steps(ckpt_dist_steps),
+    m_ckpt_memory_steps(ckpt_memory_steps),
+    m_memory_dir(memory_dir),
+    m_num_partners(num_partners),
+    m_ckpt_dist_full_interval(ckpt_dist_full_interval) {}
+  checkpoint(const checkpoint& other);
+  checkpoint& operator=(const checkpoint& other);
+  ~checkpoint() override;
   checkpoint* copy() const override { return new checkpoint(*this); }
   void setup(model *m) override;
   void on_epoch_end(model *m) override;
   void on_batch_end(model *m) override;
   void on_validation_end(model *m) override;
+  void on_train_end(model *m) override;
 
   inline void set_checkpoint_dir(std::string dir){
     m_checkpoint_dir= dir;
@@ -103,11 +135,38 @@ class checkpoint : public callback_base {
     m_ckpt_dist_steps = ckpt_dist_steps;
   }
 
+  inline void set_ckpt_memory_steps(int ckpt_memory_steps){
+    m_ckpt_memory_steps = ckpt_memory_steps;
+  }
+
   bool need_checkpoint(model *m);
   bool restart(model *m);
   std::string name() const override { return "checkpoint"; }
  protected:
   bool do_checkpoint(model *m);
+  /** @brief Write a memory checkpoint and start sending it to partners */
+  void do_memory_checkpoint(model *m, int epoch, int step);
+  /** @brief Make progress on the partner copies of the last memory
+   *         checkpoint
+   *
+   *  Received copies are written to the memory filesystem as soon as
+   *  they arrive, and the transfer buffers are freed. Once every
+   *  rank has stored its copies, the previous memory checkpoint and
+   *  the previous partner copies are removed. If @c wait is false,
+   *  only completed requests are handled.
+   */
+  void progress_replication(model *m, bool wait);
+  /** @brief Remove the previous memory checkpoint and the previous
+   *         partner copies
+   */
+  void remove_previous_memory_checkpoint(model *m);
+  /** @brief Restart from the memory level
+   *
+   *  Uses the most recent step, no older than @c min_step, for which
+   *  every rank has either its memory checkpoint or a partner copy
+   *  of it. Returns false if there is no such step.
+   */
+  bool restart_from_memory(model *m, int min_step);
  private:
   std::string m_checkpoint_dir;
   int m_checkpoint_epochs;
@@ -117,9 +176,57 @@ class checkpoint : public callback_base {
   int m_ckpt_dist_epochs;
   int m_ckpt_dist_steps;
   EvalType m_checkpoint_last;
+  int m_ckpt_memory_steps;
+  std::string m_memory_dir;
+  int m_num_partners;
+  int m_ckpt_dist_full_interval;
+  /** @brief Number of distributed checkpoints written */
+  int m_ckpt_dist_count = 0;
+  /** @brief Last full distributed checkpoint */
+  std::string m_ckpt_dist_base_dir;
   persist p;
   bool m_checkpoint_dist;
   bool m_checkpoint_shared;
+  bool m_checkpoint_memory = false;
+
+  /** @brief Ranks in trainer that receive copies of this rank's
+   *         memory checkpoints.
+   *  Partners are a multiple of the processes per node away, so they
+   *  are on other nodes.
+   */
+  std::vector<int> m_partner_dests;
+  /** @brief Ranks in trainer whose memory checkpoints this rank holds.
+   *  Entry k is the rank that has this rank as its k-th destination.
+   */
+  std::vector<int> m_partner_sources;
+  /** @brief Communicator for partner transfers.
+   *  Keeps them from matching other point-to-point messages.
+   */
+  El::mpi::Comm m_partner_comm;
+  bool m_has_partner_comm = false;
+  /** @brief Epoch and step of the last local memory checkpoint */
+  int m_memory_epoch = -1;
+  int m_memory_step = -1;
+  /** @brief Epoch and step of the previous local memory checkpoint.
+   *  It is kept until the partner copies of the last one are
+   *  confirmed.
+   */
+  int m_memory_prev_epoch = -1;
+  int m_memory_prev_step = -1;
+  /** @brief Packed memory checkpoint being sent to partners */
+  std::vector<char> m_partner_send_buffer;
+  /** @brief Partner memory checkpoints being received */
+  std::vector<std::vector<char>> m_partner_recv_buffers;
+  std::vector<El::mpi::Request<El::byte>> m_partner_requests;
+  /** @brief Start time of the outstanding partner transfers */
+  EvalType m_partner_start = 0;
+  /** @brief Barrier confirming that all ranks stored their partner
+   *         copies
+   */
+  MPI_Request m_partner_confirm_request = MPI_REQUEST_NULL;
+  bool m_partner_confirming = false;
+
+  std::string get_memory_dir() const;
 
   template<size_t _max_dir_len>
   struct header_t {
@@ -169,6 +276,39 @@ static inline std::string get_distributed_checkpoint_dirname(model *m, std::stri
   return ss.str();
 }
 
+static inline std::string get_last_memory_checkpoint_filename(model *m, std::string dir) {
+  lbann_comm *comm = m->get_comm();
+  std::stringstream ss;
+  ss << dir << "/";
+  ss << m->get_name().c_str() << ".";
+  ss << comm->get_trainer_rank();
+  ss << ".rank." << comm->get_rank_in_trainer() << ".last.memory.checkpoint";
+  return ss.str();
+}
+
+/** \brief File recording the previous memory checkpoint while the
+ *         partner copies of the last one are unconfirmed
+ */
+static inline std::string get_previous_memory_checkpoint_filename(model *m, std::string dir) {
+  lbann_comm *comm = m->get_comm();
+  std::stringstream ss;
+  ss << dir << "/";
+  ss << m->get_name().c_str() << ".";
+  ss << comm->get_trainer_rank();
+  ss << ".rank." << comm->get_rank_in_trainer() << ".previous.memory.checkpoint";
+  return ss.str();
+}
+
+/** \brief File holding a partner's packed memory checkpoint */
+static inline std::string get_partner_checkpoint_filename(model *m, std::string dir, int rank) {
+  lbann_comm *comm = m->get_comm();
+  std::stringstream ss;
+  ss << dir << "/" << m->get_name().c_str();
+  ss << "." << comm->get_trainer_rank();
+  ss << ".rank." << rank << ".partner.checkpoint";
+  return ss.str();
+}
+
 // Print last checkpoint to file, used to determine which checkpoint to load from.
 static inline bool write_latest(std::string filename, int epoch, int train) {
   // open the file for writing
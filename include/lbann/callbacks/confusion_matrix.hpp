@@ -50,6 +50,7 @@ public:
     return new confusion_matrix(*this);
   }
   std::string name() const override { return "confusion matrix"; }
+  bool reads_activations() const override { return true; }
 
   void setup(model *m) override;
 
@@ -28,9 +28,12 @@
 #define LBANN_CALLBACKS_CALLBACK_DUMP_OUTPUTS_HPP_INCLUDED
 
 #include "lbann/callbacks/callback.hpp"
+#include "lbann/utils/output_stream.hpp"
 
+#include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace lbann {
 namespace callback {
@@ -50,6 +53,15 @@ namespace callback {
  *  we use internally).
  *
  *  CNPY is required to export to NumPy file formats (npy and npz).
+ *
+ *  The stream format is intended for inference at scale. Instead of
+ *  gathering outputs onto one process and saving a file per tensor
+ *  and step, each process appends its local outputs and their sample
+ *  indices to a few large binary files, written by a background
+ *  thread (see @c output_stream_writer). Files have the form
+ *  "<model>-trainer<#>-rank<#>-part<#>.bin" and can be read with
+ *  @c output_stream_reader or python/lbann/util/output_stream.py.
+ *  Sample indices are taken from the first input layer.
  */
 class dump_outputs : public callback_base {
 public:
@@ -65,19 +77,28 @@ public:
    *  @param directory      Directory for output files (default: current
    *                        working directory).
    *  @param file_format    Output file format. Options are csv, tsv,
-   *                        npy, npz (default: csv).
+   *                        npy, npz, stream (default: csv).
+   *  @param stream_file_size Maximum size in MB of each file in the
+   *                        stream format (default: 1024).
    */
   dump_outputs(
     std::set<std::string> layer_names,// = std::set<std::string>(),
     std::set<execution_mode> modes, // = std::set<std::string>(),
     El::Int batch_interval = 0,
     std::string directory = "",
-    std::string file_format = "");
+    std::string file_format = "",
+    El::Int stream_file_size = 0);
+  dump_outputs(const dump_outputs& other);
+  dump_outputs& operator=(const dump_outputs& other);
 
   dump_outputs* copy() const override {
     return new dump_outputs(*this);
   }
   std::string name() const override { return "dump outputs"; }
+  bool reads_activations() const override { return true; }
+
+  using callback_base::on_forward_prop_end;
+  using callback_base::on_evaluate_forward_prop_end;
 
   void on_forward_prop_end(model* m, Layer* l) override {
     do_dump_outputs(*m, *l);
@@ -87,6 +108,15 @@ public:
       do_dump_outputs(*m, *l);
     }
   }
+  void on_forward_prop_end(model* m) override {
+    write_stream_chunks(*m);
+  }
+  void on_evaluate_forward_prop_end(model* m) override {
+    write_stream_chunks(*m);
+  }
+  void on_train_end(model* m) override { flush_stream(); }
+  void on_validation_end(model* m) override { flush_stream(); }
+  void on_test_end(model* m) override { flush_stream(); }
 
 private:
 
@@ -108,11 +138,39 @@ private:
   /** @brief Output file format. */
   std::string m_file_format;
 
+  /** @brief Maximum size in bytes of each file in the stream format. */
+  size_t m_stream_file_size;
+
+  /** @brief   Writer for the stream format.
+   *  @details Created at the first output dump.
+   */
+  std::unique_ptr<output_stream_writer> m_stream_writer;
+
+  /** @brief   Stream chunks of the current mini-batch step.
+   *  @details Written once forward prop has finished and sample
+   *           indices are known.
+   */
+  std::vector<std::unique_ptr<output_stream_chunk>> m_stream_chunks;
+
+  /** @brief Buffer to redistribute outputs that are not
+   *         data-parallel CPU matrices.
+   */
+  std::unique_ptr<StarVCMat<El::Device::CPU>> m_stream_buffer;
+
   /** @brief   Dump outputs to file.
    *  @details Returns immediately if an output dump is not needed.
    */
   void do_dump_outputs(const model& m, const Layer& l);
 
+  /** @brief Copy local outputs into stream chunks. */
+  void do_stream_outputs(const model& m, const Layer& l);
+
+  /** @brief Attach sample indices to stream chunks and queue them. */
+  void write_stream_chunks(const model& m);
+
+  /** @brief Wait until queued stream chunks are written. */
+  void flush_stream();
+
 };
 
 // Builder function
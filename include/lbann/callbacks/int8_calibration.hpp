@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_CALLBACKS_CALLBACK_INT8_CALIBRATION_HPP_INCLUDED
+#define LBANN_CALLBACKS_CALLBACK_INT8_CALIBRATION_HPP_INCLUDED
+
+#include "lbann/callbacks/callback.hpp"
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lbann {
+namespace callback {
+
+/** @brief Quantize layers to int8 for CPU inference.
+ *
+ *  Post-training quantization of fully-connected, convolution, and
+ *  deconvolution layers. The first evaluation mini-batches run in
+ *  full precision while the largest absolute value in each channel
+ *  of each selected layer's input is recorded. The layers are then
+ *  quantized with these ranges (see @c Layer::quantize_int8) and the
+ *  following evaluation mini-batches use int8 GEMMs.
+ *
+ *  Once as many int8 mini-batches as calibration mini-batches have
+ *  run, the metric values and forward prop throughput of both are
+ *  reported. They are measured on different mini-batches, so small
+ *  metric differences may be sampling noise. Training invalidates
+ *  the quantized weights, so layers are restored to full precision
+ *  and recalibrated at the next evaluation.
+ */
+class int8_calibration : public callback_base {
+public:
+
+  /** @brief Construct a callback to quantize layers.
+   *
+   *  @param num_batches    Number of calibration mini-batches.
+   *  @param layer_names    Names of quantized layers (default: all
+   *                        layers with an int8 path).
+   */
+  int8_calibration(El::Int num_batches,
+                   std::set<std::string> layer_names);
+  int8_calibration(const int8_calibration&) = default;
+  int8_calibration& operator=(const int8_calibration&) = default;
+  int8_calibration* copy() const override {
+    return new int8_calibration(*this);
+  }
+  std::string name() const override { return "int8 calibration"; }
+
+  using callback_base::on_evaluate_forward_prop_begin;
+  using callback_base::on_evaluate_forward_prop_end;
+
+  void on_batch_begin(model* m) override;
+  void on_evaluate_forward_prop_begin(model* m) override;
+  void on_evaluate_forward_prop_end(model* m, Layer* l) override;
+  void on_evaluate_forward_prop_end(model* m) override;
+  void on_batch_evaluate_end(model* m) override;
+
+private:
+
+  /** Statistics of full precision or int8 mini-batches. */
+  struct phase_statistics {
+    El::Int num_batches = 0;
+    El::Int num_samples = 0;
+    /** Forward prop time, excluding calibration. */
+    EvalType time = 0;
+    /** Sum of metric values over samples, one entry per metric. */
+    std::vector<EvalType> metric_sums;
+  };
+
+  /** Number of calibration mini-batches. */
+  El::Int m_num_batches;
+  /** Names of quantized layers. If empty, all layers with an int8
+   *  path are quantized.
+   */
+  std::set<std::string> m_layer_names;
+
+  /** Largest absolute value in each input channel, by layer name. */
+  std::unordered_map<std::string, std::vector<DataType>> m_input_ranges;
+  /** Whether the layers are quantized. */
+  bool m_quantized = false;
+  /** Whether the accuracy and throughput have been reported. */
+  bool m_reported = false;
+  /** Statistics of the calibration mini-batches. */
+  phase_statistics m_full_precision_statistics;
+  /** Statistics of the quantized mini-batches. */
+  phase_statistics m_int8_statistics;
+  /** Execution mode of the previous mini-batch. */
+  execution_mode m_metric_mode = execution_mode::invalid;
+  /** Number of samples in each metric's statistics after the
+   *  previous mini-batch.
+   */
+  std::vector<int> m_metric_num_samples;
+  /** Sum of values in each metric's statistics after the previous
+   *  mini-batch.
+   */
+  std::vector<EvalType> m_metric_totals;
+  /** Start time of the current forward prop. */
+  EvalType m_fp_start_time = 0;
+  /** Time spent recording input ranges in the current mini-batch. */
+  EvalType m_calibration_time = 0;
+
+  /** Whether a layer is quantized by this callback. */
+  bool is_selected(const Layer& l) const;
+  /** Quantize layers with the recorded input ranges. */
+  void quantize(model& m);
+  /** Restore full precision layers and restart calibration. */
+  void reset(model& m);
+  /** Print metric and throughput comparison. */
+  void report(model& m) const;
+
+};
+
+// Builder function
+std::unique_ptr<callback_base>
+build_int8_calibration_callback_from_pbuf(
+  const google::protobuf::Message&, const std::shared_ptr<lbann_summary>&);
+
+} // namespace callback
+} // namespace lbann
+
+#endif  // LBANN_CALLBACKS_CALLBACK_INT8_CALIBRATION_HPP_INCLUDED
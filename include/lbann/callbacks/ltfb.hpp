@@ -87,6 +87,24 @@ public:
      */
     sendrecv_weights,
 
+    /** Exchange a packed model snapshot with non-blocking sendrecv.
+     *
+     *  Each rank packs its local part of the weights values and
+     *  optimizer state (and optionally the hyperparameters) into a
+     *  single buffer. Non-blocking sends and receives with the
+     *  corresponding rank in the partner trainer are posted as soon
+     *  as the tournament partners are known, and the transfer
+     *  proceeds while the local model is evaluated.
+     *
+     *  Notes:
+     *    - Requires all models to be identical aside from their
+     *      weights values and hyperparameters.
+     *    - Exchanges SGD velocity and both Adam moments.
+     *    - Communication progress during evaluation depends on the
+     *      MPI implementation's asynchronous progress.
+     */
+    sendrecv_snapshot,
+
     /** Save and load model data with checkpoint files.
      *
      *  @todo Implement.
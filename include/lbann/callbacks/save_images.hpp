@@ -58,6 +58,7 @@ public:
   void on_epoch_end(model *m) override;
   void on_test_end(model *m) override;
   std::string name() const override { return "save images"; }
+  bool reads_activations() const override { return true; }
 
 private:
 
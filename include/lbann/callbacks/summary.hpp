@@ -59,6 +59,7 @@ class summary : public callback_base {
   void on_epoch_end(model *m) override;
   void on_test_end(model *m) override;
   std::string name() const override { return "summary"; }
+  bool reads_activations() const override { return true; }
 
 protected:
   /** Write out histograms from the model's layers. */
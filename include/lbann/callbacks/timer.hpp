@@ -83,6 +83,8 @@ private:
   std::map<execution_mode,EvalType> m_batch_start_times;
   /** Mini-batch times. */
   std::map<execution_mode,std::vector<EvalType>> m_batch_times;
+  /** Model's total weights update time at start of timing session. */
+  std::map<execution_mode,EvalType> m_update_weights_start_times;
 
   /** Start timing session. */
   void timing_begin(const model& m);
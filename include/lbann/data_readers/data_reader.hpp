@@ -36,10 +36,12 @@
 #include "lbann/io/file_io.hpp"
 #include "lbann/io/persist.hpp"
 #include "lbann/utils/options.hpp"
+#include "lbann/utils/metadata_cache.hpp"
 #include "lbann/utils/threads/thread_pool.hpp"
 #include "lbann/transforms/transform_pipeline.hpp"
 #include <cassert>
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 #include <unistd.h>
@@ -56,6 +58,13 @@ namespace lbann {
 class data_store_conduit;
 class model;
 
+/** Element type of the samples a data reader produces.
+ *  Narrow types are carried through the I/O buffers unconverted and
+ *  widened to DataType when the input layer populates its
+ *  activations.
+ */
+enum class sample_storage_type { data_type, uint8, int16 };
+
 /**
  * A data reader manages reading in data in a particular format.
  * This abstract base class manages common functionality. In particular, child
@@ -280,6 +289,28 @@ class generic_data_reader {
 
   /// Fetch this mini-batch's samples into X.
   virtual int fetch_data(CPUMat& X, El::Matrix<El::Int>& indices_fetched);
+  /// Fetch this mini-batch's samples into X in their native uint8 type.
+  int fetch_data(El::Matrix<uint8_t>& X, El::Matrix<El::Int>& indices_fetched);
+  /// Fetch this mini-batch's samples into X in their native int16 type.
+  int fetch_data(El::Matrix<int16_t>& X, El::Matrix<El::Int>& indices_fetched);
+
+  /**
+   * Element type of the samples produced by fetch_narrow_datum. If
+   * this is not sample_storage_type::data_type, samples are fetched
+   * in that type and converted with get_sample_conversion.
+   */
+  virtual sample_storage_type get_sample_storage_type() const {
+    return sample_storage_type::data_type;
+  }
+  /**
+   * Entry-wise affine map, x -> scale*x + bias, that converts narrow
+   * samples to DataType. It must produce the same values as
+   * fetch_datum.
+   */
+  virtual void get_sample_conversion(DataType& scale, DataType& bias) const {
+    scale = DataType(1);
+    bias = DataType(0);
+  }
   /// Fetch this mini-batch's labels into Y.
   virtual int fetch_labels(CPUMat& Y);
   /// Fetch this mini-batch's responses into Y.
@@ -759,11 +790,58 @@ class generic_data_reader {
    */
   double get_validation_percent() const;
 
+  /**
+   * Read a file on the trainer master and broadcast its contents to
+   * the other ranks in the trainer, so that small metadata files
+   * (e.g. sample lists) are not read by every rank. Returns false on
+   * all ranks if the file could not be read.
+   */
+  bool load_file_from_trainer_master(const std::string& filename,
+                                     std::vector<char>& buf) const;
+
+  /**
+   * Create a cache for the metadata this reader parses from an input
+   * file, keyed by the reader type. The cache lives in the directory
+   * given by --metadata_cache_dir, or next to the input file with
+   * --metadata_cache. Returns null if neither option is set.
+   */
+  std::unique_ptr<metadata_cache> make_metadata_cache(
+    const std::string& input_file) const;
+
+  /**
+   * Validate and read a metadata cache on the trainer master (or the
+   * world master if world is true) and broadcast the payload. Returns
+   * the same result on all ranks.
+   */
+  bool read_metadata_cache(const metadata_cache& cache,
+                           std::string& payload,
+                           bool world = false) const;
+
+  /**
+   * Write a metadata cache from the trainer master (or the world
+   * master if world is true). Failures only produce a warning.
+   */
+  void write_metadata_cache(const metadata_cache& cache,
+                            const std::string& payload,
+                            bool world = false) const;
+
   data_store_conduit *m_data_store;
 
   lbann_comm *m_comm;
 
   virtual bool fetch_data_block(CPUMat& X, El::Int thread_index, El::Int mb_size, El::Matrix<El::Int>& indices_fetched);
+  template <typename T>
+  bool fetch_narrow_data_block(El::Matrix<T>& X, El::Int thread_index, El::Int mb_size, El::Matrix<El::Int>& indices_fetched);
+  /// Fetch samples in the type of X into X
+  template <typename SampleMat>
+  int fetch_samples(SampleMat& X, El::Matrix<El::Int>& indices_fetched);
+  bool fetch_block(CPUMat& X, El::Int thread_index, El::Int mb_size, El::Matrix<El::Int>& indices_fetched) {
+    return fetch_data_block(X, thread_index, mb_size, indices_fetched);
+  }
+  template <typename T>
+  bool fetch_block(El::Matrix<T>& X, El::Int thread_index, El::Int mb_size, El::Matrix<El::Int>& indices_fetched) {
+    return fetch_narrow_data_block(X, thread_index, mb_size, indices_fetched);
+  }
 
   /**
    * Fetch a single sample into a matrix.
@@ -776,6 +854,22 @@ class generic_data_reader {
     return false;
   }
 
+  /**
+   * Fetch a single sample into a matrix in its native type, without
+   * conversion to DataType (see get_sample_storage_type).
+   * @param X The matrix to load data into.
+   * @param data_id The index of the datum to fetch.
+   * @param mb_idx The index within the mini-batch.
+   */
+  virtual bool fetch_narrow_datum(El::Matrix<uint8_t>& X, int data_id, int mb_idx) {
+    NOT_IMPLEMENTED("fetch_narrow_datum");
+    return false;
+  }
+  virtual bool fetch_narrow_datum(El::Matrix<int16_t>& X, int data_id, int mb_idx) {
+    NOT_IMPLEMENTED("fetch_narrow_datum");
+    return false;
+  }
+
   /**
    * Fetch a single label into a matrix.
    * @param Y The matrix to load data into.
@@ -44,6 +44,7 @@
 #else
 #include "lbann/data_readers/sample_list_hdf5.hpp"
 #endif
+#include "lbann/data_readers/packed_sample_bundle.hpp"
 
 namespace lbann {
 
@@ -294,6 +295,10 @@ class data_reader_jag_conduit : public generic_data_reader {
 
   bool fetch(CPUMat& X, int data_id, conduit::Node& sample, int mb_idx, int tid,
              const variable_t vt, const std::string tag);
+  /// Preprocess images into column mb_idx of X
+  void fetch_images(CPUMat& X, std::vector< std::vector<DataType> > img_data, int mb_idx);
+  /// Fetch a variable from a record of the packed sample bundle
+  bool fetch_packed(CPUMat& X, const char* record, const variable_t vt, const std::string tag);
   bool fetch_datum(CPUMat& X, int data_id, int mb_idx) override;
   bool fetch_response(CPUMat& Y, int data_id, int mb_idx) override;
   bool fetch_label(CPUMat& X, int data_id, int mb_idx) override;
@@ -318,6 +323,10 @@ class data_reader_jag_conduit : public generic_data_reader {
   void load_list_of_samples(const std::string filename, size_t stride=1, size_t offset=0);
   /// Load the sample list from a serialized archive from another rank
   void load_list_of_samples_from_archive(const std::string& sample_list_archive);
+  /// Read samples from a pre-packed bundle instead of a sample list
+  void load_packed_bundle(const std::string& index_file);
+  /// Resolve the record fields of the selected images, scalars and inputs
+  void setup_packed_fields();
 
   /// See if the image size is consistent with the linearized size
   void check_image_data();
@@ -361,6 +370,47 @@ class data_reader_jag_conduit : public generic_data_reader {
   /// Obtain image data
   std::vector< std::vector<DataType> > get_image_data(const size_t i, conduit::Node& sample) const;
 
+  /**
+   * Plan to access a group of scalar or input fields, resolved once at
+   * load(). The whole group is brought into the sample node with a
+   * single read, and each selected field is then found by its position
+   * among the children of the group instead of by a path lookup.
+   */
+  struct field_access_plan {
+    /// Path of the group relative to a sample
+    std::string group;
+    /// Selected fields in output order
+    std::vector<std::string> keys;
+    /// Position of each selected field among the children of the group
+    std::vector<conduit::index_t> child_index;
+    /// Number of children of the group when the plan was resolved
+    conduit::index_t num_children = 0;
+  };
+
+  /// Resolve the access plans for scalars and inputs using the first sample
+  void setup_access_plans();
+  /// Resolve a plan for the given keys of a group already loaded in n_group
+  static field_access_plan build_access_plan(const std::string& prefix,
+                                             const std::vector<std::string>& keys,
+                                             const conduit::Node* n_group);
+  /**
+   * Return the node at the given path of sample i, reading it (and all
+   * of its children) from file in one read if it is not in the sample
+   * node yet.
+   */
+  conduit::Node& get_sample_node(const size_t i, conduit::Node& sample,
+                                 const std::string& conduit_field) const;
+  /// Return the k-th field of a plan in a group node
+  static conduit::Node& get_field(conduit::Node& n_group,
+                                  const field_access_plan& plan,
+                                  const size_t k);
+  /// Write the normalized scalar outputs of sample i into out
+  template<typename T>
+  void read_scalars(const size_t i, conduit::Node& sample, T* out) const;
+  /// Write the normalized input parameters of sample i into out
+  template<typename T>
+  void read_inputs(const size_t i, conduit::Node& sample, T* out) const;
+
   bool data_store_active() const override {
     bool flag = generic_data_reader::data_store_active();
     return (m_data_store != nullptr && flag);
@@ -407,6 +457,10 @@ class data_reader_jag_conduit : public generic_data_reader {
   std::vector<std::string> m_scalar_keys;
   /// Keys to select a set of simulation input parameters to use. By default, use all.
   std::vector<std::string> m_input_keys;
+  /// Access plan for the selected scalar outputs
+  field_access_plan m_scalar_plan;
+  /// Access plan for the selected input parameters
+  field_access_plan m_input_plan;
 
   /**
    * Set of keys that are associated with non_numerical values.
@@ -464,6 +518,19 @@ class data_reader_jag_conduit : public generic_data_reader {
   sample_list_t m_sample_list;
   bool m_list_per_trainer;
   bool m_list_per_model;
+
+  /**
+   * Pre-packed bundle that samples are read from when the data index
+   * names one instead of a sample list. It is shared by copies of
+   * this reader.
+   */
+  std::shared_ptr<const packed_sample_bundle> m_packed_bundle;
+  /// Record fields of the selected images
+  std::vector<const packed_sample_bundle::field_t*> m_packed_image_fields;
+  /// Record fields of the selected scalar outputs
+  std::vector<const packed_sample_bundle::field_t*> m_packed_scalar_fields;
+  /// Record fields of the selected input parameters
+  std::vector<const packed_sample_bundle::field_t*> m_packed_input_fields;
 };
 
 /**
@@ -51,9 +51,17 @@ class mnist_reader : public image_data_reader {
   // MNIST-specific functions
   void load() override;
 
+  /** Pixels are fetched as uint8 if the transform pipeline is an
+   *  affine map (e.g. scale), which is then applied by the input
+   *  layer. */
+  sample_storage_type get_sample_storage_type() const override;
+  void get_sample_conversion(DataType& scale, DataType& bias) const override;
+
  protected:
   void set_defaults() override;
   bool fetch_datum(CPUMat& X, int data_id, int mb_idx) override;
+  using generic_data_reader::fetch_narrow_datum;
+  bool fetch_narrow_datum(El::Matrix<uint8_t>& X, int data_id, int mb_idx) override;
   bool fetch_label(CPUMat& Y, int data_id, int mb_idx) override;
 
  protected:
@@ -64,6 +64,17 @@ namespace lbann {
 
     void load() override;
 
+    /** int16 data is fetched unconverted and scaled by the input layer. */
+    sample_storage_type get_sample_storage_type() const override {
+      return (m_data.word_size == 2 ?
+              sample_storage_type::int16 :
+              sample_storage_type::data_type);
+    }
+    void get_sample_conversion(DataType& scale, DataType& bias) const override {
+      scale = m_scaling_factor_int16;
+      bias = DataType(0);
+    }
+
     int get_num_labels() const override { return m_num_labels; }
     int get_num_responses() const override { return get_linearized_response_size(); }
     int get_linearized_data_size() const override { return m_num_features; }
@@ -77,6 +88,8 @@ namespace lbann {
 
   protected:
     bool fetch_datum(CPUMat& X, int data_id, int mb_idx) override;
+    using generic_data_reader::fetch_narrow_datum;
+    bool fetch_narrow_datum(El::Matrix<int16_t>& X, int data_id, int mb_idx) override;
     bool fetch_label(CPUMat& Y, int data_id, int mb_idx) override;
     bool fetch_response(CPUMat& Y, int data_id, int mb_idx) override;
 
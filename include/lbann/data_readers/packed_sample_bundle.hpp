@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_DATA_READERS_PACKED_SAMPLE_BUNDLE_HPP_INCLUDED
+#define LBANN_DATA_READERS_PACKED_SAMPLE_BUNDLE_HPP_INCLUDED
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace lbann {
+
+/**
+ * Samples repacked from many conduit/HDF5 bundles into a few large
+ * binary shards of fixed-size records. Every record holds the same
+ * selected fields at the same byte offsets, so fetching a sample is a
+ * single read at a computed offset instead of opening a bundle and
+ * walking its tree field by field.
+ *
+ * The bundle is described by a text index file:
+ * @verbatim
+   PACKED_SAMPLE_BUNDLE 1
+   <num_fields> <record_size>
+   <type> <num_elements> <offset> <field path>      (num_fields lines)
+   <num_shards> <num_samples>
+   <shard file> <num_samples in shard>              (num_shards lines)
+   <source bundle> <sample name>                    (num_samples lines)
+   @endverbatim
+ * Shard files are relative to the directory of the index file, and
+ * the samples of a shard are stored back to back in index order. The
+ * trailing sample lines only record where each sample came from and
+ * are not read back by load().
+ */
+class packed_sample_bundle {
+ public:
+  /// Storage type of the elements of a field
+  enum class field_type { float32, float64 };
+
+  /// A field of a record
+  struct field_t {
+    /// Conduit path of the field relative to the sample root
+    std::string path;
+    field_type type = field_type::float64;
+    size_t num_elements = 0u;
+    /// Byte offset of the field within a record
+    size_t offset = 0u;
+
+    size_t get_num_bytes() const;
+  };
+
+  packed_sample_bundle() = default;
+  packed_sample_bundle(const packed_sample_bundle&) = delete;
+  packed_sample_bundle& operator=(const packed_sample_bundle&) = delete;
+  ~packed_sample_bundle();
+
+  /// Check whether a file starts like a packed sample bundle index
+  static bool is_packed_index(const std::string& filename);
+
+  /// Read the index and open every shard for reading
+  void load(const std::string& index_filename);
+
+  /// Number of samples in the bundle
+  size_t size() const { return m_num_samples; }
+  /// Number of bytes of a record
+  size_t get_record_size() const { return m_record_size; }
+  const std::vector<field_t>& get_fields() const { return m_fields; }
+  /// Return the field with the given path, or nullptr if there is none
+  const field_t* find_field(const std::string& path) const;
+
+  /// Read the record of a sample into buf of get_record_size() bytes
+  void read_record(size_t sample_id, char* buf) const;
+
+  /// Return the i-th element of a field in a record
+  static double get_value(const char* record, const field_t& f, size_t i);
+  /// Convert all the elements of a field in a record into out
+  template<typename T>
+  static void copy_field(const char* record, const field_t& f, T* out);
+
+  /**
+   * Assign the offsets of the fields in order, aligning each to eight
+   * bytes, and return the resulting record size.
+   */
+  static size_t layout_fields(std::vector<field_t>& fields);
+  /// Write an index file for shards written with the given layout
+  static void write_index(const std::string& index_filename,
+                          const std::vector<field_t>& fields,
+                          size_t record_size,
+                          const std::vector<std::pair<std::string, size_t>>& shards,
+                          const std::vector<std::string>& sample_names);
+
+  /// Strip leading and repeated slashes so that paths compare equal
+  static std::string normalize_path(const std::string& path);
+  static std::string to_string(field_type t);
+
+ private:
+  size_t m_num_samples = 0u;
+  size_t m_record_size = 0u;
+  std::vector<field_t> m_fields;
+  /// File descriptor of each shard
+  std::vector<int> m_shard_fds;
+  /// Global index of the first sample of each shard, plus the total
+  std::vector<size_t> m_shard_offsets;
+};
+
+template<typename T>
+inline void packed_sample_bundle::copy_field(const char* record,
+                                             const field_t& f,
+                                             T* out) {
+  const char* src = record + f.offset;
+  if (f.type == field_type::float32) {
+    const float* vals = reinterpret_cast<const float*>(src);
+    for (size_t i = 0u; i < f.num_elements; ++i) {
+      out[i] = static_cast<T>(vals[i]);
+    }
+  } else {
+    const double* vals = reinterpret_cast<const double*>(src);
+    for (size_t i = 0u; i < f.num_elements; ++i) {
+      out[i] = static_cast<T>(vals[i]);
+    }
+  }
+}
+
+} // namespace lbann
+
+#endif // LBANN_DATA_READERS_PACKED_SAMPLE_BUNDLE_HPP_INCLUDED
@@ -9,6 +9,7 @@
 #include "lbann/comm.hpp"
 
 #include "lbann/utils/file_utils.hpp"
+#include "lbann/data_readers/sample_list_binary.hpp"
 #include <cereal/types/unordered_map.hpp>
 #include <cereal/types/deque.hpp>
 #include <cereal/types/vector.hpp>
@@ -64,7 +65,10 @@ class sample_list {
 
   void copy_members(const sample_list& rhs);
 
-  /// Load a sample list file
+  /**
+   * Load a sample list file, either in text or in binary form. Only
+   * the files i with i % stride == offset are loaded.
+   */
   void load(const std::string& samplelist_file, size_t stride=1, size_t offset=0);
 
   /// Load the header of a sample list file
@@ -91,6 +95,9 @@ class sample_list {
   /// Write the sample list
   void write(const std::string filename) const;
 
+  /// Write the sample list in binary form
+  void write_binary(const std::string filename) const;
+
   /// Allow read-only access to the internal list data
   const samples_t& get_list() const;
 
@@ -119,6 +126,15 @@ class sample_list {
   /// read the body of a sample list, which is the list of sample files, where each file contains a single sample.
   virtual void read_sample_list(std::istream& istrm, size_t stride=1, size_t offset=0);
 
+  /// Make the header of a sample list from a binary list
+  sample_list_header read_binary_header(const sample_list_binary& list, const std::string& filename) const;
+
+  /// Populate the list with the files of a binary list selected by stride and offset
+  virtual void read_binary_sample_list(const sample_list_binary& list, size_t stride=1, size_t offset=0);
+
+  /// Describe the files and the samples of this list for writing in binary form
+  virtual void get_binary_files(std::vector<sample_list_binary::file_t>& files) const;
+
   /// Assign names to samples when there is only one sample per file without a name.
   virtual void assign_samples_name();
 
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_DATA_READERS_SAMPLE_LIST_BINARY_HPP_INCLUDED
+#define LBANN_DATA_READERS_SAMPLE_LIST_BINARY_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lbann {
+
+/**
+ * Read-only view of a sample list stored in binary form. The file is
+ * memory-mapped, so a rank only touches the pages of the files and
+ * samples it selects, and nothing is parsed line by line.
+ *
+ * Layout, with every offset in bytes from the start of the file:
+ * - header
+ * - file_entry[num_files]: one per bundle, naming it once and giving
+ *   the range of its included samples
+ * - sample_entry[num_samples]: fixed-width records, grouped by file
+ * - a blob of the file directory, the file names and the sample names
+ */
+class sample_list_binary {
+ public:
+  struct header {
+    char magic[8];
+    uint64_t num_included;
+    uint64_t num_excluded;
+    uint64_t num_files;
+    uint64_t files_offset;
+    uint64_t samples_offset;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+    uint64_t file_dir_offset;
+    uint64_t file_dir_len;
+  };
+
+  struct file_entry {
+    uint64_t name_offset;
+    uint64_t name_len;
+    /// Number of samples in the file, included or not
+    uint64_t total_samples;
+    /// Index of the first included sample of the file
+    uint64_t first_sample;
+    /// Number of included samples of the file
+    uint64_t num_samples;
+  };
+
+  struct sample_entry {
+    uint64_t name_offset;
+    uint64_t name_len;
+  };
+
+  /// Description of a file used to write a binary list
+  struct file_t {
+    std::string name;
+    size_t total_samples;
+    std::vector<std::string> sample_names;
+  };
+
+  /// Check whether a file starts like a binary sample list
+  static bool is_binary_sample_list(const std::string& filename);
+
+  /// Write the files in order as a binary sample list
+  static void write(const std::string& filename,
+                    const std::string& file_dir,
+                    const std::vector<file_t>& files);
+
+  explicit sample_list_binary(const std::string& filename);
+  sample_list_binary(const sample_list_binary&) = delete;
+  sample_list_binary& operator=(const sample_list_binary&) = delete;
+  ~sample_list_binary();
+
+  size_t get_num_included() const { return m_header->num_included; }
+  size_t get_num_excluded() const { return m_header->num_excluded; }
+  size_t get_num_files() const { return m_header->num_files; }
+  std::string get_file_dir() const;
+
+  const file_entry& get_file(size_t i) const { return m_files[i]; }
+  std::string get_filename(size_t i) const;
+  std::string get_sample_name(size_t i) const;
+
+ private:
+  std::string get_string(uint64_t offset, uint64_t len) const;
+
+  std::string m_filename;
+  const char* m_data = nullptr;
+  size_t m_size = 0u;
+  const header* m_header = nullptr;
+  const file_entry* m_files = nullptr;
+  const sample_entry* m_samples = nullptr;
+};
+
+} // namespace lbann
+
+#endif // LBANN_DATA_READERS_SAMPLE_LIST_BINARY_HPP_INCLUDED
@@ -159,6 +159,12 @@ template <typename sample_name_t>
 inline void sample_list<sample_name_t>
 ::load(const std::string& samplelist_file,
        size_t stride, size_t offset) {
+  if (sample_list_binary::is_binary_sample_list(samplelist_file)) {
+    const sample_list_binary list(samplelist_file);
+    m_header = read_binary_header(list, samplelist_file);
+    read_binary_sample_list(list, stride, offset);
+    return;
+  }
   std::ifstream istr(samplelist_file);
   get_samples_per_file(istr, samplelist_file, stride, offset);
   istr.close();
@@ -167,6 +173,10 @@ inline void sample_list<sample_name_t>
 template <typename sample_name_t>
 inline sample_list_header sample_list<sample_name_t>
 ::load_header(const std::string& samplelist_file) const {
+  if (sample_list_binary::is_binary_sample_list(samplelist_file)) {
+    const sample_list_binary list(samplelist_file);
+    return read_binary_header(list, samplelist_file);
+  }
   std::ifstream istr(samplelist_file);
   return read_header(istr, samplelist_file);
 }
@@ -320,6 +330,47 @@ inline void sample_list<sample_name_t>
 }
 
 
+template <typename sample_name_t>
+inline sample_list_header sample_list<sample_name_t>
+::read_binary_header(const sample_list_binary& list,
+                     const std::string& filename) const {
+  sample_list_header hdr;
+
+  hdr.m_sample_list_filename = filename;
+  // Binary lists always name the included samples
+  hdr.m_is_exclusive = false;
+  hdr.m_included_sample_count = list.get_num_included();
+  hdr.m_excluded_sample_count = list.get_num_excluded();
+  hdr.m_num_files = list.get_num_files();
+  hdr.m_file_dir = list.get_file_dir();
+
+  if (hdr.get_file_dir().empty() || !check_if_dir_exists(hdr.get_file_dir())) {
+    LBANN_ERROR(std::string{} + "file " + filename
+                 + " :: data root directory '" + hdr.get_file_dir() + "' does not exist.");
+  }
+
+  return hdr;
+}
+
+
+template <typename sample_name_t>
+inline void sample_list<sample_name_t>
+::read_binary_sample_list(const sample_list_binary& list,
+                          size_t stride, size_t offset) {
+  const size_t num_files = list.get_num_files();
+  m_sample_list.reserve((num_files + stride - 1) / stride);
+
+  // Unlike the text list, the existence of each file is not checked
+  // here but when the file is opened
+  for (size_t f = offset; f < num_files; f += stride) {
+    const sample_file_id_t index = m_file_id_stats_map.size();
+    static const auto sn0 = uninitialized_sample_name<sample_name_t>();
+    m_sample_list.emplace_back(std::make_pair(index, sn0));
+    m_file_id_stats_map.emplace_back(list.get_filename(f));
+  }
+}
+
+
 template <typename sample_name_t>
 inline size_t sample_list<sample_name_t>
 ::get_samples_per_file(std::istream& istrm,
@@ -495,6 +546,32 @@ inline void sample_list<sample_name_t>
   ofs.close();
 }
 
+template <typename sample_name_t>
+inline void sample_list<sample_name_t>
+::get_binary_files(std::vector<sample_list_binary::file_t>& files) const {
+  files.clear();
+  files.reserve(m_sample_list.size());
+  for (const auto& s : m_sample_list) {
+    // Each file holds a single sample that is named by its position
+    files.push_back({m_file_id_stats_map[s.first], 1u, {std::string()}});
+  }
+}
+
+template <typename sample_name_t>
+inline void sample_list<sample_name_t>
+::write_binary(const std::string filename) const {
+  std::string dir, basename;
+  parse_path(filename, dir, basename);
+  if (!dir.empty() && !check_if_dir_exists(dir)) {
+    std::cerr << "The sample list output directory (" + dir + ") does not exist" << std::endl;
+    return;
+  }
+
+  std::vector<sample_list_binary::file_t> files;
+  get_binary_files(files);
+  sample_list_binary::write(filename, m_header.get_file_dir(), files);
+}
+
 template <typename sample_name_t>
 inline const typename sample_list<sample_name_t>::samples_t&
 sample_list<sample_name_t>::get_list() const {
@@ -100,6 +100,14 @@ class sample_list_open_files : public sample_list<sample_name_t> {
   /// read the body of a sample list
   void read_sample_list(std::istream& istrm, size_t stride=1, size_t offset=0) override;
 
+  /**
+   * Populate the list from a binary list without opening the bundles,
+   * which are opened on first access instead
+   */
+  void read_binary_sample_list(const sample_list_binary& list, size_t stride=1, size_t offset=0) override;
+
+  void get_binary_files(std::vector<sample_list_binary::file_t>& files) const override;
+
   void assign_samples_name() override {}
 
   /// Get the number of total/included/excluded samples
@@ -283,6 +283,58 @@ inline void sample_list_open_files<sample_name_t, file_handle_t>
 }
 
 
+template <typename sample_name_t, typename file_handle_t>
+inline void sample_list_open_files<sample_name_t, file_handle_t>
+::read_binary_sample_list(const sample_list_binary& list, size_t stride, size_t offset) {
+  const size_t num_files = list.get_num_files();
+  m_file_id_stats_map.reserve((num_files + stride - 1) / stride);
+
+  for (size_t f = offset; f < num_files; f += stride) {
+    const sample_list_binary::file_entry& e = list.get_file(f);
+    const std::string filename = list.get_filename(f);
+
+    if(m_file_map.count(filename) > 0) {
+      if(e.total_samples != m_file_map[filename]) {
+        LBANN_ERROR(std::string("The same file ")
+                    + filename
+                    + " is listed multiple times with different sizes: "
+                    + std::to_string(e.total_samples)
+                    + " and "
+                    + std::to_string(m_file_map[filename]));
+      }
+    }else {
+      m_file_map[filename] = e.total_samples;
+    }
+
+    sample_file_id_t index = m_file_id_stats_map.size();
+    m_file_id_stats_map.emplace_back(std::make_tuple(filename, uninitialized_file_handle<file_handle_t>(), std::deque<std::pair<int,int>>{}));
+
+    for (size_t s = e.first_sample; s < e.first_sample + e.num_samples; ++s) {
+      m_sample_list.emplace_back(index, to_sample_name_t<sample_name_t>(list.get_sample_name(s)));
+    }
+  }
+}
+
+template <typename sample_name_t, typename file_handle_t>
+inline void sample_list_open_files<sample_name_t, file_handle_t>
+::get_binary_files(std::vector<sample_list_binary::file_t>& files) const {
+  // Files keep the order in which the list first names them
+  std::unordered_map<std::string, size_t> file_index;
+  files.clear();
+  for (const auto& s : m_sample_list) {
+    const std::string& filename = get_samples_filename(s.first);
+    const auto it = file_index.find(filename);
+    size_t i = files.size();
+    if (it == file_index.end()) {
+      file_index.emplace(filename, i);
+      files.push_back({filename, m_file_map.at(filename), {}});
+    } else {
+      i = it->second;
+    }
+    files[i].sample_names.emplace_back(lbann::to_string(s.second));
+  }
+}
+
 template <typename sample_name_t, typename file_handle_t>
 template <class Archive>
 void sample_list_open_files<sample_name_t, file_handle_t>
@@ -33,6 +33,7 @@
 #include "lbann/base.hpp"
 #include "lbann/comm.hpp"
 #include "conduit/conduit_node.hpp"
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <mutex>
@@ -145,6 +146,16 @@ class data_store_conduit {
     m_super_node = true;
   }
 
+  /// Reorders a freshly shuffled epoch so that each rank consumes as
+  /// many samples as possible that it already owns. Samples are only
+  /// permuted within windows of m_locality_window mini-batches, so a
+  /// window of one keeps the composition of every mini-batch and only
+  /// changes which rank reads which of its samples. Does nothing
+  /// unless --data_store_locality=<num mini-batches> was given, or
+  /// before the data store has started exchanging data. Also reports
+  /// the exchange statistics of the epoch that just finished.
+  void apply_locality_order(std::vector<int>& indices);
+
   void set_node_sizes_vary() { m_node_sizes_vary = true; }
 
   bool has_conduit_node(int data_id) const;
@@ -184,6 +195,26 @@ protected :
   /// exchange_data_by_sample; default if false
   bool m_super_node = false;
 
+  /// number of mini-batches within which apply_locality_order may
+  /// move samples; zero disables locality-aware ordering
+  int m_locality_window = 0;
+
+  /// if true, report the per-step exchange volume each epoch
+  bool m_report_exchange_stats = false;
+
+  /// bytes sent to other ranks, and samples read from other ranks or
+  /// from myself, since the last report
+  size_t m_exchange_bytes_sent = 0;
+  size_t m_exchange_remote_samples = 0;
+  size_t m_exchange_local_samples = 0;
+  int m_exchange_steps = 0;
+
+  /// accumulates the exchange statistics of the current step
+  void record_exchange_stats(size_t bytes_sent);
+
+  /// prints and resets the exchange statistics; see apply_locality_order
+  void report_exchange_stats();
+
   /// size of a compacted conduit::Node that contains a single sample
   int m_compacted_sample_size = 0;
 
@@ -310,6 +341,36 @@ protected :
   char *m_mem_seg = 0;
   size_t m_mem_seg_length = 0;
   std::string m_seg_name;
+
+  /// if true (--data_store_node_shared), the samples owned by all
+  /// ranks on a compute node, from every trainer, are placed once in a
+  /// node-wide shared memory segment; samples whose owner is on the
+  /// consumer's node are read from there instead of being exchanged
+  bool m_node_shared = false;
+
+  /// the node-wide segment of compacted samples; the mapping is shared
+  /// by copies of this data store and released with the last of them
+  std::shared_ptr<char> m_node_seg;
+
+  /// maps a data_id to the offset and size of its compacted sample in
+  /// m_node_seg
+  std::unordered_map<int, std::pair<size_t, size_t>> m_node_index;
+
+  /// m_node_local_ranks[p] is true if rank p of the trainer is on
+  /// this compute node
+  std::vector<bool> m_node_local_ranks;
+
+  /// data_ids of the current mini-batch that are read from m_node_seg
+  std::vector<int> m_node_reads;
+
+  /// collectively (over the node communicator) copies the samples in
+  /// m_data into m_node_seg and repoints m_data at the shared copies
+  void build_node_shared_store();
+
+  /// true if the sample is read from m_node_seg rather than exchanged
+  bool is_node_shared(int owner, int reader) const {
+    return m_node_shared && m_node_local_ranks[owner] && m_node_local_ranks[reader];
+  }
 };
 
 }  // namespace lbann
@@ -40,7 +40,12 @@ class fetch_data_functor {
  public:
   fetch_data_functor (data_reader_target_mode target_mode) :
     _target_mode(target_mode) {}
-  int operator() (CPUMat& samples, CPUMat& responses, El::Matrix<El::Int>& indices_fetched, generic_data_reader* data_reader) const {
+  data_reader_target_mode get_target_mode() const { return _target_mode; }
+  /** Fetch samples and their targets. Samples may be fetched in a
+   *  narrow type (see generic_data_reader::get_sample_storage_type),
+   *  except for reconstruction, where they are also the targets. */
+  template <typename SampleMat>
+  int operator() (SampleMat& samples, CPUMat& responses, El::Matrix<El::Int>& indices_fetched, generic_data_reader* data_reader) const {
     int num_samples_fetched = data_reader->fetch_data(samples, indices_fetched);
     int num_responses_fetched;
     switch(_target_mode) {
@@ -48,7 +53,7 @@ class fetch_data_functor {
       num_responses_fetched = data_reader->fetch_responses(responses);
       break;
     case data_reader_target_mode::RECONSTRUCTION:
-      El::Copy(samples, responses);
+      copy_samples(samples, responses);
       num_responses_fetched = num_samples_fetched;
       break;
     case data_reader_target_mode::NA:
@@ -64,7 +69,8 @@ class fetch_data_functor {
     }
     return num_samples_fetched;
   }
-  int operator() (CPUMat& samples, El::Matrix<El::Int>& indices_fetched, generic_data_reader* data_reader) const {
+  template <typename SampleMat>
+  int operator() (SampleMat& samples, El::Matrix<El::Int>& indices_fetched, generic_data_reader* data_reader) const {
     int num_samples_fetched = data_reader->fetch_data(samples, indices_fetched);
     switch(_target_mode) {
     case data_reader_target_mode::NA:
@@ -78,6 +84,13 @@ class fetch_data_functor {
     return num_samples_fetched;
   }
  private:
+  static void copy_samples(const CPUMat& samples, CPUMat& responses) {
+    El::Copy(samples, responses);
+  }
+  template <typename T>
+  static void copy_samples(const El::Matrix<T>&, CPUMat&) {
+    LBANN_ERROR("reconstruction targets require samples of type DataType");
+  }
   const data_reader_target_mode _target_mode;
 };
 
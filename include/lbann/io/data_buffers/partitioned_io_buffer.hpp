@@ -41,9 +41,23 @@ class data_buffer {
   std::future<void> m_data_fetch_future;
   /// 1-D Matrix of which indices were fetched in this mini-batch
   El::Matrix<El::Int> m_indices_fetched_per_mb;
+  /** Element type of the samples that were fetched. Narrow samples
+   *  are held in m_uint8_samples or m_int16_samples instead of the
+   *  first input buffer, and converted when they are distributed. */
+  sample_storage_type m_sample_storage_type;
+  /// Local samples fetched as uint8
+  El::Matrix<uint8_t> m_uint8_samples;
+  /// Local samples fetched as int16
+  El::Matrix<int16_t> m_int16_samples;
+  /// Scale applied when converting narrow samples to DataType
+  DataType m_sample_scale;
+  /// Bias applied when converting narrow samples to DataType
+  DataType m_sample_bias;
 
   data_buffer(lbann_comm *comm, int num_child_layers) :
-    m_num_samples_fetched(0), m_fetch_data_in_background(false)
+    m_num_samples_fetched(0), m_fetch_data_in_background(false),
+    m_sample_storage_type(sample_storage_type::data_type),
+    m_sample_scale(1), m_sample_bias(0)
   {
     m_input_buffers.clear();
     m_input_buffers.resize(num_child_layers);
@@ -53,7 +67,12 @@ class data_buffer {
   }
 
   data_buffer(const data_buffer& other) :
-    m_num_samples_fetched(other.m_num_samples_fetched)
+    m_num_samples_fetched(other.m_num_samples_fetched),
+    m_sample_storage_type(other.m_sample_storage_type),
+    m_uint8_samples(other.m_uint8_samples),
+    m_int16_samples(other.m_int16_samples),
+    m_sample_scale(other.m_sample_scale),
+    m_sample_bias(other.m_sample_bias)
   {
     m_fetch_data_in_background.store(other.m_fetch_data_in_background);
     m_input_buffers.clear();
@@ -64,6 +83,11 @@ class data_buffer {
   }
   data_buffer& operator=(const data_buffer& other) {
     m_num_samples_fetched = other.m_num_samples_fetched;
+    m_sample_storage_type = other.m_sample_storage_type;
+    m_uint8_samples = other.m_uint8_samples;
+    m_int16_samples = other.m_int16_samples;
+    m_sample_scale = other.m_sample_scale;
+    m_sample_bias = other.m_sample_bias;
     m_fetch_data_in_background.store(other.m_fetch_data_in_background);
     m_input_buffers.clear();
     m_input_buffers.reserve(other.m_input_buffers.size());
@@ -135,6 +159,15 @@ class partitioned_io_buffer : public generic_io_buffer {
    *  or label or responase.
    */
   data_buffer_map_t m_data_buffers;
+
+ private:
+  /** Fetch samples in the data reader's native narrow type. */
+  template <typename T>
+  int fetch_narrow_samples(data_buffer& buf, El::Matrix<T>& samples,
+                           generic_data_reader *data_reader);
+  /** Populate the input layer's samples from the fetched samples,
+   *  converting narrow samples to DataType. */
+  void distribute_samples(data_buffer& buf, AbsDistMat& sample);
 };
 }
 
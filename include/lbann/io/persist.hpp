@@ -32,6 +32,10 @@
 #include "lbann/base.hpp"
 #include "El.hpp"
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace lbann {
 
 enum class persist_type {
@@ -58,6 +62,19 @@ class persist {
   char m_train_filename[1024];
   char m_validate_filename[1024];
   callback_type ckpt_type;
+  /** Whether rank matrices are compressed */
+  bool m_compress = false;
+  /** Checkpoint holding the base values of delta-encoded rank
+   *  matrices, or empty to write full values */
+  std::string m_delta_base_dir;
+  /** Base values of delta-encoded rank matrices for the checkpoint
+   *  being read */
+  std::string m_restart_base_dir;
+  /** Local values of the rank matrices in the last full checkpoint,
+   *  by file name */
+  std::unordered_map<std::string, std::vector<DataType>> m_delta_base;
+  uint64_t m_uncompressed_bytes = 0;
+  EvalType m_compression_time = 0;
  public:
   char m_checkpoint_dir[1024];
 
@@ -85,6 +102,30 @@ class persist {
 
   void reset_bytes() {
     m_bytes = 0;
+    m_uncompressed_bytes = 0;
+    m_compression_time = 0;
+  }
+
+  /** @brief Compress rank matrices in the next checkpoints.
+   *
+   *  Rank matrices are compressed losslessly (see
+   *  @c compress_values). With an empty @c delta_base_dir, full
+   *  values are written and kept in memory as the base for later
+   *  delta checkpoints. Otherwise only the XOR of each matrix with its
+   *  base is stored, and @c delta_base_dir is recorded as the
+   *  checkpoint to read base values from on restart. It must be the
+   *  last full checkpoint and be in the same parent directory.
+   */
+  void set_compression(bool compress, const std::string& delta_base_dir = "");
+
+  /** Size of the compressed rank matrices before compression */
+  uint64_t get_uncompressed_bytes() const {
+    return m_uncompressed_bytes;
+  }
+
+  /** Time spent compressing and decompressing rank matrices */
+  EvalType get_compression_time() const {
+    return m_compression_time;
   }
 
   bool write_rank_distmat(persist_type type, const char *name, const AbsDistMat& M);
@@ -119,8 +160,31 @@ class persist {
 
  private:
   int get_fd(persist_type type) const;
+  bool write_compressed_rank_distmat(const std::string& filename,
+                                     const std::string& key,
+                                     const AbsDistMat& M);
+  void read_compressed_rank_distmat(int fd,
+                                    const std::string& filename,
+                                    const std::string& key,
+                                    AbsDistMat& M);
 };
 
+/** Write a distributed matrix to a single shared file.
+ *  Every process writes its local block concurrently with MPI-IO and
+ *  redundant copies split their block, so no process gathers the
+ *  matrix. Returns the number of bytes written by this process. The
+ *  file is written with El::Write if the distribution is not
+ *  supported (CIRC or BLOCK distributions).
+ */
+uint64_t write_shared_distmat(const std::string& filename, const AbsDistMat& M);
+/** Read a distributed matrix written by write_shared_distmat.
+ *  The matrix may have a different distribution or process grid
+ *  than the writer. Returns false if the file does not exist or is
+ *  not in the shared format, e.g. a legacy El::BINARY file.
+ */
+bool read_shared_distmat(const std::string& filename, AbsDistMat& M,
+                         uint64_t *bytes = nullptr);
+
 bool write_distmat(int fd, const char *name, DistMat *M, uint64_t *bytes);
 bool read_distmat (int fd, const char *name, DistMat *M, uint64_t *bytes);
 
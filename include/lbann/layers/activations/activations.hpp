@@ -55,6 +55,10 @@ DEFINE_ENTRYWISE_UNARY_LAYER(log_sigmoid_layer, "log sigmoid")
  *  See https://en.wikipedia.org/wiki/Rectifier_(neural_networks).
  */
 DEFINE_ENTRYWISE_UNARY_LAYER(relu_layer, "ReLU")
+template <>
+struct entrywise_unary_epilogue<relu_layer_name_struct> {
+  static gemm_epilogue get() { return gemm_epilogue(epilogue_activation::relu); }
+};
 
 /** @class lbann::selu_layer
  *  @brief Scaled exponential rectified linear unit.
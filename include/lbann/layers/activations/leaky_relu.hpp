@@ -55,6 +55,13 @@ public:
   std::string get_type() const override { return "leaky ReLU"; }
   data_layout get_data_layout() const override { return Layout; }
   El::Device get_device_allocation() const override { return Device; }
+  gemm_epilogue get_fusable_activation() const override {
+    if (!gemm_epilogue::is_supported(epilogue_activation::leaky_relu,
+                                     m_negative_slope)) {
+      return gemm_epilogue();
+    }
+    return gemm_epilogue(epilogue_activation::leaky_relu, m_negative_slope);
+  }
 
   description get_description() const override {
     auto desc = Layer::get_description();
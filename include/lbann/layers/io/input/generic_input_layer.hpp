@@ -128,6 +128,8 @@ class generic_input_layer : public io_layer {
 
   std::string get_type() const override { return "generic_input"; }
 
+  bool may_run_concurrently() const override { return false; }
+
   description get_description() const override {
     auto desc = io_layer::get_description();
     desc.add("Buffer", m_io_buffers[0]->get_type());
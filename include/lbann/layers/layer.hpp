@@ -34,6 +34,9 @@
 #include "lbann/utils/exception.hpp"
 #include "lbann/utils/timer.hpp"
 #include "lbann/utils/description.hpp"
+#include "lbann/utils/reduced_precision.hpp"
+#include "lbann/utils/gemm_epilogue.hpp"
+#include "lbann/utils/int8_gemm.hpp"
 #include "lbann/io/persist.hpp"
 #include <string>
 #include <vector>
@@ -325,6 +328,192 @@ public:
   void unfreeze();
   bool is_frozen() const;
 
+  // ===========================================================
+  // Activation storage functions
+  // ===========================================================
+
+  /** Storage precision of output tensors between forward and back
+   *  prop.
+   */
+  storage_precision get_activation_storage_precision() const {
+    return m_activation_storage_precision;
+  }
+  /** Storage precision of output tensors between forward and back
+   *  prop.
+   */
+  void set_activation_storage_precision(storage_precision precision) {
+    m_activation_storage_precision = precision;
+  }
+
+  /** Move output tensors into reduced precision storage.
+   *  Called once all child layers have finished forward prop. The
+   *  full precision buffers are deallocated. Output tensors that are
+   *  views, are viewed by a child's output tensors, are not on CPU,
+   *  or have full storage precision are left untouched. Returns the number of bytes freed (net of the packed
+   *  storage).
+   */
+  size_t pack_activations();
+  /** Restore output tensors from reduced precision storage.
+   *  Values are rounded to the storage precision. Input tensors of
+   *  child layers must be set up again with @c refresh_inputs since
+   *  the output buffers are reallocated.
+   */
+  void unpack_activations();
+  /** Whether any output tensors are in reduced precision storage. */
+  bool has_packed_activations() const;
+  /** Set up input tensors again as views or copies of the parent
+   *  layers' output tensors.
+   */
+  void refresh_inputs();
+
+  /** Whether forward and back prop may run concurrently with other
+   *  layers. Layers that communicate over a communicator shared with
+   *  other layers must issue their collectives in the same order on
+   *  every process, so the model runs them one at a time in
+   *  topological order. Gradient allreduces don't count since the
+   *  model launches them itself. The base method accepts
+   *  data-parallel layers whose parents and children have the same
+   *  data layout and device, since tensors are otherwise
+   *  redistributed with collectives.
+   */
+  virtual bool may_run_concurrently() const;
+
+  // ===========================================================
+  // Tensor placement functions
+  // ===========================================================
+
+  /** Whether output tensors and gradients w.r.t. input tensors can be
+   *  placed inside other layers' tensors.
+   *  Placed tensors are views with a leading dimension larger than
+   *  their height, so compute kernels must respect the leading
+   *  dimension. Layers whose kernels have been checked for this opt
+   *  in. The base method returns false.
+   */
+  virtual bool supports_tensor_placement() const { return false; }
+  /** Place tensors of neighboring layers inside this layer's tensors.
+   *  Called during model setup if zero-copy tensor placement is
+   *  enabled. The base method does nothing. Returns the number of
+   *  tensors that were placed.
+   */
+  virtual int setup_tensor_placement() { return 0; }
+  /** Remove placement of this layer's tensors. */
+  void clear_tensor_placement();
+  /** Set up output tensor as a block of rows in a child layer's
+   *  output tensor.
+   *  The parent layer allocates the child's output tensor if needed.
+   */
+  void place_activations(Layer& child, El::Int row_offset);
+  /** Set up gradient w.r.t. input tensor as a block of rows in a
+   *  parent layer's gradient w.r.t. input tensor.
+   *  The child layer allocates the parent's gradient w.r.t. input
+   *  tensor if needed.
+   */
+  void place_error_signals(Layer& parent, El::Int row_offset);
+  /** Whether tensors of other layers are placed inside this layer's
+   *  tensors.
+   */
+  bool is_tensor_placement_target() const noexcept {
+    return m_tensor_placement_target;
+  }
+  /** Local bytes not copied in the most recent step because tensors
+   *  were already in place.
+   */
+  size_t get_bytes_copy_elided() const noexcept {
+    return m_bytes_copy_elided;
+  }
+
+  // ===========================================================
+  // Activation fusion functions
+  // ===========================================================
+
+  /** Whether this layer can apply the activation of its child in its
+   *  forward prop compute kernel. The base method returns false.
+   */
+  virtual bool supports_fused_activation() const { return false; }
+  /** Entrywise activation this layer computes, if the parent layer
+   *  may compute it instead. The base method returns an epilogue
+   *  without activation.
+   */
+  virtual gemm_epilogue get_fusable_activation() const { return gemm_epilogue(); }
+  /** Apply the activation of the only child layer in this layer's
+   *  forward prop.
+   *  The child layer passes its input tensors through as views. In
+   *  back prop, the gradient w.r.t. this layer's output is converted
+   *  to a gradient w.r.t. the activation input before the compute
+   *  kernel runs, so the output tensor holds the activation output
+   *  for both.
+   */
+  void fuse_activation(Layer& child);
+  /** Remove activation fusion of this layer. */
+  void clear_activation_fusion();
+  /** Activation applied in forward prop on behalf of the child layer. */
+  const gemm_epilogue& get_fused_activation() const noexcept {
+    return m_fused_activation;
+  }
+  /** Whether the parent layer computes this layer's output, either
+   *  as a fused activation or as folded parameters.
+   */
+  bool is_fused_into_parent() const noexcept { return m_fused_into_parent; }
+
+  // ===========================================================
+  // Inference folding functions
+  // ===========================================================
+
+  /** Per-channel affine transform y = scale * x + shift that this
+   *  layer applies during inference, if the parent layer may fold it
+   *  into its parameters. The input tensor is split into equal blocks
+   *  of rows, one for each channel. The base method returns false.
+   */
+  virtual bool get_foldable_affine(std::vector<DataType>& scale,
+                                   std::vector<DataType>& shift) const {
+    return false;
+  }
+  /** Whether a per-channel affine transform of the output tensor with
+   *  the given number of channels can be folded into this layer's
+   *  parameters. The base method returns false.
+   */
+  virtual bool supports_affine_folding(El::Int num_channels) const {
+    return false;
+  }
+  /** Fold the affine transform of the only child layer into this
+   *  layer's parameters.
+   *  The child layer passes its input tensors through as views. The
+   *  parameters are changed in place, so the model may only be used
+   *  for inference afterwards.
+   */
+  void fold_affine(Layer& child);
+  /** Apply forward prop to a given input tensor without involving
+   *  parent or child layers. Used to check graph transforms. Returns
+   *  the output tensor.
+   */
+  const AbsDistMat& forward_prop_probe(const AbsDistMat& input);
+
+  // ===========================================================
+  // Int8 quantization functions
+  // ===========================================================
+
+  /** Whether this layer has an int8 inference path on CPU. The
+   *  input tensor is split into equal blocks of rows, one for each
+   *  entry of the first input dimension. The base method returns
+   *  false.
+   */
+  virtual bool supports_int8_quantization() const { return false; }
+  /** Quantize parameters to int8 for inference.
+   *  The full precision parameters are kept, and the int8 path is
+   *  only used outside of training. The parameters must not change
+   *  while the layer is quantized. The base method throws an
+   *  exception.
+   *  @param input_ranges   Largest absolute value in each input
+   *                        channel, e.g. found by calibration.
+   */
+  virtual void quantize_int8(const std::vector<DataType>& input_ranges);
+  /** Remove int8 quantization. The base method does nothing. */
+  virtual void clear_int8_quantization() {}
+  /** Quantized parameters, or a null pointer if the layer is not
+   *  quantized. The base method returns a null pointer.
+   */
+  virtual const int8_gemm* get_int8_gemm() const { return nullptr; }
+
 protected:
 
   // ===========================================================
@@ -421,6 +610,30 @@ protected:
    */
   virtual bool update_compute() { return true; }
 
+  // ===========================================================
+  // Inference folding helper functions
+  // ===========================================================
+
+  /** Change parameters so that the output tensor becomes
+   *  scale * output + shift in each channel.
+   *  Called by the 'fold_affine' function. The base method throws an
+   *  exception.
+   */
+  virtual void fold_affine_parameters(const std::vector<DataType>& scale,
+                                      const std::vector<DataType>& shift);
+
+  // ===========================================================
+  // Tensor placement helper functions
+  // ===========================================================
+
+  /** Whether a tensor is a view of a block of rows in another tensor.
+   *  If so, copying between them is unnecessary. Only distributions
+   *  where all rows are local are recognized.
+   */
+  static bool occupies_rows(const AbsDistMat& block,
+                            const AbsDistMat& tensor,
+                            El::Int row_offset);
+
   // ===========================================================
   // Protected class members
   // ===========================================================
@@ -468,6 +681,12 @@ protected:
    */
   std::string m_name;
 
+  /** Local bytes not copied in the most recent step because tensors
+   *  were already in place.
+   *  Reset at the start of forward prop.
+   */
+  size_t m_bytes_copy_elided = 0;
+
 private:
 
   // ===========================================================
@@ -478,6 +697,12 @@ private:
   const AbsDistMat& get_activations(const Layer& child) const;
   /** Get error signal tensor corresponding to parent layer. */
   const AbsDistMat& get_error_signals(const Layer& parent) const;
+  /** Whether an output tensor of the child layer is a view into an
+   *  output tensor of this layer. Layers further down the graph may
+   *  still read through such views (e.g. split or identity), so the
+   *  output tensor must stay allocated.
+   */
+  bool is_output_viewed_by_child(int child_index) const;
 
   // ===========================================================
   // Private class members
@@ -510,6 +735,53 @@ private:
    */
   const Layer* m_hint_layer = nullptr;
 
+  /** Storage precision of output tensors between forward and back
+   *  prop.
+   */
+  storage_precision m_activation_storage_precision = storage_precision::full;
+
+  /** Output tensor in reduced precision storage. */
+  struct packed_tensor {
+    /** Whether the output tensor is currently packed. */
+    bool packed = false;
+    /** Local data in 16-bit format (column-major, fully packed). */
+    std::vector<uint16_t> data;
+    /** Distribution of the full precision tensor. */
+    El::DistData dist;
+    /** Global dimensions of the full precision tensor. */
+    El::Int height = 0;
+    El::Int width = 0;
+  };
+  /** Packed output tensors, one entry for each child layer. */
+  std::vector<packed_tensor> m_packed_outputs;
+
+  /** Tensor stored as a block of rows in another layer's tensor. */
+  struct tensor_placement {
+    /** Layer that owns the underlying tensor. */
+    Layer* target = nullptr;
+    /** First row of the block. */
+    El::Int row_offset = 0;
+  };
+  /** Placement of output tensors, one entry for each child layer. */
+  std::vector<tensor_placement> m_output_placements;
+  /** Placement of gradients w.r.t. input tensors, one entry for each
+   *  parent layer.
+   */
+  std::vector<tensor_placement> m_gradient_wrt_input_placements;
+  /** Whether tensors of other layers are placed inside this layer's
+   *  tensors.
+   */
+  bool m_tensor_placement_target = false;
+
+  /** Activation applied in forward prop on behalf of the child layer. */
+  gemm_epilogue m_fused_activation;
+  /** Whether the parent layer computes this layer's activation. */
+  bool m_fused_into_parent = false;
+  /** Gradient w.r.t. the activation input when an activation is
+   *  fused. Allocated on first use.
+   */
+  std::unique_ptr<AbsDistMat> m_fused_gradient_wrt_output;
+
 };
 
 } // namespace lbann
@@ -69,6 +69,12 @@ protected:
    *  If the scaling factor is zero, bias is not applied.
    */
   DataType m_bias_scaling_factor;
+  /** Bias with folded affine transforms, one entry per output
+   *  channel. Replaces the bias weights if not empty.
+   */
+  std::vector<DataType> m_folded_bias;
+  /** Convolution kernel quantized for int8 inference. */
+  int8_gemm m_int8_kernel;
 
 #ifdef LBANN_HAS_CUDNN
 
@@ -121,7 +127,9 @@ public:
       m_strides(other.m_strides),
       m_dilations(other.m_dilations),
       m_groups(other.m_groups),
-      m_bias_scaling_factor(other.m_bias_scaling_factor)
+      m_bias_scaling_factor(other.m_bias_scaling_factor),
+      m_folded_bias(other.m_folded_bias),
+      m_int8_kernel(other.m_int8_kernel)
 #ifdef LBANN_HAS_CUDNN
     , m_tensors_cudnn_desc(other.m_tensors_cudnn_desc),
       m_fwd_cudnn_algos(other.m_fwd_cudnn_algos),
@@ -151,6 +159,8 @@ public:
     m_dilations = other.m_dilations;
     m_groups = other.m_groups;
     m_bias_scaling_factor = other.m_bias_scaling_factor;
+    m_folded_bias = other.m_folded_bias;
+    m_int8_kernel = other.m_int8_kernel;
 
 #ifdef LBANN_HAS_CUDNN
     // Copy cuDNN objects
@@ -186,6 +196,17 @@ public:
 #endif // LBANN_HAS_CUDNN
   }
 
+  bool supports_fused_activation() const override {
+    return Device == El::Device::CPU;
+  }
+  bool supports_int8_quantization() const override {
+    return Device == El::Device::CPU;
+  }
+  void clear_int8_quantization() override { m_int8_kernel.clear(); }
+  const int8_gemm* get_int8_gemm() const override {
+    return m_int8_kernel.is_empty() ? nullptr : &m_int8_kernel;
+  }
+
   description get_description() const override {
     auto desc = Layer::get_description();
     std::ostringstream ss;
@@ -786,6 +807,12 @@ protected:
     DMat<Device> im2col_matrix(k, m);
     const DMat<Device> kernel_matrix(k, n, local_kernel.LockedBuffer(), k);
 
+    // Use int8 kernel during inference
+    const bool use_int8 = (during_forward_prop
+                           && !m_int8_kernel.is_empty()
+                           && this->m_model->get_execution_mode() != execution_mode::training);
+    std::vector<std::int8_t> quantized_im2col(use_int8 ? k * m : 0);
+
     // Iterate through input columns
     for (El::Int col = 0; col < local_width; ++col) {
 
@@ -802,9 +829,17 @@ protected:
 
       // Apply convolution to current input column
       output_col.Attach(m, n, local_output.Buffer(0, col), m);
-      El::Gemm(El::TRANSPOSE, El::NORMAL,
-               DataType(1), im2col_matrix, kernel_matrix,
-               DataType(0), output_col);
+      if (use_int8) {
+        m_int8_kernel.quantize_input(m, im2col_matrix.LockedBuffer(), k,
+                                     false, quantized_im2col.data());
+        m_int8_kernel.apply(m, quantized_im2col.data(),
+                            output_col.Buffer(), m, true);
+      } else {
+        El::Gemm(El::TRANSPOSE, El::NORMAL,
+                 DataType(1), im2col_matrix, kernel_matrix,
+                 DataType(0), output_col);
+      }
+      if (during_forward_prop) { apply_epilogue_cpu(local_output, col); }
 
     }
 
@@ -847,14 +882,27 @@ protected:
     DMat<Device> im2col_matrix(m, n);
     const DMat<Device> kernel_matrix(m, k, local_kernel.LockedBuffer(), m);
 
+    // Use int8 kernel during inference
+    const bool use_int8 = (during_forward_prop
+                           && !m_int8_kernel.is_empty()
+                           && this->m_model->get_execution_mode() != execution_mode::training);
+    std::vector<std::int8_t> quantized_input(use_int8 ? k * n : 0);
+
     // Iterate through input columns
     for (El::Int col = 0; col < local_width; ++col) {
 
       // Apply transposed convolution to current input column
       input_col.LockedAttach(n, k, local_input.LockedBuffer(0, col), n);
-      El::Gemm(El::NORMAL, El::TRANSPOSE,
-               DataType(1), kernel_matrix, input_col,
-               DataType(0), im2col_matrix);
+      if (use_int8) {
+        m_int8_kernel.quantize_input(n, input_col.LockedBuffer(), n,
+                                     true, quantized_input.data());
+        m_int8_kernel.apply(n, quantized_input.data(),
+                            im2col_matrix.Buffer(), m, false);
+      } else {
+        El::Gemm(El::NORMAL, El::TRANSPOSE,
+                 DataType(1), kernel_matrix, input_col,
+                 DataType(0), im2col_matrix);
+      }
 
       // Perform col2im to accumulate contributions from each kernel
       // position
@@ -867,39 +915,66 @@ protected:
              m_pads.data(),
              &kernel_dims[2],
              m_strides.data());
+      if (during_forward_prop) { apply_epilogue_cpu(local_output, col); }
 
     }
 
   }
 
-  void apply_bias_cpu() {
-
-    // Return immediately if there is no bias
-    if (m_bias_scaling_factor == DataType(0)) return;
-
-    // Local matrices
-    const auto& local_bias = m_weights[1]->get_values().LockedMatrix();
-    auto& local_output = get_local_activations();
-
-    // Matrix parameters
-    const El::Int local_width = local_output.Width();
-    const auto& output_dims = get_output_dims();
-    const El::Int num_output_channels = output_dims[0];
-    const El::Int num_per_output_channel = get_output_size() / num_output_channels;
-
-    // Apply bias to each output channel
-    LBANN_OMP_PARALLEL_FOR
-    for (El::Int channel = 0; channel < num_output_channels; ++channel) {
-      const El::Int row_start = channel * num_per_output_channel;
-      const El::Int row_end = (channel+1) * num_per_output_channel;
-      const DataType bias_term = m_bias_scaling_factor * local_bias(channel, 0);
-      for (El::Int col = 0; col < local_width; ++col) {
-        for (El::Int row = row_start; row < row_end; ++row) {
-          local_output(row, col) += bias_term;
-        }
-      }
+  /** Apply bias and fused activation to an output column on CPU.
+   *  Called right after the column is computed, while it is still in
+   *  cache.
+   */
+  void apply_epilogue_cpu(AbsMat& local_output, El::Int col) {
+    const auto& epilogue = get_fused_activation();
+    const DataType* bias = nullptr;
+    DataType bias_scale = m_bias_scaling_factor;
+    if (!m_folded_bias.empty()) {
+      bias = m_folded_bias.data();
+      bias_scale = DataType(1);
+    } else if (m_bias_scaling_factor != DataType(0)) {
+      bias = m_weights[1]->get_values().LockedMatrix().LockedBuffer();
     }
+    if (bias == nullptr && !epilogue.has_activation()) { return; }
+    const auto& num_output_channels = get_output_dims()[0];
+    epilogue.apply_forward(local_output.Height(), 1,
+                           local_output.Buffer(0, col),
+                           local_output.LDim(),
+                           bias, bias_scale,
+                           get_output_size() / num_output_channels);
+  }
 
+  /** Quantize the convolution kernel for the int8 im2col path.
+   *  The kernel matrix is a GEMM operand of the same shape as in
+   *  apply_convolution_im2col or
+   *  apply_transposed_convolution_im2col.
+   */
+  void quantize_kernel_int8(const std::vector<DataType>& input_ranges,
+                            bool using_transposed_convolution) {
+    std::vector<DataType> input_scales;
+    for (const auto& range : input_ranges) {
+      input_scales.push_back(int8_gemm::get_scale(range));
+    }
+    const auto& local_kernel = this->m_weights[0]->get_values().LockedMatrix();
+    const auto& kernel_dims = get_kernel_dims();
+    const auto& kernel_size = std::accumulate(kernel_dims.begin(),
+                                              kernel_dims.end(),
+                                              1, std::multiplies<int>());
+    if (using_transposed_convolution) {
+      // Kernel matrix is (window size x input channels)
+      const int num_input_channels = get_input_dims()[0];
+      const int window_size = kernel_size / num_input_channels;
+      m_int8_kernel.setup(window_size, num_input_channels,
+                          local_kernel.LockedBuffer(), window_size,
+                          false, input_scales);
+    } else {
+      // Kernel matrix is (window size x output channels)
+      const int num_output_channels = get_output_dims()[0];
+      const int window_size = kernel_size / num_output_channels;
+      m_int8_kernel.setup(num_output_channels, window_size,
+                          local_kernel.LockedBuffer(), window_size,
+                          true, input_scales);
+    }
   }
 
   void compute_gradients_im2col(bool using_transposed_convolution) {
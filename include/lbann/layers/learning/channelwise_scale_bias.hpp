@@ -83,6 +83,20 @@ public:
   data_layout get_data_layout() const override { return Layout; }
   El::Device get_device_allocation() const override { return Device; }
 
+  bool get_foldable_affine(std::vector<DataType>& scale,
+                           std::vector<DataType>& shift) const override {
+    if (Device != El::Device::CPU) { return false; }
+    const auto& local_weights = m_weights[0]->get_values().LockedMatrix();
+    const El::Int num_channels = get_output_dims()[0];
+    scale.resize(num_channels);
+    shift.resize(num_channels);
+    for (El::Int channel = 0; channel < num_channels; ++channel) {
+      scale[channel] = local_weights(channel, 0);
+      shift[channel] = local_weights(channel, 1);
+    }
+    return true;
+  }
+
   void setup_matrices(const El::Grid& grid) override {
     Layer::setup_matrices(grid);
     m_weights_gradient.reset(new StarMat<Device>(grid));
@@ -102,6 +102,25 @@ public:
 
   El::Device get_device_allocation() const override { return Device; }
 
+  /** The im2col kernels access output and input gradient columns
+   *  through the leading dimension.
+   */
+  bool supports_tensor_placement() const override {
+    return (Device == El::Device::CPU && !this->is_fused_into_parent());
+  }
+
+  bool supports_affine_folding(El::Int num_channels) const override {
+    return (Device == El::Device::CPU
+            && num_channels == this->get_output_dims()[0]);
+  }
+
+  void quantize_int8(const std::vector<DataType>& input_ranges) override {
+    if (!this->supports_int8_quantization()) {
+      Layer::quantize_int8(input_ranges);
+    }
+    base_convolution_layer<Device>::quantize_kernel_int8(input_ranges, false);
+  }
+
 protected:
 
   void setup_dims() override {
@@ -143,11 +162,42 @@ protected:
       base_convolution_layer<Device>::apply_convolution_cudnn(true);
       base_convolution_layer<Device>::apply_bias_cudnn();
     } else {
+      // Note: Bias is applied to each output column right after the
+      // column is computed
       base_convolution_layer<Device>::apply_convolution_im2col(true);
-      base_convolution_layer<Device>::apply_bias_cpu();
     }
   }
 
+  void fold_affine_parameters(const std::vector<DataType>& scale,
+                              const std::vector<DataType>& shift) override {
+    const El::Int num_channels = scale.size();
+
+    // Bias before folding
+    std::vector<DataType> bias(num_channels, DataType(0));
+    if (!this->m_folded_bias.empty()) {
+      bias = this->m_folded_bias;
+    } else if (this->m_bias_scaling_factor != DataType(0)) {
+      const auto& local_bias = this->m_weights[1]->get_values().LockedMatrix();
+      for (El::Int channel = 0; channel < num_channels; ++channel) {
+        bias[channel] = this->m_bias_scaling_factor * local_bias(channel, 0);
+      }
+    }
+
+    // Scale kernel entries and bias of each output channel
+    // Note: Kernel entries of an output channel are contiguous.
+    auto& local_kernel = this->m_weights[0]->get_values().Matrix();
+    const El::Int channel_kernel_size = local_kernel.Height() / num_channels;
+    for (El::Int channel = 0; channel < num_channels; ++channel) {
+      const auto& a = scale[channel];
+      bias[channel] = a * bias[channel] + shift[channel];
+      auto* kernel = local_kernel.Buffer(channel * channel_kernel_size, 0);
+      for (El::Int i = 0; i < channel_kernel_size; ++i) {
+        kernel[i] *= a;
+      }
+    }
+    this->m_folded_bias = std::move(bias);
+  }
+
   void bp_compute() override {
     if(this->using_gpus()) {
       base_convolution_layer<Device>::compute_gradients_cudnn(false);
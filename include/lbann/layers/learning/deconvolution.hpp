@@ -97,6 +97,13 @@ public:
 
   El::Device get_device_allocation() const override { return Device; }
 
+  void quantize_int8(const std::vector<DataType>& input_ranges) override {
+    if (!this->supports_int8_quantization()) {
+      Layer::quantize_int8(input_ranges);
+    }
+    base_convolution_layer<Device>::quantize_kernel_int8(input_ranges, true);
+  }
+
   void setup_dims() override {
     base_convolution_layer<Device>::setup_dims();
     std::stringstream err;
@@ -159,8 +166,9 @@ protected:
       base_convolution_layer<Device>::apply_transposed_convolution_cudnn(true);
       base_convolution_layer<Device>::apply_bias_cudnn();
     } else {
+      // Note: Bias is applied to each output column right after the
+      // column is computed
       base_convolution_layer<Device>::apply_transposed_convolution_im2col(true);
-      base_convolution_layer<Device>::apply_bias_cpu();
     }
   }
 
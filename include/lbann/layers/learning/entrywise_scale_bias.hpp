@@ -76,6 +76,26 @@ public:
   data_layout get_data_layout() const override { return Layout; }
   El::Device get_device_allocation() const override { return Device; }
 
+  /** Each tensor entry is its own channel. Only data-parallel scale
+   *  and bias terms are stored on every process.
+   */
+  bool get_foldable_affine(std::vector<DataType>& scale,
+                           std::vector<DataType>& shift) const override {
+    if (Layout != data_layout::DATA_PARALLEL
+        || Device != El::Device::CPU) {
+      return false;
+    }
+    const auto& local_scale_bias = m_weights[0]->get_values().LockedMatrix();
+    const El::Int size = get_output_size();
+    scale.resize(size);
+    shift.resize(size);
+    for (El::Int i = 0; i < size; ++i) {
+      scale[i] = local_scale_bias(i, 0);
+      shift[i] = local_scale_bias(i, 1);
+    }
+    return true;
+  }
+
   void setup_matrices(const El::Grid& grid) override {
     Layer::setup_matrices(grid);
     auto dist = get_prev_activations().DistData();
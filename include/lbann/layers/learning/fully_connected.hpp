@@ -31,8 +31,10 @@
 #include "lbann/models/model.hpp"
 #include "lbann/weights/initializer.hpp"
 #include "lbann/weights/variance_scaling_initializers.hpp"
+#include <cstdint>
 #include <string>
 #include <sstream>
+#include <vector>
 
 namespace lbann {
 
@@ -62,7 +64,9 @@ public:
   fully_connected_layer(const fully_connected_layer& other) :
     learning_layer(other),
     m_bias_scaling_factor(other.m_bias_scaling_factor),
-    m_transpose(other.m_transpose) {
+    m_transpose(other.m_transpose),
+    m_folded_bias(other.m_folded_bias),
+    m_int8_linearity(other.m_int8_linearity) {
 
     // Deep matrix copies
     m_bias_gradient = other.m_bias_gradient;
@@ -76,6 +80,8 @@ public:
     learning_layer::operator=(other);
     m_bias_scaling_factor = other.m_bias_scaling_factor;
     m_transpose = other.m_transpose;
+    m_folded_bias = other.m_folded_bias;
+    m_int8_linearity = other.m_int8_linearity;
 
     // Deep matrix copies
     deallocate_matrices();
@@ -98,6 +104,41 @@ public:
   std::string get_type() const override { return "fully connected"; }
   data_layout get_data_layout() const override { return T_layout; }
   El::Device get_device_allocation() const override { return Dev; }
+  bool supports_fused_activation() const override {
+    return Dev == El::Device::CPU;
+  }
+  bool supports_affine_folding(El::Int num_channels) const override {
+    return (T_layout == data_layout::DATA_PARALLEL
+            && Dev == El::Device::CPU
+            && num_channels > 0
+            && get_output_size() % num_channels == 0);
+  }
+  bool supports_int8_quantization() const override {
+    return (T_layout == data_layout::DATA_PARALLEL
+            && Dev == El::Device::CPU);
+  }
+  void quantize_int8(const std::vector<DataType>& input_ranges) override {
+    if (!supports_int8_quantization()) {
+      learning_layer::quantize_int8(input_ranges);
+    }
+    std::vector<DataType> input_scales;
+    for (const auto& range : input_ranges) {
+      input_scales.push_back(int8_gemm::get_scale(range));
+    }
+    const auto& local_linearity = this->m_weights[0]->get_values().LockedMatrix();
+    m_int8_linearity.setup(get_output_size(), get_input_size(),
+                           local_linearity.LockedBuffer(),
+                           local_linearity.LDim(),
+                           m_transpose,
+                           input_scales);
+  }
+  void clear_int8_quantization() override {
+    m_int8_linearity.clear();
+    std::vector<std::int8_t>().swap(m_int8_input);
+  }
+  const int8_gemm* get_int8_gemm() const override {
+    return m_int8_linearity.is_empty() ? nullptr : &m_int8_linearity;
+  }
 
   description get_description() const override {
     auto desc = learning_layer::get_description();
@@ -207,6 +248,43 @@ protected:
   void fp_compute() override;
   void bp_compute() override;
 
+  void fold_affine_parameters(const std::vector<DataType>& scale,
+                              const std::vector<DataType>& shift) override {
+    const El::Int output_size = get_output_size();
+    const El::Int channel_size = output_size / scale.size();
+
+    // Bias before folding
+    std::vector<DataType> bias(output_size, DataType(0));
+    if (!m_folded_bias.empty()) {
+      bias = m_folded_bias;
+    } else if (m_bias_scaling_factor != DataType(0)) {
+      const auto& local_bias = this->m_weights[1]->get_values().LockedMatrix();
+      for (El::Int row = 0; row < output_size; ++row) {
+        bias[row] = m_bias_scaling_factor * local_bias(row, 0);
+      }
+    }
+
+    // Scale linearity entries and bias of each output
+    // Note: Linearity weights are not distributed in data-parallel
+    // layers.
+    auto& local_linearity = this->m_weights[0]->get_values().Matrix();
+    for (El::Int row = 0; row < output_size; ++row) {
+      const auto& a = scale[row / channel_size];
+      bias[row] = a * bias[row] + shift[row / channel_size];
+      if (m_transpose) {
+        for (El::Int i = 0; i < local_linearity.Height(); ++i) {
+          local_linearity(i, row) *= a;
+        }
+      } else {
+        for (El::Int j = 0; j < local_linearity.Width(); ++j) {
+          local_linearity(row, j) *= a;
+        }
+      }
+    }
+    m_folded_bias = std::move(bias);
+
+  }
+
 private:
 
   /** Scaling factor for bias term.
@@ -223,6 +301,29 @@ private:
   /** Whether the transpose of the linearity matrix is applied. */
   bool m_transpose;
 
+  /** Bias with folded affine transforms, one entry per output.
+   *  Replaces the bias weights if not empty.
+   */
+  std::vector<DataType> m_folded_bias;
+
+  /** Linearity quantized for int8 inference. */
+  int8_gemm m_int8_linearity;
+  /** Workspace for the quantized input during int8 inference.
+   *  Reused across mini-batches and not copied.
+   */
+  std::vector<std::int8_t> m_int8_input;
+
+  /** Bias applied in the GEMM epilogue, or null if there is none. */
+  const DataType* get_epilogue_bias(DataType& scale) const {
+    if (!m_folded_bias.empty()) {
+      scale = DataType(1);
+      return m_folded_bias.data();
+    }
+    scale = m_bias_scaling_factor;
+    if (m_bias_scaling_factor == DataType(0)) { return nullptr; }
+    return this->m_weights[1]->get_values().LockedMatrix().LockedBuffer();
+  }
+
   /** Deallocate distributed matrices. */
   void deallocate_matrices() {
     if (m_bias_gradient != nullptr) delete m_bias_gradient;
@@ -31,6 +31,15 @@
 
 namespace lbann {
 
+/** @brief Activation of an entry-wise unary layer that a parent
+ *         layer may apply in its GEMM epilogue.
+ *  @details Specialized for the name types of fusable layers.
+ */
+template <typename Name>
+struct entrywise_unary_epilogue {
+  static gemm_epilogue get() { return gemm_epilogue(); }
+};
+
 /** @brief Templated class for entry-wise unary layers.
  *  @param Layout   Parallelism scheme.
  *  @param Device   Device allocation.
@@ -46,6 +55,9 @@ public:
   std::string get_type() const override { return Name(); }
   data_layout get_data_layout() const override { return Layout; }
   El::Device get_device_allocation() const override { return Device; }
+  gemm_epilogue get_fusable_activation() const override {
+    return entrywise_unary_epilogue<Name>::get();
+  }
 protected:
   void setup_dims() override {
     Layer::setup_dims();
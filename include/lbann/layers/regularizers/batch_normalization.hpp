@@ -175,6 +175,10 @@ public:
 
   batch_normalization_layer* copy() const override { return new batch_normalization_layer(*this); }
   std::string get_type() const override { return "batch normalization"; }
+  bool may_run_concurrently() const override {
+    return (m_statistics_group_size == 1
+            && regularizer_layer::may_run_concurrently());
+  }
   data_layout get_data_layout() const override { return T_layout; }
   El::Device get_device_allocation() const override { return Dev; }
 
@@ -186,6 +190,29 @@ public:
     return desc;
   }
 
+  /** Normalization with the running statistics, as applied outside
+   *  of training.
+   */
+  bool get_foldable_affine(std::vector<DataType>& scale,
+                           std::vector<DataType>& shift) const override {
+    if (Dev != El::Device::CPU) { return false; }
+    const auto& local_scale = this->m_weights[0]->get_values().LockedMatrix();
+    const auto& local_bias = this->m_weights[1]->get_values().LockedMatrix();
+    const auto& local_mean = this->m_weights[2]->get_values().LockedMatrix();
+    const auto& local_var = this->m_weights[3]->get_values().LockedMatrix();
+    const El::Int num_channels = get_output_dims()[0];
+    scale.resize(num_channels);
+    shift.resize(num_channels);
+    for (El::Int channel = 0; channel < num_channels; ++channel) {
+      const DataType inv_stdev
+        = 1 / std::sqrt(local_var(channel, 0) + m_epsilon);
+      scale[channel] = local_scale(channel, 0) * inv_stdev;
+      shift[channel] = (local_bias(channel, 0)
+                        - scale[channel] * local_mean(channel, 0));
+    }
+    return true;
+  }
+
 protected:
 
   void setup_matrices(const El::Grid& grid) override {
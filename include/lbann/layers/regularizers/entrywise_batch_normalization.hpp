@@ -80,6 +80,7 @@ public:
 
   entrywise_batch_normalization_layer* copy() const override { return new entrywise_batch_normalization_layer(*this); }
   std::string get_type() const override { return "entry-wise batch normalization"; }
+  bool may_run_concurrently() const override { return false; }
   data_layout get_data_layout() const override { return Layout; }
   El::Device get_device_allocation() const override { return Device; }
 
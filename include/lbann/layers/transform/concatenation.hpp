@@ -69,6 +69,47 @@ public:
     return desc;
   }
 
+  /** Parent layers write output tensors directly into this layer's
+   *  output tensor.
+   *  Only possible if each input tensor is one contiguous block of
+   *  rows in the output tensor, i.e. if all dimensions before the
+   *  concatenation dimension are 1.
+   */
+  int setup_tensor_placement() override {
+    const auto& num_inputs = get_num_parents();
+    const auto& output_dims = get_output_dims();
+    if (T_layout != data_layout::DATA_PARALLEL
+        || Dev != El::Device::CPU
+        || num_inputs < 2) {
+      return 0;
+    }
+    const auto& blocks_per_slice
+      = std::accumulate(&output_dims[0], &output_dims[m_concat_dim],
+                        1, std::multiplies<int>());
+    if (blocks_per_slice > 1) { return 0; }
+    const auto& unit_block_size
+      = std::accumulate(output_dims.begin() + m_concat_dim + 1,
+                        output_dims.end(),
+                        1, std::multiplies<int>());
+
+    // Place output tensors of parents that are viewed as input tensors
+    const auto& dist_data = get_activations().DistData();
+    int num_placed = 0;
+    for (int i = 0; i < num_inputs; ++i) {
+      auto& parent = const_cast<Layer&>(*m_parent_layers[i]);
+      const auto& input = get_prev_activations(i);
+      if (parent.supports_tensor_placement()
+          && input.Viewing()
+          && input.DistData() == dist_data) {
+        parent.place_activations(*this,
+                                 m_concat_points[i] * unit_block_size);
+        ++num_placed;
+      }
+    }
+    return num_placed;
+
+  }
+
 protected:
 
   void setup_pointers() override {
@@ -149,12 +190,19 @@ protected:
     const auto& output_dims = get_output_dims();
 
     // Initialize output tensor
+    // Note: Parent layers may have already allocated the output
+    // tensor. See setup_tensor_placement.
     auto& output = get_activations();
-    output.Empty(false);
     if (num_inputs > 1) {
-      output.AlignWith(get_prev_activations());
-      output.Resize(get_output_size(), mini_batch_size);
+      if (!is_tensor_placement_target()
+          || output.Height() != get_output_size()
+          || output.Width() != mini_batch_size) {
+        output.Empty(false);
+        output.AlignWith(get_prev_activations());
+        output.Resize(get_output_size(), mini_batch_size);
+      }
     } else {
+      output.Empty(false);
       El::LockedView(output, get_prev_activations());
       return;
     }
@@ -186,6 +234,14 @@ protected:
       const auto& block_size = input_num_unit_slices * unit_block_size;
       const auto& output_block_offset = m_concat_points[i] * unit_block_size;
 
+      // Nothing to copy if parent wrote into output tensor directly
+      if (blocks_per_slice == 1
+          && occupies_rows(input, output, output_block_offset)) {
+        m_bytes_copy_elided += (input.LocalHeight() * input.LocalWidth()
+                                * sizeof(DataType));
+        continue;
+      }
+
       // Populate output tensor one block at a time
       for (int block = 0; block < blocks_per_slice; ++block) {
         const auto& input_offset = block * block_size;
@@ -39,8 +39,17 @@ public:
   EvalType get_scale() const { return m_scale; }
   /** Set scaling factor. */
   void set_scale(EvalType scale) { m_scale = scale; }
-  /** Get evaluated value. */
+  /** Get evaluated value.
+   *  The value is the mean over the mini-batch samples that were
+   *  last reduced by the model's evaluation aggregator.
+   */
   EvalType get_value(bool scaled = true);
+  /** Get sum of the input entries held by this process for the
+   *  current mini-batch.
+   */
+  EvalType get_local_value();
+  /** Set slot in the model's evaluation aggregator. */
+  void set_evaluation_slot(int slot) { m_slot = slot; }
 
   /** Construct an evaluation layer.
    *  The caller is responsible for deallocating the layer.
@@ -60,12 +69,12 @@ private:
 
   /** Scaling factor to apply to evaluated value. */
   EvalType m_scale = 0;
-  /** Evaluated value.
+  /** Local sum of input entries.
    *  The value may be stored in pinned memory.
    */
   CPUMat m_value;
-  /** Non-blocking allreduce request. */
-  Al::request m_allreduce_req;
+  /** Slot in the model's evaluation aggregator. */
+  int m_slot = -1;
 #ifdef LBANN_HAS_GPU
   /** CUDA event after a non-blocking GPU-CPU memory copy. */
   cuda::event_wrapper m_copy_event;
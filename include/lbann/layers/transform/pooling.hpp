@@ -31,6 +31,7 @@
 #include <vector>
 #include "lbann/layers/transform/transform.hpp"
 #include "lbann/utils/cudnn.hpp"
+#include "lbann/utils/direct_pooling.hpp"
 #include "lbann/utils/exception.hpp"
 #include "lbann/utils/im2col.hpp"
 
@@ -59,9 +60,21 @@ private:
   /** Input indices for max pooling.
    *  Each entry corresponds to a local entry in the activations
    *  matrix. The entry gives the index of the maximum entry within
-   *  the pooling window.
+   *  the pooling window. Empty if the maxima are found again during
+   *  back prop, or if the im2col path is used.
    */
-  std::vector<int> m_max_pool_indices;
+  std::vector<unsigned char> m_max_pool_indices;
+  /** Input indices for max pooling with im2col.
+   *  Same as @c m_max_pool_indices, for tensors with more than three
+   *  spatial dimensions, which may have windows of any size.
+   */
+  std::vector<int> m_max_pool_im2col_indices;
+  /** Whether max pooling finds the maxima again during back prop
+   *  instead of storing their indices.
+   *  Windows with more than 256 entries always do, except on the
+   *  im2col path, which always stores the indices.
+   */
+  bool m_recompute_max_indices = false;
 
 #ifdef LBANN_HAS_CUDNN
   /** Pooling descriptor. */
@@ -121,7 +134,9 @@ public:
       m_pool_size(other.m_pool_size),
       m_pads(other.m_pads),
       m_strides(other.m_strides),
-      m_max_pool_indices(other.m_max_pool_indices)
+      m_max_pool_indices(other.m_max_pool_indices),
+      m_max_pool_im2col_indices(other.m_max_pool_im2col_indices),
+      m_recompute_max_indices(other.m_recompute_max_indices)
 #ifdef LBANN_HAS_CUDNN
     , m_pooling_cudnn_desc(nullptr),
       m_tensors_cudnn_desc(other.m_tensors_cudnn_desc)
@@ -141,6 +156,8 @@ public:
     m_pads = other.m_pads;
     m_strides = other.m_strides;
     m_max_pool_indices = other.m_max_pool_indices;
+    m_max_pool_im2col_indices = other.m_max_pool_im2col_indices;
+    m_recompute_max_indices = other.m_recompute_max_indices;
 #ifdef LBANN_HAS_CUDNN
     copy_pooling_cudnn_desc(other.m_pooling_cudnn_desc, m_pooling_cudnn_desc);
     m_tensors_cudnn_desc = other.m_tensors_cudnn_desc;
@@ -162,6 +179,14 @@ public:
   data_layout get_data_layout() const override { return T_layout; }
   El::Device get_device_allocation() const override { return Dev; }
 
+  /** Whether max pooling finds the maxima again during back prop
+   *  instead of storing their indices. Saves a byte per output entry
+   *  at the cost of a second pass over the input.
+   */
+  void set_recompute_max_indices(bool recompute) {
+    m_recompute_max_indices = recompute;
+  }
+
   description get_description() const override {
     auto desc = transform_layer::get_description();
     std::stringstream ss;
@@ -263,6 +288,8 @@ protected:
   void fp_compute() override {
     if(this->using_gpus()) {
       fp_compute_cudnn();
+    } else if(pooling_geometry::is_supported(m_pool_dims.size())) {
+      fp_compute_direct();
     } else {
       fp_compute_im2col();
     }
@@ -271,6 +298,8 @@ protected:
   void bp_compute() override {
     if(this->using_gpus()) {
       bp_compute_cudnn();
+    } else if(pooling_geometry::is_supported(m_pool_dims.size())) {
+      bp_compute_direct();
     } else {
       bp_compute_im2col();
     }
@@ -333,7 +362,95 @@ private:
 #endif // #ifndef LBANN_HAS_CUDNN
   }
 
+  /// Window geometry for the direct CPU kernels
+  pooling_geometry get_pooling_geometry() const {
+    const auto& input_dims = get_input_dims();
+    return pooling_geometry(input_dims[0],
+                            std::vector<int>(input_dims.begin() + 1,
+                                             input_dims.end()),
+                            m_pool_dims, m_pads, m_strides);
+  }
+
+  /// Whether max pooling stores the indices of the maxima
+  bool store_max_indices() const {
+    if (!pooling_geometry::is_supported(m_pool_dims.size())) { return true; }
+    return !m_recompute_max_indices && m_pool_size <= 256;
+  }
+
+  /// Window position of the maximum for a local output entry
+  /** Entries are numbered with the outputs of each sample back to
+   *  back. Requires stored indices.
+   */
+  int get_max_pool_index(size_t index) const {
+    return (m_max_pool_im2col_indices.empty() ?
+            m_max_pool_indices[index] : m_max_pool_im2col_indices[index]);
+  }
+
+  /// Pooling forward propagation reading the input in place
+  void fp_compute_direct() {
+    const auto& local_input = get_local_prev_activations();
+    auto& local_output = get_local_activations();
+    const auto& geom = get_pooling_geometry();
+    const int local_width = local_input.Width();
+    switch (m_pool_mode) {
+    case pool_mode::max:
+      if (store_max_indices()) {
+        m_max_pool_indices.resize(get_output_size() * local_width);
+      } else {
+        m_max_pool_indices.clear();
+      }
+      geom.max_pool_forward(local_width,
+                            local_input.LockedBuffer(), local_input.LDim(),
+                            local_output.Buffer(), local_output.LDim(),
+                            (store_max_indices() ?
+                             m_max_pool_indices.data() : nullptr));
+      break;
+    case pool_mode::average:
+    case pool_mode::average_no_pad:
+      geom.average_pool_forward(local_width,
+                                local_input.LockedBuffer(), local_input.LDim(),
+                                local_output.Buffer(), local_output.LDim(),
+                                m_pool_mode == pool_mode::average);
+      break;
+    default:
+      LBANN_ERROR("invalid pooling mode");
+    }
+  }
+
+  /// Pooling backward propagation reading the gradient in place
+  void bp_compute_direct() {
+    const auto& local_input = get_local_prev_activations();
+    const auto& local_gradient_wrt_output = get_local_prev_error_signals();
+    auto& local_gradient_wrt_input = get_local_error_signals();
+    const auto& geom = get_pooling_geometry();
+    const int local_width = local_gradient_wrt_output.Width();
+    switch (m_pool_mode) {
+    case pool_mode::max:
+      geom.max_pool_backward(local_width,
+                             local_input.LockedBuffer(), local_input.LDim(),
+                             (m_max_pool_indices.empty() ?
+                              nullptr : m_max_pool_indices.data()),
+                             local_gradient_wrt_output.LockedBuffer(),
+                             local_gradient_wrt_output.LDim(),
+                             local_gradient_wrt_input.Buffer(),
+                             local_gradient_wrt_input.LDim());
+      break;
+    case pool_mode::average:
+    case pool_mode::average_no_pad:
+      geom.average_pool_backward(local_width,
+                                 local_gradient_wrt_output.LockedBuffer(),
+                                 local_gradient_wrt_output.LDim(),
+                                 local_gradient_wrt_input.Buffer(),
+                                 local_gradient_wrt_input.LDim(),
+                                 m_pool_mode == pool_mode::average);
+      break;
+    default:
+      LBANN_ERROR("invalid pooling mode");
+    }
+  }
+
   /// Pooling forward propagation with im2col
+  /** Used for tensors with more than three spatial dimensions. */
   void fp_compute_im2col() {
     if(m_pool_mode != pool_mode::max && m_pool_mode != pool_mode::average) {
       LBANN_ERROR("CPU pooling layer only supports max and average pooling");
@@ -351,7 +468,8 @@ private:
 
     // Initialize max pool indices if needed
     if(m_pool_mode == pool_mode::max) {
-      m_max_pool_indices.assign(get_output_size() * local_width, 0);
+      m_max_pool_indices.clear();
+      m_max_pool_im2col_indices.assign(get_output_size() * local_width, 0);
     }
 
     // Initialize matrices
@@ -376,7 +494,7 @@ private:
       if(m_pool_mode == pool_mode::max) {
         // Apply max pooling
         DataType *output_buffer = local_output.Buffer(0, sample);
-        int *indices_buffer = &m_max_pool_indices[sample * get_output_size()];
+        int *indices_buffer = &m_max_pool_im2col_indices[sample * get_output_size()];
         LBANN_OMP_PARALLEL_FOR
         for(int channel = 0; channel < num_channels; ++channel) {
           for(int j = 0; j < num_per_output_channel; ++j) {
@@ -454,7 +572,7 @@ private:
         const DataType *gradient_wrt_output_buffer
           = local_gradient_wrt_output.LockedBuffer(0, sample);
         const int *indices_buffer
-          = &m_max_pool_indices[sample * get_output_size()];
+          = &m_max_pool_im2col_indices[sample * get_output_size()];
         LBANN_OMP_PARALLEL_FOR
         for(int channel = 0; channel < num_channels; ++channel) {
           for(int j = 0; j < num_per_input_channel; ++j) {
@@ -94,6 +94,46 @@ public:
     return desc;
   }
 
+  /** Child layers write gradients w.r.t. input tensors directly into
+   *  this layer's gradient w.r.t. input tensor.
+   *  Only possible if each output tensor is one contiguous block of
+   *  rows in the input tensor, i.e. if all dimensions before the
+   *  slice dimension are 1, and if the slices cover the whole input
+   *  tensor.
+   */
+  int setup_tensor_placement() override {
+    const auto& num_outputs = get_num_children();
+    const auto& input_dims = get_input_dims();
+    if (T_layout != data_layout::DATA_PARALLEL
+        || Dev != El::Device::CPU
+        || num_outputs < 1
+        || m_slice_points[0] != 0
+        || m_slice_points[num_outputs] != input_dims[m_slice_dim]) {
+      return 0;
+    }
+    const auto& blocks_per_slice
+      = std::accumulate(&input_dims[0], &input_dims[m_slice_dim],
+                        1, std::multiplies<int>());
+    if (blocks_per_slice > 1) { return 0; }
+    const auto& unit_block_size
+      = std::accumulate(input_dims.begin() + m_slice_dim + 1,
+                        input_dims.end(),
+                        1, std::multiplies<int>());
+
+    // Place gradients w.r.t. input tensors of children
+    int num_placed = 0;
+    for (int i = 0; i < num_outputs; ++i) {
+      auto& child = const_cast<Layer&>(*m_child_layers[i]);
+      if (child.supports_tensor_placement()) {
+        child.place_error_signals(*this,
+                                  m_slice_points[i] * unit_block_size);
+        ++num_placed;
+      }
+    }
+    return num_placed;
+
+  }
+
 protected:
 
   void setup_matrices(const El::Grid& grid) override {
@@ -217,10 +257,16 @@ protected:
     const auto& input_dims = get_input_dims();
 
     // Initialize gradient w.r.t. input tensor
+    // Note: Child layers may have already allocated the gradient
+    // w.r.t. input tensor. See setup_tensor_placement.
     auto& gradient_wrt_input = get_error_signals();
-    gradient_wrt_input.Empty(false);
-    gradient_wrt_input.AlignWith(get_prev_activations());
-    gradient_wrt_input.Resize(get_input_size(), mini_batch_size);
+    if (!is_tensor_placement_target()
+        || gradient_wrt_input.Height() != get_input_size()
+        || gradient_wrt_input.Width() != mini_batch_size) {
+      gradient_wrt_input.Empty(false);
+      gradient_wrt_input.AlignWith(get_prev_activations());
+      gradient_wrt_input.Resize(get_input_size(), mini_batch_size);
+    }
     if (m_slice_points[0] != 0
         || m_slice_points[num_outputs] != input_dims[m_slice_dim]) {
       El::Zero(gradient_wrt_input);
@@ -251,6 +297,16 @@ protected:
       const auto& block_size = output_num_unit_slices * unit_block_size;
       const auto& input_block_offset = m_slice_points[i] * unit_block_size;
 
+      // Nothing to copy if child wrote into gradient directly
+      if (blocks_per_slice == 1
+          && occupies_rows(gradient_wrt_output, gradient_wrt_input,
+                           input_block_offset)) {
+        m_bytes_copy_elided += (gradient_wrt_output.LocalHeight()
+                                * gradient_wrt_output.LocalWidth()
+                                * sizeof(DataType));
+        continue;
+      }
+
       // Populate gradient w.r.t. input tensor one block at a time
       for (int block = 0; block < blocks_per_slice; ++block) {
         const auto& input_offset = (input_block_offset
@@ -72,6 +72,11 @@ class unpooling_layer : public transform_layer {
     if(m_pooling_layer->using_gpus()) {
       throw lbann_exception("unpooling_layer: GPU version not yet implemented");
     }
+    if(!m_pooling_layer->store_max_indices()) {
+      LBANN_ERROR("unpooling layer \"" + get_name() + "\" needs the indices "
+                  "of the maxima, but pooling layer "
+                  "\"" + m_pooling_layer->get_name() + "\" does not store them");
+    }
   }
 
   void setup_dims() override {
@@ -169,13 +174,13 @@ class unpooling_layer : public transform_layer {
       // Populate im2col matrix
       const DataType *prev_activations_buffer
         = prev_activations_local.LockedBuffer(0, sample);
-      const int *indices_buffer
-        = &m_pooling_layer->m_max_pool_indices[sample * get_input_size()];
+      const size_t indices_offset = sample * get_input_size();
       LBANN_OMP_PARALLEL_FOR
       for(int channel = 0; channel < num_channels; ++channel) {
         for(int j = 0; j < num_per_input_channel; ++j) {
           const int input_index = j + channel * num_per_input_channel;
-          const int max_index = indices_buffer[input_index];
+          const int max_index
+            = m_pooling_layer->get_max_pool_index(indices_offset + input_index);
           DataType *im2col_buffer
             = im2col_mat.Buffer(channel * pool_size, j);
           im2col_buffer[max_index]
@@ -233,13 +238,13 @@ class unpooling_layer : public transform_layer {
 
       // Propagate error signal based on pooling layer
       DataType *output_buffer = error_signal_local.Buffer(0, sample);
-      const int *indices_buffer
-        = &m_pooling_layer->m_max_pool_indices[sample * get_input_size()];
+      const size_t indices_offset = sample * get_input_size();
       LBANN_OMP_PARALLEL_FOR
       for(int channel = 0; channel < num_channels; ++channel) {
         for(int j = 0; j < num_per_output_channel; ++j) {
           const int output_index = j + channel * num_per_output_channel;
-          const int max_index = indices_buffer[output_index];
+          const int max_index
+            = m_pooling_layer->get_max_pool_index(indices_offset + output_index);
           DataType *im2col_buffer
             = im2col_mat.Buffer(channel * pool_size, j);
           output_buffer[output_index] = im2col_buffer[max_index];
@@ -138,6 +138,7 @@
 #include "lbann/callbacks/check_init.hpp"
 #include "lbann/callbacks/check_metric.hpp"
 #include "lbann/callbacks/check_nan.hpp"
+#include "lbann/callbacks/check_numerical_health.hpp"
 #include "lbann/callbacks/check_small.hpp"
 #include "lbann/callbacks/checkpoint.hpp"
 #include "lbann/callbacks/confusion_matrix.hpp"
@@ -152,6 +153,7 @@
 #include "lbann/callbacks/gpu_memory_usage.hpp"
 #include "lbann/callbacks/hang.hpp"
 #include "lbann/callbacks/imcomm.hpp"
+#include "lbann/callbacks/int8_calibration.hpp"
 #include "lbann/callbacks/learning_rate.hpp"
 #include "lbann/callbacks/ltfb.hpp"
 #include "lbann/callbacks/mixup.hpp"
@@ -173,6 +175,7 @@
 
 /// Weights and weight initializers
 #include "lbann/weights/weights.hpp"
+#include "lbann/weights/weights_arena.hpp"
 #include "lbann/weights/initializer.hpp"
 #include "lbann/weights/variance_scaling_initializers.hpp"
 
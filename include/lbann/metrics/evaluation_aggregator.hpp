@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_METRIC_EVALUATION_AGGREGATOR_HPP
+#define LBANN_METRIC_EVALUATION_AGGREGATOR_HPP
+
+#include "lbann/base.hpp"
+#include "lbann/comm.hpp"
+
+#include <vector>
+
+namespace lbann {
+
+// Forward declaration
+class abstract_evaluation_layer;
+
+/** @brief Trainer-wide reduction of evaluation layer values.
+ *
+ *  Each evaluation layer is registered in a slot. After forward prop,
+ *  the local partial sums of all slots are packed into one buffer and
+ *  reduced with a single non-blocking allreduce, which completes
+ *  while the objective function and metrics are waiting for the
+ *  values.
+ *
+ *  In deferred mode, the local partial sums are accumulated over
+ *  several mini-batch steps and reduced every few steps, or only when
+ *  flushed at the end of an epoch or evaluation. The reduced values
+ *  are means over all accumulated samples, so statistics at epoch end
+ *  are the same as without deferral but per-step values are not
+ *  available.
+ */
+class evaluation_aggregator {
+public:
+
+  evaluation_aggregator(lbann_comm* comm = nullptr) : m_comm(comm) {}
+  /** Copy the configuration, but not the slots or values. */
+  evaluation_aggregator(const evaluation_aggregator& other);
+  evaluation_aggregator& operator=(const evaluation_aggregator& other);
+  ~evaluation_aggregator();
+
+  void set_comm(lbann_comm* comm) { m_comm = comm; }
+
+  /** Mini-batch steps between reductions.
+   *  Values larger than one enable deferred mode. Zero reduces at
+   *  every step, like one. If the interval is negative, values are
+   *  only reduced when flushed.
+   */
+  void set_reduction_interval(int interval) { m_reduction_interval = interval; }
+  int get_reduction_interval() const noexcept { return m_reduction_interval; }
+
+  /** Remove all slots and values. */
+  void clear_slots();
+  /** Register an evaluation layer. Returns its slot index. */
+  int add_slot(abstract_evaluation_layer& l);
+  int get_num_slots() const noexcept { return m_layers.size(); }
+
+  /** Accumulate local values after a mini-batch step.
+   *  Starts a reduction if the reduction interval is reached.
+   *  @param mode             Execution mode of the step. Pending
+   *                          values must be flushed before the mode
+   *                          changes.
+   *  @param mini_batch_size  Number of samples in the step.
+   */
+  void finish_step(execution_mode mode, int mini_batch_size);
+  /** Start a reduction of all pending steps, if there are any. */
+  void flush();
+  /** Whether there are steps that have not been reduced. */
+  bool has_pending_steps() const noexcept { return m_num_pending_steps > 0; }
+
+  /** Whether reduced values are available. */
+  bool has_values() const noexcept { return m_has_values; }
+  /** Execution mode of the reduced values. */
+  execution_mode get_mode() const noexcept { return m_mode; }
+  /** Number of samples in the reduced values. */
+  int get_num_samples() const noexcept { return m_num_samples; }
+  /** Mean value of a slot over the reduced samples.
+   *  Waits for the reduction to finish.
+   */
+  EvalType get_value(int slot);
+  /** Discard reduced values once they have been used. */
+  void clear_values();
+
+private:
+
+  lbann_comm* m_comm;
+  int m_reduction_interval = 1;
+
+  /** Registered evaluation layers, by slot. */
+  std::vector<abstract_evaluation_layer*> m_layers;
+
+  /** Execution mode of pending or reduced steps. */
+  execution_mode m_mode = execution_mode::invalid;
+  /** Sum of local values over pending steps, by slot. */
+  std::vector<EvalType> m_pending_values;
+  int m_num_pending_steps = 0;
+  int m_num_pending_samples = 0;
+
+  /** Reduction buffer, by slot. */
+  std::vector<EvalType> m_values;
+  int m_num_samples = 0;
+  bool m_has_values = false;
+  /** Non-blocking allreduce request. */
+  Al::request m_request;
+  bool m_request_active = false;
+
+  /** Wait for the reduction to finish. */
+  void wait();
+
+};
+
+} // namespace lbann
+
+#endif // LBANN_METRIC_EVALUATION_AGGREGATOR_HPP
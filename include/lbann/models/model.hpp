@@ -36,12 +36,16 @@
 #include "lbann/io/persist.hpp"
 #include "lbann/objective_functions/objective_function.hpp"
 #include "lbann/metrics/metric.hpp"
+#include "lbann/metrics/evaluation_aggregator.hpp"
 #include "lbann/weights/weights.hpp"
+#include "lbann/weights/weights_arena.hpp"
 #include "lbann/optimizers/optimizer.hpp"
 #include "lbann/utils/threads/thread_pool.hpp"
+#include "lbann/utils/threads/dag_scheduler.hpp"
 
 #include <vector>
 #include <string>
+#include <mutex>
 #include <unordered_map>
 
 // Forward-declare protobuf class
@@ -105,6 +109,11 @@ public:
     return m_metrics;
   }
 
+  /** @brief Trainer-wide reduction of evaluation layer values. */
+  evaluation_aggregator& get_evaluation_aggregator() {
+    return m_evaluation_aggregator;
+  }
+
   /** @brief Size of model's list of layers. */
   El::Int get_num_layers() const noexcept;
   /** @param pos Position in model's list of layers. */
@@ -224,6 +233,137 @@ public:
   /** @brief Are background I/O activities enabled by the input layers */
   bool background_io_activity_allowed() { return m_background_io_allowed; }
 
+  /** @brief Whether data-parallel weights are stored in a contiguous
+   *         arena.
+   *  @details Must be set before setup. See @c weights_arena.
+   */
+  void set_use_weights_arena(bool enable) { m_use_weights_arena = enable; }
+  /** @brief Whether data-parallel weights are stored in a contiguous
+   *         arena.
+   */
+  bool using_weights_arena() const noexcept { return m_use_weights_arena; }
+
+  /** @brief Whether layers may write tensors directly into the
+   *         tensors of concatenation and slice layers.
+   *  @details Must be set before setup. See
+   *  @c Layer::setup_tensor_placement.
+   */
+  void set_use_tensor_placement(bool enable) { m_use_tensor_placement = enable; }
+  /** @brief Whether layers may write tensors directly into the
+   *         tensors of concatenation and slice layers.
+   */
+  bool using_tensor_placement() const noexcept { return m_use_tensor_placement; }
+  /** @brief Whether layers absorb the entrywise activation that
+   *         follows them.
+   *  @details Must be set before setup. See
+   *  @c Layer::fuse_activation.
+   */
+  void set_fuse_activations(bool enable) { m_fuse_activations = enable; }
+  /** @brief Whether layers absorb the entrywise activation that
+   *         follows them.
+   */
+  bool fusing_activations() const noexcept { return m_fuse_activations; }
+  /** @brief Mini-batch steps between reductions of evaluation
+   *         layer values.
+   *  @details Values larger than one defer the reduction, so the
+   *  objective function and metric statistics are only updated every
+   *  few steps. Zero reduces at every step, like one. If the interval
+   *  is negative, values are only reduced at the end of each epoch or
+   *  evaluation. See @c evaluation_aggregator.
+   */
+  void set_evaluation_reduction_interval(int interval) {
+    m_evaluation_aggregator.set_reduction_interval(interval);
+  }
+  /** @brief Whether optimization steps are applied during back prop
+   *         as soon as each gradient is complete.
+   *  @details Each gradient allreduce is launched once the last layer
+   *  using the weights finishes back prop and is polled after every
+   *  later layer. Weight regularization is added to the gradients
+   *  before back prop instead of after it. Weights in a weights
+   *  arena are still updated with one fused step at the end.
+   */
+  void set_overlap_gradient_updates(bool enable) {
+    m_overlap_gradient_updates = enable;
+  }
+  /** @brief Whether optimization steps are applied during back prop
+   *         as soon as each gradient is complete.
+   */
+  bool overlapping_gradient_updates() const noexcept {
+    return m_overlap_gradient_updates;
+  }
+  /** @brief Run independent layers concurrently.
+   *  @details Must be set before setup. Forward and back prop are run
+   *  as tasks on a @c dag_scheduler with the given number of workers,
+   *  so independent branches of the layer graph overlap. Layers that
+   *  may not run concurrently (see @c Layer::may_run_concurrently)
+   *  and layers sharing weights are still run one at a time in
+   *  topological order, and gradient allreduces are launched in the
+   *  same order on every process. A single worker keeps the serial
+   *  layer loop.
+   *  @param num_workers       Layers run concurrently.
+   *  @param threads_per_task  OpenMP threads per layer. If zero, the
+   *                           OpenMP threads are split evenly between
+   *                           the workers.
+   */
+  void set_layer_task_workers(int num_workers, int threads_per_task = 0) {
+    m_layer_task_workers = num_workers;
+    m_layer_task_threads = threads_per_task;
+  }
+  /** @brief Number of layers run concurrently. */
+  int get_layer_task_workers() const noexcept { return m_layer_task_workers; }
+  /** @brief Task scheduler for forward prop.
+   *  @details Null if layers are run serially.
+   */
+  const dag_scheduler* get_forward_prop_scheduler() const noexcept {
+    return m_fp_scheduler.get();
+  }
+  /** @brief Task scheduler for back prop.
+   *  @details Null if layers are run serially.
+   */
+  const dag_scheduler* get_backward_prop_scheduler() const noexcept {
+    return m_bp_scheduler.get();
+  }
+  /** @brief Gradient communication time hidden behind back prop in
+   *         the most recent training step.
+   *  @details Summed over gradients, from the back prop step that
+   *  launched the allreduce to the one after which it was found
+   *  complete. Only measured when overlapping gradient updates.
+   */
+  EvalType get_hidden_gradient_comm_time() const noexcept {
+    return m_hidden_gradient_comm_time;
+  }
+  /** @brief Time spent waiting for gradient communication after back
+   *         prop in the most recent training step.
+   *  @details Only measured when overlapping gradient updates.
+   */
+  EvalType get_exposed_gradient_comm_time() const noexcept {
+    return m_exposed_gradient_comm_time;
+  }
+
+  /** @brief Memory traffic saved by zero-copy tensor placement.
+   *  @details Local bytes not copied by concatenation and slice
+   *  layers in the most recent training step.
+   */
+  size_t get_bytes_copy_elided() const noexcept {
+    return m_bytes_copy_elided;
+  }
+
+  /** @brief Memory saved by reduced precision activation storage.
+   *  @details Local bytes freed between forward and back prop in the
+   *  most recent training step. See
+   *  @c Layer::set_activation_storage_precision.
+   */
+  size_t get_activation_storage_bytes_saved() const noexcept {
+    return m_activation_storage_bytes_saved;
+  }
+
+  /** @brief Total time spent in weights update steps.
+   *  @details Includes optimization steps and optimize callbacks.
+   */
+  EvalType get_update_weights_time() const noexcept {
+    return m_update_weights_time;
+  }
+
   // ===========================================
   // Setup
   // ===========================================
@@ -232,6 +372,21 @@ public:
    *  execution. */
   virtual void setup(std::shared_ptr<thread_pool> io_thread_pool);
 
+  /** @brief Fold normalization layers into the preceding layers for
+   *         inference.
+   *  @details Must be called after setup, once trained weights are
+   *  loaded. A batch normalization, channel-wise scale/bias, or
+   *  entry-wise scale/bias layer whose only parent is a CPU
+   *  fully-connected or convolution layer with no other children is
+   *  folded into that layer's weights and bias, and then passes its
+   *  input through without computation (see
+   *  @c Layer::fold_affine). Each fold is checked against the
+   *  unfolded layers on a random input, and an exception is thrown
+   *  if they disagree. The model can no longer be trained.
+   *  @returns Number of folded layers.
+   */
+  int fold_batch_normalization();
+
   // ===========================================
   // Execution
   // ===========================================
@@ -345,6 +500,25 @@ protected:
    *  Called in setup function.
    */
   virtual void setup_layers();
+  /** @brief Set up zero-copy tensor placement.
+   *
+   *  Called in setup function after layers are set up. If enabled,
+   *  concatenation layers let their parents write output tensors
+   *  directly into the concatenated tensor and slice layers let their
+   *  children write gradients directly into the sliced gradient. See
+   *  @c Layer::setup_tensor_placement.
+   */
+  virtual void setup_tensor_placement();
+  /** @brief Fuse activation layers into their parents.
+   *
+   *  Called in setup function after layers are set up. If enabled,
+   *  a ReLU, leaky ReLU, or ELU layer whose only parent is a CPU
+   *  fully-connected or convolution layer with no other children is
+   *  applied in the parent's GEMM epilogue, and the activation layer
+   *  passes its input through. Every fusion is reported. See
+   *  @c Layer::fuse_activation.
+   */
+  virtual void setup_layer_fusion();
   /** @brief Set up weights.
    *
    *  Called in setup function. All weights being used by layers or
@@ -352,6 +526,19 @@ protected:
    *  weights are deleted.
    */
   virtual void setup_weights();
+  /** @brief Set up the layer task schedulers.
+   *
+   *  Called in setup function after weights are set up. Does nothing
+   *  unless more than one layer task worker is requested.
+   */
+  virtual void setup_layer_scheduler();
+  /** @brief Register evaluation layers with the evaluation
+   *         aggregator.
+   *
+   *  Called in setup function after layers are set up. Slots follow
+   *  the layer execution order.
+   */
+  virtual void setup_evaluation_aggregator();
 
   /** @brief Reset model pointer and execution mode. */
   virtual void reset_mode_and_model(execution_mode mode);
@@ -359,6 +546,22 @@ protected:
   virtual void reset_epoch_statistics(execution_mode mode);
   /** @brief Evaluate model on a mini-batch */
   virtual bool evaluate_mini_batch(execution_mode mode);
+  /** @brief Start evaluating the objective function.
+   *
+   *  Does nothing if the evaluation aggregator has no reduced
+   *  values, i.e. if the reduction is deferred. Terms that are not
+   *  evaluation layers, e.g. weight regularization, are then only
+   *  evaluated at reduction steps and count for all reduced samples.
+   */
+  virtual void start_evaluation();
+  /** @brief Update objective function and metric statistics.
+   *
+   *  Does nothing if the evaluation aggregator has no reduced
+   *  values.
+   */
+  virtual void finish_evaluation();
+  /** @brief Reduce deferred evaluation values and update statistics. */
+  virtual void flush_evaluation();
   /** @brief Train model on a mini-batch. */
   virtual bool train_mini_batch();
 
@@ -372,6 +575,27 @@ protected:
    *  set an optimizer flag during forward prop.
    */
   virtual void clear_gradients();
+  /** @brief Restore reduced precision activations needed for a
+   *         layer's back prop step.
+   *
+   *  The layer's outputs and its parents' outputs are unpacked and
+   *  the layer's input tensors are set up again.
+   */
+  virtual void unpack_activations_for_back_prop(Layer& l);
+  /** @brief Apply optimization steps for weights whose gradients are
+   *         complete.
+   *  @details Called after each layer's back prop step when
+   *  overlapping gradient updates. Tests in-progress gradient
+   *  allreduces without blocking.
+   */
+  virtual void step_ready_weights();
+  /** @brief Launch the gradient allreduce of a weights.
+   *  @details Called by the back prop scheduler once the last layer
+   *  using the weights has finished back prop. Does nothing if other
+   *  gradient sources remain.
+   *  @param i Index of the weights in the model.
+   */
+  void launch_gradient_allreduce(El::Int i);
   /** @brief Update weights step. */
   virtual void update_weights();
   /** @brief Update layers step. */
@@ -487,6 +711,8 @@ private:
 
   /** @brief Mathematical function to be minimized during training. */
   objective_function* m_objective_function;
+  /** @brief Reduction of evaluation layer values. */
+  evaluation_aggregator m_evaluation_aggregator;
 
   /** @brief Numerical quantities to evaluate model performance.
    *  @details Does not affect training.
@@ -502,6 +728,101 @@ private:
   /** @brief Flag that allows input layers to fetch data in the background */
   bool m_background_io_allowed = true;
 
+  /** @brief Whether data-parallel weights are stored in a contiguous
+   *         arena.
+   */
+  bool m_use_weights_arena = false;
+
+  /** @brief Contiguous storage for data-parallel weights.
+   *  @details Only constructed during setup if
+   *  @c m_use_weights_arena is set. Not copied with the model.
+   */
+  std::unique_ptr<weights_arena> m_weights_arena;
+
+  /** @brief Total time spent in weights update steps. */
+  EvalType m_update_weights_time = 0;
+
+  /** @brief Whether optimization steps are applied during back prop
+   *         as soon as each gradient is complete.
+   */
+  bool m_overlap_gradient_updates = false;
+  /** @brief Whether each weights has been optimized in the current
+   *         training step.
+   */
+  std::vector<bool> m_weights_stepped;
+  /** @brief Time at which each gradient was seen to have no
+   *         remaining sources in the current training step.
+   *  @details Negative if the gradient is still being computed.
+   */
+  std::vector<EvalType> m_gradient_launch_times;
+  /** @brief Gradient communication hidden behind back prop in the
+   *         most recent training step.
+   */
+  EvalType m_hidden_gradient_comm_time = 0;
+  /** @brief Time spent waiting for gradient communication after back
+   *         prop in the most recent training step.
+   */
+  EvalType m_exposed_gradient_comm_time = 0;
+  /** @brief Hidden and exposed gradient communication time summed
+   *         over the training steps of the current epoch.
+   */
+  EvalType m_epoch_hidden_gradient_comm_time = 0;
+  EvalType m_epoch_exposed_gradient_comm_time = 0;
+
+  /** @brief Number of layers run concurrently. */
+  int m_layer_task_workers = 1;
+  /** @brief OpenMP threads per layer task.
+   *  @details Zero splits the OpenMP threads between the workers.
+   */
+  int m_layer_task_threads = 0;
+  /** @brief Task schedulers for forward and back prop.
+   *  @details Only constructed during setup if layers are run
+   *  concurrently. Not copied with the model. Back prop nodes past
+   *  the last layer launch the gradient allreduce of the weights
+   *  with index node - number of layers.
+   */
+  std::unique_ptr<dag_scheduler> m_fp_scheduler;
+  std::unique_ptr<dag_scheduler> m_bp_scheduler;
+  /** @brief Protects model state shared by layer tasks.
+   *  @details Held for callbacks, activation packing and
+   *  optimization steps during concurrent forward and back prop.
+   */
+  std::mutex m_layer_task_mutex;
+  /** @brief Layer task time summed over the training steps of the
+   *         current epoch.
+   *  @details Wall-clock time, summed task time and critical path
+   *  time of forward and back prop.
+   */
+  EvalType m_epoch_layer_task_run_time = 0;
+  EvalType m_epoch_layer_task_work_time = 0;
+  EvalType m_epoch_layer_task_critical_path_time = 0;
+
+  /** @brief Whether any layers store activations in reduced
+   *         precision between forward and back prop.
+   */
+  bool m_pack_activations = false;
+  /** @brief Memory saved by reduced precision activation storage in
+   *         the most recent training step.
+   */
+  size_t m_activation_storage_bytes_saved = 0;
+
+  /** @brief Whether layers may write tensors directly into the
+   *         tensors of concatenation and slice layers.
+   */
+  bool m_use_tensor_placement = false;
+  /** @brief Whether layers absorb the entrywise activation that
+   *         follows them.
+   */
+  bool m_fuse_activations = false;
+  /** @brief Whether layer parameters were changed for inference.
+   *  @details See @c fold_batch_normalization.
+   */
+  bool m_folded_for_inference = false;
+  /** @brief Local bytes not copied by concatenation and slice layers
+   *         in the most recent training step.
+   */
+  size_t m_bytes_copy_elided = 0;
+
   // ===========================================
   // Functions to add utility layers
   // ===========================================
@@ -30,6 +30,7 @@
 #include <string>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 #include "lbann/utils/compiler_control.hpp"
 #include "lbann/base.hpp"
 #include "lbann/comm.hpp"
@@ -75,6 +76,7 @@ class persist;
  *  w.r.t. the weights.
  */
 class optimizer {
+  friend class weights_arena;
 public:
 
   optimizer(lbann_comm* comm, DataType learning_rate = 0);
@@ -123,6 +125,13 @@ public:
                        bool allreduce_needed = false);
   /** @brief Zero out the objective function gradient w.r.t. the weights. */
   void clear_gradient();
+  /** @brief Whether the gradient can be accessed without blocking.
+   *
+   *  False while gradient sources remain. Otherwise the gradient
+   *  allreduce is launched if needed and tested if in progress, so
+   *  polling this also lets the allreduce progress.
+   */
+  bool is_gradient_ready();
   /** @brief Get the gradient buffer.
    *
    *  This provides access to the underlying gradient buffer, which may be
@@ -165,6 +174,14 @@ public:
    *  will be launched on the gradient, if needed.
    */
   void remove_gradient_source(const void* source);
+  /** @brief Leave the gradient allreduce to the caller.
+   *
+   *  If set, removing the last gradient source does not launch the
+   *  allreduce. It is launched by the next call to
+   *  is_gradient_ready() or get_gradient(), which lets the caller fix
+   *  the order in which allreduces are launched.
+   */
+  void set_defer_gradient_allreduce(bool defer) { m_defer_gradient_allreduce = defer; }
 
   /** @brief Must be called before training.
    *
@@ -191,6 +208,60 @@ public:
   /** @brief Reset stats counters. */
   virtual void reset_counters() { m_step_time = 0; }
 
+  /** @name Fused optimization steps */
+  ///@{
+
+  /** @brief Matrices that hold optimizer state.
+   *
+   *  These have the same distribution as the gradient and are
+   *  updated in each optimization step (e.g. momentum velocity or
+   *  Adam moments). A @c weights_arena may attach them to a shared
+   *  contiguous buffer.
+   */
+  virtual std::vector<AbsDistMat*> get_state_matrices() { return {}; }
+
+  /** @brief Whether fused optimization steps are supported. */
+  virtual bool supports_fused_step() const { return false; }
+
+  /** @brief Whether an optimization step can be fused with @c other.
+   *
+   *  Fusable optimizers have the same type and hyperparameters, so a
+   *  single sweep over their concatenated data is equivalent to
+   *  separate steps. Should be checked after @c fused_step_begin.
+   */
+  virtual bool is_step_fusable(const optimizer& other) const {
+    return false;
+  }
+
+  /** @brief Prepare for a fused optimization step.
+   *
+   *  Called once per step on every optimizer taking part in a fused
+   *  step, before any @c fused_step_compute. Updates scalar state
+   *  (e.g. Adam bias correction).
+   */
+  virtual void fused_step_begin() {}
+
+  /** @brief Optimization step on contiguous local data.
+   *
+   *  May be applied to data belonging to several optimizers, as long
+   *  as they are fusable with this one.
+   *
+   *  @param size       Number of entries.
+   *  @param values     Weights values.
+   *  @param gradient   Objective function gradient.
+   *  @param state      One buffer for each state matrix (see
+   *                    @c get_state_matrices).
+   */
+  virtual void fused_step_compute(size_t size,
+                                  DataType* values,
+                                  const DataType* gradient,
+                                  const std::vector<DataType*>& state);
+
+  /** @brief Add to time spent in optimization step. */
+  void add_step_time(EvalType time) { m_step_time += time; }
+
+  ///@}
+
 protected:
 
   /** @brief Computation for an optimization step.
@@ -235,6 +306,9 @@ private:
   /** @brief Status of values in objective function gradient. */
   optimizer_gradient_status m_gradient_status = optimizer_gradient_status::cleared;
 
+  /** @brief Whether the gradient allreduce is launched by the caller. */
+  bool m_defer_gradient_allreduce = false;
+
   /** @brief Communication request object for gradient allreduce.
    *
    *  Used to synchronize non-blocking allreduce.
@@ -94,6 +94,19 @@ public:
 
   ///@}
 
+  /** @name Fused optimization steps */
+  ///@{
+
+  std::vector<AbsDistMat*> get_state_matrices() override;
+  bool supports_fused_step() const override { return true; }
+  bool is_step_fusable(const optimizer& other) const override;
+  void fused_step_compute(size_t size,
+                          DataType* values,
+                          const DataType* gradient,
+                          const std::vector<DataType*>& state) override;
+
+  ///@}
+
 protected:
 
   /** Computation for an optimization step. */
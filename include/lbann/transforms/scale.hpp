@@ -46,6 +46,12 @@ public:
 
   std::string get_type() const override { return "scale"; }
 
+  bool get_affine_coefficients(DataType& scale, DataType& bias) const override {
+    scale = m_scale;
+    bias = DataType(0);
+    return true;
+  }
+
   void apply(utils::type_erased_matrix& data, std::vector<size_t>& dims) override;
 private:
   /** Amount to scale data by. */
@@ -69,6 +69,15 @@ public:
     return false;
   }
 
+  /**
+   * Get the coefficients if the transform is a fixed entry-wise affine
+   * map, x -> scale*x + bias, that does not change the data dimensions.
+   * Returns false otherwise.
+   */
+  virtual bool get_affine_coefficients(DataType& scale, DataType& bias) const {
+    return false;
+  }
+
   /**
    * Apply the transform to data.
    * @param data The input data to transform, which is modified in-place. The
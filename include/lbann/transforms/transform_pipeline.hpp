@@ -71,6 +71,12 @@ public:
   void apply(utils::type_erased_matrix& data, std::vector<size_t>& dims);
   /** Apply to CPUMat data, which will be modified in-place. */
   void apply(CPUMat& data, std::vector<size_t>& dims);
+  /**
+   * Get the coefficients if the whole pipeline is an entry-wise affine
+   * map, x -> scale*x + bias (an empty pipeline is the identity).
+   * Returns false otherwise.
+   */
+  bool get_affine_coefficients(DataType& scale, DataType& bias) const;
   /**
    * Apply the transforms to data.
    * @param data The data to transform. Will be modified in-place.
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_UTILS_DIRECT_POOLING_HPP
+#define LBANN_UTILS_DIRECT_POOLING_HPP
+
+#include "lbann/base.hpp"
+
+#include <vector>
+
+namespace lbann {
+
+/// Pooling window sliding over the spatial dimensions of a tensor
+/** Tensors are stored channel by channel in row-major order, one
+ *  sample per column. 1D and 2D tensors are handled as 3D tensors
+ *  with leading unit dimensions.
+ *
+ *  The direct pooling kernels read the input in place instead of
+ *  building an im2col matrix. They follow the im2col implementation:
+ *  padding entries count as zeros, and the max pooling index
+ *  is the row-major position within the window of the first maximum.
+ *  Work is parallel over samples and channels, and the inner loops
+ *  run along the last spatial dimension.
+ */
+class pooling_geometry {
+public:
+  /** @param num_channels   Number of channels.
+   *  @param input_dims     Spatial dimensions of the input tensor.
+   *  @param window_dims    Dimensions of the pooling window.
+   *  @param pads           Zero pads for the input tensor.
+   *  @param strides        Window shift strides.
+   */
+  pooling_geometry(int num_channels,
+                   const std::vector<int>& input_dims,
+                   const std::vector<int>& window_dims,
+                   const std::vector<int>& pads,
+                   const std::vector<int>& strides);
+
+  /// Whether the direct kernels handle this number of spatial dimensions
+  static bool is_supported(int num_dims) { return num_dims >= 1 && num_dims <= 3; }
+
+  int get_num_channels() const { return m_num_channels; }
+  /// Number of entries in the pooling window
+  int get_window_size() const { return m_window_dims[0] * m_window_dims[1] * m_window_dims[2]; }
+  /// Number of input entries per channel
+  int get_input_channel_size() const { return m_input_dims[0] * m_input_dims[1] * m_input_dims[2]; }
+  /// Number of output entries per channel
+  int get_output_channel_size() const { return m_output_dims[0] * m_output_dims[1] * m_output_dims[2]; }
+
+  /// Max pooling forward propagation
+  /** If indices is not null, the position within the window of each
+   *  output's maximum is stored there, one entry per output entry with
+   *  the outputs of each sample back to back. This requires a window
+   *  of at most 256 entries.
+   */
+  void max_pool_forward(int num_samples,
+                        const DataType* input, int input_ldim,
+                        DataType* output, int output_ldim,
+                        unsigned char* indices) const;
+  /// Max pooling backward propagation
+  /** Uses the indices stored by max_pool_forward if indices is not
+   *  null. Otherwise the maxima are found again from the input.
+   */
+  void max_pool_backward(int num_samples,
+                         const DataType* input, int input_ldim,
+                         const unsigned char* indices,
+                         const DataType* gradient_wrt_output, int gradient_wrt_output_ldim,
+                         DataType* gradient_wrt_input, int gradient_wrt_input_ldim) const;
+  /// Average pooling forward propagation
+  /** If include_pads is false, each output is averaged over the window
+   *  entries inside the input tensor.
+   */
+  void average_pool_forward(int num_samples,
+                            const DataType* input, int input_ldim,
+                            DataType* output, int output_ldim,
+                            bool include_pads) const;
+  /// Average pooling backward propagation
+  void average_pool_backward(int num_samples,
+                             const DataType* gradient_wrt_output, int gradient_wrt_output_ldim,
+                             DataType* gradient_wrt_input, int gradient_wrt_input_ldim,
+                             bool include_pads) const;
+
+private:
+  int m_num_channels;
+  int m_input_dims[3];
+  int m_output_dims[3];
+  int m_window_dims[3];
+  int m_pads[3];
+  int m_strides[3];
+
+  /// Range of outputs along a dimension whose window position k is
+  /// inside the input
+  void get_valid_range(int dim, int k, int& begin, int& end) const;
+  /// Scale factors of average pooling along a dimension
+  std::vector<DataType> get_average_scales(int dim, bool include_pads) const;
+  /// Find the maximum and its window position for a channel
+  template <typename IndexType>
+  void find_max(const DataType* input, DataType* output, IndexType* indices) const;
+};
+
+} // namespace lbann
+
+#endif // LBANN_UTILS_DIRECT_POOLING_HPP
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_UTILS_GEMM_EPILOGUE_HPP
+#define LBANN_UTILS_GEMM_EPILOGUE_HPP
+
+#include "lbann/base.hpp"
+
+#include <string>
+
+namespace lbann {
+
+/// Entrywise activations that can be applied in a GEMM epilogue
+enum class epilogue_activation { none, relu, leaky_relu, elu };
+
+/// Bias and activation applied to a GEMM output while it is in cache
+/** The output holds one sample per column. Rows are grouped into
+ *  channels of rows_per_bias rows that share a bias entry: one row per
+ *  channel for fully-connected layers and the spatial size of a
+ *  channel for convolution.
+ *
+ *  Back prop finds the activation derivative from the activation
+ *  output, so the pre-activation values are never stored. This works
+ *  for ReLU, leaky ReLU with a non-negative slope and ELU with a
+ *  positive scale, since their output is positive exactly where
+ *  their input is.
+ */
+class gemm_epilogue {
+public:
+  /// Epilogue without activation
+  gemm_epilogue() = default;
+  /** @param activation   Activation applied after the bias.
+   *  @param alpha        Negative slope of leaky ReLU or scale of ELU.
+   */
+  gemm_epilogue(epilogue_activation activation, DataType alpha = DataType(0));
+
+  /// Whether the derivative of an activation can be found from its output
+  static bool is_supported(epilogue_activation activation, DataType alpha);
+
+  epilogue_activation get_activation() const { return m_activation; }
+  DataType get_alpha() const { return m_alpha; }
+  bool has_activation() const { return m_activation != epilogue_activation::none; }
+  /// Human-readable description of the activation
+  std::string get_activation_name() const;
+
+  /// Number of columns in a GEMM panel whose output stays in cache
+  static El::Int get_panel_width(El::Int height);
+
+  /// Apply bias and activation to a block of columns
+  /** Computes y = act(y + bias_scale * bias[row / rows_per_bias]). If
+   *  bias is null, only the activation is applied.
+   */
+  void apply_forward(El::Int height, El::Int width,
+                     DataType* output, El::Int output_ldim,
+                     const DataType* bias, DataType bias_scale,
+                     El::Int rows_per_bias) const;
+  /// Convert gradients w.r.t. activation outputs into gradients w.r.t. activation inputs
+  /** The output is the result of apply_forward. The gradients may
+   *  share storage.
+   */
+  void apply_backward(El::Int height, El::Int width,
+                      const DataType* output, El::Int output_ldim,
+                      const DataType* gradient_wrt_output, El::Int gradient_wrt_output_ldim,
+                      DataType* gradient_wrt_input, El::Int gradient_wrt_input_ldim) const;
+
+private:
+  epilogue_activation m_activation = epilogue_activation::none;
+  DataType m_alpha = DataType(0);
+};
+
+} // namespace lbann
+
+#endif // LBANN_UTILS_GEMM_EPILOGUE_HPP
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_UTILS_INT8_GEMM_HPP
+#define LBANN_UTILS_INT8_GEMM_HPP
+
+#include "lbann/base.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace lbann {
+
+/// Weights matrix quantized to int8 for CPU inference
+/** Computes y = W x with int8 weights and inputs and int32
+ *  accumulation. Quantization is symmetric, with values in
+ *  [-127,127] and no zero points.
+ *
+ *  The inputs are split into channels of consecutive rows, each with
+ *  its own activation scale s_c. The activation scales are folded into
+ *  the weights before they are quantized, W'(i,l) = W(i,l) s_c, and
+ *  each weights row gets its own scale t_i. Then
+ *    y(i,j) = t_i sum_l qW'(i,l) qx(l,j),
+ *  with qx(l,j) = round(x(l,j) / s_c) clamped to [-127,127].
+ *
+ *  Weights rows and input columns are stored contiguously, so each
+ *  output entry is a dot product of contiguous int8 vectors.
+ */
+class int8_gemm {
+public:
+  /// Empty weights
+  int8_gemm() = default;
+
+  /// Quantize weights
+  /** @param height         Number of weights rows.
+   *  @param width          Number of weights columns.
+   *  @param weights        Weights matrix, with entry (i,l) at
+   *                        weights[i + l*ldim], or at
+   *                        weights[l + i*ldim] if transposed.
+   *  @param input_scales   Activation scale of each input channel.
+   *                        width must be a multiple of the number of
+   *                        channels.
+   */
+  void setup(El::Int height, El::Int width,
+             const DataType* weights, El::Int weights_ldim,
+             bool transpose_weights,
+             const std::vector<DataType>& input_scales);
+  /// Release the quantized weights
+  void clear();
+
+  bool is_empty() const { return m_weights.empty(); }
+  El::Int get_height() const { return m_height; }
+  El::Int get_width() const { return m_width; }
+  /// Largest absolute value in each row of the scaled weights
+  const std::vector<DataType>& get_weights_ranges() const { return m_weights_ranges; }
+
+  /// Activation scale for a largest absolute value
+  static DataType get_scale(DataType range);
+
+  /// Quantize a (width x n) input
+  /** Input entry (l,j) is input[l + j*ldim], or input[j + l*ldim] if
+   *  transposed. The quantized input has contiguous columns.
+   */
+  void quantize_input(El::Int n,
+                      const DataType* input, El::Int input_ldim,
+                      bool transpose_input,
+                      std::int8_t* quantized_input) const;
+  /// Multiply the weights with a quantized (width x n) input
+  /** Output entry (i,j) is written to output[i + j*ldim], or to
+   *  output[j + i*ldim] if transposed.
+   */
+  void apply(El::Int n, const std::int8_t* quantized_input,
+             DataType* output, El::Int output_ldim,
+             bool transpose_output) const;
+
+private:
+  El::Int m_height = 0;
+  El::Int m_width = 0;
+  /// Quantized weights, stored row by row
+  std::vector<std::int8_t> m_weights;
+  /// Dequantization scale of each weights row
+  std::vector<DataType> m_output_scales;
+  /// Reciprocal activation scale of each input row
+  std::vector<DataType> m_input_inv_scales;
+  std::vector<DataType> m_weights_ranges;
+};
+
+} // namespace lbann
+
+#endif // LBANN_UTILS_INT8_GEMM_HPP
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_UTILS_METADATA_CACHE_HPP
+#define LBANN_UTILS_METADATA_CACHE_HPP
+
+#include <string>
+#include <vector>
+
+namespace lbann {
+
+/// Persistent cache of the metadata a data reader parses at load time
+/** The cache file holds an opaque payload (e.g. a cereal archive of
+ *  a sample index) together with the identity of the input files it
+ *  was parsed from: their paths, sizes and modification times. A
+ *  cached payload is only returned if every recorded input file is
+ *  unchanged, so editing or replacing the data invalidates it.
+ *
+ *  The file name is derived from the cache name, the parameters and
+ *  the input file paths, so jobs that parse the same data the same
+ *  way share one cache file. Files that are only known after parsing
+ *  (e.g. the files named in a file list) can be added as dependent
+ *  files before writing; they are validated but do not change the
+ *  file name.
+ *
+ *  Files are written to a temporary name and renamed, so concurrent
+ *  jobs never see a partial cache. Failures to read or write a cache
+ *  are not errors: the reader falls back to parsing its inputs.
+ */
+class metadata_cache {
+public:
+  /** @param name       Identifies the reader and its payload layout.
+   *  @param cache_dir  Directory for the cache file. If empty, the
+   *                    cache is placed next to the first input file.
+   */
+  metadata_cache(const std::string& name, const std::string& cache_dir);
+
+  /// Add an input file, which must be unchanged for a cache hit
+  void add_input_file(const std::string& path);
+  /// Add a file found while parsing, which must also be unchanged
+  void add_dependent_file(const std::string& path);
+  /// Add a parameter that changes the parsed metadata
+  void add_parameter(const std::string& name, const std::string& value);
+
+  /// Path of the cache file
+  std::string get_filename() const;
+
+  /// Read the payload if the cache is valid
+  /** Returns false if there is no cache file, if it is corrupt, or
+   *  if any input file changed since it was written.
+   */
+  bool read(std::string& payload) const;
+  /// Write the payload along with the identity of the input files
+  /** Returns false if an input file or the cache file could not be
+   *  accessed.
+   */
+  bool write(const std::string& payload) const;
+
+private:
+  /** Name of the reader and payload layout. */
+  std::string m_name;
+  /** Directory for the cache file. */
+  std::string m_cache_dir;
+  /** Parameters, as a list of name=value pairs. */
+  std::string m_parameters;
+  /** Input files, which name the cache file. */
+  std::vector<std::string> m_input_files;
+  /** Dependent files, which are only validated. */
+  std::vector<std::string> m_dependent_files;
+};
+
+} // namespace lbann
+
+#endif // LBANN_UTILS_METADATA_CACHE_HPP
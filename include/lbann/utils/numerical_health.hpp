@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_UTILS_NUMERICAL_HEALTH_HPP
+#define LBANN_UTILS_NUMERICAL_HEALTH_HPP
+
+#include "lbann/base.hpp"
+
+namespace lbann {
+
+/// Summary of the entries in a matrix
+struct numerical_health {
+  /// Number of NaN entries
+  El::Int num_nans = 0;
+  /// Number of infinite entries
+  El::Int num_infs = 0;
+  /// Largest absolute value of the finite entries
+  DataType max_abs = 0;
+  /// Position of the first non-finite entry in column-major order
+  El::Int row = -1;
+  El::Int col = -1;
+
+  bool is_finite() const { return num_nans == 0 && num_infs == 0; }
+};
+
+/// Check the entries of a column-major matrix
+/** NaNs, infinities, and the largest finite absolute value are found
+ *  in one branch-free SIMD pass. Entries
+ *  are only visited again to count and locate non-finite values, so
+ *  healthy matrices are read once. No memory is allocated.
+ *
+ *  Non-finite values are detected with comparisons, which
+ *  -ffast-math is allowed to optimize away.
+ */
+numerical_health get_numerical_health(El::Int height, El::Int width,
+                                      const DataType* buffer, El::Int ldim);
+
+} // namespace lbann
+
+#endif // LBANN_UTILS_NUMERICAL_HEALTH_HPP
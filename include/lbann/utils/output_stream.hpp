@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_UTILS_OUTPUT_STREAM_HPP
+#define LBANN_UTILS_OUTPUT_STREAM_HPP
+
+#include "lbann/base.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lbann {
+
+/// Tensor recorded in an output stream
+struct output_stream_tensor {
+  std::string layer_name;
+  int output_index = 0;
+  std::vector<int> dims;
+  /// Number of entries per sample
+  El::Int get_size() const;
+};
+
+/// Values of a tensor for a set of samples
+struct output_stream_chunk {
+  /// Position of the tensor in the stream header
+  int tensor = 0;
+  execution_mode mode = execution_mode::invalid;
+  El::Int epoch = 0;
+  El::Int step = 0;
+  /// Sample index of each sample
+  std::vector<El::Int> indices;
+  /// Tensor values, with each sample stored contiguously
+  std::vector<DataType> values;
+};
+
+/// Append tensor values to chunked binary files
+/** Chunks are written by a background thread in the order they are
+ *  submitted. Files are named "<prefix>-part<#>.bin" and a new file
+ *  is started once a file reaches a maximum size. Each file is self
+ *  describing. All integers and values are in native byte order:
+ *
+ *    Header: char magic[8] = "LBANNOUT", uint32 version,
+ *            uint32 bytes per value, uint32 number of tensors, and
+ *            for each tensor: uint32 name length, char name[],
+ *            uint32 output index, uint32 number of dims,
+ *            int32 dims[].
+ *    Chunks until the end of the file: uint32 tensor,
+ *            uint32 execution mode, int64 epoch, int64 step,
+ *            int64 number of samples n, int64 indices[n],
+ *            value values[n * tensor size].
+ *
+ *  Submitting blocks while too much data is queued, so output
+ *  cannot grow without bound when the file system is slower than the
+ *  model. Chunk buffers are recycled.
+ */
+class output_stream_writer {
+public:
+
+  /** @param file_prefix      Path prefix of output files.
+   *  @param tensors          Tensors recorded in the stream.
+   *  @param max_file_size    Bytes per file before a new file is
+   *                          started.
+   *  @param max_queued_bytes Bytes waiting to be written before
+   *                          submitting blocks.
+   */
+  output_stream_writer(std::string file_prefix,
+                       std::vector<output_stream_tensor> tensors,
+                       size_t max_file_size,
+                       size_t max_queued_bytes);
+  output_stream_writer(const output_stream_writer&) = delete;
+  output_stream_writer& operator=(const output_stream_writer&) = delete;
+  /// Write all queued chunks and close the file
+  ~output_stream_writer();
+
+  const std::vector<output_stream_tensor>& get_tensors() const { return m_tensors; }
+
+  /// Empty chunk, reusing the buffers of a written chunk if possible
+  std::unique_ptr<output_stream_chunk> get_chunk();
+  /// Queue a chunk to be written
+  void write(std::unique_ptr<output_stream_chunk> chunk);
+  /// Wait until all queued chunks are written to the file system
+  void flush();
+
+  /// Number of files started so far
+  int get_num_files() const;
+
+private:
+
+  std::string m_file_prefix;
+  std::vector<output_stream_tensor> m_tensors;
+  size_t m_max_file_size;
+  size_t m_max_queued_bytes;
+
+  /// Protects the queue, recycled chunks, and writer status
+  mutable std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<std::unique_ptr<output_stream_chunk>> m_queue;
+  std::vector<std::unique_ptr<output_stream_chunk>> m_free_chunks;
+  size_t m_queued_bytes = 0;
+  /// Whether the writer thread is writing a chunk
+  bool m_busy = false;
+  bool m_stop = false;
+  /// Error raised on the writer thread
+  std::string m_error;
+  int m_num_files = 0;
+
+  /// Only accessed by the writer thread
+  std::ofstream m_file;
+  size_t m_file_size = 0;
+  El::Int m_file_num_chunks = 0;
+
+  std::thread m_thread;
+
+  void run();
+  void write_chunk(const output_stream_chunk& chunk);
+  void open_file();
+  /// Throw if the writer thread has failed (m_mutex must be held)
+  void check_error() const;
+
+};
+
+/// Read a file written by @c output_stream_writer
+class output_stream_reader {
+public:
+  output_stream_reader(const std::string& file_name);
+
+  const std::vector<output_stream_tensor>& get_tensors() const { return m_tensors; }
+  /// Read the next chunk
+  /** Returns false at the end of the file. */
+  bool read(output_stream_chunk& chunk);
+
+private:
+  std::string m_file_name;
+  std::ifstream m_file;
+  std::vector<output_stream_tensor> m_tensors;
+};
+
+} // namespace lbann
+
+#endif // LBANN_UTILS_OUTPUT_STREAM_HPP
@@ -12,6 +12,9 @@ class LbannPB;
 
 namespace lbann {
 
+// Forward declaration
+class lbann_comm;
+
 /** @file protobuf_utils.hpp
  *  @brief static methods for parsing command line for prototext
  *         filenames, reading in prototext files, etc.
@@ -39,6 +42,20 @@ load_prototext(
   const int argc,
   char* const argv[]);
 
+/** @brief Load prototext on one rank and broadcast it.
+ *
+ *  The world master parses and verifies the prototext files named on
+ *  the command line, then broadcasts the binary-serialized messages
+ *  to all other ranks. This avoids every rank reading and parsing
+ *  the same text files. Throws on all ranks if the world master
+ *  fails.
+ */
+std::vector<std::unique_ptr<lbann_data::LbannPB>>
+load_prototext(
+  lbann_comm& comm,
+  const int argc,
+  char* const argv[]);
+
 /** @brief Parses the command line for special prototext flags
  *
  *  This looks for `--model=<string>`, `--reader=<string>`, and
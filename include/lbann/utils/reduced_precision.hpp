@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_UTILS_REDUCED_PRECISION_HPP_INCLUDED
+#define LBANN_UTILS_REDUCED_PRECISION_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace lbann {
+
+/** @brief Floating-point format used to store tensors in memory.
+ *
+ *  Computation is always performed in @c DataType. Tensors with a
+ *  reduced storage precision are rounded when they are packed and
+ *  expanded back to @c DataType when they are unpacked.
+ */
+enum class storage_precision {
+  /** Same as @c DataType. */
+  full,
+  /** bfloat16: 8 exponent bits, 7 mantissa bits. */
+  bf16,
+  /** IEEE 754 binary16: 5 exponent bits, 10 mantissa bits. */
+  fp16
+};
+
+/** @brief Parse storage precision from a string.
+ *  @details Accepts "fp32", "full", "bf16", "fp16" or an empty
+ *  string (full precision).
+ */
+storage_precision to_storage_precision(const std::string& str);
+/** @brief Human-readable string for storage precision. */
+std::string to_string(storage_precision precision);
+
+/** @brief Round to nearest bfloat16 (ties to even). */
+uint16_t float_to_bf16(float x);
+/** @brief Expand bfloat16 to single precision. */
+float bf16_to_float(uint16_t x);
+/** @brief Round to nearest IEEE binary16 (ties to even).
+ *  @details Values that are too large become infinity and values
+ *  that are too small become (possibly signed) zero or subnormals.
+ */
+uint16_t float_to_fp16(float x);
+/** @brief Expand IEEE binary16 to single precision. */
+float fp16_to_float(uint16_t x);
+
+/** @brief Convert a column-major matrix to 16-bit storage.
+ *
+ *  @param height     Number of rows.
+ *  @param width      Number of columns.
+ *  @param in         Input buffer.
+ *  @param in_ldim    Leading dimension of input buffer.
+ *  @param out        Packed output buffer with @c height*width
+ *                    entries.
+ *  @param precision  Must be @c bf16 or @c fp16.
+ */
+template <typename T>
+void pack_reduced_precision(size_t height, size_t width,
+                            const T* in, size_t in_ldim,
+                            uint16_t* out,
+                            storage_precision precision);
+
+/** @brief Expand 16-bit storage to a column-major matrix.
+ *  @details Inverse of @c pack_reduced_precision.
+ */
+template <typename T>
+void unpack_reduced_precision(size_t height, size_t width,
+                              const uint16_t* in,
+                              T* out, size_t out_ldim,
+                              storage_precision precision);
+
+} // namespace lbann
+
+#endif // LBANN_UTILS_REDUCED_PRECISION_HPP_INCLUDED
@@ -0,0 +1,125 @@
+#ifndef LBANN_UTILS_THREADS_DAG_SCHEDULER_HPP_INCLUDED
+#define LBANN_UTILS_THREADS_DAG_SCHEDULER_HPP_INCLUDED
+
+#include "lbann/base.hpp"
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace lbann {
+
+/** @class dag_scheduler
+ *  @brief Run the nodes of a directed acyclic graph as tasks on a
+ *         pool of worker threads.
+ *
+ *  A node becomes ready once all of its predecessors have finished.
+ *  Ready nodes are dispatched longest remaining path first, using the
+ *  task times measured in the previous run, so the critical path is
+ *  started as early as possible. The calling thread works as one of
+ *  the workers. Each worker runs its tasks with a fixed OpenMP thread
+ *  budget.
+ *
+ *  The graph uses the node and edge representation of @c graph.hpp.
+ */
+class dag_scheduler {
+public:
+  /** @param num_workers       Tasks run concurrently, including the
+   *                           calling thread.
+   *  @param threads_per_task  OpenMP threads available to each task.
+   *                           If zero, the OpenMP threads are split
+   *                           evenly between the workers.
+   */
+  dag_scheduler(int num_workers, int threads_per_task = 0);
+  dag_scheduler(const dag_scheduler&) = delete;
+  dag_scheduler& operator=(const dag_scheduler&) = delete;
+  ~dag_scheduler();
+
+  /** @brief Set the graph to run.
+   *  @details Must not be called while the scheduler is running.
+   */
+  void set_graph(const std::set<El::Int>& nodes,
+                 const std::map<El::Int,std::set<El::Int>>& edges);
+
+  /** @brief Run every node once, respecting the edges.
+   *  @details Blocks until all tasks have finished. If a task throws,
+   *  no further tasks are started and the exception is rethrown.
+   */
+  void run(const std::function<void(El::Int)>& task);
+
+  int get_num_workers() const noexcept { return m_num_workers; }
+  int get_threads_per_task() const noexcept { return m_threads_per_task; }
+
+  /** @brief Wall-clock time of the most recent run. */
+  double get_run_time() const noexcept { return m_run_time; }
+  /** @brief Summed task time of the most recent run. */
+  double get_work_time() const noexcept { return m_work_time; }
+  /** @brief Longest chain of task times through the graph in the
+   *         most recent run.
+   */
+  double get_critical_path_time() const noexcept { return m_critical_path_time; }
+  /** @brief Mean number of tasks running during the most recent run. */
+  double get_achieved_parallelism() const noexcept {
+    return m_run_time > 0 ? m_work_time / m_run_time : 0;
+  }
+  /** @brief Parallelism that would be reached with unlimited workers
+   *         and the task times of the most recent run.
+   */
+  double get_available_parallelism() const noexcept {
+    return m_critical_path_time > 0 ? m_work_time / m_critical_path_time : 0;
+  }
+
+private:
+  /** Main loop of the worker threads. */
+  void worker_loop();
+  /** Run ready tasks until the current run is done or has failed. */
+  void process_tasks(std::unique_lock<std::mutex>& lock);
+  /** Recompute the priorities and the critical path from the task
+   *  times.
+   */
+  void update_priorities();
+
+  int m_num_workers;
+  int m_threads_per_task;
+  std::vector<std::thread> m_threads;
+
+  /** Graph in local ids: m_nodes[id] is the node of id. */
+  std::vector<El::Int> m_nodes;
+  std::vector<std::vector<size_t>> m_successors;
+  std::vector<size_t> m_num_predecessors;
+  /** Local ids in a topological order. */
+  std::vector<size_t> m_order;
+
+  /** Duration of each task in the most recent run. */
+  std::vector<double> m_task_times;
+  /** Longest remaining path from each task, including the task. */
+  std::vector<double> m_priorities;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  const std::function<void(El::Int)>* m_task = nullptr;
+  std::vector<size_t> m_pending;
+  std::vector<size_t> m_ready;
+  /** Tasks of the current run that have not finished. */
+  size_t m_num_remaining = 0;
+  /** Tasks currently executing. */
+  size_t m_num_running = 0;
+  /** Incremented for every run so that workers join each run once. */
+  size_t m_generation = 0;
+  int m_num_active_workers = 0;
+  bool m_shutdown = false;
+  std::exception_ptr m_error;
+
+  double m_run_time = 0;
+  double m_work_time = 0;
+  double m_critical_path_time = 0;
+};
+
+}// namespace lbann
+
+#endif // LBANN_UTILS_THREADS_DAG_SCHEDULER_HPP_INCLUDED
@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_UTILS_VALUE_CODEC_HPP
+#define LBANN_UTILS_VALUE_CODEC_HPP
+
+#include "lbann/base.hpp"
+
+#include <vector>
+
+namespace lbann {
+
+/// Lossless compression of floating-point values
+/** Values may be XORed with a base array first, so entries that did
+ *  not change become zero and entries that changed a little keep
+ *  zero sign and exponent bits. The i-th bytes of all values are then
+ *  grouped into byte planes, and zero runs in each plane are run-length
+ *  encoded. Values are split into blocks that are encoded in
+ *  parallel.
+ *
+ *  @param size    Number of values.
+ *  @param values  Values to compress.
+ *  @param base    Values to XOR with, or null.
+ *  @param data    Compressed data (output).
+ */
+void compress_values(size_t size,
+                     const DataType* values,
+                     const DataType* base,
+                     std::vector<unsigned char>& data);
+
+/// Decompress values written by compress_values
+/** @param data_size Number of bytes of compressed data.
+ *  @param data      Compressed data.
+ *  @param size      Number of values.
+ *  @param base      Values the data was XORed with, or null.
+ *  @param values    Decompressed values (output).
+ */
+void decompress_values(size_t data_size,
+                       const unsigned char* data,
+                       size_t size,
+                       const DataType* base,
+                       DataType* values);
+
+} // namespace lbann
+
+#endif // LBANN_UTILS_VALUE_CODEC_HPP
@@ -63,6 +63,7 @@ class optimizer;
  */
 class weights {
   friend class optimizer;
+  friend class weights_arena;
 
 public:
   weights(lbann_comm* comm);
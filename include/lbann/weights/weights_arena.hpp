@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LBANN_WEIGHTS_WEIGHTS_ARENA_HPP_INCLUDED
+#define LBANN_WEIGHTS_WEIGHTS_ARENA_HPP_INCLUDED
+
+#include "lbann/base.hpp"
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace lbann {
+
+// Forward declarations
+class weights;
+class optimizer;
+
+/** @brief Contiguous storage for data-parallel weights.
+ *
+ *  The values, gradients, and optimizer state (e.g. momentum
+ *  velocity or Adam moments) of a set of weights are placed in a few
+ *  large buffers. Each weights object keeps its own distributed
+ *  matrices, but they are attached as views into the arena.
+ *
+ *  Weights are grouped by optimizer type. Within a group, each
+ *  buffer holds the members' local data back-to-back (padded to a
+ *  cache line), so an optimization step can be performed with a
+ *  single vectorized sweep over the group instead of one kernel
+ *  launch per weights tensor. Consecutive members whose
+ *  hyperparameters differ (e.g. because of a per-weights learning
+ *  rate schedule) are swept separately.
+ *
+ *  Only weights with CPU data, replicated (STAR,STAR) distribution,
+ *  and an optimizer that supports fused steps are placed in the
+ *  arena. Other weights are left untouched and should be optimized
+ *  with @c optimizer::step.
+ */
+class weights_arena {
+public:
+
+  weights_arena() = default;
+  weights_arena(const weights_arena&) = delete;
+  weights_arena& operator=(const weights_arena&) = delete;
+  /** Members are detached before the buffers are deallocated. */
+  ~weights_arena();
+
+  /** @brief Place eligible weights in contiguous buffers.
+   *
+   *  Any weights already in the arena are detached first. The
+   *  weights and their optimizers must already be setup.
+   */
+  void setup(const std::vector<weights*>& weights_list);
+
+  /** @brief Give each member its own storage again.
+   *
+   *  Data is copied out of the arena, so it is safe to deallocate
+   *  the arena afterwards.
+   */
+  void detach();
+
+  /** Whether weights are stored in the arena. */
+  bool contains(const weights& w) const;
+
+  /** @brief Apply an optimization step to all weights in the arena.
+   *
+   *  Gradients are synchronized before the step. If a member's
+   *  matrices have been reallocated since setup (e.g. by setting up
+   *  its optimizer again), the arena is rebuilt first.
+   */
+  void step();
+
+  /** Number of weights stored in the arena. */
+  size_t get_num_weights() const;
+  /** Number of entries (including padding) in each buffer. */
+  size_t get_size() const;
+  /** Human-readable summary of the arena layout. */
+  std::string get_summary() const;
+
+private:
+
+  /** Location of a weights object in its group's buffers. */
+  struct member {
+    weights* w;
+    /** Optimizer at setup. It is only dereferenced while it is still
+     *  the optimizer of @c w.
+     */
+    optimizer* opt;
+    /** Offset into group buffers. */
+    size_t offset;
+    /** Number of local entries. */
+    size_t size;
+  };
+
+  /** Weights with the same optimizer type. */
+  struct group {
+    /** Optimizer type name. */
+    std::string type;
+    std::vector<member> members;
+    CPUMat values;
+    CPUMat gradient;
+    std::vector<CPUMat> state;
+  };
+
+  std::vector<group> m_groups;
+  /** Weights stored in the arena. */
+  std::unordered_set<const weights*> m_members;
+
+  /** Whether each member is still attached to the arena buffers. */
+  bool is_attached() const;
+
+};
+
+} // namespace lbann
+
+#endif // LBANN_WEIGHTS_WEIGHTS_ARENA_HPP_INCLUDED
@@ -0,0 +1,297 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann_config.hpp"
+
+#include "conduit/conduit.hpp"
+#include "conduit/conduit_relay.hpp"
+#include "conduit/conduit_relay_io_hdf5.hpp"
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include "lbann/lbann.hpp"
+#include "lbann/data_readers/packed_sample_bundle.hpp"
+
+using namespace lbann;
+using namespace std;
+
+using field_t = packed_sample_bundle::field_t;
+
+vector<string> get_field_names_jag();
+vector<string> read_field_names(string filename);
+bool setup_fields(hid_t hdf5_file_hnd, const string& sample, vector<field_t>& fields);
+bool pack_sample(hid_t hdf5_file_hnd, const string& sample, const vector<field_t>& fields, vector<char>& record);
+
+//==========================================================================
+int main(int argc, char *argv[]) {
+  int random_seed = lbann_default_random_seed;
+  world_comm_ptr comm = initialize(argc, argv, random_seed);
+
+  options *opts = options::get();
+  opts->init(argc, argv);
+
+  if (!(opts->has_string("filelist") && opts->has_string("output_dir"))) {
+    LBANN_ERROR("usage: pack_bundles --filelist=<string> --output_dir=<string> [--output_base=<string>] [--samples_per_shard=<int>] [--fields=<string>]\n"
+                "where --fields names a file that lists one conduit path per line, relative to a sample; by default the JAG inputs, scalars and images are packed");
+  }
+
+  // The packing is sequential; run it on a single rank
+  if (!comm->am_world_master()) {
+    return EXIT_SUCCESS;
+  }
+
+  const string filelist = opts->get_string("filelist");
+  const string output_dir = opts->get_string("output_dir");
+  const string output_base = opts->get_string("output_base", "packed");
+  const int samples_per_shard = opts->get_int("samples_per_shard", 10000);
+  if (samples_per_shard <= 0) {
+    LBANN_ERROR("--samples_per_shard must be positive");
+  }
+  stringstream s;
+  s << "mkdir -p " << output_dir;
+  system(s.str().c_str());
+
+  vector<field_t> fields;
+  for (const auto& name : (opts->has_string("fields") ? read_field_names(opts->get_string("fields")) : get_field_names_jag())) {
+    field_t f;
+    f.path = name;
+    fields.push_back(f);
+  }
+  bool have_layout = false;
+  size_t record_size = 0;
+  vector<char> record;
+
+  vector<pair<string, size_t>> shards;
+  vector<string> sample_names;
+  ofstream shard_out;
+  int num_files = 0;
+  int bad_samples = 0;
+  double tm1 = get_time();
+
+  ifstream in(filelist.c_str());
+  if (!in) {
+    LBANN_ERROR("failed to open " + filelist + " for reading");
+  }
+  string filename;
+  while (getline(in, filename)) {
+    if (filename.size() < 2) {
+      continue;
+    }
+    ++num_files;
+    hid_t hdf5_file_hnd;
+    try {
+      hdf5_file_hnd = conduit::relay::io::hdf5_open_file_for_read( filename.c_str() );
+    } catch (...) {
+      LBANN_ERROR("failed to open " + filename + " for reading");
+    }
+    cout << "reading: " << filename << endl;
+
+    std::vector<std::string> cnames;
+    try {
+      conduit::relay::io::hdf5_group_list_child_names(hdf5_file_hnd, "/", cnames);
+    } catch (...) {
+      LBANN_ERROR("exception hdf5_group_list_child_names; " + filename);
+    }
+
+    for (size_t i=0; i<cnames.size(); i++) {
+      conduit::Node n_ok;
+      const string key = "/" + cnames[i] + "/performance/success";
+      try {
+        conduit::relay::io::hdf5_read(hdf5_file_hnd, key, n_ok);
+      } catch (...) {
+        cout << "failed to read success flag for file: " + filename + " and key: " + key << endl;
+        continue;
+      }
+      if (n_ok.to_int64() != 1) {
+        ++bad_samples;
+        continue;
+      }
+
+      // The first good sample fixes the type and size of every field
+      if (!have_layout) {
+        if (!setup_fields(hdf5_file_hnd, cnames[i], fields)) {
+          LBANN_ERROR("failed to read the selected fields of sample " + cnames[i] + " in " + filename);
+        }
+        record_size = packed_sample_bundle::layout_fields(fields);
+        record.assign(record_size, 0);
+        have_layout = true;
+      }
+      if (!pack_sample(hdf5_file_hnd, cnames[i], fields, record)) {
+        cout << "skipping sample " << cnames[i] << " in " << filename
+             << " whose fields do not match the record layout" << endl;
+        ++bad_samples;
+        continue;
+      }
+
+      if (shards.empty() || shards.back().second == static_cast<size_t>(samples_per_shard)) {
+        if (shard_out.is_open()) {
+          shard_out.close();
+        }
+        const string shard = output_base + "_" + to_string(shards.size()) + ".bin";
+        shard_out.open((output_dir + "/" + shard).c_str(), ios::out | ios::binary);
+        if (!shard_out) {
+          LBANN_ERROR("failed to open " + output_dir + "/" + shard + " for writing");
+        }
+        shards.emplace_back(shard, 0);
+      }
+      shard_out.write(record.data(), record_size);
+      if (!shard_out) {
+        LBANN_ERROR("failed to write " + output_dir + "/" + shards.back().first);
+      }
+      ++shards.back().second;
+      sample_names.push_back(filename + " " + cnames[i]);
+    }
+    conduit::relay::io::hdf5_close_file(hdf5_file_hnd);
+  }
+  if (shard_out.is_open()) {
+    shard_out.close();
+  }
+  if (!have_layout) {
+    LBANN_ERROR("no good samples were found in the files of " + filelist);
+  }
+
+  const string index = output_dir + "/" + output_base + "_index.txt";
+  packed_sample_bundle::write_index(index, fields, record_size, shards, sample_names);
+
+  double tm2 = get_time();
+  cout << "========================================================\n"
+       << "packed " << sample_names.size() << " samples from " << num_files << " files into "
+       << shards.size() << " shards; num bad samples: " << bad_samples << "\n"
+       << "bytes per record: " << record_size << " time: " << tm2 - tm1 << "\n"
+       << "index: " << index << endl;
+
+  return EXIT_SUCCESS;
+}
+
+// Determine the type and the number of elements of each field
+bool setup_fields(hid_t hdf5_file_hnd, const string& sample, vector<field_t>& fields) {
+  conduit::Node tmp;
+  for (auto& f : fields) {
+    try {
+      tmp.reset();
+      conduit::relay::io::hdf5_read(hdf5_file_hnd, sample + "/" + f.path, tmp);
+    } catch (...) {
+      cout << "failed to read " << sample << "/" << f.path << endl;
+      return false;
+    }
+    if (!tmp.dtype().is_number()) {
+      LBANN_ERROR("field " + f.path + " is not numeric");
+    }
+    f.type = tmp.dtype().is_float32() ? packed_sample_bundle::field_type::float32
+                                      : packed_sample_bundle::field_type::float64;
+    f.num_elements = tmp.dtype().number_of_elements();
+  }
+  return true;
+}
+
+// Read the fields of a sample into a record
+bool pack_sample(hid_t hdf5_file_hnd, const string& sample, const vector<field_t>& fields, vector<char>& record) {
+  conduit::Node tmp;
+  for (const auto& f : fields) {
+    try {
+      tmp.reset();
+      conduit::relay::io::hdf5_read(hdf5_file_hnd, sample + "/" + f.path, tmp);
+    } catch (...) {
+      return false;
+    }
+    if (static_cast<size_t>(tmp.dtype().number_of_elements()) != f.num_elements) {
+      return false;
+    }
+    // Values are converted, since a sample may store a field with
+    // another type than the one in the layout
+    char* dst = record.data() + f.offset;
+    conduit::Node converted;
+    if (f.type == packed_sample_bundle::field_type::float32) {
+      tmp.to_float32_array(converted);
+      conduit::float32_array vals = converted.as_float32_array();
+      float* out = reinterpret_cast<float*>(dst);
+      for (size_t j=0; j<f.num_elements; j++) {
+        out[j] = vals[j];
+      }
+    } else {
+      tmp.to_float64_array(converted);
+      conduit::float64_array vals = converted.as_float64_array();
+      double* out = reinterpret_cast<double*>(dst);
+      for (size_t j=0; j<f.num_elements; j++) {
+        out[j] = vals[j];
+      }
+    }
+  }
+  return true;
+}
+
+vector<string> read_field_names(string filename) {
+  vector<string> f;
+  ifstream in(filename.c_str());
+  if (!in) {
+    LBANN_ERROR("failed to open " + filename + " for reading");
+  }
+  string line;
+  while (getline(in, line)) {
+    if (line.size() > 0) {
+      f.push_back(line);
+    }
+  }
+  return f;
+}
+
+vector<string> get_field_names_jag() {
+  vector<string> f;
+  f.push_back("inputs/shape_model_initial_modes:(4,3)");
+  f.push_back("inputs/betti_prl15_trans_u");
+  f.push_back("inputs/betti_prl15_trans_v");
+  f.push_back("inputs/shape_model_initial_modes:(2,1)");
+  f.push_back("inputs/shape_model_initial_modes:(1,0)");
+  f.push_back("outputs/scalars/BWx");
+  f.push_back("outputs/scalars/BT");
+  f.push_back("outputs/scalars/tMAXt");
+  f.push_back("outputs/scalars/BWn");
+  f.push_back("outputs/scalars/MAXpressure");
+  f.push_back("outputs/scalars/BAte");
+  f.push_back("outputs/scalars/MAXtion");
+  f.push_back("outputs/scalars/tMAXpressure");
+  f.push_back("outputs/scalars/BAt");
+  f.push_back("outputs/scalars/Yn");
+  f.push_back("outputs/scalars/Ye");
+  f.push_back("outputs/scalars/Yx");
+  f.push_back("outputs/scalars/tMAXte");
+  f.push_back("outputs/scalars/BAtion");
+  f.push_back("outputs/scalars/MAXte");
+  f.push_back("outputs/scalars/tMAXtion");
+  f.push_back("outputs/scalars/BTx");
+  f.push_back("outputs/scalars/MAXt");
+  f.push_back("outputs/scalars/BTn");
+  f.push_back("outputs/scalars/BApressure");
+  f.push_back("outputs/scalars/tMINradius");
+  f.push_back("outputs/scalars/MINradius");
+  f.push_back("outputs/images/(0.0, 0.0)/0.0/emi");
+  f.push_back("outputs/images/(90.0, 0.0)/0.0/emi");
+  f.push_back("outputs/images/(90.0, 78.0)/0.0/emi");
+  return f;
+}
@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann_config.hpp"
+
+#include "conduit/conduit.hpp"
+#include "conduit/conduit_relay.hpp"
+#include "conduit/conduit_relay_io_hdf5.hpp"
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <random>
+#include "lbann/lbann.hpp"
+#include "lbann/data_readers/packed_sample_bundle.hpp"
+
+using namespace lbann;
+using namespace std;
+
+double test_hdf5(string filelist, const packed_sample_bundle& bundle, int max_samples, int& num_samples);
+double test_packed(const packed_sample_bundle& bundle, int num_samples, bool random_order);
+
+//==========================================================================
+int main(int argc, char *argv[]) {
+  int random_seed = lbann_default_random_seed;
+  world_comm_ptr comm = initialize(argc, argv, random_seed);
+
+  options *opts = options::get();
+  opts->init(argc, argv);
+
+  if (!(opts->has_string("filelist") && opts->has_string("index"))) {
+    LBANN_ERROR("usage: test_packed_reading_speed --filelist=<string> --index=<string> [--max_samples=<int>] [--random=<0|1>]\n"
+                "where --index is the index written by pack_bundles for the files in --filelist");
+  }
+
+  packed_sample_bundle bundle;
+  bundle.load(opts->get_string("index"));
+  const int max_samples = opts->get_int("max_samples", 10000);
+
+  // Read the same fields of the same number of samples both ways
+  int num_samples = 0;
+  const double hdf5_time = test_hdf5(opts->get_string("filelist"), bundle, max_samples, num_samples);
+  const double packed_time = test_packed(bundle, num_samples, opts->get_int("random", 0));
+
+  cout << "========================================================\n"
+       << "num samples: " << num_samples << " bytes per record: " << bundle.get_record_size() << "\n"
+       << "hdf5   time: " << hdf5_time << " samples/sec: " << num_samples / hdf5_time << "\n"
+       << "packed time: " << packed_time << " samples/sec: " << num_samples / packed_time << "\n"
+       << "speedup: " << hdf5_time / packed_time << endl;
+  return EXIT_SUCCESS;
+}
+
+double test_hdf5(string filelist, const packed_sample_bundle& bundle, int max_samples, int& num_samples) {
+  double tm1 = get_time();
+  conduit::Node n_ok;
+  conduit::Node tmp;
+  conduit::Node converted;
+  double total = 0;
+  num_samples = 0;
+
+  ifstream in(filelist.c_str());
+  if (!in) {
+    LBANN_ERROR("failed to open " + filelist + " for reading");
+  }
+  string filename;
+  while (num_samples < max_samples && getline(in, filename)) {
+    if (filename.size() < 2) {
+      continue;
+    }
+    hid_t hdf5_file_hnd = conduit::relay::io::hdf5_open_file_for_read( filename.c_str() );
+    std::vector<std::string> cnames;
+    conduit::relay::io::hdf5_group_list_child_names(hdf5_file_hnd, "/", cnames);
+
+    for (size_t i=0; i<cnames.size() && num_samples < max_samples; i++) {
+      try {
+        conduit::relay::io::hdf5_read(hdf5_file_hnd, "/" + cnames[i] + "/performance/success", n_ok);
+      } catch (...) {
+        continue;
+      }
+      if (n_ok.to_int64() != 1) {
+        continue;
+      }
+      for (const auto& f : bundle.get_fields()) {
+        conduit::relay::io::hdf5_read(hdf5_file_hnd, cnames[i] + "/" + f.path, tmp);
+        tmp.to_float64_array(converted);
+        conduit::float64_array vals = converted.as_float64_array();
+        for (conduit::index_t g=0; g<vals.number_of_elements(); g++) {
+          total += vals[g];
+        }
+      }
+      ++num_samples;
+    }
+    conduit::relay::io::hdf5_close_file(hdf5_file_hnd);
+  }
+
+  double tm2 = get_time();
+  cout << "hdf5 checksum: " << total << endl;
+  return tm2 - tm1;
+}
+
+double test_packed(const packed_sample_bundle& bundle, int num_samples, bool random_order) {
+  num_samples = std::min(num_samples, static_cast<int>(bundle.size()));
+  vector<size_t> ids(num_samples);
+  for (int j=0; j<num_samples; j++) {
+    ids[j] = j;
+  }
+  if (random_order) {
+    std::mt19937 gen(lbann_default_random_seed);
+    std::shuffle(ids.begin(), ids.end(), gen);
+  }
+
+  double tm1 = get_time();
+  vector<char> record(bundle.get_record_size());
+  vector<double> vals;
+  double total = 0;
+  for (const auto id : ids) {
+    bundle.read_record(id, record.data());
+    for (const auto& f : bundle.get_fields()) {
+      vals.resize(f.num_elements);
+      packed_sample_bundle::copy_field(record.data(), f, vals.data());
+      for (const auto v : vals) {
+        total += v;
+      }
+    }
+  }
+  double tm2 = get_time();
+  cout << "packed checksum: " << total << endl;
+  return tm2 - tm1;
+}
@@ -74,7 +74,7 @@ int main(int argc, char *argv[]) {
     // Initalize a global I/O thread pool
     std::shared_ptr<thread_pool> io_thread_pool = construct_io_thread_pool(comm.get());
 
-    auto pbs = protobuf_utils::load_prototext(master, argc, argv);
+    auto pbs = protobuf_utils::load_prototext(*comm, argc, argv);
     lbann_data::LbannPB pb = *(pbs[0]);
 
     lbann_data::Model *pb_model = pb.mutable_model();
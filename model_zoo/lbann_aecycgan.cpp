@@ -56,7 +56,7 @@ int main(int argc, char *argv[]) {
     // Initalize a global I/O thread pool
     std::shared_ptr<thread_pool> io_thread_pool = construct_io_thread_pool(comm.get());
 
-    auto pbs = protobuf_utils::load_prototext(master, argc, argv);
+    auto pbs = protobuf_utils::load_prototext(*comm, argc, argv);
 
     auto model_1 = build_model_from_prototext(argc, argv, *(pbs[0]),
                                                 comm.get(), io_thread_pool, true); //ae
@@ -42,7 +42,6 @@ using namespace lbann;
 int main(int argc, char *argv[]) {
   int random_seed = lbann_default_random_seed;
   auto comm = initialize(argc, argv, random_seed);
-  const bool master = comm->am_world_master();
 
   try {
     // Initialize options db (this parses the command line)
@@ -59,7 +58,7 @@ int main(int argc, char *argv[]) {
     std::shared_ptr<thread_pool> io_thread_pool
       = construct_io_thread_pool(comm.get());
 
-    auto pbs = protobuf_utils::load_prototext(master, argc, argv);
+    auto pbs = protobuf_utils::load_prototext(*comm, argc, argv);
     std::vector<std::unique_ptr<model>> models;
     for(auto&& pb_model : pbs) {
       models.emplace_back(
@@ -80,6 +79,14 @@ int main(int argc, char *argv[]) {
       LBANN_ERROR("Unable to reload model");
     }
 
+    /// Fold batch normalization into the preceding layers once the
+    /// trained weights are loaded
+    if(opts->get_bool("fold_batch_norm")){
+      for(auto&& m : models) {
+        m->fold_batch_normalization();
+      }
+    }
+
     /// Interleave the inference between the models so that they can use a shared data reader
     /// Enable shared testing data readers on the command line via --share_testing_data_readers=1
     El::Int num_samples = models[0]->get_num_iterations_per_epoch(execution_mode::testing);
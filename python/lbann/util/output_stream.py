@@ -0,0 +1,103 @@
+"""Read output streams written by the dump_outputs callback.
+
+With the "stream" format, each process appends its layer outputs and
+their sample indices to chunked binary files named
+"<model>-trainer<#>-rank<#>-part<#>.bin". See
+include/lbann/utils/output_stream.hpp for the file layout.
+
+"""
+import glob
+import struct
+
+import numpy as np
+
+_MAGIC = b'LBANNOUT'
+_VERSION = 1
+_VALUE_TYPES = {4: np.float32, 8: np.float64}
+_MODES = {0: 'training', 1: 'validation', 2: 'testing', 3: 'prediction'}
+
+def _read(f, fmt):
+    size = struct.calcsize(fmt)
+    data = f.read(size)
+    if len(data) != size:
+        raise EOFError('unexpected end of output stream file')
+    return struct.unpack(fmt, data)
+
+def read_file(file_name):
+    """Read one output stream file.
+
+    Returns a list of tensor descriptions and a generator of chunks.
+    Each tensor is a dict with 'layer', 'output', and 'dims'. Each
+    chunk is a dict with 'tensor' (position in the tensor list),
+    'mode', 'epoch', 'step', 'indices' (one sample index per sample),
+    and 'values' (array with one row per sample, shaped by the
+    tensor dims).
+
+    """
+    f = open(file_name, 'rb')
+    if f.read(len(_MAGIC)) != _MAGIC:
+        f.close()
+        raise ValueError('{} is not an output stream file'.format(file_name))
+    version, value_size, num_tensors = _read(f, '=III')
+    if version != _VERSION or value_size not in _VALUE_TYPES:
+        f.close()
+        raise ValueError('{} has unsupported version {} or value size {}'
+                         .format(file_name, version, value_size))
+    value_type = _VALUE_TYPES[value_size]
+    tensors = []
+    for _ in range(num_tensors):
+        name_length, = _read(f, '=I')
+        name = f.read(name_length).decode('utf-8')
+        output_index, num_dims = _read(f, '=II')
+        dims = _read(f, '={}i'.format(num_dims))
+        tensors.append({'layer': name, 'output': output_index, 'dims': dims})
+
+    def chunks():
+        with f:
+            while True:
+                header = f.read(struct.calcsize('=IIqqq'))
+                if not header:
+                    return
+                tensor, mode, epoch, step, num_samples = struct.unpack('=IIqqq', header)
+                indices = np.fromfile(f, dtype=np.int64, count=num_samples)
+                dims = tensors[tensor]['dims']
+                count = num_samples * int(np.prod(dims, dtype=np.int64))
+                values = np.fromfile(f, dtype=value_type, count=count)
+                if len(indices) != num_samples or len(values) != count:
+                    raise EOFError('truncated chunk in {}'.format(file_name))
+                yield {'tensor': tensor,
+                       'mode': _MODES.get(mode, 'invalid'),
+                       'epoch': epoch,
+                       'step': step,
+                       'indices': indices,
+                       'values': values.reshape((num_samples,) + tuple(dims))}
+
+    return tensors, chunks()
+
+def read_outputs(pattern, mode=None):
+    """Gather the outputs in all files matching a glob pattern.
+
+    Returns a dict keyed by (layer name, output index). Each entry is
+    a dict with 'indices' and 'values' arrays, concatenated over
+    chunks and files. If mode is given (e.g. 'testing'), other
+    execution modes are skipped.
+
+    """
+    results = {}
+    file_names = sorted(glob.glob(pattern))
+    if not file_names:
+        raise FileNotFoundError('no files match {}'.format(pattern))
+    for file_name in file_names:
+        tensors, chunks = read_file(file_name)
+        for chunk in chunks:
+            if mode is not None and chunk['mode'] != mode:
+                continue
+            t = tensors[chunk['tensor']]
+            entry = results.setdefault((t['layer'], t['output']),
+                                       {'indices': [], 'values': []})
+            entry['indices'].append(chunk['indices'])
+            entry['values'].append(chunk['values'])
+    for entry in results.values():
+        entry['indices'] = np.concatenate(entry['indices'])
+        entry['values'] = np.concatenate(entry['values'])
+    return results
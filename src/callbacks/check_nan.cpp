@@ -26,50 +26,32 @@
 
 #include "lbann/callbacks/check_nan.hpp"
 #include "lbann/utils/exception.hpp"
+#include "lbann/utils/numerical_health.hpp"
+
+#include <cmath>
 
 namespace lbann {
 namespace callback {
 
 namespace {
 
-/** Check whether a matrix contains a NaN.
- *  If a NaN entry is detected, return true and output the local entry
- *  position in row and col. mat is assumed to be a CPU matrix.
+/** Check whether a matrix contains a NaN or inf.
+ *  If a non-finite entry is detected, return true and output the
+ *  local entry position of the first one in row and col and whether
+ *  it is "NaN" or "inf" in kind. mat is assumed to be a CPU matrix.
  */
-bool has_nan(const AbsDistMat& mat, El::Int& row, El::Int& col) {
-  row = -1;
-  col = -1;
+bool has_nonfinite(const AbsDistMat& mat,
+                   El::Int& row, El::Int& col, std::string& kind) {
   const auto& local_mat = mat.LockedMatrix();
-  for (El::Int j = 0; j < local_mat.Width(); ++j) {
-    for (El::Int i = 0; i < local_mat.Height(); ++i) {
-      if (std::isnan(local_mat(i,j))) {
-        row = i;
-        col = j;
-        return true;
-      }
-    }
-  }
-  return false;
-}
-
-/** Check whether a matrix contains an inf.
- *  If an inf entry is detected, return true and output the entry
- *  position in row and col. mat is assumed to be a CPU matrix.
- */
-bool has_inf(const AbsDistMat& mat, El::Int& row, El::Int& col) {
-  row = -1;
-  col = -1;
-  const auto& local_mat = mat.LockedMatrix();
-  for (El::Int j = 0; j < local_mat.Width(); ++j) {
-    for (El::Int i = 0; i < local_mat.Height(); ++i) {
-      if (std::isinf(local_mat(i,j))) {
-        row = i;
-        col = j;
-        return true;
-      }
-    }
-  }
-  return false;
+  const auto& health = get_numerical_health(local_mat.Height(),
+                                            local_mat.Width(),
+                                            local_mat.LockedBuffer(),
+                                            local_mat.LDim());
+  row = health.row;
+  col = health.col;
+  if (health.is_finite()) { return false; }
+  kind = std::isnan(local_mat(row,col)) ? "NaN" : "inf";
+  return true;
 }
 
 /** Dump the local network matrices for debugging.
@@ -123,20 +105,12 @@ void check_nan::on_forward_prop_end(model *m, Layer *l) {
   const auto& num_outputs = l->get_num_children();
   for (int i = 0; i < num_outputs; ++i) {
     El::Int row, col;
+    std::string kind;
     AbsDistMatReadProxy<El::Device::CPU> mat_proxy(l->get_activations(i));
-    if (has_nan(mat_proxy.GetLocked(), row, col)) {
-      dump_network(m);
-      err << "rank " << m->get_comm()->get_rank_in_world() << ": "
-          << "local entry (" << row << "," << col << ") is NaN "
-          << "in activations ";
-      if (num_outputs > 1) { err << i << " "; }
-      err << "of layer \"" << l->get_name() << "\"";
-      LBANN_ERROR(err.str());
-    }
-    if (has_inf(mat_proxy.GetLocked(), row, col)) {
+    if (has_nonfinite(mat_proxy.GetLocked(), row, col, kind)) {
       dump_network(m);
       err << "rank " << m->get_comm()->get_rank_in_world() << ": "
-          << "local entry (" << row << "," << col << ") is inf "
+          << "local entry (" << row << "," << col << ") is " << kind << " "
           << "in activations ";
       if (num_outputs > 1) { err << i << " "; }
       err << "of layer \"" << l->get_name() << "\"";
@@ -150,20 +124,12 @@ void check_nan::on_backward_prop_end(model *m, Layer *l) {
   const auto& num_inputs = l->get_num_parents();
   for (int i = 0; i < num_inputs; ++i) {
     El::Int row, col;
+    std::string kind;
     AbsDistMatReadProxy<El::Device::CPU> mat_proxy(l->get_error_signals(i));
-    if (has_nan(mat_proxy.GetLocked(), row, col)) {
+    if (has_nonfinite(mat_proxy.GetLocked(), row, col, kind)) {
       dump_network(m);
       err << "rank " << m->get_comm()->get_rank_in_world() << ": "
-          << "local entry (" << row << "," << col << ") is NaN "
-          << "in error signals ";
-      if (num_inputs > 1) { err << i << " "; }
-      err << "of layer \"" << l->get_name() << "\"";
-      LBANN_ERROR(err.str());
-    }
-    if (has_inf(mat_proxy.GetLocked(), row, col)) {
-      dump_network(m);
-      err << "rank " << m->get_comm()->get_rank_in_world() << ": "
-          << "local entry (" << row << "," << col << ") is inf "
+          << "local entry (" << row << "," << col << ") is " << kind << " "
           << "in error signals ";
       if (num_inputs > 1) { err << i << " "; }
       err << "of layer \"" << l->get_name() << "\"";
@@ -178,18 +144,12 @@ void check_nan::on_backward_prop_end(model *m) {
     auto* opt = w->get_optimizer();
     if (opt != nullptr) {
       El::Int row, col;
+      std::string kind;
       AbsDistMatReadProxy<El::Device::CPU> mat_proxy(opt->get_gradient());
-      if (has_nan(mat_proxy.GetLocked(), row, col)) {
+      if (has_nonfinite(mat_proxy.GetLocked(), row, col, kind)) {
         dump_network(m);
         err << "rank " << m->get_comm()->get_rank_in_world() << ": "
-            << "local entry (" << row << "," << col << ") is NaN "
-            << "in gradient w.r.t. weights \"" << w->get_name() << "\"";
-        LBANN_ERROR(err.str());
-      }
-      if (has_inf(mat_proxy.GetLocked(), row, col)) {
-        dump_network(m);
-        err << "rank " << m->get_comm()->get_rank_in_world() << ": "
-            << "local entry (" << row << "," << col << ") is inf "
+            << "local entry (" << row << "," << col << ") is " << kind << " "
             << "in gradient w.r.t. weights \"" << w->get_name() << "\"";
         LBANN_ERROR(err.str());
       }
@@ -201,18 +161,12 @@ void check_nan::on_batch_end(model *m) {
   std::stringstream err;
   for (weights *w : m->get_weights()) {
     El::Int row, col;
+    std::string kind;
     AbsDistMatReadProxy<El::Device::CPU> mat_proxy(w->get_values());
-    if (has_nan(mat_proxy.GetLocked(), row, col)) {
-      dump_network(m);
-      err << "rank " << m->get_comm()->get_rank_in_world() << ": "
-          << "local entry (" << row << "," << col << ") is NaN "
-          << "in weights \"" << w->get_name() << "\"";
-      LBANN_ERROR(err.str());
-    }
-    if (has_inf(mat_proxy.GetLocked(), row, col)) {
+    if (has_nonfinite(mat_proxy.GetLocked(), row, col, kind)) {
       dump_network(m);
       err << "rank " << m->get_comm()->get_rank_in_world() << ": "
-          << "local entry (" << row << "," << col << ") is inf "
+          << "local entry (" << row << "," << col << ") is " << kind << " "
           << "in weights \"" << w->get_name() << "\"";
       LBANN_ERROR(err.str());
     }
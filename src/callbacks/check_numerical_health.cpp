@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/callbacks/check_numerical_health.hpp"
+#include "lbann/utils/file_utils.hpp"
+
+#include <callbacks.pb.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace lbann {
+namespace callback {
+
+check_numerical_health::check_numerical_health(El::Int batch_interval,
+                                               DataType max_abs,
+                                               bool synchronous,
+                                               std::string directory)
+  : callback_base(),
+    m_interval(std::max(batch_interval, El::Int(1))),
+    m_max_abs(max_abs),
+    m_synchronous(synchronous),
+    m_directory(std::move(directory)) {
+  if (m_directory.empty()) { m_directory = "./"; }
+  if (m_directory.back() != '/') { m_directory += "/"; }
+}
+
+check_numerical_health::check_numerical_health(const check_numerical_health& other)
+  : callback_base(other),
+    m_interval(other.m_interval),
+    m_max_abs(other.m_max_abs),
+    m_synchronous(other.m_synchronous),
+    m_directory(other.m_directory) {}
+
+check_numerical_health& check_numerical_health::operator=(const check_numerical_health& other) {
+  wait();
+  callback_base::operator=(other);
+  m_interval = other.m_interval;
+  m_max_abs = other.m_max_abs;
+  m_synchronous = other.m_synchronous;
+  m_directory = other.m_directory;
+  m_active = false;
+  m_checks.clear();
+  return *this;
+}
+
+check_numerical_health::~check_numerical_health() {
+  // Scans on the I/O thread pool write into m_checks
+  for (auto& f : m_pending) {
+    if (f.valid()) { f.wait(); }
+  }
+}
+
+void check_numerical_health::setup(model* m) {
+  size_t num_tensors = 0;
+  for (const auto* l : m->get_layers()) {
+    num_tensors += l->get_num_children() + l->get_num_parents();
+  }
+  m_checks.reserve(num_tensors);
+  m_pending.reserve(num_tensors);
+}
+
+void check_numerical_health::on_batch_begin(model* m) {
+  wait();
+  m_active = (m->get_step() % m_interval == 0);
+  m_checks.clear();
+}
+
+void check_numerical_health::on_forward_prop_end(model* m, Layer* l) {
+  if (!m_active) { return; }
+
+  // Reduced precision storage replaces output buffers once all child
+  // layers have finished forward prop
+  const bool defer = (l->get_activation_storage_precision()
+                      == storage_precision::full);
+  for (int i = 0; i < l->get_num_children(); ++i) {
+    check_tensor(*m, *l, l->get_activations(i), false, i, defer);
+  }
+
+}
+
+void check_numerical_health::on_backward_prop_end(model* m, Layer* l) {
+  if (!m_active) { return; }
+  for (int i = 0; i < l->get_num_parents(); ++i) {
+    check_tensor(*m, *l, l->get_error_signals(i), true, i, true);
+  }
+}
+
+void check_numerical_health::on_batch_end(model* m) {
+  if (!m_active) { return; }
+  wait();
+  for (const auto& check : m_checks) {
+    report(*m, check);
+  }
+  m_checks.clear();
+  m_active = false;
+}
+
+void check_numerical_health::check_tensor(model& m, const Layer& l,
+                                          const AbsDistMat& mat,
+                                          bool error_signals, int index,
+                                          bool defer) {
+  if (m_checks.size() == m_checks.capacity()) {
+    std::stringstream err;
+    err << "callback \"" << name() << "\" "
+        << "checked more tensors than were reserved during setup";
+    LBANN_ERROR(err.str());
+  }
+  m_checks.emplace_back();
+  auto& check = m_checks.back();
+  check.layer = &l;
+  check.error_signals = error_signals;
+  check.index = index;
+
+  // Tensors that may change before the end of the step are scanned
+  // immediately
+  auto io_thread_pool = m.get_io_thread_pool();
+  defer = (defer
+           && !m_synchronous
+           && !mat.Viewing()
+           && !m.using_tensor_placement()
+           && mat.GetLocalDevice() == El::Device::CPU
+           && io_thread_pool != nullptr
+           && io_thread_pool->get_num_threads() > 0);
+
+  // Scan tensor
+  if (mat.GetLocalDevice() == El::Device::CPU) {
+    const auto& local_mat = mat.LockedMatrix();
+    const auto height = local_mat.Height();
+    const auto width = local_mat.Width();
+    const auto ldim = local_mat.LDim();
+    const auto* buffer = local_mat.LockedBuffer();
+    if (defer) {
+      auto* health = &check.health;
+      m_pending.emplace_back(io_thread_pool->submit_job(
+        [health,height,width,buffer,ldim]() {
+          *health = get_numerical_health(height, width, buffer, ldim);
+        }));
+      return;
+    }
+    check.health = get_numerical_health(height, width, buffer, ldim);
+  } else {
+    AbsDistMatReadProxy<El::Device::CPU> mat_proxy(mat);
+    const auto& local_mat = mat_proxy.GetLocked().LockedMatrix();
+    check.health = get_numerical_health(local_mat.Height(),
+                                        local_mat.Width(),
+                                        local_mat.LockedBuffer(),
+                                        local_mat.LDim());
+  }
+  report(m, check);
+
+}
+
+void check_numerical_health::wait() {
+  for (auto& f : m_pending) { f.get(); }
+  m_pending.clear();
+}
+
+void check_numerical_health::report(model& m,
+                                    const tensor_check& check) const {
+  const auto& health = check.health;
+  const bool too_large = (m_max_abs > DataType(0)
+                          && health.max_abs > m_max_abs);
+  if (health.is_finite() && !too_large) { return; }
+  const auto& l = *check.layer;
+  auto& comm = *m.get_comm();
+
+  // Dump local tensors of offending layer
+  // Note: Only the ranks with bad data write files.
+  std::stringstream ss;
+  ss << m_directory
+     << "model" << comm.get_trainer_rank()
+     << "-rank" << comm.get_rank_in_trainer()
+     << "-epoch" << m.get_epoch()
+     << "-step" << m.get_step(execution_mode::training)
+     << "-" << l.get_name() << "-";
+  const std::string prefix = ss.str();
+  file::make_directory(m_directory);
+  for (int i = 0; i < l.get_num_children(); ++i) {
+    El::Write(l.get_local_activations(i),
+              prefix + "Activations" + std::to_string(i),
+              El::BINARY);
+  }
+  if (check.error_signals) {
+    for (int i = 0; i < l.get_num_parents(); ++i) {
+      El::Write(l.get_local_error_signals(i),
+                prefix + "ErrorSignal" + std::to_string(i),
+                El::BINARY);
+    }
+  }
+  for (const auto* w : l.get_weights()) {
+    El::Write(w->get_values().LockedMatrix(),
+              prefix + w->get_name() + "-Weights",
+              El::BINARY);
+  }
+
+  // Report error
+  std::stringstream err;
+  err << "rank " << comm.get_rank_in_world() << ": ";
+  if (health.is_finite()) {
+    err << "largest absolute value (" << health.max_abs << ") "
+        << "exceeds " << m_max_abs << " ";
+  } else {
+    err << health.num_nans << " NaN and "
+        << health.num_infs << " inf local entries "
+        << "(first at (" << health.row << "," << health.col << ")) ";
+  }
+  err << "in " << (check.error_signals ? "error signals " : "activations ");
+  const int num_tensors = (check.error_signals ?
+                           l.get_num_parents() :
+                           l.get_num_children());
+  if (num_tensors > 1) { err << check.index << " "; }
+  err << "of layer \"" << l.get_name() << "\" "
+      << "(tensors dumped to " << prefix << "*)";
+  LBANN_ERROR(err.str());
+
+}
+
+std::unique_ptr<callback_base>
+build_check_numerical_health_callback_from_pbuf(
+  const google::protobuf::Message& proto_msg, const std::shared_ptr<lbann_summary>&) {
+  const auto& params =
+    dynamic_cast<const lbann_data::Callback::CallbackCheckNumericalHealth&>(proto_msg);
+  return make_unique<check_numerical_health>(params.batch_interval(),
+                                             params.max_abs(),
+                                             params.synchronous(),
+                                             params.directory());
+}
+
+} // namespace callback
+} // namespace lbann
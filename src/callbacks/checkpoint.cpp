@@ -30,17 +30,325 @@
 #include "lbann/callbacks/checkpoint.hpp"
 
 #include "lbann/models/model.hpp"
+#include "lbann/utils/exception.hpp"
+#include "lbann/utils/file_utils.hpp"
 
 #include <callbacks.pb.h>
 
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <memory>
 #include <string>
 
 namespace lbann {
 namespace callback {
+
+namespace {
+
+/** Largest message used to send a memory checkpoint to a partner. */
+constexpr size_t max_partner_message_size = size_t(1) << 30;
+
+template <typename T>
+void pack_value(std::vector<char>& buf, const T& val) {
+  const char* ptr = reinterpret_cast<const char*>(&val);
+  buf.insert(buf.end(), ptr, ptr + sizeof(T));
+}
+
+template <typename T>
+T unpack_value(const std::vector<char>& buf, size_t& pos) {
+  if (pos + sizeof(T) > buf.size()) {
+    LBANN_ERROR("truncated memory checkpoint");
+  }
+  T val;
+  std::memcpy(&val, buf.data() + pos, sizeof(T));
+  pos += sizeof(T);
+  return val;
+}
+
+/** List the regular files under dir/prefix, relative to dir. */
+void list_files(const std::string& dir, const std::string& prefix,
+                std::vector<std::string>& files) {
+  DIR* d = opendir((dir + "/" + prefix).c_str());
+  if (d == nullptr) { return; }
+  while (struct dirent* entry = readdir(d)) {
+    const std::string name = entry->d_name;
+    if (name == "." || name == "..") { continue; }
+    const std::string path = prefix.empty() ? name : prefix + "/" + name;
+    struct stat st;
+    if (lstat((dir + "/" + path).c_str(), &st) != 0) { continue; }
+    if (S_ISDIR(st.st_mode)) {
+      list_files(dir, path, files);
+    } else if (S_ISREG(st.st_mode)) {
+      files.push_back(path);
+    }
+  }
+  closedir(d);
+}
+
+/** Remove a directory and everything under it. */
+void remove_directory(const std::string& dir) {
+  DIR* d = opendir(dir.c_str());
+  if (d == nullptr) { return; }
+  while (struct dirent* entry = readdir(d)) {
+    const std::string name = entry->d_name;
+    if (name == "." || name == "..") { continue; }
+    const std::string path = dir + "/" + name;
+    struct stat st;
+    if (lstat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+      remove_directory(path);
+    } else {
+      unlink(path.c_str());
+    }
+  }
+  closedir(d);
+  rmdir(dir.c_str());
+}
+
+/** Pack a checkpoint directory into a buffer.
+ *  The buffer starts with the epoch and step, followed by the
+ *  relative path and contents of each file.
+ */
+void pack_checkpoint(const std::string& dir, int epoch, int step,
+                     std::vector<char>& buf) {
+  std::vector<std::string> files;
+  list_files(dir, "", files);
+  buf.clear();
+  pack_value<int64_t>(buf, epoch);
+  pack_value<int64_t>(buf, step);
+  pack_value<uint64_t>(buf, files.size());
+  std::vector<char> contents;
+  for (const auto& f : files) {
+    if (!load_file(dir + "/" + f, contents)) {
+      LBANN_ERROR("failed to read file (", dir, "/", f, ")");
+    }
+    pack_value<uint64_t>(buf, f.size());
+    buf.insert(buf.end(), f.begin(), f.end());
+    pack_value<uint64_t>(buf, contents.size());
+    buf.insert(buf.end(), contents.begin(), contents.end());
+  }
+}
+
+/** Epoch and step of a packed checkpoint. */
+void unpack_checkpoint_header(const std::vector<char>& buf,
+                              int& epoch, int& step) {
+  size_t pos = 0;
+  epoch = unpack_value<int64_t>(buf, pos);
+  step = unpack_value<int64_t>(buf, pos);
+}
+
+/** Write the files of a packed checkpoint to a directory. */
+void unpack_checkpoint(const std::vector<char>& buf, const std::string& dir) {
+  size_t pos = 2 * sizeof(int64_t);
+  const auto num_files = unpack_value<uint64_t>(buf, pos);
+  for (uint64_t i = 0; i < num_files; ++i) {
+    const auto path_size = unpack_value<uint64_t>(buf, pos);
+    if (pos + path_size > buf.size()) {
+      LBANN_ERROR("truncated memory checkpoint");
+    }
+    const std::string filename = dir + "/" + std::string(buf.data() + pos, path_size);
+    pos += path_size;
+    const auto size = unpack_value<uint64_t>(buf, pos);
+    if (pos + size > buf.size()) {
+      LBANN_ERROR("truncated memory checkpoint");
+    }
+    file::make_directory(file::extract_parent_directory(filename));
+    std::ofstream ofs(filename, std::ios::binary);
+    ofs.write(buf.data() + pos, size);
+    if (!ofs) {
+      LBANN_ERROR("failed to write file (", filename, ")");
+    }
+    pos += size;
+  }
+}
+
+/** Read the epoch and step of a packed checkpoint file. */
+bool read_packed_checkpoint_header(const std::string& filename,
+                                   int& epoch, int& step) {
+  std::ifstream ifs(filename, std::ios::binary);
+  int64_t header[2];
+  ifs.read(reinterpret_cast<char*>(header), sizeof(header));
+  if (!ifs) { return false; }
+  epoch = header[0];
+  step = header[1];
+  return true;
+}
+
+/** Write a buffer to a file, replacing it only once complete. */
+void write_file(const std::string& filename, const std::vector<char>& buf) {
+  const std::string tmp = filename + ".tmp";
+  {
+    std::ofstream ofs(tmp, std::ios::binary);
+    ofs.write(buf.data(), buf.size());
+    if (!ofs) {
+      LBANN_ERROR("failed to write file (", tmp, ")");
+    }
+  }
+  if (std::rename(tmp.c_str(), filename.c_str()) != 0) {
+    LBANN_ERROR("failed to rename file (", tmp, ") to (", filename, ")");
+  }
+}
+
+/** Buffer sent to or received from a partner rank. */
+struct partner_transfer {
+  int rank;
+  /** Partner index, used for message tags. */
+  int slot;
+  std::vector<char>* buffer;
+};
+
+/** Start sending and receiving buffers between partner ranks.
+ *  Message sizes are exchanged first. Buffers are then transferred in
+ *  chunks with non-blocking sends and receives, whose requests are
+ *  appended to @c requests. Receive buffers are resized.
+ */
+void start_partner_transfers(lbann_comm& comm,
+                             const El::mpi::Comm& partner_comm,
+                             const std::vector<partner_transfer>& sends,
+                             const std::vector<partner_transfer>& recvs,
+                             std::vector<El::mpi::Request<El::byte>>& requests) {
+  std::vector<uint64_t> send_sizes(sends.size()), recv_sizes(recvs.size());
+  std::vector<El::mpi::Request<El::byte>> size_requests(sends.size() + recvs.size());
+  size_t r = 0;
+  for (size_t i = 0; i < recvs.size(); ++i) {
+    auto* ptr = reinterpret_cast<El::byte*>(&recv_sizes[i]);
+    comm.nb_tagged_recv<El::byte>(ptr, sizeof(uint64_t), recvs[i].rank,
+                                  2 * recvs[i].slot, size_requests[r++],
+                                  partner_comm);
+  }
+  for (size_t i = 0; i < sends.size(); ++i) {
+    send_sizes[i] = sends[i].buffer->size();
+    const auto* ptr = reinterpret_cast<const El::byte*>(&send_sizes[i]);
+    comm.nb_tagged_send<El::byte>(ptr, sizeof(uint64_t), sends[i].rank,
+                                  2 * sends[i].slot, size_requests[r++],
+                                  partner_comm);
+  }
+  comm.wait_all(size_requests);
+
+  for (size_t i = 0; i < recvs.size(); ++i) {
+    auto& buf = *recvs[i].buffer;
+    buf.resize(recv_sizes[i]);
+    for (size_t offset = 0; offset < buf.size(); offset += max_partner_message_size) {
+      const size_t count = std::min(max_partner_message_size, buf.size() - offset);
+      auto* ptr = reinterpret_cast<El::byte*>(buf.data() + offset);
+      requests.emplace_back();
+      comm.nb_tagged_recv<El::byte>(ptr, count, recvs[i].rank,
+                                    2 * recvs[i].slot + 1, requests.back(),
+                                    partner_comm);
+    }
+  }
+  for (size_t i = 0; i < sends.size(); ++i) {
+    const auto& buf = *sends[i].buffer;
+    for (size_t offset = 0; offset < buf.size(); offset += max_partner_message_size) {
+      const size_t count = std::min(max_partner_message_size, buf.size() - offset);
+      const auto* ptr = reinterpret_cast<const El::byte*>(buf.data() + offset);
+      requests.emplace_back();
+      comm.nb_tagged_send<El::byte>(ptr, count, sends[i].rank,
+                                    2 * sends[i].slot + 1, requests.back(),
+                                    partner_comm);
+    }
+  }
+}
+
+} // namespace
+
+checkpoint::checkpoint(const checkpoint& other)
+  : callback_base(other),
+    m_checkpoint_dir(other.m_checkpoint_dir),
+    m_checkpoint_epochs(other.m_checkpoint_epochs),
+    m_checkpoint_steps(other.m_checkpoint_steps),
+    m_checkpoint_secs(other.m_checkpoint_secs),
+    m_per_rank_dir(other.m_per_rank_dir),
+    m_ckpt_dist_epochs(other.m_ckpt_dist_epochs),
+    m_ckpt_dist_steps(other.m_ckpt_dist_steps),
+    m_checkpoint_last(other.m_checkpoint_last),
+    m_ckpt_memory_steps(other.m_ckpt_memory_steps),
+    m_memory_dir(other.m_memory_dir),
+    m_num_partners(other.m_num_partners),
+    m_ckpt_dist_full_interval(other.m_ckpt_dist_full_interval),
+    m_ckpt_dist_count(other.m_ckpt_dist_count),
+    m_ckpt_dist_base_dir(other.m_ckpt_dist_base_dir),
+    p(other.p),
+    m_checkpoint_dist(other.m_checkpoint_dist),
+    m_checkpoint_shared(other.m_checkpoint_shared),
+    m_checkpoint_memory(other.m_checkpoint_memory) {}
+
+checkpoint& checkpoint::operator=(const checkpoint& other) {
+  callback_base::operator=(other);
+  m_checkpoint_dir = other.m_checkpoint_dir;
+  m_checkpoint_epochs = other.m_checkpoint_epochs;
+  m_checkpoint_steps = other.m_checkpoint_steps;
+  m_checkpoint_secs = other.m_checkpoint_secs;
+  m_per_rank_dir = other.m_per_rank_dir;
+  m_ckpt_dist_epochs = other.m_ckpt_dist_epochs;
+  m_ckpt_dist_steps = other.m_ckpt_dist_steps;
+  m_checkpoint_last = other.m_checkpoint_last;
+  m_ckpt_memory_steps = other.m_ckpt_memory_steps;
+  m_memory_dir = other.m_memory_dir;
+  m_num_partners = other.m_num_partners;
+  m_ckpt_dist_full_interval = other.m_ckpt_dist_full_interval;
+  m_ckpt_dist_count = other.m_ckpt_dist_count;
+  m_ckpt_dist_base_dir = other.m_ckpt_dist_base_dir;
+  p = other.p;
+  m_checkpoint_dist = other.m_checkpoint_dist;
+  m_checkpoint_shared = other.m_checkpoint_shared;
+  m_checkpoint_memory = other.m_checkpoint_memory;
+  return *this;
+}
+
+checkpoint::~checkpoint() {
+  // Every rank takes part in the confirmation barrier, so it is
+  // started here if the transfers were still outstanding
+  if (!m_partner_requests.empty()) {
+    El::mpi::WaitAll(m_partner_requests.size(), m_partner_requests.data());
+    if (!m_partner_confirming) {
+      MPI_Ibarrier(m_partner_comm.GetMPIComm(), &m_partner_confirm_request);
+      m_partner_confirming = true;
+    }
+  }
+  if (m_partner_confirming) {
+    MPI_Wait(&m_partner_confirm_request, MPI_STATUS_IGNORE);
+  }
+  if (m_has_partner_comm) {
+    El::mpi::Free(m_partner_comm);
+  }
+}
+
 // Load from checkpoint occurs during setup callbacks
 void checkpoint::setup(model *m) {
   p.set_cb_type(callback_type::invalid);
+  if (m_ckpt_memory_steps > 0) {
+    // Choose partners a multiple of the processes per node away, so
+    // copies of memory checkpoints are on other nodes
+    lbann_comm *comm = m->get_comm();
+    const int rank = comm->get_rank_in_trainer();
+    const int procs = comm->get_procs_per_trainer();
+    const int stride = std::max(comm->get_procs_per_node(), 1);
+    m_partner_dests.clear();
+    m_partner_sources.clear();
+    for (int k = 1; k <= m_num_partners; ++k) {
+      const int offset = (k * stride) % procs;
+      if (offset == 0) { break; }
+      m_partner_dests.push_back((rank + offset) % procs);
+      m_partner_sources.push_back((rank - offset + procs) % procs);
+    }
+    if (comm->am_trainer_master()
+        && (int) m_partner_dests.size() < m_num_partners) {
+      LBANN_WARNING("memory checkpoints have ", m_partner_dests.size(),
+                    " partner copies instead of ", m_num_partners,
+                    " since the trainer spans too few nodes");
+    }
+    if (!m_has_partner_comm) {
+      El::mpi::Split(comm->get_trainer_comm(), 0, rank, m_partner_comm);
+      m_has_partner_comm = true;
+    }
+  }
   restart(m);
 }
 // Interval defined with checkpoint_epochs or ckpt_dist_epochs
@@ -61,12 +369,18 @@ void checkpoint::on_validation_end(model *m) {
 }
  // Interval defined with checkpoint_steps or ckpt_dist_steps
 void checkpoint::on_batch_end(model *m) {
+  // Store partner copies that arrived during the step
+  progress_replication(m, false);
   p.set_cb_type(callback_type::batch);
   if(need_checkpoint(m)){
     do_checkpoint(m);
   }
   p.set_cb_type(callback_type::invalid);
 }
+// Partner copies of the last memory checkpoint must be complete
+void checkpoint::on_train_end(model *m) {
+  progress_replication(m, true);
+}
 
 // Decide if we need to trigger a checkpoint for either mode, based on prototext defined intervals
 bool checkpoint::need_checkpoint(model *m) {
@@ -77,12 +391,14 @@ bool checkpoint::need_checkpoint(model *m) {
       m_checkpoint_steps  == 0 &&
       m_checkpoint_secs   == 0.0 &&
       m_ckpt_dist_epochs == 0 &&
-      m_ckpt_dist_steps== 0) {
+      m_ckpt_dist_steps== 0 &&
+      m_ckpt_memory_steps <= 0) {
     return false;
   }
   // assume that we won't checkpoint
   m_checkpoint_shared = false;
   m_checkpoint_dist = false;
+  m_checkpoint_memory = false;
   lbann_comm *comm = m->get_comm();
   int cur_epoch = m->get_epoch();
   // If we are at the end of a training epoch and the training epoch lands on defined interval, ckpt
@@ -103,6 +419,11 @@ bool checkpoint::need_checkpoint(model *m) {
       m_checkpoint_dist = (m->get_step(execution_mode::training) > 0) && (m->get_step(execution_mode::training) % m_ckpt_dist_steps == 0);
   }
 
+  // Memory checkpoints are only taken at the end of training mb steps
+  if (m_ckpt_memory_steps > 0 && p.get_cb_type() == callback_type::batch) {
+    m_checkpoint_memory = (m->get_step(execution_mode::training) > 0) && (m->get_step(execution_mode::training) % m_ckpt_memory_steps == 0);
+  }
+
   // check the clock if time-based checkpoint is enabled
   if (!m_checkpoint_shared && m_checkpoint_secs != 0.0) {
     // have rank 0 determine whether we should checkpoint
@@ -117,14 +438,15 @@ bool checkpoint::need_checkpoint(model *m) {
     }
     comm->trainer_broadcast(0, m_checkpoint_shared);
   }
-  // If either checkpoint version is triggered, return true, otherwise false.
-  return (m_checkpoint_shared || m_checkpoint_dist);
+  // If any checkpoint version is triggered, return true, otherwise false.
+  return (m_checkpoint_shared || m_checkpoint_dist || m_checkpoint_memory);
 }
 
-// Checkpoint Shared/Distributed
+// Checkpoint Shared/Distributed/Memory
 bool checkpoint::do_checkpoint(model *m) {
   // if the checkpoint directory is not defined, bail
-  if (m_checkpoint_dir.length() == 0 && m_per_rank_dir.length() == 0) {
+  if (m_checkpoint_dir.length() == 0 && m_per_rank_dir.length() == 0
+      && !m_checkpoint_memory) {
     return false;
   }
   // time how long this takes
@@ -145,15 +467,44 @@ bool checkpoint::do_checkpoint(model *m) {
   if (comm->am_trainer_master()) {
     epoch = m->get_epoch();
     step = m->get_step(execution_mode::training);
-    timer.Start();
-    printf("Checkpoint: epoch %d step %d ...\n", epoch, step);
-    fflush(stdout);
+    if (m_checkpoint_dist || m_checkpoint_shared) {
+      printf("Checkpoint: epoch %d step %d ...\n", epoch, step);
+      fflush(stdout);
+    }
   }
   comm->trainer_broadcast(0, epoch);
   comm->trainer_broadcast(0, step);
 
+  // Report the cost of each checkpoint level
+  auto report = [&](const char* level, EvalType secs) {
+    uint64_t bytes_count = p.get_bytes();
+    uint64_t uncompressed_bytes = p.get_uncompressed_bytes();
+    if (comm->am_trainer_master()) {
+      EvalType bw = 0;
+      if (secs > 0.0) {
+        bw = EvalType(bytes_count) / (secs * 1024.0 * 1024.0);
+      }
+      printf("[%s.%d] %s checkpoint complete: Epoch=%d Step=%d (%f secs, %llu bytes, %f MB/sec)\n",
+             m->get_name().c_str(), comm->get_trainer_rank(), level, epoch, step, secs, (unsigned long long) bytes_count, bw);
+      if (uncompressed_bytes > 0) {
+        printf("[%s.%d] %s checkpoint compression: %s (%llu matrix bytes before compression, %f secs compressing)\n",
+               m->get_name().c_str(), comm->get_trainer_rank(), level,
+               (m_ckpt_dist_base_dir == epochdir ? "full" : "delta"),
+               (unsigned long long) uncompressed_bytes, p.get_compression_time());
+      }
+      fflush(stdout);
+    }
+    p.reset_bytes();
+  };
+
+  // Memory ckpt
+  if (m_checkpoint_memory) {
+    do_memory_checkpoint(m, epoch, step);
+  }
+
   // Distributed ckpt
   if(m_checkpoint_dist){
+    timer.Start();
     // prepend per rank directory with shared checkpoint dir name
     // Per rank directory typically a cache location like node local SSDs
     if(m_per_rank_dir.length() != 0){
@@ -164,18 +515,32 @@ bool checkpoint::do_checkpoint(model *m) {
     makedir(dir);
     // create directories per ranks
     epochdir = get_distributed_checkpoint_dirname(m, dir, epoch, step);
+    // Compressed checkpoints between full ones hold deltas against
+    // the last full one
+    if (m_ckpt_dist_full_interval > 0) {
+      if (m_ckpt_dist_count % m_ckpt_dist_full_interval == 0) {
+        m_ckpt_dist_base_dir = epochdir;
+        p.set_compression(true);
+      } else {
+        p.set_compression(true, m_ckpt_dist_base_dir);
+      }
+    }
     p.open_checkpoint(epochdir.c_str());
     // Call top level save to checkpoint function in model, in turn calls save to checkpoint functions for other model classes (weights, layers)
     m->save_to_checkpoint_distributed(p);
     p.close_checkpoint();
+    p.set_compression(false);
+    ++m_ckpt_dist_count;
     // Print latest checkpoint to file
     if (comm->am_trainer_master()) {
       latest_file = get_last_distributed_checkpoint_filename(m, dir);
       write_latest(latest_file, epoch, step);
     }
+    report("Distributed", timer.Stop());
   }
   // Shared checkpoint, logic identical to Distributed.i
   if(m_checkpoint_shared){
+    timer.Start();
     strcpy(dir, m_checkpoint_dir.c_str());
     makedir(dir);
     epochdir = get_shared_checkpoint_dirname(m, dir, epoch, step);
@@ -191,31 +556,335 @@ bool checkpoint::do_checkpoint(model *m) {
       latest_file = get_last_shared_checkpoint_filename(m, dir);
       write_latest(latest_file, epoch, step);
     }
+    report("Shared", timer.Stop());
   }
 
-  uint64_t bytes_count = p.get_bytes();
+  // record last checkpoint time in case checkpoint_secs interval defined.
+  if (m_checkpoint_dist || m_checkpoint_shared) {
+    m_checkpoint_last = MPI_Wtime();
+  }
+  return true;
+}
+
+std::string checkpoint::get_memory_dir() const {
+  if (m_checkpoint_dir.length() == 0) {
+    return m_memory_dir;
+  }
+  return m_memory_dir + "/" + m_checkpoint_dir;
+}
+
+void checkpoint::do_memory_checkpoint(model *m, int epoch, int step) {
+  lbann_comm *comm = m->get_comm();
+  // Partner copies of the last checkpoint must be stored and
+  // confirmed before it becomes the previous one
+  progress_replication(m, true);
+
+  // Write a distributed checkpoint to the memory filesystem. The last
+  // memory checkpoint is kept until copies of this one are confirmed.
+  El::Timer timer;
+  timer.Start();
+  const std::string dir = get_memory_dir();
+  makedir(dir.c_str());
+  const std::string epochdir = get_distributed_checkpoint_dirname(m, dir, epoch, step);
+  p.open_checkpoint(epochdir.c_str());
+  m->save_to_checkpoint_distributed(p);
+  p.close_checkpoint();
+  if (m_memory_step >= 0 && (m_memory_epoch != epoch || m_memory_step != step)) {
+    m_memory_prev_epoch = m_memory_epoch;
+    m_memory_prev_step = m_memory_step;
+    write_latest(get_previous_memory_checkpoint_filename(m, dir),
+                 m_memory_prev_epoch, m_memory_prev_step);
+  }
+  write_latest(get_last_memory_checkpoint_filename(m, dir), epoch, step);
+  m_memory_epoch = epoch;
+  m_memory_step = step;
+  const EvalType secs = timer.Stop();
+  const uint64_t bytes_count = p.get_bytes();
+  p.reset_bytes();
+
+  // Start sending the packed checkpoint to partners. The transfers
+  // overlap with training and are polled at the end of each step.
+  EvalType start_secs = 0;
+  if (!m_partner_dests.empty()) {
+    timer.Start();
+    pack_checkpoint(epochdir, epoch, step, m_partner_send_buffer);
+    m_partner_recv_buffers.resize(m_partner_sources.size());
+    std::vector<partner_transfer> sends, recvs;
+    for (size_t k = 0; k < m_partner_dests.size(); ++k) {
+      sends.push_back({m_partner_dests[k], (int) k, &m_partner_send_buffer});
+      recvs.push_back({m_partner_sources[k], (int) k, &m_partner_recv_buffers[k]});
+    }
+    start_partner_transfers(*comm, m_partner_comm, sends, recvs, m_partner_requests);
+    m_partner_start = MPI_Wtime();
+    start_secs = timer.Stop();
+  } else {
+    remove_previous_memory_checkpoint(m);
+  }
 
   if (comm->am_trainer_master()) {
-    EvalType secs = timer.Stop();
     EvalType bw = 0;
     if (secs > 0.0) {
       bw = EvalType(bytes_count) / (secs * 1024.0 * 1024.0);
     }
-    printf("[%s.%d] Checkpoint complete: Epoch=%d Step=%d (%f secs, %llu bytes, %f MB/sec)\n",
-           m->get_name().c_str(), comm->get_trainer_rank(), epoch, step, secs, (unsigned long long) bytes_count, bw);
+    printf("[%s.%d] Memory checkpoint complete: Epoch=%d Step=%d (%f secs, %llu bytes, %f MB/sec, %f secs to start copies to %d partners)\n",
+           m->get_name().c_str(), comm->get_trainer_rank(), epoch, step, secs, (unsigned long long) bytes_count, bw,
+           start_secs, (int) m_partner_dests.size());
+    fflush(stdout);
+  }
+}
+
+void checkpoint::progress_replication(model *m, bool wait) {
+  if (m_partner_requests.empty() && !m_partner_confirming) {
+    return;
+  }
+  lbann_comm *comm = m->get_comm();
+
+  if (!m_partner_requests.empty()) {
+    El::Timer timer;
+    timer.Start();
+    if (wait) {
+      comm->wait_all(m_partner_requests);
+    } else {
+      for (auto& req : m_partner_requests) {
+        if (!El::mpi::Test(req)) { return; }
+      }
+    }
+    m_partner_requests.clear();
+    const EvalType wait_secs = timer.Stop();
+    const EvalType secs = MPI_Wtime() - m_partner_start;
+
+    // Store partner copies in the memory filesystem. Copies of the
+    // previous checkpoint are kept until all ranks have stored theirs.
+    const std::string dir = get_memory_dir();
+    uint64_t bytes_count = 0;
+    for (size_t k = 0; k < m_partner_sources.size(); ++k) {
+      const auto filename = get_partner_checkpoint_filename(m, dir, m_partner_sources[k]);
+      std::rename(filename.c_str(), (filename + ".previous").c_str());
+      write_file(filename, m_partner_recv_buffers[k]);
+      bytes_count += m_partner_recv_buffers[k].size();
+    }
+    std::vector<char>().swap(m_partner_send_buffer);
+    std::vector<std::vector<char>>().swap(m_partner_recv_buffers);
+    MPI_Ibarrier(m_partner_comm.GetMPIComm(), &m_partner_confirm_request);
+    m_partner_confirming = true;
+
+    if (comm->am_trainer_master()) {
+      printf("[%s.%d] Memory checkpoint copies complete: Step=%d (%f secs, %llu bytes from %d partners, %f secs waiting)\n",
+             m->get_name().c_str(), comm->get_trainer_rank(), m_memory_step, secs, (unsigned long long) bytes_count,
+             (int) m_partner_sources.size(), wait_secs);
+      fflush(stdout);
+    }
+  }
+
+  // Once every rank has stored its copies, the last memory checkpoint
+  // can be rebuilt without the previous one
+  if (wait) {
+    MPI_Wait(&m_partner_confirm_request, MPI_STATUS_IGNORE);
+  } else {
+    int done = 0;
+    MPI_Test(&m_partner_confirm_request, &done, MPI_STATUS_IGNORE);
+    if (!done) { return; }
+  }
+  m_partner_confirming = false;
+  remove_previous_memory_checkpoint(m);
+}
+
+void checkpoint::remove_previous_memory_checkpoint(model *m) {
+  const std::string dir = get_memory_dir();
+  if (m_memory_prev_step >= 0
+      && (m_memory_prev_epoch != m_memory_epoch || m_memory_prev_step != m_memory_step)) {
+    remove_directory(get_distributed_checkpoint_dirname(m, dir, m_memory_prev_epoch, m_memory_prev_step));
+  }
+  m_memory_prev_epoch = -1;
+  m_memory_prev_step = -1;
+  std::remove(get_previous_memory_checkpoint_filename(m, dir).c_str());
+  for (const auto& source : m_partner_sources) {
+    std::remove((get_partner_checkpoint_filename(m, dir, source) + ".previous").c_str());
+  }
+}
+
+bool checkpoint::restart_from_memory(model *m, int min_step) {
+  lbann_comm *comm = m->get_comm();
+  const std::string dir = get_memory_dir();
+  const int rank = comm->get_rank_in_trainer();
+  const int procs = comm->get_procs_per_trainer();
+  const int num_slots = m_partner_sources.size();
+
+  // Each rank has its last memory checkpoint, and the previous one if
+  // copies of the last were not confirmed. Partner copies are kept
+  // the same way.
+  const std::string local_files[2] = {
+    get_last_memory_checkpoint_filename(m, dir),
+    get_previous_memory_checkpoint_filename(m, dir)
+  };
+  const std::string partner_suffixes[2] = {"", ".previous"};
+  int local_epochs[2], local_step_list[2];
+  for (int c = 0; c < 2; ++c) {
+    read_latest(local_files[c], &local_epochs[c], &local_step_list[c]);
+    if (local_step_list[c] >= 0
+        && !file::directory_exists(get_distributed_checkpoint_dirname(m, dir, local_epochs[c], local_step_list[c]))) {
+      local_epochs[c] = -1;
+      local_step_list[c] = -1;
+    }
+  }
+
+  // Steps of the local memory checkpoints of each rank, followed by
+  // the steps of the partner copies held for each rank
+  std::vector<int> local_steps(2 * procs * (num_slots + 1), -1);
+  std::vector<int> steps(local_steps.size());
+  const auto partner_index = [procs, num_slots](int r, int k, int c) {
+    return 2 * (procs + r * num_slots + k) + c;
+  };
+  for (int c = 0; c < 2; ++c) {
+    local_steps[2 * rank + c] = local_step_list[c];
+    for (int k = 0; k < num_slots; ++k) {
+      const int source = m_partner_sources[k];
+      int partner_epoch, partner_step;
+      if (read_packed_checkpoint_header(get_partner_checkpoint_filename(m, dir, source) + partner_suffixes[c],
+                                        partner_epoch, partner_step)) {
+        local_steps[partner_index(source, k, c)] = partner_step;
+      }
+    }
+  }
+  comm->trainer_allreduce(local_steps.data(), local_steps.size(), steps.data(),
+                          El::mpi::MAX);
+
+  // Use the most recent step that every rank has, or can rebuild from
+  // a partner copy. The k-th partner copy of a rank is held by its
+  // k-th destination.
+  std::vector<int> candidates;
+  for (const auto& s : steps) {
+    if (s >= 0 && s >= min_step) { candidates.push_back(s); }
+  }
+  std::sort(candidates.begin(), candidates.end(), std::greater<int>());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                   candidates.end());
+  int step = -1;
+  std::vector<int> slots(procs, -1), copies(procs, -1);
+  int num_rebuilt = 0;
+  for (const auto& candidate : candidates) {
+    std::fill(slots.begin(), slots.end(), -1);
+    std::fill(copies.begin(), copies.end(), -1);
+    num_rebuilt = 0;
+    int lost_rank = -1;
+    for (int r = 0; r < procs && lost_rank < 0; ++r) {
+      if (steps[2 * r] == candidate || steps[2 * r + 1] == candidate) { continue; }
+      for (int k = 0; k < num_slots && slots[r] < 0; ++k) {
+        for (int c = 0; c < 2 && slots[r] < 0; ++c) {
+          if (steps[partner_index(r, k, c)] == candidate) {
+            slots[r] = k;
+            copies[r] = c;
+          }
+        }
+      }
+      if (slots[r] < 0) {
+        lost_rank = r;
+      } else {
+        ++num_rebuilt;
+      }
+    }
+    if (lost_rank < 0) {
+      step = candidate;
+      break;
+    }
+    if (comm->am_trainer_master()) {
+      LBANN_WARNING("memory checkpoint at step ", candidate,
+                    " is lost on rank ", lost_rank);
+    }
+  }
+  if (step < 0) {
+    if (comm->am_trainer_master() && !candidates.empty()) {
+      LBANN_WARNING("no memory checkpoint can be rebuilt, falling back to filesystem checkpoints");
+    }
+    return false;
+  }
+
+  El::Timer timer;
+  if (comm->am_trainer_master()) {
+    timer.Start();
+    printf("Restart from memory: step %d ...\n", step);
+    fflush(stdout);
+  }
+
+  // Rebuild lost checkpoints from partner copies
+  int epoch = -1;
+  for (int c = 0; c < 2; ++c) {
+    if (local_step_list[c] == step) {
+      epoch = local_epochs[c];
+    }
+  }
+  if (num_rebuilt > 0) {
+    std::vector<std::vector<char>> send_buffers(num_slots);
+    std::vector<char> recv_buffer;
+    std::vector<partner_transfer> sends, recvs;
+    for (int k = 0; k < num_slots; ++k) {
+      const int source = m_partner_sources[k];
+      if (slots[source] == k) {
+        const auto filename = get_partner_checkpoint_filename(m, dir, source)
+                              + partner_suffixes[copies[source]];
+        if (!load_file(filename, send_buffers[k])) {
+          LBANN_ERROR("failed to read file (", filename, ")");
+        }
+        sends.push_back({source, k, &send_buffers[k]});
+      }
+    }
+    if (slots[rank] >= 0) {
+      recvs.push_back({m_partner_dests[slots[rank]], slots[rank], &recv_buffer});
+    }
+    std::vector<El::mpi::Request<El::byte>> requests;
+    start_partner_transfers(*comm, m_partner_comm, sends, recvs, requests);
+    comm->wait_all(requests);
+    if (slots[rank] >= 0) {
+      int recv_step;
+      unpack_checkpoint_header(recv_buffer, epoch, recv_step);
+      if (recv_step != step) {
+        LBANN_ERROR("partner copy is at step ", recv_step, " instead of ", step);
+      }
+      makedir(dir.c_str());
+      unpack_checkpoint(recv_buffer, get_distributed_checkpoint_dirname(m, dir, epoch, step));
+    }
+  }
+
+  // Only the checkpoint being restarted from is kept
+  for (int c = 0; c < 2; ++c) {
+    if (local_step_list[c] >= 0 && local_step_list[c] != step) {
+      remove_directory(get_distributed_checkpoint_dirname(m, dir, local_epochs[c], local_step_list[c]));
+    }
+  }
+  write_latest(local_files[0], epoch, step);
+  std::remove(local_files[1].c_str());
+  m_memory_epoch = epoch;
+  m_memory_step = step;
+  m_memory_prev_epoch = -1;
+  m_memory_prev_step = -1;
+
+  const std::string epochdir = get_distributed_checkpoint_dirname(m, dir, epoch, step);
+  p.open_restart(epochdir.c_str());
+  m->load_from_checkpoint_distributed(p);
+  p.close_restart();
+
+  uint64_t bytes_count = p.get_bytes();
+  if (comm->am_trainer_master()) {
+    EvalType secs = timer.Stop();
+    EvalType bw = 0.0;
+    if (secs > 0.0) {
+      bw = EvalType(bytes_count) / (secs * 1024.0 * 1024.0);
+    }
+    printf("[%s.%d] Restart from memory complete: Epoch=%d Step=%d (%f secs, %llu bytes, %f MB/sec, %d ranks rebuilt from partners)\n",
+           m->get_name().c_str(), comm->get_trainer_rank(), epoch, step, secs, (unsigned long long) bytes_count, bw,
+           num_rebuilt);
     fflush(stdout);
   }
-  // record last checkpoint time in case checkpoint_secs interval defined.
-  m_checkpoint_last = MPI_Wtime();
   p.reset_bytes();
   return true;
 }
 
 // Restart Shared/Distributed
 bool checkpoint::restart(model *m) {
-  // if the checkpoint directory is not defined, bail
+  // if the checkpoint directory is not defined, only the memory
+  // level can be restarted from
   if (m_checkpoint_dir.length() == 0 &&  m_per_rank_dir.length() == 0) {
-    return false;
+    return (m_ckpt_memory_steps > 0 && restart_from_memory(m, -1));
   }
   constexpr unsigned int max_len_dirname = 1024;
   // get top level directory
@@ -279,6 +948,12 @@ bool checkpoint::restart(model *m) {
   comm->trainer_broadcast(0, &(dir[0]), sizeof(dir));
 #endif
 
+  // Memory checkpoints are preferred unless a filesystem checkpoint
+  // is more recent
+  if (m_ckpt_memory_steps > 0 && restart_from_memory(m, step)) {
+    return true;
+  }
+
   // if we couldn't find the latest epoch, just return
   if (epoch < 0) {
     return false;
@@ -341,7 +1016,13 @@ build_checkpoint_callback_from_pbuf(
                                                 params.checkpoint_secs(),
                                                 params.per_rank_dir(),
                                                 params.ckpt_dist_epochs(),
-                                                params.ckpt_dist_steps());
+                                                params.ckpt_dist_steps(),
+                                                params.ckpt_memory_steps(),
+                                                (params.memory_dir().empty()
+                                                 ? "/dev/shm"
+                                                 : params.memory_dir()),
+                                                std::max<int64_t>(params.num_partners(), 1),
+                                                params.ckpt_dist_full_interval());
 }
 
 } // namespace callback
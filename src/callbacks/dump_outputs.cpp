@@ -25,11 +25,14 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "lbann/callbacks/dump_outputs.hpp"
+#include "lbann/layers/io/input/generic_input_layer.hpp"
 #include "lbann/proto/proto_common.hpp"
 #include "lbann/utils/file_utils.hpp"
 
 #include <callbacks.pb.h>
 
+#include <algorithm>
+
 #ifdef LBANN_HAS_CNPY
 #include <cnpy.h>
 #endif // LBANN_HAS_CNPY
@@ -95,18 +98,26 @@ void save_npz(const std::string& file_name,
 #endif // LBANN_HAS_CNPY
 }
 
+/** Bytes of stream chunks waiting to be written before output dumps
+ *  block.
+ */
+constexpr size_t max_stream_queued_bytes = 256 << 20;
+
 } // namespace
 
 dump_outputs::dump_outputs(std::set<std::string> layer_names,
                            std::set<execution_mode> modes,
                            El::Int batch_interval,
                            std::string directory,
-                           std::string file_format)
+                           std::string file_format,
+                           El::Int stream_file_size)
   : callback_base(std::max(batch_interval, El::Int(1))),
     m_layer_names(std::move(layer_names)),
     m_modes(std::move(modes)),
     m_directory(std::move(directory)),
-    m_file_format(std::move(file_format)) {
+    m_file_format(std::move(file_format)),
+    m_stream_file_size((stream_file_size > 0 ? stream_file_size : 1024)
+                       * size_t(1 << 20)) {
   std::stringstream err;
 
   // Initialize directory for output files
@@ -126,7 +137,8 @@ dump_outputs::dump_outputs(std::set<std::string> layer_names,
   }
 #endif // LBANN_HAS_CNPY
   if (m_file_format != "csv" && m_file_format != "tsv"
-      && m_file_format != "npy" && m_file_format != "npz") {
+      && m_file_format != "npy" && m_file_format != "npz"
+      && m_file_format != "stream") {
     err << "callback \"" << this->name() << "\" attempted "
         << "to use invalid file format (" << m_file_format << ")";
     LBANN_ERROR(err.str());
@@ -134,6 +146,27 @@ dump_outputs::dump_outputs(std::set<std::string> layer_names,
 
 }
 
+dump_outputs::dump_outputs(const dump_outputs& other)
+  : callback_base(other),
+    m_layer_names(other.m_layer_names),
+    m_modes(other.m_modes),
+    m_directory(other.m_directory),
+    m_file_format(other.m_file_format),
+    m_stream_file_size(other.m_stream_file_size) {}
+
+dump_outputs& dump_outputs::operator=(const dump_outputs& other) {
+  callback_base::operator=(other);
+  m_layer_names = other.m_layer_names;
+  m_modes = other.m_modes;
+  m_directory = other.m_directory;
+  m_file_format = other.m_file_format;
+  m_stream_file_size = other.m_stream_file_size;
+  m_stream_writer.reset();
+  m_stream_chunks.clear();
+  m_stream_buffer.reset();
+  return *this;
+}
+
 void dump_outputs::do_dump_outputs(const model& m, const Layer& l) {
 
   // Get mini-batch step information
@@ -146,6 +179,12 @@ void dump_outputs::do_dump_outputs(const model& m, const Layer& l) {
   if (!m_layer_names.empty()
       && m_layer_names.count(l.get_name()) == 0) { return; }
 
+  // Stream outputs from all processes
+  if (m_file_format == "stream") {
+    do_stream_outputs(m, l);
+    return;
+  }
+
   // Create directory
   file::make_directory(m_directory);
 
@@ -179,6 +218,110 @@ void dump_outputs::do_dump_outputs(const model& m, const Layer& l) {
 
 }
 
+void dump_outputs::do_stream_outputs(const model& m, const Layer& l) {
+
+  // Create writer with a tensor for each output of each dumped layer
+  if (m_stream_writer == nullptr) {
+    std::vector<output_stream_tensor> tensors;
+    for (const auto* layer : m.get_layers()) {
+      if (!m_layer_names.empty()
+          && m_layer_names.count(layer->get_name()) == 0) { continue; }
+      for (int i = 0; i < layer->get_num_children(); ++i) {
+        output_stream_tensor t;
+        t.layer_name = layer->get_name();
+        t.output_index = i;
+        t.dims = layer->get_output_dims(i);
+        tensors.emplace_back(std::move(t));
+      }
+    }
+    file::make_directory(m_directory);
+    const auto& comm = *m.get_comm();
+    const std::string file_prefix = (m_directory
+                                     + m.get_name()
+                                     + "-trainer" + std::to_string(comm.get_trainer_rank())
+                                     + "-rank" + std::to_string(comm.get_rank_in_trainer()));
+    m_stream_writer.reset(new output_stream_writer(file_prefix,
+                                                   std::move(tensors),
+                                                   m_stream_file_size,
+                                                   max_stream_queued_bytes));
+  }
+  const auto& tensors = m_stream_writer->get_tensors();
+
+  // Copy local outputs into chunks
+  // Note: Local columns of data-parallel matrices are the process's
+  // mini-batch samples, in the order they were fetched.
+  for (int i = 0; i < l.get_num_children(); ++i) {
+    int tensor = 0;
+    while (tensor < (int) tensors.size()
+           && (tensors[tensor].layer_name != l.get_name()
+               || tensors[tensor].output_index != i)) {
+      ++tensor;
+    }
+    const AbsDistMat* data = &l.get_activations(i);
+    if (data->ColDist() != El::STAR
+        || data->RowDist() != El::VC
+        || data->GetLocalDevice() != El::Device::CPU) {
+      if (m_stream_buffer == nullptr) {
+        m_stream_buffer.reset(new StarVCMat<El::Device::CPU>(data->Grid()));
+      }
+      El::Copy(*data, *m_stream_buffer);
+      data = m_stream_buffer.get();
+    }
+    const auto& local_data = data->LockedMatrix();
+    const El::Int local_height = local_data.Height();
+    const El::Int local_width = local_data.Width();
+    auto chunk = m_stream_writer->get_chunk();
+    chunk->tensor = tensor;
+    chunk->mode = m.get_execution_mode();
+    chunk->epoch = m.get_epoch();
+    chunk->step = m.get_step();
+    chunk->values.resize(local_height * local_width);
+    LBANN_OMP_PARALLEL_FOR
+    for (El::Int col = 0; col < local_width; ++col) {
+      std::copy(local_data.LockedBuffer(0, col),
+                local_data.LockedBuffer(0, col) + local_height,
+                &chunk->values[col * local_height]);
+    }
+    m_stream_chunks.emplace_back(std::move(chunk));
+  }
+
+}
+
+void dump_outputs::write_stream_chunks(const model& m) {
+  if (m_stream_chunks.empty()) { return; }
+
+  // Sample indices of local mini-batch samples
+  const El::Matrix<El::Int>* indices = nullptr;
+  for (auto* l : m.get_layers()) {
+    if (dynamic_cast<generic_input_layer*>(l) != nullptr) {
+      indices = l->get_sample_indices_per_mb();
+      break;
+    }
+  }
+
+  // Queue chunks
+  for (auto& chunk : m_stream_chunks) {
+    const auto& tensor_size = m_stream_writer->get_tensors()[chunk->tensor].get_size();
+    const El::Int num_samples = (tensor_size > 0 ?
+                                 chunk->values.size() / tensor_size :
+                                 0);
+    chunk->indices.resize(num_samples, El::Int(-1));
+    if (indices != nullptr) {
+      const El::Int num_indices = std::min(num_samples, indices->Height());
+      for (El::Int j = 0; j < num_indices; ++j) {
+        chunk->indices[j] = indices->Get(j, 0);
+      }
+    }
+    m_stream_writer->write(std::move(chunk));
+  }
+  m_stream_chunks.clear();
+
+}
+
+void dump_outputs::flush_stream() {
+  if (m_stream_writer != nullptr) { m_stream_writer->flush(); }
+}
+
 std::unique_ptr<callback_base>
 build_dump_outputs_callback_from_pbuf(
   const google::protobuf::Message& proto_msg, const std::shared_ptr<lbann_summary>&) {
@@ -191,7 +334,8 @@ build_dump_outputs_callback_from_pbuf(
                                                   modes,
                                                   params.batch_interval(),
                                                   params.directory(),
-                                                  params.format());
+                                                  params.format(),
+                                                  params.stream_file_size());
 }
 
 } // namespace callback
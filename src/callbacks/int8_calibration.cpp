@@ -0,0 +1,231 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/callbacks/int8_calibration.hpp"
+#include "lbann/proto/proto_common.hpp"
+#include "lbann/utils/timer.hpp"
+
+#include <callbacks.pb.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+namespace lbann {
+namespace callback {
+
+int8_calibration::int8_calibration(El::Int num_batches,
+                                   std::set<std::string> layer_names)
+  : callback_base(),
+    m_num_batches(std::max(num_batches, El::Int(1))),
+    m_layer_names(std::move(layer_names)) {}
+
+bool int8_calibration::is_selected(const Layer& l) const {
+  if (!l.supports_int8_quantization()) { return false; }
+  return m_layer_names.empty() || m_layer_names.count(l.get_name()) > 0;
+}
+
+void int8_calibration::on_batch_begin(model* m) {
+  if (!m_input_ranges.empty() || m_quantized) { reset(*m); }
+}
+
+void int8_calibration::on_evaluate_forward_prop_begin(model* m) {
+  m_fp_start_time = get_time();
+  m_calibration_time = 0;
+}
+
+void int8_calibration::on_evaluate_forward_prop_end(model* m, Layer* l) {
+  if (m_quantized || !is_selected(*l)) { return; }
+  const auto start_time = get_time();
+
+  // Largest absolute value in each input channel
+  // Note: Each column of a data-parallel input is a full sample.
+  // Other distributions split samples between processes, so local
+  // rows would not line up with channels.
+  const auto& input = l->get_prev_activations();
+  const auto dist = input.DistData();
+  if (dist.colDist != El::STAR || dist.rowDist != El::VC) {
+    LBANN_ERROR("int8 calibration expects data-parallel input to layer \"",
+                l->get_name(), "\"");
+  }
+  const auto& local_input = input.LockedMatrix();
+  const El::Int num_channels = l->get_input_dims()[0];
+  const El::Int channel_size = l->get_input_size() / num_channels;
+  auto& ranges = m_input_ranges[l->get_name()];
+  ranges.resize(num_channels, DataType(0));
+  const El::Int local_width = local_input.Width();
+  LBANN_OMP_PARALLEL_FOR
+  for (El::Int channel = 0; channel < num_channels; ++channel) {
+    auto range = ranges[channel];
+    for (El::Int col = 0; col < local_width; ++col) {
+      const auto* x = local_input.LockedBuffer(channel * channel_size, col);
+      for (El::Int i = 0; i < channel_size; ++i) {
+        range = std::max(range, std::fabs(x[i]));
+      }
+    }
+    ranges[channel] = range;
+  }
+
+  m_calibration_time += get_time() - start_time;
+}
+
+void int8_calibration::on_evaluate_forward_prop_end(model* m) {
+  auto& stats = (m_quantized ?
+                 m_int8_statistics :
+                 m_full_precision_statistics);
+  stats.time += get_time() - m_fp_start_time - m_calibration_time;
+}
+
+void int8_calibration::on_batch_evaluate_end(model* m) {
+  auto& stats = (m_quantized ?
+                 m_int8_statistics :
+                 m_full_precision_statistics);
+  ++stats.num_batches;
+  stats.num_samples += m->get_current_mini_batch_size();
+
+  // Metric values of this mini-batch, from the change in each
+  // metric's statistics
+  // Note: Statistics are reset at the start of each evaluation.
+  const auto mode = m->get_execution_mode();
+  const auto& metrics = m->get_metrics();
+  if (mode != m_metric_mode) {
+    m_metric_num_samples.clear();
+    m_metric_mode = mode;
+  }
+  m_metric_num_samples.resize(metrics.size(), 0);
+  m_metric_totals.resize(metrics.size(), EvalType(0));
+  stats.metric_sums.resize(metrics.size(), EvalType(0));
+  for (size_t i = 0; i < metrics.size(); ++i) {
+    const auto& num_samples = metrics[i]->get_statistics_num_samples(mode);
+    const EvalType total = (num_samples > 0 ?
+                            metrics[i]->get_mean_value(mode) * num_samples :
+                            EvalType(0));
+    if (num_samples < m_metric_num_samples[i]) {
+      m_metric_totals[i] = EvalType(0);
+    }
+    stats.metric_sums[i] += total - m_metric_totals[i];
+    m_metric_num_samples[i] = num_samples;
+    m_metric_totals[i] = total;
+  }
+
+  if (!m_quantized
+      && m_full_precision_statistics.num_batches >= m_num_batches) {
+    quantize(*m);
+  } else if (m_quantized && !m_reported
+             && (m_int8_statistics.num_batches
+                 >= m_full_precision_statistics.num_batches)) {
+    report(*m);
+    m_reported = true;
+  }
+}
+
+void int8_calibration::quantize(model& m) {
+  auto* comm = m.get_comm();
+  const bool master = comm->am_world_master();
+  for (auto* l : m.get_layers()) {
+    if (!is_selected(*l) || m_input_ranges.count(l->get_name()) == 0) {
+      continue;
+    }
+    auto& ranges = m_input_ranges[l->get_name()];
+    comm->allreduce(ranges.data(), ranges.size(),
+                    comm->get_trainer_comm(), El::mpi::MAX);
+    l->quantize_int8(ranges);
+    if (master) {
+      const auto& weights_ranges = l->get_int8_gemm()->get_weights_ranges();
+      const auto input_minmax = std::minmax_element(ranges.begin(),
+                                                    ranges.end());
+      const auto weights_minmax = std::minmax_element(weights_ranges.begin(),
+                                                      weights_ranges.end());
+      std::cout << "model \"" << m.get_name() << "\" "
+                << "quantized " << l->get_type() << " "
+                << "layer \"" << l->get_name() << "\" to int8 "
+                << "(" << ranges.size() << " input channels "
+                << "with ranges in [" << *input_minmax.first << ", "
+                << *input_minmax.second << "], "
+                << weights_ranges.size() << " weights rows "
+                << "with ranges in [" << *weights_minmax.first << ", "
+                << *weights_minmax.second << "])" << std::endl;
+    }
+  }
+  m_quantized = true;
+}
+
+void int8_calibration::reset(model& m) {
+  for (auto* l : m.get_layers()) {
+    if (is_selected(*l)) { l->clear_int8_quantization(); }
+  }
+  m_input_ranges.clear();
+  m_quantized = false;
+  m_reported = false;
+  m_full_precision_statistics = phase_statistics();
+  m_int8_statistics = phase_statistics();
+}
+
+void int8_calibration::report(model& m) const {
+  if (!m.get_comm()->am_world_master()) { return; }
+  const auto& metrics = m.get_metrics();
+  const auto& full = m_full_precision_statistics;
+  const auto& int8 = m_int8_statistics;
+  std::stringstream msg;
+  msg << "model \"" << m.get_name() << "\" "
+      << "int8 inference over " << int8.num_batches << " mini-batches "
+      << "vs. full precision over " << full.num_batches << " mini-batches"
+      << std::endl;
+  for (size_t i = 0; i < metrics.size() && i < int8.metric_sums.size(); ++i) {
+    const EvalType full_value = full.metric_sums[i] / std::max(full.num_samples, El::Int(1));
+    const EvalType int8_value = int8.metric_sums[i] / std::max(int8.num_samples, El::Int(1));
+    msg << "  " << metrics[i]->name() << " : "
+        << int8_value << metrics[i]->get_unit() << " vs. "
+        << full_value << metrics[i]->get_unit() << " "
+        << "(delta " << int8_value - full_value << ")" << std::endl;
+  }
+  const EvalType full_throughput = (full.time > EvalType(0) ?
+                                    full.num_samples / full.time :
+                                    EvalType(0));
+  const EvalType int8_throughput = (int8.time > EvalType(0) ?
+                                    int8.num_samples / int8.time :
+                                    EvalType(0));
+  msg << "  forward prop throughput : "
+      << int8_throughput << " samples/sec vs. "
+      << full_throughput << " samples/sec";
+  if (full_throughput > EvalType(0)) {
+    msg << " (" << std::setprecision(3)
+        << int8_throughput / full_throughput << "x)";
+  }
+  std::cout << msg.str() << std::endl;
+}
+
+std::unique_ptr<callback_base>
+build_int8_calibration_callback_from_pbuf(
+  const google::protobuf::Message& proto_msg, const std::shared_ptr<lbann_summary>&) {
+  const auto& params =
+    dynamic_cast<const lbann_data::Callback::CallbackInt8Calibration&>(proto_msg);
+  const auto& layer_names = parse_set<std::string>(params.layers());
+  return make_unique<int8_calibration>(params.num_batches(), layer_names);
+}
+
+} // namespace callback
+} // namespace lbann
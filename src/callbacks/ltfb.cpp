@@ -33,6 +33,7 @@
 
 #include <callbacks.pb.h>
 
+#include <algorithm>
 #include <sstream>
 #include <string>
 #include <tuple>
@@ -197,6 +198,218 @@ void exchange_models__sendrecv_weights(lbann_comm& comm,
 
 }
 
+/** Whether weights are exchanged with partner trainer. */
+bool is_exchanged(const std::set<std::string>& weights_names,
+                  const weights& w) {
+  return (weights_names.empty()
+          || weights_names.count(w.get_name()) > 0);
+}
+
+/** Local matrices in a model snapshot.
+ *
+ *  The snapshot of a weights object contains its values and the
+ *  state of its optimizer. Partner trainers are assumed to have
+ *  identical models, so both sides agree on the layout.
+ */
+std::vector<AbsMat*> get_snapshot_matrices(const std::set<std::string>& weights_names,
+                                           const std::vector<weights*>& weights_list) {
+  std::vector<AbsMat*> mats;
+  for (auto* w : weights_list) {
+    if (!is_exchanged(weights_names, *w)) { continue; }
+    mats.push_back(&w->get_values().Matrix());
+    auto* opt = w->get_optimizer();
+    auto* opt_sgd = dynamic_cast<sgd*>(opt);
+    if (opt_sgd != nullptr) {
+      mats.push_back(&opt_sgd->get_velocity().Matrix());
+    }
+    auto* opt_adam = dynamic_cast<adam*>(opt);
+    if (opt_adam != nullptr) {
+      mats.push_back(&opt_adam->get_moment1().Matrix());
+      mats.push_back(&opt_adam->get_moment2().Matrix());
+    }
+  }
+  return mats;
+}
+
+/** Optimizer hyperparameters in a model snapshot. */
+std::vector<DataType> get_snapshot_hyperparameters(const std::set<std::string>& weights_names,
+                                                   const std::vector<weights*>& weights_list) {
+  std::vector<DataType> hyperparameters;
+  for (auto* w : weights_list) {
+    if (!is_exchanged(weights_names, *w)) { continue; }
+    const auto* opt = w->get_optimizer();
+    const auto* opt_sgd = dynamic_cast<const sgd*>(opt);
+    if (opt_sgd != nullptr) {
+      hyperparameters.push_back(opt_sgd->get_learning_rate());
+      hyperparameters.push_back(opt_sgd->get_momentum());
+      hyperparameters.push_back(opt_sgd->using_nesterov() ? 1 : 0);
+    }
+    const auto* opt_adam = dynamic_cast<const adam*>(opt);
+    if (opt_adam != nullptr) {
+      hyperparameters.push_back(opt_adam->get_learning_rate());
+      hyperparameters.push_back(opt_adam->get_beta1());
+      hyperparameters.push_back(opt_adam->get_beta2());
+      hyperparameters.push_back(opt_adam->get_eps());
+      hyperparameters.push_back(opt_adam->get_current_beta1());
+      hyperparameters.push_back(opt_adam->get_current_beta2());
+    }
+  }
+  return hyperparameters;
+}
+
+/** Apply hyperparameters received in a model snapshot. */
+void set_snapshot_hyperparameters(const std::set<std::string>& weights_names,
+                                  const std::vector<weights*>& weights_list,
+                                  const DataType* hyperparameters) {
+  for (auto* w : weights_list) {
+    if (!is_exchanged(weights_names, *w)) { continue; }
+    auto* opt = w->get_optimizer();
+    auto* opt_sgd = dynamic_cast<sgd*>(opt);
+    if (opt_sgd != nullptr) {
+      opt_sgd->set_learning_rate(*hyperparameters++);
+      opt_sgd->set_momentum(*hyperparameters++);
+      opt_sgd->set_nesterov(*hyperparameters++ != DataType(0));
+    }
+    auto* opt_adam = dynamic_cast<adam*>(opt);
+    if (opt_adam != nullptr) {
+      opt_adam->set_learning_rate(*hyperparameters++);
+      opt_adam->set_beta1(*hyperparameters++);
+      opt_adam->set_beta2(*hyperparameters++);
+      opt_adam->set_eps(*hyperparameters++);
+      opt_adam->set_current_beta1(*hyperparameters++);
+      opt_adam->set_current_beta2(*hyperparameters++);
+    }
+  }
+}
+
+/** Largest snapshot message posted with a single MPI call (in bytes). */
+constexpr size_t max_snapshot_message_size = size_t(1) << 30;
+/** MPI tag for snapshot messages. */
+constexpr int snapshot_message_tag = 7781;
+
+/** Non-blocking exchange of a packed model snapshot.
+ *
+ *  All exchanged weights values, optimizer state, and (optionally)
+ *  hyperparameters are packed into one buffer, which is sent to the
+ *  corresponding rank in the partner trainer with non-blocking
+ *  sends. Receives are posted at the same time, so the transfer can
+ *  proceed while the local model is evaluated.
+ */
+class snapshot_exchange {
+public:
+
+  snapshot_exchange(lbann_comm& comm,
+                    El::Int partner_trainer,
+                    const std::set<std::string>& weights_names,
+                    const std::vector<weights*>& local_weights,
+                    bool exchange_hyperparameters)
+    : m_weights_names(weights_names),
+      m_exchange_hyperparameters(exchange_hyperparameters) {
+    const auto start = get_time();
+
+    // Pack local model data
+    const auto mats = get_snapshot_matrices(weights_names, local_weights);
+    std::vector<DataType> hyperparameters;
+    if (exchange_hyperparameters) {
+      hyperparameters = get_snapshot_hyperparameters(weights_names,
+                                                     local_weights);
+    }
+    size_t size = hyperparameters.size();
+    for (const auto* mat : mats) {
+      size += mat->Height() * mat->Width();
+    }
+    m_send_buffer.resize(size);
+    m_recv_buffer.resize(size);
+    size_t offset = 0;
+    for (const auto* mat : mats) {
+      CPUMat packed(mat->Height(), mat->Width(),
+                    m_send_buffer.data() + offset,
+                    std::max(mat->Height(), El::Int(1)));
+      El::Copy(*mat, packed);
+      offset += mat->Height() * mat->Width();
+    }
+    std::copy(hyperparameters.begin(), hyperparameters.end(),
+              m_send_buffer.begin() + offset);
+
+    // Post sends and receives to partner process
+    const El::Int partner_rank_in_world
+      = (partner_trainer * comm.get_procs_per_trainer()
+         + comm.get_rank_in_trainer());
+    const auto mpi_comm = comm.get_world_comm().GetMPIComm();
+    const size_t bytes = size * sizeof(DataType);
+    auto* send_ptr = reinterpret_cast<char*>(m_send_buffer.data());
+    auto* recv_ptr = reinterpret_cast<char*>(m_recv_buffer.data());
+    for (size_t pos = 0; pos < bytes; pos += max_snapshot_message_size) {
+      const int count = std::min(bytes - pos, max_snapshot_message_size);
+      m_requests.emplace_back();
+      MPI_Irecv(recv_ptr + pos, count, MPI_BYTE, partner_rank_in_world,
+                snapshot_message_tag, mpi_comm, &m_requests.back());
+      m_requests.emplace_back();
+      MPI_Isend(send_ptr + pos, count, MPI_BYTE, partner_rank_in_world,
+                snapshot_message_tag, mpi_comm, &m_requests.back());
+    }
+    m_bytes = bytes;
+    m_post_time = get_time() - start;
+    m_start_time = start;
+  }
+
+  /** Wait for partner data and unpack it into model. */
+  void finish(const std::vector<weights*>& model_weights) {
+    const auto start = get_time();
+    MPI_Waitall(m_requests.size(), m_requests.data(), MPI_STATUSES_IGNORE);
+    m_requests.clear();
+    m_send_buffer.clear();
+    const auto wait_end = get_time();
+
+    // Unpack partner model data
+    size_t offset = 0;
+    for (auto* mat : get_snapshot_matrices(m_weights_names, model_weights)) {
+      const CPUMat packed(mat->Height(), mat->Width(),
+                          m_recv_buffer.data() + offset,
+                          std::max(mat->Height(), El::Int(1)));
+      El::Copy(packed, *mat);
+      offset += mat->Height() * mat->Width();
+    }
+    if (m_exchange_hyperparameters) {
+      set_snapshot_hyperparameters(m_weights_names,
+                                   model_weights,
+                                   m_recv_buffer.data() + offset);
+    }
+    m_recv_buffer.clear();
+
+    const auto end = get_time();
+    m_wait_time = wait_end - start;
+    m_exposed_time = m_post_time + (end - start);
+    m_total_time = end - m_start_time;
+  }
+
+  /** Bytes sent to partner process. */
+  size_t get_bytes() const { return m_bytes; }
+  /** Time from packing until partner data is unpacked. */
+  double get_total_time() const { return m_total_time; }
+  /** Time spent waiting for communication to complete. */
+  double get_wait_time() const { return m_wait_time; }
+  /** Time spent packing, waiting, and unpacking. */
+  double get_exposed_time() const { return m_exposed_time; }
+
+private:
+
+  std::set<std::string> m_weights_names;
+  bool m_exchange_hyperparameters;
+
+  std::vector<DataType> m_send_buffer;
+  std::vector<DataType> m_recv_buffer;
+  std::vector<MPI_Request> m_requests;
+
+  size_t m_bytes = 0;
+  double m_start_time = 0;
+  double m_post_time = 0;
+  double m_wait_time = 0;
+  double m_exposed_time = 0;
+  double m_total_time = 0;
+
+};
+
 void exchange_models__checkpoint_file(lbann_comm& comm,
                                       El::Int partner_trainer,
                                       model& m,
@@ -433,12 +646,6 @@ void ltfb::on_batch_begin(model *m) {
   const El::Int partner_trainer
     = get_partner_trainer(comm, message_prefix);
 
-  // Evaluate local model
-  if (comm.am_world_master()) {
-    std::cout << message_prefix + "evaluating local model...\n";
-  }
-  const auto local_score = evaluate(*m, m_metric_name);
-
   // Store local model data
   auto&& model_weights = m->get_weights();
   std::vector<weights*> local_weights;
@@ -447,11 +654,40 @@ void ltfb::on_batch_begin(model *m) {
     *local_weights[i] = *model_weights[i];
   }
 
+  // Start sending model data to partner trainer
+  // Note: Snapshot exchange overlaps with local model evaluation.
+  std::unique_ptr<snapshot_exchange> snapshot;
+  if (m_comm_algo == communication_algorithm::sendrecv_snapshot) {
+    snapshot = make_unique<snapshot_exchange>(comm,
+                                              partner_trainer,
+                                              m_weights_names,
+                                              local_weights,
+                                              m_exchange_hyperparameters);
+  }
+
+  // Evaluate local model
+  if (comm.am_world_master()) {
+    std::cout << message_prefix + "evaluating local model...\n";
+  }
+  const auto local_score = evaluate(*m, m_metric_name);
+
   // Exchange model data with partner trainer
   if (comm.am_world_master()) {
     std::cout << message_prefix + "exchanging model data...\n";
   }
   switch (m_comm_algo) {
+  case communication_algorithm::sendrecv_snapshot:
+    snapshot->finish(model_weights);
+    if (comm.am_world_master()) {
+      std::stringstream msg;
+      msg << message_prefix
+          << "exchanged " << snapshot->get_bytes() << " bytes per process "
+          << "in " << snapshot->get_total_time() << "s "
+          << "(" << snapshot->get_exposed_time() << "s not overlapped, "
+          << snapshot->get_wait_time() << "s waiting)\n";
+      std::cout << msg.str();
+    }
+    break;
   case communication_algorithm::sendrecv_weights:
     exchange_models__sendrecv_weights(comm,
                                       partner_trainer,
@@ -485,6 +721,7 @@ void ltfb::on_batch_begin(model *m) {
     tournament_winner = local_trainer;
     switch (m_comm_algo) {
     case communication_algorithm::sendrecv_weights:
+    case communication_algorithm::sendrecv_snapshot:
       for (size_t i = 0; i < model_weights.size(); ++i) {
         *model_weights[i] = *local_weights[i];
       }
@@ -517,6 +754,9 @@ ltfb::string_to_comm_algo(const std::string& str) {
   if (str.empty() || str == "sendrecv_weights") {
     return communication_algorithm::sendrecv_weights;
   }
+  if (str == "sendrecv_snapshot") {
+    return communication_algorithm::sendrecv_snapshot;
+  }
   if (str == "checkpoint_file") {
     return communication_algorithm::checkpoint_file;
   }
@@ -162,92 +162,105 @@ void print_statistics::report_results(model *m) {
   if (comm->am_trainer_master()) {
     const int num_trainers = comm->get_num_trainers();
 
-    // Report objective function value
-    const EvalType obj_fn = m->get_objective_function()->get_mean_value(mode);
-    const int obj_fn_samples = m->get_objective_function()->get_statistics_num_samples(mode);
-    if (comm->am_world_master()) {
-      std::vector<EvalType> obj_fn_list(comm->get_num_trainers());
-      std::vector<int> num_samples_list(comm->get_num_trainers());
-      comm->intertrainer_gather(obj_fn, obj_fn_list);
-      comm->intertrainer_gather(obj_fn_samples, num_samples_list);
-      if(!m_print_global_stat_only) {
-        for (int i = 0; i < num_trainers; ++i) {
-          std::cout << m->get_name() << " (instance " <<  i <<  ") "  << mode_string << " "
-                    << "objective function : " << obj_fn_list[i]
-                    << std::endl;
-        }
+    // Gather objective function and metric statistics from all
+    // trainers at once
+    // Note: Each trainer sends the mean value and number of samples
+    // of the objective function followed by those of each metric.
+    const auto& metrics = m->get_metrics();
+    const int num_values = 2 * (metrics.size() + 1);
+    std::vector<EvalType> local_values;
+    local_values.reserve(num_values);
+    local_values.push_back(m->get_objective_function()->get_mean_value(mode));
+    local_values.push_back(m->get_objective_function()->get_statistics_num_samples(mode));
+    for (const auto& met : metrics) {
+      local_values.push_back(met->get_mean_value(mode));
+      local_values.push_back(met->get_statistics_num_samples(mode));
+    }
+    if (!comm->am_world_master()) {
+      comm->intertrainer_gather(local_values.data(), num_values,
+                                comm->get_intertrainer_master());
+      return;
+    }
+    std::vector<EvalType> values(num_trainers * num_values);
+    comm->intertrainer_gather(local_values.data(), num_values, values.data());
+    std::vector<EvalType> value_list(num_trainers);
+    std::vector<int> num_samples_list(num_trainers);
+    const auto& get_lists = [&] (int offset) {
+      for (int i = 0; i < num_trainers; ++i) {
+        value_list[i] = values[i * num_values + offset];
+        num_samples_list[i] = values[i * num_values + offset + 1];
       }
-      if (num_trainers > 1) {
-        const EvalType avg_obj_fn = (std::inner_product(num_samples_list.begin(),
-                                                        num_samples_list.end(),
-                                                        obj_fn_list.begin(),
-                                                        EvalType(0))
-                                     / std::accumulate(num_samples_list.begin(),
-                                                       num_samples_list.end(),
-                                                       0));
-        std::cout << m->get_name() << " global average " << mode_string << " "
-                  << "objective function : " << avg_obj_fn
+    };
+
+    // Report objective function value
+    get_lists(0);
+    const auto& obj_fn_list = value_list;
+    if(!m_print_global_stat_only) {
+      for (int i = 0; i < num_trainers; ++i) {
+        std::cout << m->get_name() << " (instance " <<  i <<  ") "  << mode_string << " "
+                  << "objective function : " << obj_fn_list[i]
                   << std::endl;
       }
-    } else {
-      comm->intertrainer_gather(obj_fn, comm->get_world_master());
-      comm->intertrainer_gather(obj_fn_samples, comm->get_world_master());
+    }
+    if (num_trainers > 1) {
+      const EvalType avg_obj_fn = (std::inner_product(num_samples_list.begin(),
+                                                      num_samples_list.end(),
+                                                      obj_fn_list.begin(),
+                                                      EvalType(0))
+                                   / std::accumulate(num_samples_list.begin(),
+                                                     num_samples_list.end(),
+                                                     0));
+      std::cout << m->get_name() << " global average " << mode_string << " "
+                << "objective function : " << avg_obj_fn
+                << std::endl;
     }
 
     // Report score for each metric
-    for (const auto& met : m->get_metrics()) {
-      const EvalType score = met->get_mean_value(mode);
-      const int score_samples = met->get_statistics_num_samples(mode);
-      if (comm->am_world_master()) {
-        std::vector<EvalType> score_list(comm->get_num_trainers());
-        std::vector<int> num_samples_list(comm->get_num_trainers());
-        comm->intertrainer_gather(score, score_list);
-        comm->intertrainer_gather(score_samples, num_samples_list);
-        if(!m_print_global_stat_only) {
-          for (int i = 0; i < num_trainers; ++i) {
-            std::cout << m->get_name() << " (instance " << i <<  ") " << mode_string << " "
-                      << met->name() << " : "
-                      << score_list[i] << met->get_unit()
-                      << std::endl;
-          }
-        }
-        if (num_trainers > 1) {
-          const EvalType min_score = *std::min_element(score_list.begin(), score_list.end());
-          const EvalType avg_score = (std::inner_product(num_samples_list.begin(),
-                                                         num_samples_list.end(),
-                                                         score_list.begin(),
-                                                         EvalType(0))
-                                      / std::accumulate(num_samples_list.begin(),
-                                                        num_samples_list.end(),
-                                                        0));
-          const EvalType max_score = *std::max_element(score_list.begin(), score_list.end());
-          EvalType scores_stdev = EvalType(0);
-          for (const auto& t : score_list) {
-            const auto& diff = t - avg_score;
-            scores_stdev += diff * diff;
-          }
-          scores_stdev /= score_list.size() - 1;
-          scores_stdev = std::sqrt(std::max(scores_stdev, EvalType(0)));
-          std::cout << m->get_name() << " (global average) "  << mode_string << " "
-                    << met->name() << " : "
-                    << avg_score << met->get_unit()
-                    << std::endl;
-          std::cout << m->get_name() << " (global min) "  << mode_string << " "
-                    << met->name() << " : "
-                    << min_score << met->get_unit()
-                    << std::endl;
-          std::cout << m->get_name() << " (global max) "  << mode_string << " "
-                    << met->name() << " : "
-                    << max_score << met->get_unit()
-                    << std::endl;
-          std::cout << m->get_name() << " (global stdev) "  << mode_string << " "
+    for (size_t k = 0; k < metrics.size(); ++k) {
+      const auto& met = metrics[k];
+      get_lists(2 * (k + 1));
+      const auto& score_list = value_list;
+      if(!m_print_global_stat_only) {
+        for (int i = 0; i < num_trainers; ++i) {
+          std::cout << m->get_name() << " (instance " << i <<  ") " << mode_string << " "
                     << met->name() << " : "
-                    << scores_stdev << met->get_unit()
+                    << score_list[i] << met->get_unit()
                     << std::endl;
         }
-      } else {
-        comm->intertrainer_gather(score, comm->get_intertrainer_master());
-        comm->intertrainer_gather(score_samples, comm->get_intertrainer_master());
+      }
+      if (num_trainers > 1) {
+        const EvalType min_score = *std::min_element(score_list.begin(), score_list.end());
+        const EvalType avg_score = (std::inner_product(num_samples_list.begin(),
+                                                       num_samples_list.end(),
+                                                       score_list.begin(),
+                                                       EvalType(0))
+                                    / std::accumulate(num_samples_list.begin(),
+                                                      num_samples_list.end(),
+                                                      0));
+        const EvalType max_score = *std::max_element(score_list.begin(), score_list.end());
+        EvalType scores_stdev = EvalType(0);
+        for (const auto& t : score_list) {
+          const auto& diff = t - avg_score;
+          scores_stdev += diff * diff;
+        }
+        scores_stdev /= score_list.size() - 1;
+        scores_stdev = std::sqrt(std::max(scores_stdev, EvalType(0)));
+        std::cout << m->get_name() << " (global average) "  << mode_string << " "
+                  << met->name() << " : "
+                  << avg_score << met->get_unit()
+                  << std::endl;
+        std::cout << m->get_name() << " (global min) "  << mode_string << " "
+                  << met->name() << " : "
+                  << min_score << met->get_unit()
+                  << std::endl;
+        std::cout << m->get_name() << " (global max) "  << mode_string << " "
+                  << met->name() << " : "
+                  << max_score << met->get_unit()
+                  << std::endl;
+        std::cout << m->get_name() << " (global stdev) "  << mode_string << " "
+                  << met->name() << " : "
+                  << scores_stdev << met->get_unit()
+                  << std::endl;
       }
     }
 
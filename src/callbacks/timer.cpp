@@ -50,6 +50,7 @@ void timer::timing_begin(const model& m) {
   const auto& mode = m.get_execution_mode();
   m_start_times[mode] = get_time();
   m_batch_times[mode].clear();
+  m_update_weights_start_times[mode] = m.get_update_weights_time();
 }
 
 void timer::timing_end(model& m) {
@@ -58,6 +59,8 @@ void timer::timing_end(model& m) {
   // Get run time
   const auto& mode = m.get_execution_mode();
   const auto& run_time = get_time() - m_start_times[mode];
+  const auto& update_weights_time = (m.get_update_weights_time()
+                                     - m_update_weights_start_times[mode]);
 
   // Compute minibatch statistics
   const auto& batch_times = m_batch_times[mode];
@@ -112,8 +115,10 @@ void timer::timing_end(model& m) {
     std::vector<EvalType> min_list(num_models);
     std::vector<EvalType> max_list(num_models);
     std::vector<EvalType> stdev_list(num_models);
+    std::vector<EvalType> update_weights_list(num_models);
     if (comm.am_world_master()) {
       comm.intertrainer_gather(run_time, run_time_list);
+      comm.intertrainer_gather(update_weights_time, update_weights_list);
       comm.intertrainer_gather(batch_time_mean, mean_list);
       comm.intertrainer_gather(batch_time_min, min_list);
       comm.intertrainer_gather(batch_time_max, max_list);
@@ -121,6 +126,7 @@ void timer::timing_end(model& m) {
     } else {
       const auto& world_master = comm.get_intertrainer_master();
       comm.intertrainer_gather(run_time, world_master);
+      comm.intertrainer_gather(update_weights_time, world_master);
       comm.intertrainer_gather(batch_time_mean, world_master);
       comm.intertrainer_gather(batch_time_min, world_master);
       comm.intertrainer_gather(batch_time_max, world_master);
@@ -134,6 +140,13 @@ void timer::timing_end(model& m) {
                   << "run time : " << run_time_list[i] << "s"
                   << std::endl;
       }
+      if (mode == execution_mode::training) {
+        for (El::Int i = 0; i < num_models; ++i) {
+          std::cout << m.get_name() << " (instance "<< i << ") " << mode_string << " "
+                    << "weights update time : " << update_weights_list[i] << "s"
+                    << std::endl;
+        }
+      }
       for (El::Int i = 0; i < num_models; ++i) {
         std::cout << m.get_name() << " (instance " << i << ") " << mode_string << " "
                   << "mini-batch time statistics : ";
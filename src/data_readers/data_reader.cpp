@@ -29,6 +29,7 @@
 #include "lbann/data_readers/data_reader.hpp"
 #include "lbann/data_store/data_store_conduit.hpp"
 #include "lbann/utils/omp_pragma.hpp"
+#include "lbann/utils/file_utils.hpp"
 #include "lbann/models/model.hpp"
 #include <omp.h>
 #include <future>
@@ -88,7 +89,36 @@ bool lbann::generic_data_reader::fetch_data_block(CPUMat& X, El::Int thread_id,
   return true;
 }
 
+template <typename T>
+bool lbann::generic_data_reader::fetch_narrow_data_block(El::Matrix<T>& X, El::Int thread_id, El::Int mb_size, El::Matrix<El::Int>& indices_fetched) {
+  std::string error_message;
+  for (int s = thread_id; s < mb_size; s+=m_io_thread_pool->get_num_threads()) {
+    int n = m_current_pos + (s * m_sample_stride);
+    int index = m_shuffled_indices[n];
+    bool valid = fetch_narrow_datum(X, index, s);
+    if (!valid) {
+      error_message = "invalid datum (index " + std::to_string(index) + ")";
+    }
+    if (!error_message.empty()) { LBANN_ERROR(error_message); }
+    indices_fetched.Set(s, 0, index);
+  }
+  return true;
+}
+
 int lbann::generic_data_reader::fetch_data(CPUMat& X, El::Matrix<El::Int>& indices_fetched) {
+  return fetch_samples(X, indices_fetched);
+}
+
+int lbann::generic_data_reader::fetch_data(El::Matrix<uint8_t>& X, El::Matrix<El::Int>& indices_fetched) {
+  return fetch_samples(X, indices_fetched);
+}
+
+int lbann::generic_data_reader::fetch_data(El::Matrix<int16_t>& X, El::Matrix<El::Int>& indices_fetched) {
+  return fetch_samples(X, indices_fetched);
+}
+
+template <typename SampleMat>
+int lbann::generic_data_reader::fetch_samples(SampleMat& X, El::Matrix<El::Int>& indices_fetched) {
   #ifdef DEBUG
   if (m_current_pos == 0) {
     if (is_master()) {
@@ -147,11 +177,12 @@ int lbann::generic_data_reader::fetch_data(CPUMat& X, El::Matrix<El::Int>& indic
       continue;
     }else {
       m_io_thread_pool->submit_job_to_work_group(
-        std::bind(&generic_data_reader::fetch_data_block, this, std::ref(X), t,
-                  mb_size, std::ref(indices_fetched)));
+        [this, &X, t, mb_size, &indices_fetched]() {
+          fetch_block(X, t, mb_size, indices_fetched);
+        });
     }
   }
-  fetch_data_block(X, m_io_thread_pool->get_local_thread_id(), mb_size, indices_fetched);
+  fetch_block(X, m_io_thread_pool->get_local_thread_id(), mb_size, indices_fetched);
 
   // Wait for all of the threads to finish
   m_io_thread_pool->finish_work_group();
@@ -294,6 +325,9 @@ bool generic_data_reader::update(bool is_active_reader) {
     if (priming_data_store()) {
       m_data_store->set_shuffled_indices(&m_shuffled_indices);
     }
+    if (m_data_store != nullptr) {
+      m_data_store->apply_locality_order(m_shuffled_indices);
+    }
 
     set_initial_position();
   }
@@ -692,6 +726,80 @@ double generic_data_reader::get_use_percent() const {
   return m_use_percent;
 }
 
+bool generic_data_reader::load_file_from_trainer_master(
+  const std::string& filename, std::vector<char>& buf) const {
+  if (m_comm == nullptr) {
+    return load_file(filename, buf);
+  }
+  int status = 0;
+  if (m_comm->am_trainer_master()) {
+    status = load_file(filename, buf) ? 1 : 0;
+  }
+  m_comm->trainer_broadcast(0, status);
+  if (status == 0) {
+    buf.clear();
+    return false;
+  }
+  m_comm->trainer_broadcast(0, buf);
+  return true;
+}
+
+std::unique_ptr<metadata_cache> generic_data_reader::make_metadata_cache(
+  const std::string& input_file) const {
+  options *opts = options::get();
+  if (!opts->get_bool("metadata_cache") && !opts->has_string("metadata_cache_dir")) {
+    return nullptr;
+  }
+  const std::string cache_dir = (opts->has_string("metadata_cache_dir") ?
+                                 opts->get_string("metadata_cache_dir") : "");
+  std::unique_ptr<metadata_cache> cache(new metadata_cache(get_type(), cache_dir));
+  cache->add_input_file(input_file);
+  return cache;
+}
+
+bool generic_data_reader::read_metadata_cache(const metadata_cache& cache,
+                                              std::string& payload,
+                                              bool world) const {
+  if (m_comm == nullptr) {
+    return cache.read(payload);
+  }
+  const bool master = world ? m_comm->am_world_master() : m_comm->am_trainer_master();
+  const auto& comm = world ? m_comm->get_world_comm() : m_comm->get_trainer_comm();
+  int status = 0;
+  std::vector<char> buf;
+  if (master && cache.read(payload)) {
+    status = 1;
+    buf.assign(payload.begin(), payload.end());
+  }
+  m_comm->broadcast(0, status, comm);
+  if (status == 0) {
+    payload.clear();
+    return false;
+  }
+  m_comm->broadcast(0, buf, comm);
+  payload.assign(buf.begin(), buf.end());
+  if (is_master()) {
+    std::cout << get_type() << " data reader: loaded metadata from "
+              << cache.get_filename() << std::endl;
+  }
+  return true;
+}
+
+void generic_data_reader::write_metadata_cache(const metadata_cache& cache,
+                                               const std::string& payload,
+                                               bool world) const {
+  if (m_comm != nullptr
+      && !(world ? m_comm->am_world_master() : m_comm->am_trainer_master())) {
+    return;
+  }
+  if (!cache.write(payload)) {
+    LBANN_WARNING("failed to write metadata cache ", cache.get_filename());
+  } else if (is_master()) {
+    std::cout << get_type() << " data reader: wrote metadata cache "
+              << cache.get_filename() << std::endl;
+  }
+}
+
 void generic_data_reader::instantiate_data_store(const std::vector<int>& local_list_sizes) {
   options *opts = options::get();
   if (! (opts->get_bool("use_data_store") || opts->get_bool("preload_data_store") || opts->get_bool("data_store_cache"))) {
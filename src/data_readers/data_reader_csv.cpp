@@ -29,7 +29,10 @@
 #include <unordered_set>
 #include "lbann/data_readers/data_reader_csv.hpp"
 #include "lbann/utils/options.hpp"
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/vector.hpp>
 #include <omp.h>
+#include <sstream>
 
 namespace lbann {
 
@@ -101,19 +104,42 @@ void csv_reader::load() {
   setup_ifstreams();
   std::ifstream& ifs = *m_ifstreams[0];
   const El::mpi::Comm& world_comm = m_comm->get_world_comm();
-  // Parse the header to determine how many columns there are.
-  // Skip rows if needed.
-  if (master) {
-    skip_rows(ifs, m_skip_rows);
-  }
-  m_comm->broadcast<int>(0, m_skip_rows, world_comm);
 
   //This will be broadcast from root to other procs, and will
   //then be converted to std::vector<int> m_labels; this is because
   //El::mpi::Broadcast<std::streampos> doesn't work
   std::vector<long long> index;
 
-  if (master) {
+  // The line index, labels and responses may be cached from an
+  // earlier run that parsed the file the same way
+  auto cache = make_metadata_cache(get_data_filename());
+  bool cached = false;
+  if (cache != nullptr) {
+    cache->add_parameter("separator", std::string(1, m_separator));
+    cache->add_parameter("skip_rows", std::to_string(m_skip_rows));
+    cache->add_parameter("has_header", std::to_string(m_has_header));
+    cache->add_parameter("label_col", std::to_string(m_label_col));
+    cache->add_parameter("response_col", std::to_string(m_response_col));
+    cache->add_parameter("disable_labels", std::to_string(m_disable_labels));
+    cache->add_parameter("disable_responses", std::to_string(m_disable_responses));
+    cache->add_parameter("num_samples", std::to_string(get_absolute_sample_count()));
+    std::string payload;
+    cached = read_metadata_cache(*cache, payload, true);
+    if (cached) {
+      std::istringstream ss(payload);
+      cereal::BinaryInputArchive archive(ss);
+      archive(m_num_cols, index, m_labels, m_responses);
+    }
+  }
+
+  // Parse the header to determine how many columns there are.
+  // Skip rows if needed.
+  if (master && !cached) {
+    skip_rows(ifs, m_skip_rows);
+  }
+  m_comm->broadcast<int>(0, m_skip_rows, world_comm);
+
+  if (master && !cached) {
     std::string line;
     std::streampos header_start = ifs.tellg();
     // TODO: Skip comment lines.
@@ -237,11 +263,32 @@ void csv_reader::load() {
     ifs.clear();
   } // if (master)
 
-  m_comm->broadcast<int>(0, m_num_cols, world_comm);
-  m_label_col = m_num_cols - 1;
+  if (!cached) {
+    m_comm->broadcast<int>(0, m_num_cols, world_comm);
 
-  //bcast the index vector
-  m_comm->world_broadcast<long long>(0, index);
+    //bcast the index vector
+    m_comm->world_broadcast<long long>(0, index);
+
+    //optionally bcast the response vector
+    if (!m_disable_responses) {
+      m_comm->world_broadcast<DataType>(0, m_responses);
+    }
+
+    //optionally bcast the label vector
+    if (!m_disable_labels) {
+      m_comm->world_broadcast<int>(0, m_labels);
+    }
+
+    if (cache != nullptr && master) {
+      std::ostringstream ss;
+      {
+        cereal::BinaryOutputArchive archive(ss);
+        archive(m_num_cols, index, m_labels, m_responses);
+      }
+      write_metadata_cache(*cache, ss.str(), true);
+    }
+  }
+  m_label_col = m_num_cols - 1;
   m_num_samples = index.size() - 1;
   if (m_master) std::cerr << "num samples: " << m_num_samples << "\n";
 
@@ -250,15 +297,10 @@ void csv_reader::load() {
     m_index.push_back(t);
   }
 
-  //optionally bcast the response vector
   if (!m_disable_responses) {
     m_response_col = m_num_cols - 1;
-    m_comm->world_broadcast<DataType>(0, m_responses);
   }
-
-  //optionally bcast the label vector
   if (!m_disable_labels) {
-    m_comm->world_broadcast<int>(0, m_labels);
     m_num_labels = m_labels.size();
   }
 
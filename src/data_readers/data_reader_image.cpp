@@ -31,7 +31,12 @@
 #include "lbann/utils/timer.hpp"
 #include "lbann/data_store/data_store_conduit.hpp"
 #include "lbann/utils/file_utils.hpp"
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/utility.hpp>
+#include <cereal/types/vector.hpp>
 #include <fstream>
+#include <sstream>
 
 namespace lbann {
 
@@ -144,20 +149,36 @@ void image_data_reader::load() {
   const std::string imageListFile = get_data_filename();
 
   // load image list
+  // Note: The list is read by the trainer master and broadcast. A
+  // parsed list cached by an earlier run is used if the list file has
+  // not changed since.
   m_image_list.clear();
-  FILE *fplist = fopen(imageListFile.c_str(), "rt");
-  if (!fplist) {
-    LBANN_ERROR("failed to open: " + imageListFile + " for reading");
-  }
-  while (!feof(fplist)) {
-    char imagepath[512];
+  auto cache = make_metadata_cache(imageListFile);
+  std::string cache_payload;
+  if (cache != nullptr && read_metadata_cache(*cache, cache_payload)) {
+    std::istringstream ss(cache_payload);
+    cereal::BinaryInputArchive archive(ss);
+    archive(m_image_list);
+  } else {
+    std::vector<char> list_buf;
+    if (!load_file_from_trainer_master(imageListFile, list_buf)) {
+      LBANN_ERROR("failed to open: " + imageListFile + " for reading");
+    }
+    std::istringstream list(std::string(list_buf.data(), list_buf.size()));
+    std::string imagepath;
     label_t imagelabel;
-    if (fscanf(fplist, "%s%d", imagepath, &imagelabel) <= 1) {
-      break;
+    while (list >> imagepath >> imagelabel) {
+      m_image_list.emplace_back(imagepath, imagelabel);
+    }
+    if (cache != nullptr && m_comm->am_trainer_master()) {
+      std::ostringstream ss;
+      {
+        cereal::BinaryOutputArchive archive(ss);
+        archive(m_image_list);
+      }
+      write_metadata_cache(*cache, ss.str());
     }
-    m_image_list.emplace_back(imagepath, imagelabel);
   }
-  fclose(fplist);
 
   // reset indices
   m_shuffled_indices.clear();
@@ -112,7 +112,9 @@ void data_reader_jag_conduit::shuffle_indices(rng_gen& gen) {
     return;
   }
   generic_data_reader::shuffle_indices(gen);
-  m_sample_list.compute_epochs_file_usage(get_shuffled_indices(), get_mini_batch_size(), *m_comm);
+  if (m_packed_bundle == nullptr) {
+    m_sample_list.compute_epochs_file_usage(get_shuffled_indices(), get_mini_batch_size(), *m_comm);
+  }
 }
 
 int data_reader_jag_conduit::compute_max_num_parallel_readers() {
@@ -152,6 +154,8 @@ void data_reader_jag_conduit::copy_members(const data_reader_jag_conduit& rhs, c
   m_emi_image_keys = rhs.m_emi_image_keys;
   m_scalar_keys = rhs.m_scalar_keys;
   m_input_keys = rhs.m_input_keys;
+  m_scalar_plan = rhs.m_scalar_plan;
+  m_input_plan = rhs.m_input_plan;
 
   m_uniform_input_type = rhs.m_uniform_input_type;
 
@@ -183,6 +187,11 @@ void data_reader_jag_conduit::copy_members(const data_reader_jag_conduit& rhs, c
   m_list_per_trainer = rhs.m_list_per_trainer;
   m_list_per_model = rhs.m_list_per_model;
 
+  m_packed_bundle = rhs.m_packed_bundle;
+  m_packed_image_fields = rhs.m_packed_image_fields;
+  m_packed_scalar_fields = rhs.m_packed_scalar_fields;
+  m_packed_input_fields = rhs.m_packed_input_fields;
+
   if(rhs.m_data_store != nullptr) {
     if(ds_sample_move_list.size() == 0) {
       m_data_store = new data_store_conduit(rhs.get_data_store());
@@ -782,12 +791,38 @@ void data_reader_jag_conduit::load() {
   const std::string data_dir = add_delimiter(get_file_dir());
   const std::string sample_list_file = data_dir + get_data_index_list();
 
+  if (packed_sample_bundle::is_packed_index(sample_list_file)) {
+    load_packed_bundle(sample_list_file);
+    return;
+  }
+
   options *opts = options::get();
 
+  // A binary sample list is mapped rather than parsed, so every rank
+  // loads all of it directly instead of gathering the partitions
+  const bool binary_list = sample_list_binary::is_binary_sample_list(sample_list_file);
+
+  // A text sample list that an earlier run gathered may be cached,
+  // in which case the data files are not opened to enumerate samples
+  std::unique_ptr<metadata_cache> cache;
+  bool cached = false;
+  if (!binary_list) {
+    cache = make_metadata_cache(sample_list_file);
+    std::string cache_payload;
+    if (cache != nullptr && read_metadata_cache(*cache, cache_payload)) {
+      load_list_of_samples_from_archive(cache_payload);
+      cached = true;
+    }
+  }
+
   /// The use of these flags need to be updated to properly separate
   /// how index lists are used between trainers and models
   /// @todo m_list_per_trainer || m_list_per_model
-  load_list_of_samples(sample_list_file, m_comm->get_procs_per_trainer(), m_comm->get_rank_in_trainer());
+  if (binary_list) {
+    load_list_of_samples(sample_list_file);
+  } else if (!cached) {
+    load_list_of_samples(sample_list_file, m_comm->get_procs_per_trainer(), m_comm->get_rank_in_trainer());
+  }
   if(is_master()) {
     std::cout << "Finished sample list, check data" << std::endl;
   }
@@ -811,6 +846,8 @@ void data_reader_jag_conduit::load() {
 
     check_image_data();
 
+    setup_access_plans();
+
     m_sample_list.close_if_done_samples_file_handle(0);
   }
   if(is_master()) {
@@ -818,7 +855,22 @@ void data_reader_jag_conduit::load() {
   }
 
   /// Merge all of the sample lists
-  m_sample_list.all_gather_packed_lists(*m_comm);
+  if (!binary_list && !cached) {
+    m_sample_list.all_gather_packed_lists(*m_comm);
+    if (cache != nullptr && m_comm->am_trainer_master()) {
+      // The samples depend on the data files, so they are validated too
+      const std::string file_dir = add_delimiter(m_sample_list.get_header().get_file_dir());
+      for (size_t i = 0u; i < m_sample_list.get_num_files(); ++i) {
+        cache->add_dependent_file(file_dir + m_sample_list.get_samples_filename(i));
+      }
+      std::stringstream ss;
+      {
+        cereal::BinaryOutputArchive oarchive(ss);
+        oarchive(m_sample_list);
+      }
+      write_metadata_cache(*cache, ss.str());
+    }
+  }
   if (opts->has_string("write_sample_list") && m_comm->am_trainer_master()) {
     {
       const std::string msg = " writing sample list " + sample_list_file;
@@ -937,6 +989,130 @@ void data_reader_jag_conduit::load_list_of_samples_from_archive(const std::strin
   }
 }
 
+void data_reader_jag_conduit::load_packed_bundle(const std::string& index_file) {
+  options *opts = options::get();
+  if (opts->get_bool("use_data_store") || opts->get_bool("preload_data_store")
+      || opts->get_bool("data_store_cache")) {
+    LBANN_ERROR(_CN_ + ":: the data store is not supported with a packed sample bundle");
+  }
+
+  // Every rank reads the whole index. It only holds the record layout
+  // and the shard sizes, so there is no sample list to gather.
+  double tm1 = get_time();
+  auto bundle = std::make_shared<packed_sample_bundle>();
+  bundle->load(index_file);
+  m_packed_bundle = bundle;
+  double tm2 = get_time();
+
+  if (is_master()) {
+    std::cout << "Time to load packed sample bundle index: " << tm2 - tm1
+              << " num samples: " << m_packed_bundle->size() << std::endl;
+  }
+
+  m_is_data_loaded = true;
+  setup_packed_fields();
+
+  m_shuffled_indices.resize(m_packed_bundle->size());
+  std::iota(m_shuffled_indices.begin(), m_shuffled_indices.end(), 0);
+  resize_shuffled_indices();
+
+  instantiate_data_store(std::vector<int>());
+
+  select_subset_of_data();
+}
+
+void data_reader_jag_conduit::setup_packed_fields() {
+  const auto& fields = m_packed_bundle->get_fields();
+
+  // Select every field directly under a prefix that is not filtered out
+  auto select_all = [&fields, this](const std::string& prefix,
+                                    const std::set<std::string>& key_filter,
+                                    const std::vector<prefix_t>& prefix_filter)
+                                    -> std::vector<std::string> {
+    std::string group = packed_sample_bundle::normalize_path(prefix);
+    if (!group.empty() && group.back() != '/') {
+      group.push_back('/');
+    }
+    std::vector<std::string> keys;
+    for (const auto& f : fields) {
+      if (f.path.compare(0, group.size(), group) != 0) {
+        continue;
+      }
+      const std::string key = f.path.substr(group.size());
+      if ((key.find('/') == std::string::npos)
+          && !filter(key_filter, prefix_filter, key)) {
+        keys.push_back(key);
+      }
+    }
+    return keys;
+  };
+
+  auto resolve = [this](const std::string& prefix,
+                        const std::vector<std::string>& keys,
+                        std::vector<const packed_sample_bundle::field_t*>& resolved) {
+    resolved.clear();
+    std::string msg;
+    for (const auto& key : keys) {
+      const auto* f = m_packed_bundle->find_field(prefix + '/' + key);
+      if (f == nullptr) {
+        msg += ' ' + key;
+      }
+      resolved.push_back(f);
+    }
+    if (!msg.empty()) {
+      LBANN_ERROR(_CN_ + ":: keys not found in the packed sample bundle:" + msg);
+    }
+  };
+
+  if (m_scalar_keys.empty()) {
+    m_scalar_keys = select_all(m_output_scalar_prefix, m_scalar_filter, m_scalar_prefix_filter);
+  }
+  resolve(m_output_scalar_prefix, m_scalar_keys, m_packed_scalar_fields);
+
+  if (m_input_keys.empty()) {
+    m_input_keys = select_all(m_input_prefix, m_input_filter, m_input_prefix_filter);
+  }
+  resolve(m_input_prefix, m_input_keys, m_packed_input_fields);
+
+  resolve(m_output_image_prefix, m_emi_image_keys, m_packed_image_fields);
+  for (const auto* f : m_packed_image_fields) {
+    if (m_image_linearized_size == f->num_elements) {
+      continue;
+    }
+    if ((m_image_width == 0) && (m_image_height == 0)) {
+      m_image_height = 1;
+      m_image_width = static_cast<int>(f->num_elements);
+      m_image_num_channels = 1;
+      set_linearized_image_size();
+    } else {
+      LBANN_ERROR(_CN_ + ":: expected linearized emi image size: "
+                  + std::to_string(f->num_elements) + '\n' + get_description());
+    }
+  }
+
+  if (m_scalar_normalization_params.empty()) {
+    m_scalar_normalization_params.assign(m_scalar_keys.size(), linear_transform_t(1.0, 0.0));
+  } else if (m_scalar_normalization_params.size() != m_scalar_keys.size()) {
+    LBANN_ERROR(_CN_ + ":: Incorrect number of scalar normalization parameter sets! " \
+                + std::to_string(m_scalar_normalization_params.size()) + " != " \
+                + std::to_string(m_scalar_keys.size()));
+  }
+  if (m_input_normalization_params.empty()) {
+    m_input_normalization_params.assign(m_input_keys.size(), linear_transform_t(1.0, 0.0));
+  } else if (m_input_normalization_params.size() != m_input_keys.size()) {
+    LBANN_ERROR(_CN_ + ":: Incorrect number of input normalization parameter sets! " \
+                + std::to_string(m_input_normalization_params.size()) + " != " \
+                + std::to_string(m_input_keys.size()));
+  }
+  if (m_image_normalization_params.empty()) {
+    m_image_normalization_params.assign(m_emi_image_keys.size()*m_image_num_channels, linear_transform_t(1.0, 0.0));
+  } else if (m_image_normalization_params.size() != static_cast<size_t>(m_image_num_channels)) {
+    LBANN_ERROR(_CN_ + ":: Incorrect number of image normalization parameter sets!" \
+                + std::to_string(m_image_normalization_params.size()) + " != " \
+                + std::to_string(m_image_num_channels));
+  }
+}
+
 unsigned int data_reader_jag_conduit::get_num_img_srcs() const {
   return m_num_img_srcs;
 }
@@ -1199,30 +1375,98 @@ bool data_reader_jag_conduit::check_non_numeric(const std::string key) {
 }
 
 
+conduit::Node& data_reader_jag_conduit::get_sample_node(const size_t sample_id, conduit::Node& sample, const std::string& conduit_field) const {
+  const std::string conduit_obj = '/' + LBANN_DATA_ID_STR(sample_id) + '/' + conduit_field;
+  if(sample[conduit_obj].schema().dtype().is_empty()) {
+    if (data_store_active()) {
+      LBANN_ERROR("Unable to find field " + conduit_obj
+                  + " in conduit node: " + std::to_string(sample_id));
+    }
+    conduit::Node n_field;
+    bool from_file = load_conduit_node(sample_id, conduit_field, n_field);
+    if (from_file) {
+      sample[conduit_obj].set(n_field);
+    } else {
+      sample = n_field;
+    }
+  }
+  return sample[conduit_obj];
+}
+
+data_reader_jag_conduit::field_access_plan
+data_reader_jag_conduit::build_access_plan(const std::string& prefix,
+                                           const std::vector<std::string>& keys,
+                                           const conduit::Node* n_group) {
+  field_access_plan plan;
+  plan.keys = keys;
+  // Fields directly under the sample root are looked up one by one
+  // rather than reading the whole sample
+  plan.group = prefix;
+  while (!plan.group.empty() && plan.group.back() == '/') {
+    plan.group.pop_back();
+  }
+  if (plan.group.empty() || n_group == nullptr) {
+    return plan;
+  }
+
+  const std::vector<std::string>& child_names = n_group->child_names();
+  std::unordered_map<std::string, conduit::index_t> child_pos;
+  for (size_t c = 0u; c < child_names.size(); ++c) {
+    child_pos.emplace(child_names[c], static_cast<conduit::index_t>(c));
+  }
+  plan.child_index.reserve(keys.size());
+  for (const auto& key : keys) {
+    const auto it = child_pos.find(key);
+    if (it == child_pos.cend()) {
+      // Unresolved fields are looked up by name
+      plan.child_index.clear();
+      return plan;
+    }
+    plan.child_index.push_back(it->second);
+  }
+  plan.num_children = n_group->number_of_children();
+  return plan;
+}
+
+void data_reader_jag_conduit::setup_access_plans() {
+  const field_access_plan scalar_plan = build_access_plan(m_output_scalar_prefix, m_scalar_keys, nullptr);
+  const field_access_plan input_plan = build_access_plan(m_input_prefix, m_input_keys, nullptr);
+
+  // Resolve the position of each field using the first sample
+  const size_t first_idx = (m_sample_list[0]).first;
+  conduit::Node n_scalar, n_input;
+  if (!scalar_plan.group.empty() && !m_scalar_keys.empty()) {
+    load_conduit_node(first_idx, scalar_plan.group, n_scalar);
+  }
+  if (!input_plan.group.empty() && !m_input_keys.empty()) {
+    load_conduit_node(first_idx, input_plan.group, n_input);
+  }
+  m_scalar_plan = build_access_plan(m_output_scalar_prefix, m_scalar_keys, &n_scalar);
+  m_input_plan = build_access_plan(m_input_prefix, m_input_keys, &n_input);
+}
+
+conduit::Node& data_reader_jag_conduit::get_field(conduit::Node& n_group,
+                                                  const field_access_plan& plan,
+                                                  const size_t k) {
+  // Samples are expected to share a schema, but fall back to lookup by
+  // name if this group does not match the one the plan was resolved on
+  if (!plan.child_index.empty()
+      && n_group.number_of_children() == plan.num_children) {
+    return n_group.child(plan.child_index[k]);
+  }
+  return n_group.child(plan.keys[k]);
+}
+
 std::vector< std::vector<DataType> >
 data_reader_jag_conduit::get_image_data(const size_t sample_id, conduit::Node& sample) const {
   std::vector< std::vector<DataType> > image_ptrs;
   image_ptrs.reserve(m_emi_image_keys.size());
 
   for (const auto& emi_tag : m_emi_image_keys) {
-    const std::string conduit_field = m_output_image_prefix + emi_tag;
-    const std::string conduit_obj = '/' + LBANN_DATA_ID_STR(sample_id) + '/' + conduit_field;
-    if(sample[conduit_obj].schema().dtype().is_empty()) {
-      if (data_store_active()) {
-        LBANN_ERROR("Unable to find field " + conduit_obj
-                    + " in conduit node: " + std::to_string(sample_id));
-      }
-      conduit::Node n_image;
-      bool from_file = load_conduit_node(sample_id, conduit_field, n_image);
-      if (from_file) {
-        sample[conduit_obj].set(n_image);
-      } else {
-        sample = n_image;
-      }
-    }
-    conduit_ch_t emi = sample[conduit_obj].value();
+    conduit::Node& n_image = get_sample_node(sample_id, sample, m_output_image_prefix + emi_tag);
+    conduit_ch_t emi = n_image.value();
     const size_t num_vals = emi.number_of_elements();
-    const ch_t* emi_data = sample[conduit_obj].value();
+    const ch_t* emi_data = n_image.value();
     // Note that data will be cast from ch_t to DataType format
     image_ptrs.emplace_back(emi_data, emi_data + num_vals);
   }
@@ -1230,92 +1474,67 @@ data_reader_jag_conduit::get_image_data(const size_t sample_id, conduit::Node& s
   return image_ptrs;
 }
 
-std::vector<data_reader_jag_conduit::scalar_t> data_reader_jag_conduit::get_scalars(const size_t sample_id, conduit::Node& sample) const {
-  std::vector<scalar_t> scalars;
-  scalars.reserve(m_scalar_keys.size());
-
-  auto tr = m_scalar_normalization_params.cbegin();
-
-  for(const auto key: m_scalar_keys) {
-    std::string conduit_field = m_output_scalar_prefix + key;
-    std::string conduit_obj = '/' + LBANN_DATA_ID_STR(sample_id) + '/' + conduit_field;
-    if(sample[conduit_obj].schema().dtype().is_empty()) {
-      if (data_store_active()) {
-        LBANN_ERROR("Unable to find field " + conduit_obj
-                    + " in conduit node: " + std::to_string(sample_id));
-      }
-      conduit::Node n_scalar;
-      bool from_file = load_conduit_node(sample_id, conduit_field, n_scalar);
-      if (from_file) {
-        sample[conduit_obj].set(n_scalar);
-      } else {
-        sample = n_scalar;
-      }
-    }
-    const scalar_t val_raw = static_cast<scalar_t>(sample[conduit_obj].to_value());
-    const scalar_t val = static_cast<scalar_t>(val_raw * tr->first + tr->second);
-    scalars.push_back(val);
-    tr ++;
+template<typename T>
+void data_reader_jag_conduit::read_scalars(const size_t sample_id, conduit::Node& sample, T* out) const {
+  const field_access_plan& plan = m_scalar_plan;
+  const size_t num_keys = m_scalar_keys.size();
+  conduit::Node* n_group = nullptr;
+  if (!plan.group.empty() && plan.keys.size() == num_keys) {
+    // One read brings in all the scalars of the sample
+    n_group = &get_sample_node(sample_id, sample, plan.group);
+  }
+
+  for (size_t k = 0u; k < num_keys; ++k) {
+    conduit::Node& n_scalar = (n_group != nullptr) ?
+      get_field(*n_group, plan, k) :
+      get_sample_node(sample_id, sample, m_output_scalar_prefix + m_scalar_keys[k]);
+    const auto& tr = m_scalar_normalization_params[k];
+    const scalar_t val_raw = static_cast<scalar_t>(n_scalar.to_value());
+    out[k] = static_cast<T>(val_raw * tr.first + tr.second);
   }
-  return scalars;
 }
 
-std::vector<data_reader_jag_conduit::input_t> data_reader_jag_conduit::get_inputs(const size_t sample_id, conduit::Node& sample) const {
-  std::vector<input_t> inputs;
-  inputs.reserve(m_input_keys.size());
+template<typename T>
+void data_reader_jag_conduit::read_inputs(const size_t sample_id, conduit::Node& sample, T* out) const {
+  const field_access_plan& plan = m_input_plan;
+  const size_t num_keys = m_input_keys.size();
+  conduit::Node* n_group = nullptr;
+  if (!plan.group.empty() && plan.keys.size() == num_keys) {
+    // One read brings in all the inputs of the sample
+    n_group = &get_sample_node(sample_id, sample, plan.group);
+  }
 
   // The sequence of normalization parameters should follow the same order as
   // that of the variable keys.
-  auto tr = m_input_normalization_params.cbegin();
-
-  // automatically determine which method to use based on if all the variables are of input_t
-  if (m_uniform_input_type) {
-    // avoid some overhead by taking advantage of the fact that all the variables are of the same type
-    for(const auto key: m_input_keys) {
-      const std::string conduit_field = m_input_prefix + key;
-      const std::string conduit_obj = '/' + LBANN_DATA_ID_STR(sample_id) + '/' + conduit_field;
-      if(sample[conduit_obj].schema().dtype().is_empty()) {
-        if (data_store_active()) {
-          LBANN_ERROR("Unable to find field " + conduit_obj
-                      + " in conduit node: " + std::to_string(sample_id));
-        }
-        conduit::Node n_input;
-        bool from_file = load_conduit_node(sample_id, conduit_field, n_input);
-        if (from_file) {
-          sample[conduit_obj].set(n_input);
-        } else {
-          sample = n_input;
-        }
-      }
-      const input_t val_raw = static_cast<input_t>(sample[conduit_obj].value());
-      const input_t val = static_cast<input_t>(val_raw * tr->first + tr->second);
-      inputs.push_back(val);
-      tr ++;
-    }
-  } else {
-    for(const auto key: m_input_keys) {
-      const std::string conduit_field = m_input_prefix + key;
-      const std::string conduit_obj = '/' + LBANN_DATA_ID_STR(sample_id) + '/' + conduit_field;
-      if(sample[conduit_obj].schema().dtype().is_empty()) {
-        if (data_store_active()) {
-          LBANN_ERROR("Unable to find field " + conduit_obj
-                      + " in conduit node: " + std::to_string(sample_id));
-        }
-        conduit::Node n_input;
-        bool from_file = load_conduit_node(sample_id, conduit_field, n_input);
-        if (from_file) {
-          sample[conduit_obj].set(n_input);
-        } else {
-          sample = n_input;
-        }
-      }
-      add_val(key, sample[conduit_obj], inputs); // more overhead but general
-      input_t& val = inputs.back();
-      val = static_cast<input_t>(val * tr->first + tr->second);
-      tr ++;
+  std::vector<input_t> vals;
+  for (size_t k = 0u; k < num_keys; ++k) {
+    conduit::Node& n_input = (n_group != nullptr) ?
+      get_field(*n_group, plan, k) :
+      get_sample_node(sample_id, sample, m_input_prefix + m_input_keys[k]);
+    input_t val_raw;
+    // automatically determine which method to use based on if all the variables are of input_t
+    if (m_uniform_input_type) {
+      // avoid some overhead by taking advantage of the fact that all the variables are of the same type
+      val_raw = static_cast<input_t>(n_input.value());
+    } else {
+      vals.clear();
+      add_val(m_input_keys[k], n_input, vals); // more overhead but general
+      val_raw = vals.back();
     }
+    const auto& tr = m_input_normalization_params[k];
+    out[k] = static_cast<T>(val_raw * tr.first + tr.second);
   }
+}
+
+std::vector<data_reader_jag_conduit::scalar_t> data_reader_jag_conduit::get_scalars(const size_t sample_id, conduit::Node& sample) const {
+  std::vector<scalar_t> scalars(m_scalar_keys.size());
+  read_scalars(sample_id, sample, scalars.data());
+  return scalars;
+}
 
+std::vector<data_reader_jag_conduit::input_t> data_reader_jag_conduit::get_inputs(const size_t sample_id, conduit::Node& sample) const {
+  std::vector<input_t> inputs(m_input_keys.size());
+  read_inputs(sample_id, sample, inputs.data());
   return inputs;
 }
 
@@ -1336,50 +1555,90 @@ bool data_reader_jag_conduit::fetch(CPUMat& X, int data_id, conduit::Node& sampl
   const data_reader_jag_conduit::variable_t vt, const std::string tag) {
   switch (vt) {
     case JAG_Image: {
-      const size_t num_images = get_num_img_srcs();
-      const size_t num_channels = m_image_num_channels;
-      const size_t image_size = get_linearized_image_size();
-      const std::vector<size_t> sizes(num_images, image_size);
-      std::vector<CPUMat> X_v = create_datum_views(X, sizes, mb_idx);
-      std::vector< std::vector<DataType> > img_data(get_image_data(data_id, sample));
-
-      if (img_data.size() != num_images) {
-        LBANN_ERROR(_CN_ + ":: fetch() : the number of images is not as expected " \
-                    + std::to_string(img_data.size()) + "!=" + std::to_string(num_images));
-      }
-      if (!m_split_channels && m_image_num_channels != 1) {
-        LBANN_ERROR(_CN_ + ":: fetch() : transform pipeline now requires single channel images: num_channels=" \
-                    + std::to_string(m_image_num_channels) + " split_channel=" + std::to_string(m_split_channels));
-      }
+      fetch_images(X, get_image_data(data_id, sample), mb_idx);
+      break;
+    }
+    case JAG_Scalar: {
+      // Normalized values are written straight into the output column
+      read_scalars(data_id, sample, X.Buffer(0, mb_idx));
+      break;
+    }
+    case JAG_Input: {
+      read_inputs(data_id, sample, X.Buffer(0, mb_idx));
+      break;
+    }
+    default: { // includes Undefined case
+      LBANN_ERROR(_CN_ + ":: fetch_" + tag + "() : unknown or undefined variable type");
+    }
+  }
+  return true;
+}
 
-      std::vector<size_t> dims = {num_channels, static_cast<size_t>(m_image_height), static_cast<size_t>(m_image_width)};
-      std::vector<size_t> ch_dims = {static_cast<size_t>(m_image_height), static_cast<size_t>(m_image_width)};
-      auto tll = lbann::transform::repack_HWC_to_CHW_layout();
-
-      for(size_t i=0u; i < num_images; ++i) {
-        CPUMat img_mat = CPUMat(utils::get_linearized_size(dims), 1, img_data[i].data(), utils::get_linearized_size(dims));
-        utils::type_erased_matrix te_img(std::move(img_mat));
-        CPUMat tgt_mat = CPUMat(utils::get_linearized_size(dims), 1);
-        tll.apply(te_img, X_v[i], dims);
-        const std::vector<size_t> ch_sizes(num_channels, m_image_height * m_image_width);
-        std::vector<CPUMat> X_ch_v = create_datum_views(X_v[i], ch_sizes, mb_idx);
-        for(size_t ch = 0; ch < num_channels; ch++) {
-          const auto& tr = m_image_normalization_params.at(ch);
-          auto s = lbann::transform::scale_and_translate(tr.first, tr.second);
-          utils::type_erased_matrix te_img_plane(std::move(X_ch_v[ch]));
-          s.apply(te_img_plane, ch_dims);
-        }
+void data_reader_jag_conduit::fetch_images(CPUMat& X, std::vector< std::vector<DataType> > img_data, int mb_idx) {
+  const size_t num_images = get_num_img_srcs();
+  const size_t num_channels = m_image_num_channels;
+  const size_t image_size = get_linearized_image_size();
+  const std::vector<size_t> sizes(num_images, image_size);
+  std::vector<CPUMat> X_v = create_datum_views(X, sizes, mb_idx);
+
+  if (img_data.size() != num_images) {
+    LBANN_ERROR(_CN_ + ":: fetch() : the number of images is not as expected " \
+                + std::to_string(img_data.size()) + "!=" + std::to_string(num_images));
+  }
+  if (!m_split_channels && m_image_num_channels != 1) {
+    LBANN_ERROR(_CN_ + ":: fetch() : transform pipeline now requires single channel images: num_channels=" \
+                + std::to_string(m_image_num_channels) + " split_channel=" + std::to_string(m_split_channels));
+  }
+
+  std::vector<size_t> dims = {num_channels, static_cast<size_t>(m_image_height), static_cast<size_t>(m_image_width)};
+  std::vector<size_t> ch_dims = {static_cast<size_t>(m_image_height), static_cast<size_t>(m_image_width)};
+  auto tll = lbann::transform::repack_HWC_to_CHW_layout();
+
+  for(size_t i=0u; i < num_images; ++i) {
+    CPUMat img_mat = CPUMat(utils::get_linearized_size(dims), 1, img_data[i].data(), utils::get_linearized_size(dims));
+    utils::type_erased_matrix te_img(std::move(img_mat));
+    tll.apply(te_img, X_v[i], dims);
+    const std::vector<size_t> ch_sizes(num_channels, m_image_height * m_image_width);
+    std::vector<CPUMat> X_ch_v = create_datum_views(X_v[i], ch_sizes, mb_idx);
+    for(size_t ch = 0; ch < num_channels; ch++) {
+      const auto& tr = m_image_normalization_params.at(ch);
+      auto s = lbann::transform::scale_and_translate(tr.first, tr.second);
+      utils::type_erased_matrix te_img_plane(std::move(X_ch_v[ch]));
+      s.apply(te_img_plane, ch_dims);
+    }
+  }
+}
+
+bool data_reader_jag_conduit::fetch_packed(CPUMat& X, const char* record,
+  const data_reader_jag_conduit::variable_t vt, const std::string tag) {
+  using bundle_t = packed_sample_bundle;
+  switch (vt) {
+    case JAG_Image: {
+      std::vector< std::vector<DataType> > img_data(m_packed_image_fields.size());
+      for (size_t i = 0u; i < img_data.size(); ++i) {
+        const auto& f = *m_packed_image_fields[i];
+        img_data[i].resize(f.num_elements);
+        bundle_t::copy_field(record, f, img_data[i].data());
       }
+      fetch_images(X, std::move(img_data), 0);
       break;
     }
     case JAG_Scalar: {
-      const std::vector<scalar_t> scalars(get_scalars(data_id, sample));
-      set_minibatch_item<scalar_t>(X, mb_idx, scalars.data(), get_linearized_scalar_size());
+      DataType* out = X.Buffer();
+      for (size_t k = 0u; k < m_packed_scalar_fields.size(); ++k) {
+        const auto& tr = m_scalar_normalization_params[k];
+        const double val_raw = bundle_t::get_value(record, *m_packed_scalar_fields[k], 0);
+        out[k] = static_cast<DataType>(val_raw * tr.first + tr.second);
+      }
       break;
     }
     case JAG_Input: {
-      const std::vector<input_t> inputs(get_inputs(data_id, sample));
-      set_minibatch_item<input_t>(X, mb_idx, inputs.data(), get_linearized_input_size());
+      DataType* out = X.Buffer();
+      for (size_t k = 0u; k < m_packed_input_fields.size(); ++k) {
+        const auto& tr = m_input_normalization_params[k];
+        const double val_raw = bundle_t::get_value(record, *m_packed_input_fields[k], 0);
+        out[k] = static_cast<DataType>(val_raw * tr.first + tr.second);
+      }
       break;
     }
     default: { // includes Undefined case
@@ -1440,6 +1699,15 @@ bool data_reader_jag_conduit::fetch_datum(CPUMat& X, int data_id, int mb_idx) {
   std::vector<size_t> sizes = get_linearized_data_sizes();
   std::vector<CPUMat> X_v = create_datum_views(X, sizes, mb_idx);
   bool ok = true;
+  if (m_packed_bundle != nullptr) {
+    // The whole sample comes in with a single read
+    std::vector<char> record(m_packed_bundle->get_record_size());
+    m_packed_bundle->read_record(data_id, record.data());
+    for(size_t i = 0u; ok && (i < X_v.size()); ++i) {
+      ok = fetch_packed(X_v[i], record.data(), m_independent[i], "datum");
+    }
+    return ok;
+  }
   // Create a node to hold all of the data
   conduit::Node node;
   if (data_store_active()) {
@@ -1469,6 +1737,14 @@ bool data_reader_jag_conduit::fetch_response(CPUMat& X, int data_id, int mb_idx)
   std::vector<size_t> sizes = get_linearized_response_sizes();
   std::vector<CPUMat> X_v = create_datum_views(X, sizes, mb_idx);
   bool ok = true;
+  if (m_packed_bundle != nullptr) {
+    std::vector<char> record(m_packed_bundle->get_record_size());
+    m_packed_bundle->read_record(data_id, record.data());
+    for(size_t i = 0u; ok && (i < X_v.size()); ++i) {
+      ok = fetch_packed(X_v[i], record.data(), m_dependent[i], "response");
+    }
+    return ok;
+  }
   // Create a node to hold all of the data
   conduit::Node node;
   if (m_data_store != nullptr && m_model->get_epoch() > 0) {
@@ -65,6 +65,27 @@ bool mnist_reader::fetch_datum(CPUMat& X, int data_id, int mb_idx) {
   return true;
 }
 
+sample_storage_type mnist_reader::get_sample_storage_type() const {
+  DataType scale, bias;
+  if (m_transform_pipeline.get_affine_coefficients(scale, bias)) {
+    return sample_storage_type::uint8;
+  }
+  return sample_storage_type::data_type;
+}
+
+void mnist_reader::get_sample_conversion(DataType& scale, DataType& bias) const {
+  if (!m_transform_pipeline.get_affine_coefficients(scale, bias)) {
+    LBANN_ERROR("MNIST transform pipeline cannot be applied as an affine map");
+  }
+}
+
+bool mnist_reader::fetch_narrow_datum(El::Matrix<uint8_t>& X, int data_id, int mb_idx) {
+  const int pixelcount = m_image_width * m_image_height;
+  const std::vector<unsigned char>& tmp = m_image_data[data_id];
+  std::copy_n(tmp.data() + 1, pixelcount, X.Buffer(0, mb_idx));
+  return true;
+}
+
 bool mnist_reader::fetch_label(CPUMat& Y, int data_id, int mb_idx) {
   if(!m_gan_labelling) { //default
     unsigned char label = m_image_data[data_id][0];
@@ -186,6 +186,12 @@ namespace lbann {
     return true;
   }
 
+  bool numpy_npz_reader::fetch_narrow_datum(El::Matrix<int16_t>& X, int data_id, int mb_idx) {
+    const short *data = m_data.data<short>() + data_id * m_num_features;
+    std::copy_n(data, m_num_features, X.Buffer(0, mb_idx));
+    return true;
+  }
+
   bool numpy_npz_reader::fetch_label(Mat& Y, int data_id, int mb_idx) {
     if (!m_has_labels) {
       throw lbann_exception("numpy_npz_reader: do not have labels");
@@ -33,6 +33,10 @@
 #include "lbann/utils/jag_utils.hpp"  // read_filelist(..) TODO should be move to file_utils
 #include "lbann/utils/timer.hpp"
 #include "lbann/models/model.hpp"
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/string.hpp>
+#include <cereal/types/vector.hpp>
+#include <sstream>
 
 
 namespace lbann {
@@ -91,12 +95,40 @@ void numpy_npz_conduit_reader::load() {
   //      is too specialized -- it checks data in a manner particular to
   //      conduit, and that doesn't apply here.
 
+  // The file list and the metadata of its first file may be cached
+  // from an earlier run; read_filelist broadcasts to the world, so
+  // the cache is validated by the world master
   std::string infile = get_data_filename();
-  read_filelist(m_comm, infile, m_filenames);
-
-  // fills in: m_num_features, m_num_response_features,
-  // m_data_dims, m_data_word_size, m_response_word_size
-  fill_in_metadata();
+  auto cache = make_metadata_cache(infile);
+  std::string cache_payload;
+  if (cache != nullptr) {
+    cache->add_parameter("has_labels", std::to_string(m_has_labels));
+    cache->add_parameter("has_responses", std::to_string(m_has_responses));
+  }
+  if (cache != nullptr && read_metadata_cache(*cache, cache_payload, true)) {
+    std::istringstream ss(cache_payload);
+    cereal::BinaryInputArchive archive(ss);
+    archive(m_filenames, m_data_dims, m_num_features, m_data_word_size,
+            m_num_response_features, m_response_word_size);
+  } else {
+    read_filelist(m_comm, infile, m_filenames);
+
+    // fills in: m_num_features, m_num_response_features,
+    // m_data_dims, m_data_word_size, m_response_word_size
+    fill_in_metadata();
+
+    if (cache != nullptr && m_comm->am_world_master() && !m_filenames.empty()) {
+      // The world master read the metadata from the first file
+      cache->add_dependent_file(m_filenames[0]);
+      std::ostringstream ss;
+      {
+        cereal::BinaryOutputArchive archive(ss);
+        archive(m_filenames, m_data_dims, m_num_features, m_data_word_size,
+                m_num_response_features, m_response_word_size);
+      }
+      write_metadata_cache(*cache, ss.str(), true);
+    }
+  }
 
   // Reset indices.
   m_shuffled_indices.clear();
@@ -0,0 +1,242 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/data_readers/packed_sample_bundle.hpp"
+#include "lbann/utils/exception.hpp"
+#include "lbann/utils/file_utils.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace lbann {
+
+namespace {
+
+const std::string packed_index_magic = "PACKED_SAMPLE_BUNDLE";
+constexpr int packed_index_version = 1;
+
+} // namespace
+
+size_t packed_sample_bundle::field_t::get_num_bytes() const {
+  const size_t type_size = (type == field_type::float32) ? sizeof(float) : sizeof(double);
+  return num_elements * type_size;
+}
+
+packed_sample_bundle::~packed_sample_bundle() {
+  for (const int fd : m_shard_fds) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+}
+
+bool packed_sample_bundle::is_packed_index(const std::string& filename) {
+  std::ifstream in(filename.c_str());
+  std::string magic;
+  return (in >> magic) && (magic == packed_index_magic);
+}
+
+void packed_sample_bundle::load(const std::string& index_filename) {
+  std::ifstream in(index_filename.c_str());
+  if (!in) {
+    LBANN_ERROR("failed to open " + index_filename + " for reading");
+  }
+
+  std::string magic;
+  int version = 0;
+  in >> magic >> version;
+  if (magic != packed_index_magic || version != packed_index_version) {
+    LBANN_ERROR(index_filename + " is not a packed sample bundle index of version "
+                + std::to_string(packed_index_version));
+  }
+
+  size_t num_fields = 0u;
+  in >> num_fields >> m_record_size;
+  m_fields.resize(num_fields);
+  for (auto& f : m_fields) {
+    std::string type;
+    in >> type >> f.num_elements >> f.offset;
+    // The path takes the rest of the line as it may contain spaces
+    std::getline(in >> std::ws, f.path);
+    if (type == to_string(field_type::float32)) {
+      f.type = field_type::float32;
+    } else if (type == to_string(field_type::float64)) {
+      f.type = field_type::float64;
+    } else {
+      LBANN_ERROR("unknown field type " + type + " in " + index_filename);
+    }
+    if (f.offset + f.get_num_bytes() > m_record_size) {
+      LBANN_ERROR("field " + f.path + " exceeds the record size in " + index_filename);
+    }
+  }
+
+  size_t num_shards = 0u;
+  in >> num_shards >> m_num_samples;
+  if (!in) {
+    LBANN_ERROR("failed to parse the header of " + index_filename);
+  }
+
+  std::string dir, basename;
+  parse_path(index_filename, dir, basename);
+  dir = add_delimiter(dir);
+
+  m_shard_fds.reserve(num_shards);
+  m_shard_offsets.assign(1, 0u);
+  for (size_t s = 0u; s < num_shards; ++s) {
+    std::string shard;
+    size_t shard_size = 0u;
+    if (!(in >> shard >> shard_size)) {
+      LBANN_ERROR("failed to parse the shard list of " + index_filename);
+    }
+    const std::string shard_path = (shard[0] == '/') ? shard : dir + shard;
+    const int fd = open(shard_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      LBANN_ERROR("failed to open " + shard_path + " for reading: " + strerror(errno));
+    }
+    m_shard_fds.push_back(fd);
+    m_shard_offsets.push_back(m_shard_offsets.back() + shard_size);
+  }
+  if (m_shard_offsets.back() != m_num_samples) {
+    LBANN_ERROR("the shards of " + index_filename + " hold "
+                + std::to_string(m_shard_offsets.back()) + " samples instead of "
+                + std::to_string(m_num_samples));
+  }
+}
+
+const packed_sample_bundle::field_t*
+packed_sample_bundle::find_field(const std::string& path) const {
+  const std::string p = normalize_path(path);
+  for (const auto& f : m_fields) {
+    if (f.path == p) {
+      return &f;
+    }
+  }
+  return nullptr;
+}
+
+void packed_sample_bundle::read_record(size_t sample_id, char* buf) const {
+  if (sample_id >= m_num_samples) {
+    LBANN_ERROR("sample " + std::to_string(sample_id) + " is out of range ["
+                + "0, " + std::to_string(m_num_samples) + ")");
+  }
+  const auto it = std::upper_bound(m_shard_offsets.cbegin(), m_shard_offsets.cend(), sample_id);
+  const size_t shard = std::distance(m_shard_offsets.cbegin(), it) - 1;
+  off_t offset = static_cast<off_t>((sample_id - m_shard_offsets[shard]) * m_record_size);
+
+  size_t remaining = m_record_size;
+  while (remaining > 0u) {
+    const ssize_t n = pread(m_shard_fds[shard], buf, remaining, offset);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      LBANN_ERROR("failed to read sample " + std::to_string(sample_id)
+                  + " from shard " + std::to_string(shard) + ": "
+                  + ((n < 0) ? strerror(errno) : "unexpected end of file"));
+    }
+    buf += n;
+    offset += n;
+    remaining -= static_cast<size_t>(n);
+  }
+}
+
+double packed_sample_bundle::get_value(const char* record, const field_t& f, size_t i) {
+  if (f.type == field_type::float32) {
+    return static_cast<double>(reinterpret_cast<const float*>(record + f.offset)[i]);
+  }
+  return reinterpret_cast<const double*>(record + f.offset)[i];
+}
+
+size_t packed_sample_bundle::layout_fields(std::vector<field_t>& fields) {
+  constexpr size_t alignment = sizeof(double);
+  size_t offset = 0u;
+  for (auto& f : fields) {
+    f.path = normalize_path(f.path);
+    f.offset = offset;
+    offset += (f.get_num_bytes() + alignment - 1) / alignment * alignment;
+  }
+  return offset;
+}
+
+void packed_sample_bundle::write_index(const std::string& index_filename,
+                                       const std::vector<field_t>& fields,
+                                       size_t record_size,
+                                       const std::vector<std::pair<std::string, size_t>>& shards,
+                                       const std::vector<std::string>& sample_names) {
+  std::ofstream out(index_filename.c_str());
+  if (!out) {
+    LBANN_ERROR("failed to open " + index_filename + " for writing");
+  }
+  size_t num_samples = 0u;
+  for (const auto& s : shards) {
+    num_samples += s.second;
+  }
+
+  out << packed_index_magic << ' ' << packed_index_version << '\n'
+      << fields.size() << ' ' << record_size << '\n';
+  for (const auto& f : fields) {
+    out << to_string(f.type) << ' ' << f.num_elements << ' ' << f.offset
+        << ' ' << f.path << '\n';
+  }
+  out << shards.size() << ' ' << num_samples << '\n';
+  for (const auto& s : shards) {
+    out << s.first << ' ' << s.second << '\n';
+  }
+  for (const auto& name : sample_names) {
+    out << name << '\n';
+  }
+  if (!out) {
+    LBANN_ERROR("failed to write " + index_filename);
+  }
+}
+
+std::string packed_sample_bundle::normalize_path(const std::string& path) {
+  std::string p;
+  p.reserve(path.size());
+  for (const char c : path) {
+    if (c == '/' && (p.empty() || p.back() == '/')) {
+      continue;
+    }
+    p.push_back(c);
+  }
+  return p;
+}
+
+std::string packed_sample_bundle::to_string(field_type t) {
+  switch (t) {
+  case field_type::float32: return "float32";
+  case field_type::float64: return "float64";
+  default: LBANN_ERROR("invalid field type");
+  }
+  return "";
+}
+
+} // namespace lbann
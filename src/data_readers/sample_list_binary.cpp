@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/data_readers/sample_list_binary.hpp"
+#include "lbann/utils/exception.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lbann {
+
+namespace {
+
+const char sample_list_binary_magic[8] = {'L','B','S','M','P','L','0','1'};
+
+} // namespace
+
+bool sample_list_binary::is_binary_sample_list(const std::string& filename) {
+  std::ifstream in(filename.c_str(), std::ios::binary);
+  char magic[sizeof(sample_list_binary_magic)];
+  return in.read(magic, sizeof(magic))
+    && (std::memcmp(magic, sample_list_binary_magic, sizeof(magic)) == 0);
+}
+
+void sample_list_binary::write(const std::string& filename,
+                               const std::string& file_dir,
+                               const std::vector<file_t>& files) {
+  header hdr;
+  std::memset(&hdr, 0, sizeof(hdr));
+  std::memcpy(hdr.magic, sample_list_binary_magic, sizeof(hdr.magic));
+
+  std::vector<file_entry> file_entries(files.size());
+  std::vector<sample_entry> sample_entries;
+  std::string strings;
+
+  auto intern = [&strings](const std::string& s, uint64_t& offset, uint64_t& len) {
+    offset = strings.size();
+    len = s.size();
+    strings += s;
+  };
+
+  intern(file_dir, hdr.file_dir_offset, hdr.file_dir_len);
+  for (size_t f = 0u; f < files.size(); ++f) {
+    const file_t& src = files[f];
+    file_entry& e = file_entries[f];
+    if (src.sample_names.size() > src.total_samples) {
+      LBANN_ERROR("file " + src.name + " includes more samples than it holds");
+    }
+    intern(src.name, e.name_offset, e.name_len);
+    e.total_samples = src.total_samples;
+    e.first_sample = sample_entries.size();
+    e.num_samples = src.sample_names.size();
+    for (const auto& name : src.sample_names) {
+      sample_entry s;
+      intern(name, s.name_offset, s.name_len);
+      sample_entries.push_back(s);
+    }
+    hdr.num_included += e.num_samples;
+    hdr.num_excluded += e.total_samples - e.num_samples;
+  }
+
+  hdr.num_files = files.size();
+  hdr.files_offset = sizeof(header);
+  hdr.samples_offset = hdr.files_offset + file_entries.size() * sizeof(file_entry);
+  hdr.strings_offset = hdr.samples_offset + sample_entries.size() * sizeof(sample_entry);
+  hdr.strings_size = strings.size();
+
+  std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+  if (!out) {
+    LBANN_ERROR("failed to open " + filename + " for writing");
+  }
+  out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+  out.write(reinterpret_cast<const char*>(file_entries.data()),
+            file_entries.size() * sizeof(file_entry));
+  out.write(reinterpret_cast<const char*>(sample_entries.data()),
+            sample_entries.size() * sizeof(sample_entry));
+  out.write(strings.data(), strings.size());
+  if (!out) {
+    LBANN_ERROR("failed to write " + filename);
+  }
+}
+
+sample_list_binary::sample_list_binary(const std::string& filename)
+  : m_filename(filename) {
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LBANN_ERROR("failed to open " + filename + " for reading: " + strerror(errno));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    LBANN_ERROR("failed to stat " + filename + ": " + strerror(errno));
+  }
+  m_size = static_cast<size_t>(st.st_size);
+  if (m_size < sizeof(header)) {
+    close(fd);
+    LBANN_ERROR(filename + " is too short to be a binary sample list");
+  }
+  void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    LBANN_ERROR("failed to map " + filename + ": " + strerror(errno));
+  }
+  m_data = static_cast<const char*>(data);
+
+  m_header = reinterpret_cast<const header*>(m_data);
+  if (std::memcmp(m_header->magic, sample_list_binary_magic, sizeof(m_header->magic)) != 0) {
+    LBANN_ERROR(filename + " is not a binary sample list");
+  }
+  if (m_header->files_offset + m_header->num_files * sizeof(file_entry) > m_size
+      || m_header->samples_offset + m_header->num_included * sizeof(sample_entry) > m_size
+      || m_header->strings_offset + m_header->strings_size > m_size) {
+    LBANN_ERROR(filename + " is truncated");
+  }
+  m_files = reinterpret_cast<const file_entry*>(m_data + m_header->files_offset);
+  m_samples = reinterpret_cast<const sample_entry*>(m_data + m_header->samples_offset);
+}
+
+sample_list_binary::~sample_list_binary() {
+  if (m_data != nullptr) {
+    munmap(const_cast<char*>(m_data), m_size);
+  }
+}
+
+std::string sample_list_binary::get_file_dir() const {
+  return get_string(m_header->file_dir_offset, m_header->file_dir_len);
+}
+
+std::string sample_list_binary::get_filename(size_t i) const {
+  return get_string(m_files[i].name_offset, m_files[i].name_len);
+}
+
+std::string sample_list_binary::get_sample_name(size_t i) const {
+  return get_string(m_samples[i].name_offset, m_samples[i].name_len);
+}
+
+std::string sample_list_binary::get_string(uint64_t offset, uint64_t len) const {
+  if (offset + len > m_header->strings_size) {
+    LBANN_ERROR("string out of bounds in " + m_filename);
+  }
+  return std::string(m_data + m_header->strings_offset + offset, len);
+}
+
+} // namespace lbann
@@ -0,0 +1,118 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/data_readers/packed_sample_bundle.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using lbann::packed_sample_bundle;
+
+TEST_CASE("Testing packed sample bundle round trip", "[data_reader][utilities]") {
+  const std::string prefix = "packed_sample_bundle_test";
+  const std::string index_file = prefix + ".index";
+
+  // Fields of different sizes are aligned to eight bytes
+  std::vector<packed_sample_bundle::field_t> fields(3);
+  fields[0].path = "//inputs/shape_model_initial_modes:(4,3)";
+  fields[0].type = packed_sample_bundle::field_type::float64;
+  fields[0].num_elements = 1;
+  fields[1].path = "outputs/images/(0.0, 0.0)//0.0/emi";
+  fields[1].type = packed_sample_bundle::field_type::float32;
+  fields[1].num_elements = 5;
+  fields[2].path = "outputs/scalars/BWx";
+  fields[2].type = packed_sample_bundle::field_type::float32;
+  fields[2].num_elements = 1;
+  const size_t record_size = packed_sample_bundle::layout_fields(fields);
+  REQUIRE(fields[0].path == "inputs/shape_model_initial_modes:(4,3)");
+  REQUIRE(fields[1].path == "outputs/images/(0.0, 0.0)/0.0/emi");
+  REQUIRE(fields[0].offset == 0u);
+  REQUIRE(fields[1].offset == 8u);
+  REQUIRE(fields[2].offset == 32u);
+  REQUIRE(record_size == 40u);
+
+  // Value of element i of field f in sample s
+  auto value = [](size_t s, size_t f, size_t i) {
+    return double(100 * s + 10 * f + i) / 4;
+  };
+
+  // Write two shards with three and two samples
+  const std::vector<std::pair<std::string, size_t>> shards = {
+    {prefix + ".0.bin", 3}, {prefix + ".1.bin", 2}};
+  std::vector<std::string> sample_names;
+  size_t sample = 0;
+  for (const auto& shard : shards) {
+    std::ofstream out(shard.first, std::ios::binary);
+    for (size_t j = 0; j < shard.second; ++j, ++sample) {
+      std::vector<char> record(record_size, 0);
+      for (size_t f = 0; f < fields.size(); ++f) {
+        for (size_t i = 0; i < fields[f].num_elements; ++i) {
+          char* dst = record.data() + fields[f].offset;
+          if (fields[f].type == packed_sample_bundle::field_type::float32) {
+            reinterpret_cast<float*>(dst)[i] = float(value(sample, f, i));
+          } else {
+            reinterpret_cast<double*>(dst)[i] = value(sample, f, i);
+          }
+        }
+      }
+      out.write(record.data(), record.size());
+      sample_names.push_back("bundle.h5 sample" + std::to_string(sample));
+    }
+  }
+  packed_sample_bundle::write_index(index_file, fields, record_size,
+                                    shards, sample_names);
+  REQUIRE(packed_sample_bundle::is_packed_index(index_file));
+  REQUIRE_FALSE(packed_sample_bundle::is_packed_index(shards[0].first));
+
+  // Read every record back
+  {
+    packed_sample_bundle bundle;
+    bundle.load(index_file);
+    REQUIRE(bundle.size() == 5u);
+    REQUIRE(bundle.get_record_size() == record_size);
+    REQUIRE(bundle.get_fields().size() == fields.size());
+    for (size_t f = 0; f < fields.size(); ++f) {
+      const auto& loaded = bundle.get_fields()[f];
+      CHECK(loaded.path == fields[f].path);
+      CHECK(loaded.type == fields[f].type);
+      CHECK(loaded.num_elements == fields[f].num_elements);
+      CHECK(loaded.offset == fields[f].offset);
+    }
+    REQUIRE(bundle.find_field("/outputs//scalars/BWx") == &bundle.get_fields()[2]);
+    REQUIRE(bundle.find_field("outputs/scalars/BWy") == nullptr);
+
+    std::vector<char> record(record_size);
+    std::vector<double> out(5);
+    for (size_t s = bundle.size(); s-- > 0;) {
+      bundle.read_record(s, record.data());
+      for (size_t f = 0; f < fields.size(); ++f) {
+        const auto& field = bundle.get_fields()[f];
+        packed_sample_bundle::copy_field(record.data(), field, out.data());
+        for (size_t i = 0; i < field.num_elements; ++i) {
+          CHECK(packed_sample_bundle::get_value(record.data(), field, i)
+                == value(s, f, i));
+          CHECK(out[i] == value(s, f, i));
+        }
+      }
+    }
+    REQUIRE_THROWS(bundle.read_record(bundle.size(), record.data()));
+  }
+
+  // A truncated shard cannot be read past its end
+  {
+    std::ofstream(shards[1].first, std::ios::binary).write("x", 1);
+    packed_sample_bundle bundle;
+    bundle.load(index_file);
+    std::vector<char> record(record_size);
+    REQUIRE_THROWS(bundle.read_record(3, record.data()));
+  }
+
+  std::remove(index_file.c_str());
+  for (const auto& shard : shards) {
+    std::remove(shard.first.c_str());
+  }
+}
@@ -0,0 +1,158 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/data_readers/sample_list_binary.hpp>
+#include <conduit/conduit.hpp>
+#include <lbann/data_readers/sample_list_open_files.hpp>
+
+#include <sys/stat.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace lbann {
+template <>
+inline FILE* uninitialized_file_handle<FILE*>() {
+  return nullptr;
+}
+} // namespace lbann
+
+namespace {
+
+/** Sample list over text bundles that hold one sample name per line */
+class text_bundle_sample_list
+  : public lbann::sample_list_open_files<std::string, FILE*> {
+ public:
+  using file_handle_t = FILE*;
+
+  ~text_bundle_sample_list() override {
+    for (auto& f : this->m_file_id_stats_map) {
+      close_file_handle(std::get<1>(f));
+    }
+  }
+
+  bool is_file_handle_valid(const file_handle_t& h) const override {
+    return (h != nullptr);
+  }
+
+ protected:
+  void obtain_sample_names(file_handle_t& h, std::vector<std::string>& sample_names) const override {
+    sample_names.clear();
+    char buf[256];
+    std::rewind(h);
+    while (std::fscanf(h, "%255s", buf) == 1) {
+      sample_names.emplace_back(buf);
+    }
+  }
+  file_handle_t open_file_handle_for_read(const std::string& path) override {
+    return std::fopen(path.c_str(), "r");
+  }
+  void close_file_handle(file_handle_t& h) override {
+    if (is_file_handle_valid(h)) {
+      std::fclose(h);
+      h = nullptr;
+    }
+  }
+  void clear_file_handle(file_handle_t& h) override {
+    h = nullptr;
+  }
+};
+
+void write_lines(const std::string& filename, const std::vector<std::string>& lines) {
+  std::ofstream ofs(filename);
+  for (const auto& l : lines) {
+    ofs << l << '\n';
+  }
+}
+
+} // namespace
+
+TEST_CASE("Testing binary sample list writer and reader", "[data_reader][utilities]") {
+  const std::string filename = "sample_list_binary_test.bin";
+
+  // Files are neither sorted nor contiguous in their sample indices
+  std::vector<lbann::sample_list_binary::file_t> files(3);
+  files[0] = {"zeta.bundle", 4u, {"s3", "s1"}};
+  files[1] = {"alpha.bundle", 2u, {"s0", "s1"}};
+  files[2] = {"mu.bundle", 3u, {"sample_with_a_long_name"}};
+  lbann::sample_list_binary::write(filename, "/data/dir", files);
+
+  REQUIRE(lbann::sample_list_binary::is_binary_sample_list(filename));
+  {
+    const lbann::sample_list_binary list(filename);
+    CHECK(list.get_num_files() == files.size());
+    CHECK(list.get_num_included() == 5u);
+    CHECK(list.get_num_excluded() == 4u);
+    CHECK(list.get_file_dir() == "/data/dir");
+
+    size_t first_sample = 0u;
+    for (size_t f = 0u; f < files.size(); ++f) {
+      const auto& e = list.get_file(f);
+      CHECK(list.get_filename(f) == files[f].name);
+      CHECK(e.total_samples == files[f].total_samples);
+      CHECK(e.first_sample == first_sample);
+      REQUIRE(e.num_samples == files[f].sample_names.size());
+      for (size_t s = 0u; s < e.num_samples; ++s) {
+        CHECK(list.get_sample_name(e.first_sample + s) == files[f].sample_names[s]);
+      }
+      first_sample += e.num_samples;
+    }
+  }
+  std::remove(filename.c_str());
+}
+
+TEST_CASE("Testing binary sample list against the text sample list", "[data_reader][utilities]") {
+  const std::string data_dir = "sample_list_binary_test_data";
+  const std::string text_file = "sample_list_binary_test.txt";
+  const std::string binary_file = "sample_list_binary_test.bin";
+  ::mkdir(data_dir.c_str(), 0755);
+  write_lines(data_dir + "/b.bundle", {"s0", "s1", "s2"});
+  write_lines(data_dir + "/a.bundle", {"t0", "t1"});
+
+  // List the bundles out of name order to check that it is preserved
+  write_lines(text_file, {lbann::sample_inclusion_list,
+                          "3 2 2",
+                          data_dir,
+                          "b.bundle 2 1 s2 s0",
+                          "a.bundle 1 1 t1"});
+
+  text_bundle_sample_list text_list;
+  text_list.load(text_file);
+  REQUIRE(text_list.size() == 3u);
+  text_list.write_binary(binary_file);
+  REQUIRE(lbann::sample_list_binary::is_binary_sample_list(binary_file));
+
+  text_bundle_sample_list binary_list;
+  binary_list.load(binary_file);
+
+  const auto& text_header = text_list.get_header();
+  const auto& binary_header = binary_list.get_header();
+  CHECK(binary_header.is_exclusive() == text_header.is_exclusive());
+  CHECK(binary_header.get_sample_count() == text_header.get_sample_count());
+  CHECK(binary_header.get_num_files() == text_header.get_num_files());
+  CHECK(binary_header.get_file_dir() == text_header.get_file_dir());
+
+  REQUIRE(binary_list.size() == text_list.size());
+  REQUIRE(binary_list.get_num_files() == text_list.get_num_files());
+  for (size_t i = 0u; i < text_list.size(); ++i) {
+    CHECK(binary_list.get_samples_filename(binary_list[i].first)
+          == text_list.get_samples_filename(text_list[i].first));
+    CHECK(binary_list[i].second == text_list[i].second);
+  }
+  CHECK(binary_list.get_samples_filename(0) == "b.bundle");
+  CHECK(binary_list.get_samples_filename(1) == "a.bundle");
+
+  // The text form also carries the per-file sample totals
+  std::string text_str, binary_str;
+  text_list.to_string(text_str);
+  binary_list.to_string(binary_str);
+  CHECK(binary_str == text_str);
+
+  std::remove(binary_file.c_str());
+  std::remove(text_file.c_str());
+  std::remove((data_dir + "/a.bundle").c_str());
+  std::remove((data_dir + "/b.bundle").c_str());
+  ::rmdir(data_dir.c_str());
+}
@@ -32,6 +32,7 @@
 #include "lbann/utils/exception.hpp"
 #include "lbann/utils/options.hpp"
 #include "lbann/utils/timer.hpp"
+#include <algorithm>
 #include <unordered_set>
 #include <sys/mman.h>
 #include <sys/stat.h>
@@ -67,6 +68,34 @@ namespace lbann {
     throw lbann::exception(ss_LBANN_ERROR.str());               \
   } while (0)
 
+namespace {
+
+/// Points 'out' at the sample data of a buffer laid out by
+/// build_node_for_sending; nothing is copied
+void unpack_compacted_sample(conduit::uint8 *buf, conduit::Node &out) {
+  conduit::Node n_msg;
+  n_msg["schema_len"].set_external((conduit::int64*)buf);
+  buf += 8;
+  n_msg["schema"].set_external_char8_str((char*)(buf));
+  conduit::Schema rcv_schema;
+  conduit::Generator gen(n_msg["schema"].as_char8_str());
+  gen.walk(rcv_schema);
+  buf += n_msg["schema"].total_bytes_compact();
+  n_msg["data"].set_external(rcv_schema, buf);
+  out.set_external(n_msg["data"]);
+}
+
+/// FNV-1a hash, used to tell apart samples that share a data_id
+size_t hash_bytes(const char *buf, size_t len) {
+  uint64_t h = 14695981039346656037ULL;
+  for (size_t j=0; j<len; j++) {
+    h = (h ^ static_cast<unsigned char>(buf[j])) * 1099511628211ULL;
+  }
+  return static_cast<size_t>(h);
+}
+
+} // namespace
+
 data_store_conduit::data_store_conduit(
   generic_data_reader *reader) :
   m_reader(reader) {
@@ -83,6 +112,12 @@ data_store_conduit::data_store_conduit(
 
   options *opts = options::get();
   m_super_node = opts->get_bool("super_node");
+  m_locality_window = opts->get_int("data_store_locality", 0);
+  if (m_locality_window < 0) {
+    LBANN_ERROR("--data_store_locality must be a number of mini-batches >= 0");
+  }
+  m_report_exchange_stats = m_locality_window > 0 || opts->get_bool("data_store_exchange_stats");
+  m_node_shared = opts->get_bool("data_store_node_shared");
 
   if (opts->get_bool("debug")) {
     std::stringstream ss;
@@ -98,15 +133,24 @@ data_store_conduit::data_store_conduit(
   if (m_is_local_cache && !m_preload) {
     LBANN_ERROR("data_store_cache is currently only implemented for preload mode; this will change in the future. For now, pleas pass both flags: data_store_cache and --preload_data_store");
   }
+  if (m_node_shared && (m_is_local_cache || m_super_node)) {
+    LBANN_ERROR("--data_store_node_shared works with the per-sample exchange only; it can't be combined with --data_store_cache or --super_node");
+  }
 
   if (m_world_master) {
     if (m_is_local_cache) {
       std::cerr << "data_store_conduit is running in local_cache mode\n";
     } else if (m_super_node) {
       std::cerr << "data_store_conduit is running in super_node mode\n";
+    } else if (m_node_shared) {
+      std::cerr << "data_store_conduit is running in multi-message mode with a node-shared store\n";
     } else {
       std::cerr << "data_store_conduit is running in multi-message mode\n";
     }
+    if (m_locality_window > 0) {
+      std::cerr << "data_store_conduit is using locality-aware ordering within "
+                << m_locality_window << " mini-batch(es)\n";
+    }
   }
 }
 
@@ -158,6 +202,8 @@ void data_store_conduit::copy_members(const data_store_conduit& rhs, const std::
   m_explicit_loading = rhs.m_explicit_loading;
   m_owner_map_mb_size = rhs.m_owner_map_mb_size;
   m_super_node = rhs.m_super_node;
+  m_locality_window = rhs.m_locality_window;
+  m_report_exchange_stats = rhs.m_report_exchange_stats;
   m_compacted_sample_size = rhs.m_compacted_sample_size;
   m_is_local_cache = rhs.m_is_local_cache;
   m_node_sizes_vary = rhs.m_node_sizes_vary;
@@ -174,6 +220,10 @@ void data_store_conduit::copy_members(const data_store_conduit& rhs, const std::
   m_mem_seg = rhs.m_mem_seg;
   m_mem_seg_length = rhs.m_mem_seg_length;
   m_seg_name = rhs.m_seg_name;
+  m_node_shared = rhs.m_node_shared;
+  m_node_seg = rhs.m_node_seg;
+  m_node_index = rhs.m_node_index;
+  m_node_local_ranks = rhs.m_node_local_ranks;
   m_image_offsets = rhs.m_image_offsets;
 
   /// This block needed when carving a validation set from the training set
@@ -334,6 +384,14 @@ void data_store_conduit::exchange_data_by_super_node(size_t current_pos, size_t
   m_comm->wait_all<El::byte>(m_send_requests);
   m_comm->wait_all<El::byte>(m_recv_requests);
 
+  size_t bytes_sent = 0;
+  for (int p=0; p<m_np_in_trainer; p++) {
+    if (p != m_rank_in_trainer) {
+      bytes_sent += m_outgoing_msg_sizes[p];
+    }
+  }
+  record_exchange_stats(bytes_sent);
+
   //========================================================================
   //part 2: exchange the actual data
 
@@ -599,6 +657,12 @@ void data_store_conduit::exchange_data_by_sample(size_t current_pos, size_t mb_s
     exchange_sample_sizes();
   }
 
+  /// the node-shared store is built once, when every rank holds all
+  /// of the samples it owns
+  if (m_node_shared && m_node_local_ranks.empty()) {
+    build_node_shared_store();
+  }
+
   if (m_output) {
     m_output << "starting data_store_conduit::exchange_data_by_sample; mb_size: " << mb_size << std::endl;
   }
@@ -616,6 +680,7 @@ void data_store_conduit::exchange_data_by_sample(size_t current_pos, size_t mb_s
 
   // start sends for outgoing data
   size_t ss = 0;
+  size_t bytes_sent = 0;
   for (int p=0; p<m_np_in_trainer; p++) {
     const std::unordered_set<int> &indices = m_indices_to_send[p];
     for (auto index : indices) {
@@ -648,8 +713,12 @@ void data_store_conduit::exchange_data_by_sample(size_t current_pos, size_t mb_s
       }
 
       m_comm->nb_tagged_send<El::byte>(s, sz, p, index, m_send_requests[ss++], m_comm->get_trainer_comm());
+      if (p != m_rank_in_trainer) {
+        bytes_sent += sz;
+      }
     }
   }
+  record_exchange_stats(bytes_sent);
 
   // sanity checks
   if (ss != m_send_requests.size()) {
@@ -695,33 +764,37 @@ void data_store_conduit::exchange_data_by_sample(size_t current_pos, size_t mb_s
   //========================================================================
   //part 3: construct the Nodes needed by me for the current minibatch
 
-  conduit::Node nd;
   m_minibatch_data.clear();
   for (size_t j=0; j < m_recv_buffer.size(); j++) {
     conduit::uint8 *n_buff_ptr = (conduit::uint8*)m_recv_buffer[j].data_ptr();
-    conduit::Node n_msg;
-    n_msg["schema_len"].set_external((conduit::int64*)n_buff_ptr);
-    n_buff_ptr +=8;
-    n_msg["schema"].set_external_char8_str((char*)(n_buff_ptr));
-    conduit::Schema rcv_schema;
-    conduit::Generator gen(n_msg["schema"].as_char8_str());
-    gen.walk(rcv_schema);
-    n_buff_ptr += n_msg["schema"].total_bytes_compact();
-    n_msg["data"].set_external(rcv_schema,n_buff_ptr);
-
     int data_id = m_recv_data_ids[j];
-    m_minibatch_data[data_id].set_external(n_msg["data"]);
+    unpack_compacted_sample(n_buff_ptr, m_minibatch_data[data_id]);
+  }
+
+  // samples owned on this node are read in place from the shared store
+  for (auto index : m_node_reads) {
+    auto t = m_node_index.find(index);
+    if (t == m_node_index.end()) {
+      LBANN_ERROR("data_id: " + std::to_string(index) + " is owned on this node but is not in the node-shared store; samples added after the first exchange can't be shared");
+    }
+    conduit::uint8 *n_buff_ptr = (conduit::uint8*)(m_node_seg.get() + t->second.first);
+    unpack_compacted_sample(n_buff_ptr, m_minibatch_data[index]);
   }
 }
 
 int data_store_conduit::build_indices_i_will_recv(int current_pos, int mb_size) {
   m_indices_to_recv.clear();
   m_indices_to_recv.resize(m_np_in_trainer);
+  m_node_reads.clear();
   int k = 0;
   for (int i=current_pos; i< current_pos + mb_size; ++i) {
     auto index = (*m_shuffled_indices)[i];
     if ((i % m_owner_map_mb_size) % m_np_in_trainer == m_rank_in_trainer) {
       int owner = m_owner[index];
+      if (is_node_shared(owner, m_rank_in_trainer)) {
+        m_node_reads.push_back(index);
+        continue;
+      }
       m_indices_to_recv[owner].insert(index);
       k++;
     }
@@ -740,7 +813,11 @@ int data_store_conduit::build_indices_i_will_send(int current_pos, int mb_size)
     auto index = (*m_shuffled_indices)[i];
     /// If this rank owns the index send it to the (i%m_np)'th rank
     if (m_data.find(index) != m_data.end()) {
-      m_indices_to_send[(i % m_owner_map_mb_size) % m_np_in_trainer].insert(index);
+      const int reader = (i % m_owner_map_mb_size) % m_np_in_trainer;
+      if (is_node_shared(m_rank_in_trainer, reader)) {
+        continue;
+      }
+      m_indices_to_send[reader].insert(index);
 
       // Sanity check
       if (m_owner[index] != m_rank_in_trainer) {
@@ -754,6 +831,127 @@ int data_store_conduit::build_indices_i_will_send(int current_pos, int mb_size)
   return k;
 }
 
+void data_store_conduit::record_exchange_stats(size_t bytes_sent) {
+  if (!m_report_exchange_stats) {
+    return;
+  }
+  m_exchange_bytes_sent += bytes_sent;
+  m_exchange_local_samples += m_node_reads.size();
+  for (int p=0; p<m_np_in_trainer; p++) {
+    if (p == m_rank_in_trainer) {
+      m_exchange_local_samples += m_indices_to_recv[p].size();
+    } else {
+      m_exchange_remote_samples += m_indices_to_recv[p].size();
+    }
+  }
+  ++m_exchange_steps;
+}
+
+void data_store_conduit::report_exchange_stats() {
+  if (m_trainer_master) {
+    const double steps = m_exchange_steps;
+    const size_t total = m_exchange_local_samples + m_exchange_remote_samples;
+    std::cerr << "data_store_conduit exchange stats for role: " << m_reader->get_role()
+              << "; rank " << m_rank_in_trainer << " of trainer " << m_comm->get_trainer_rank()
+              << " over " << m_exchange_steps << " steps; per step: "
+              << m_exchange_bytes_sent / steps << " bytes sent to other ranks, "
+              << m_exchange_remote_samples / steps << " samples received from other ranks, "
+              << m_exchange_local_samples / steps << " samples owned locally ("
+              << (total ? 100.0 * m_exchange_local_samples / total : 0.0) << "%)\n";
+  }
+  m_exchange_bytes_sent = 0;
+  m_exchange_remote_samples = 0;
+  m_exchange_local_samples = 0;
+  m_exchange_steps = 0;
+}
+
+void data_store_conduit::apply_locality_order(std::vector<int>& indices) {
+  if (m_report_exchange_stats && m_exchange_steps > 0) {
+    report_exchange_stats();
+  }
+
+  // Ownership is settled once the first exchange has happened, which
+  // every rank sees at the same time; before that, non-preloaded
+  // stores are still being primed and samples must stay with the rank
+  // that reads them.
+  if (m_locality_window == 0 || m_n == 0 || m_is_local_cache || m_owner_map_mb_size == 0) {
+    return;
+  }
+
+  const size_t mb_size = m_owner_map_mb_size;
+  const size_t window = mb_size * m_locality_window;
+  const size_t n = indices.size();
+  std::vector<int> ordered(n);
+  std::vector<std::vector<size_t>> owned(m_np_in_trainer);
+  std::vector<size_t> next(m_np_in_trainer);
+  std::vector<size_t> open_slots;
+  std::vector<bool> placed;
+  size_t local_before = 0;
+  size_t local_after = 0;
+  size_t moved = 0;
+  double displacement = 0.0;
+
+  for (size_t start = 0; start < n; start += window) {
+    const size_t end = std::min(start + window, n);
+    for (auto& v : owned) {
+      v.clear();
+    }
+    std::fill(next.begin(), next.end(), 0);
+    placed.assign(end - start, false);
+    open_slots.clear();
+
+    // bucket the positions of the window by the owner of their sample;
+    // each bucket stays in shuffled order
+    for (size_t j = start; j < end; ++j) {
+      const auto it = m_owner.find(indices[j]);
+      if (it == m_owner.end()) {
+        continue;
+      }
+      owned[it->second].push_back(j);
+      if (it->second == static_cast<int>((j % mb_size) % m_np_in_trainer)) {
+        ++local_before;
+      }
+    }
+
+    // give every slot the earliest remaining sample owned by the rank
+    // that reads the slot
+    for (size_t i = start; i < end; ++i) {
+      const int reader = (i % mb_size) % m_np_in_trainer;
+      if (next[reader] == owned[reader].size()) {
+        open_slots.push_back(i);
+        continue;
+      }
+      const size_t j = owned[reader][next[reader]++];
+      placed[j - start] = true;
+      ordered[i] = indices[j];
+      ++local_after;
+      displacement += (i > j) ? i - j : j - i;
+      moved += (i / mb_size != j / mb_size);
+    }
+
+    // the remaining samples fill the remaining slots in shuffled order
+    size_t k = 0;
+    for (size_t j = start; j < end; ++j) {
+      if (placed[j - start]) {
+        continue;
+      }
+      const size_t i = open_slots[k++];
+      ordered[i] = indices[j];
+      displacement += (i > j) ? i - j : j - i;
+      moved += (i / mb_size != j / mb_size);
+    }
+  }
+  indices.swap(ordered);
+
+  if (m_world_master && n > 0) {
+    std::cerr << "data_store_conduit locality order for role: " << m_reader->get_role()
+              << "; samples read by their owner: " << 100.0 * local_before / n
+              << "% -> " << 100.0 * local_after / n
+              << "%; samples moved to another mini-batch: " << 100.0 * moved / n
+              << "%; mean displacement: " << displacement / n << " positions\n";
+  }
+}
+
 void data_store_conduit::build_preloaded_owner_map(const std::vector<int>& per_rank_list_sizes) {
   m_owner.clear();
   int owning_rank = 0;
@@ -1342,4 +1540,135 @@ void data_store_conduit::exchange_images(std::vector<char> &work, std::unordered
 }
 
 
+void data_store_conduit::build_node_shared_store() {
+  const El::mpi::Comm& node_comm = m_comm->get_node_comm();
+  const int node_rank = m_comm->get_rank_in_node();
+  const int np_node = m_comm->get_procs_per_node();
+  double tm1 = get_time();
+
+  m_node_local_ranks.resize(m_np_in_trainer);
+  for (int p=0; p<m_np_in_trainer; p++) {
+    m_node_local_ranks[p] = m_comm->is_rank_node_local(p, m_comm->get_trainer_comm());
+  }
+
+  // gather (data_id, size, hash) for every sample held on the node; the
+  // leading triple of each rank is padding, so no list is empty
+  std::vector<size_t> mine(3, 0);
+  mine.reserve(3 * (m_data.size() + 1));
+  for (const auto &t : m_data) {
+    const size_t sz = t.second.total_bytes_compact();
+    mine.push_back(t.first);
+    mine.push_back(sz);
+    mine.push_back(hash_bytes(static_cast<const char*>(t.second.data_ptr()), sz));
+  }
+  int my_count = mine.size();
+  std::vector<int> counts(np_node);
+  m_comm->all_gather(my_count, counts, node_comm);
+  std::vector<int> disp(np_node + 1, 0);
+  for (int h=0; h<np_node; h++) {
+    disp[h+1] = disp[h] + counts[h];
+  }
+  std::vector<size_t> work(disp[np_node]);
+  m_comm->all_gather(mine, work, counts, disp, node_comm);
+
+  // the first rank that holds a sample writes it; the same data_id
+  // from other ranks, e.g, from other trainers, must hold the same bytes
+  m_node_index.clear();
+  std::unordered_map<int, size_t> hashes;
+  std::vector<int> my_writes;
+  size_t length = 0;
+  size_t num_held = 0;
+  for (int h=0; h<np_node; h++) {
+    for (int k=disp[h]+3; k<disp[h+1]; k+=3) {
+      const int data_id = work[k];
+      const size_t sz = work[k+1];
+      ++num_held;
+      auto t = hashes.find(data_id);
+      if (t != hashes.end()) {
+        if (t->second != work[k+2]) {
+          LBANN_ERROR("data_id: " + std::to_string(data_id) + " holds different samples on ranks of this node; --data_store_node_shared requires all trainers on a node to read the same data set");
+        }
+        continue;
+      }
+      hashes[data_id] = work[k+2];
+      m_node_index[data_id] = std::make_pair(length, sz);
+      if (h == node_rank) {
+        my_writes.push_back(data_id);
+      }
+      // keep every sample 8-byte aligned
+      length += (sz + 7) / 8 * 8;
+    }
+  }
+  length = std::max(length, size_t(8));
+
+  struct statvfs stat;
+  if (statvfs("/dev/shm", &stat) != 0) {
+    LBANN_ERROR("statvfs failed\n");
+  }
+  const size_t avail_mem = stat.f_bsize*stat.f_bavail;
+  if (length >= avail_mem) {
+    LBANN_ERROR("insufficient shared memory for the node-shared store; required: " + std::to_string(length) + " available: " + std::to_string(avail_mem));
+  }
+
+  // the name only has to be unique while the ranks attach to it
+  int pid = getpid();
+  m_comm->broadcast(0, pid, node_comm);
+  const std::string seg_name = "/lbann_ds_" + m_reader->get_role() + "_" + std::to_string(pid);
+
+  int shm_fd = -1;
+  if (node_rank == 0) {
+    shm_fd = shm_open(seg_name.c_str(), O_CREAT | O_RDWR | O_EXCL, 0600);
+    if (shm_fd == -1) {
+      LBANN_ERROR("shm_open failed for " + seg_name);
+    }
+    if (ftruncate(shm_fd, length) != 0) {
+      LBANN_ERROR("ftruncate failed for size: " + std::to_string(length));
+    }
+  }
+  m_comm->barrier(node_comm);
+  if (node_rank != 0) {
+    shm_fd = shm_open(seg_name.c_str(), O_RDWR, 0600);
+    if (shm_fd == -1) {
+      LBANN_ERROR("shm_open failed for " + seg_name);
+    }
+  }
+  void *m = mmap(0, length, PROT_WRITE | PROT_READ, MAP_SHARED, shm_fd, 0);
+  if (m == MAP_FAILED) {
+    LBANN_ERROR("mmap failed");
+  }
+  close(shm_fd);
+  m_node_seg = std::shared_ptr<char>(reinterpret_cast<char*>(m),
+                                     [length](char *p) { munmap(p, length); });
+
+  // every rank has attached, so the segment can be unlinked; it lives
+  // until the last mapping goes away, even if the run aborts
+  m_comm->barrier(node_comm);
+  if (node_rank == 0) {
+    shm_unlink(seg_name.c_str());
+  }
+
+  for (auto data_id : my_writes) {
+    const conduit::Node &nd = m_data[data_id];
+    const auto &t = m_node_index[data_id];
+    memcpy(m_node_seg.get() + t.first, nd.data_ptr(), t.second);
+  }
+  m_comm->barrier(node_comm);
+  if (mprotect(m, length, PROT_READ) != 0) {
+    LBANN_ERROR("mprotect failed");
+  }
+
+  // drop the private copies; the nodes now view the shared samples
+  for (auto &t : m_data) {
+    const conduit::Schema s = t.second.schema();
+    t.second.set_external(s, m_node_seg.get() + m_node_index[t.first].first);
+  }
+
+  if (m_world_master) {
+    std::cerr << "data_store_conduit node-shared store for role: " << m_reader->get_role()
+              << "; " << m_node_index.size() << " samples (" << num_held
+              << " held by ranks on the node); segment size: " << length
+              << " bytes; time: " << get_time() - tm1 << "\n";
+  }
+}
+
 }  // namespace lbann
@@ -0,0 +1,139 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/data_store/data_store_conduit.hpp>
+
+#include "TestHelpers.hpp"
+#include <lbann/data_readers/data_reader_synthetic.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+/** Data store whose ownership is set up by the test */
+class test_data_store : public lbann::data_store_conduit {
+ public:
+  using lbann::data_store_conduit::data_store_conduit;
+
+  /** Ownership as set up by build_owner_map in an earlier epoch */
+  void set_ownership(const std::vector<int>& previous, int mb_size,
+                     int num_ranks, int window) {
+    m_np_in_trainer = num_ranks;
+    m_owner_map_mb_size = mb_size;
+    m_locality_window = window;
+    m_owner.clear();
+    for (size_t i = 0; i < previous.size(); ++i) {
+      m_owner[previous[i]] = (i % mb_size) % num_ranks;
+    }
+  }
+  void start_exchanges() { m_n = 1; }
+  int owner(int index) const { return m_owner.at(index); }
+};
+
+std::vector<int> shuffled(int n, unsigned seed) {
+  std::vector<int> indices(n);
+  std::iota(indices.begin(), indices.end(), 0);
+  std::mt19937 gen(seed);
+  std::shuffle(indices.begin(), indices.end(), gen);
+  return indices;
+}
+
+/** Rank that reads the sample at a position. */
+int reading_rank(size_t pos, int mb_size, int num_ranks) {
+  return (pos % mb_size) % num_ranks;
+}
+
+/** Samples in [begin, end) read by their owner. */
+size_t count_local(const test_data_store& ds, const std::vector<int>& indices,
+                   size_t begin, size_t end, int mb_size, int num_ranks) {
+  size_t count = 0;
+  for (size_t i = begin; i < end; ++i) {
+    count += (ds.owner(indices[i]) == reading_rank(i, mb_size, num_ranks));
+  }
+  return count;
+}
+
+/** Most samples in [begin, end) that can be read by their owner. */
+size_t max_local(const test_data_store& ds, const std::vector<int>& indices,
+                 size_t begin, size_t end, int mb_size, int num_ranks) {
+  std::vector<size_t> slots(num_ranks, 0), owned(num_ranks, 0);
+  for (size_t i = begin; i < end; ++i) {
+    ++slots[reading_rank(i, mb_size, num_ranks)];
+    ++owned[ds.owner(indices[i])];
+  }
+  size_t count = 0;
+  for (int r = 0; r < num_ranks; ++r) {
+    count += std::min(slots[r], owned[r]);
+  }
+  return count;
+}
+
+bool same_samples(std::vector<int> a, std::vector<int> b) {
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+  return a == b;
+}
+
+} // namespace
+
+TEST_CASE("Testing locality-aware data store ordering", "[data_store]") {
+  auto& comm = unit_test::utilities::current_world_comm();
+  lbann::data_reader_synthetic reader(96, 4);
+  reader.set_comm(&comm);
+  reader.set_role("train");
+  test_data_store ds(&reader);
+
+  const int num_samples = 96, mb_size = 12, num_ranks = 4;
+  const auto previous = shuffled(num_samples, 1);
+  const auto epoch = shuffled(num_samples, 2);
+
+  SECTION("Nothing moves before the first exchange or without a window") {
+    auto indices = epoch;
+    ds.set_ownership(previous, mb_size, num_ranks, 1);
+    ds.apply_locality_order(indices);
+    CHECK(indices == epoch);
+    ds.start_exchanges();
+    ds.set_ownership(previous, mb_size, num_ranks, 0);
+    ds.apply_locality_order(indices);
+    CHECK(indices == epoch);
+  }
+
+  SECTION("A window of one mini-batch keeps every mini-batch") {
+    auto indices = epoch;
+    ds.set_ownership(previous, mb_size, num_ranks, 1);
+    ds.start_exchanges();
+    ds.apply_locality_order(indices);
+    REQUIRE(same_samples(indices, epoch));
+    for (int start = 0; start < num_samples; start += mb_size) {
+      const std::vector<int> before(epoch.begin() + start, epoch.begin() + start + mb_size);
+      const std::vector<int> after(indices.begin() + start, indices.begin() + start + mb_size);
+      CHECK(same_samples(before, after));
+      CHECK(count_local(ds, indices, start, start + mb_size, mb_size, num_ranks)
+            == max_local(ds, epoch, start, start + mb_size, mb_size, num_ranks));
+    }
+    CHECK(count_local(ds, indices, 0, num_samples, mb_size, num_ranks)
+          >= count_local(ds, epoch, 0, num_samples, mb_size, num_ranks));
+  }
+
+  SECTION("Samples stay within larger windows") {
+    const int window = 3;
+    const int window_size = window * mb_size;
+    auto indices = epoch;
+    ds.set_ownership(previous, mb_size, num_ranks, window);
+    ds.start_exchanges();
+    ds.apply_locality_order(indices);
+    REQUIRE(same_samples(indices, epoch));
+    for (int start = 0; start < num_samples; start += window_size) {
+      const int end = std::min(start + window_size, num_samples);
+      const std::vector<int> before(epoch.begin() + start, epoch.begin() + end);
+      const std::vector<int> after(indices.begin() + start, indices.begin() + end);
+      CHECK(same_samples(before, after));
+      CHECK(count_local(ds, indices, start, end, mb_size, num_ranks)
+            == max_local(ds, epoch, start, end, mb_size, num_ranks));
+    }
+  }
+}
@@ -0,0 +1,130 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/data_store/data_store_conduit.hpp>
+
+#include "TestHelpers.hpp"
+#include <lbann/data_readers/data_reader_synthetic.hpp>
+#include <lbann/utils/options.hpp>
+
+#include <conduit/conduit.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+/** Data store that reports where its samples are read from */
+class test_data_store : public lbann::data_store_conduit {
+ public:
+  using lbann::data_store_conduit::data_store_conduit;
+
+  bool has_node_store() const { return m_node_seg != nullptr; }
+  size_t num_node_reads() const { return m_node_reads.size(); }
+  size_t num_node_samples() const { return m_node_index.size(); }
+  int rank() const { return m_rank_in_trainer; }
+  int num_ranks() const { return m_np_in_trainer; }
+  bool owned_on_node(int owner) const { return is_node_shared(owner, m_rank_in_trainer); }
+
+  /** True if the owned sample is held in the node-wide segment */
+  bool in_node_store(int data_id) const {
+    const auto* p = static_cast<const char*>(m_data.at(data_id).data_ptr());
+    const auto t = m_node_index.find(data_id);
+    return t != m_node_index.end() && p == m_node_seg.get() + t->second.first;
+  }
+};
+
+const int sample_size = 8;
+
+void make_sample(int data_id, conduit::Node& node) {
+  std::vector<float> values(sample_size);
+  std::iota(values.begin(), values.end(), static_cast<float>(data_id));
+  node.reset();
+  node["id"] = static_cast<conduit::int64>(data_id);
+  node["values"].set(values);
+}
+
+void check_sample(int data_id, const conduit::Node& node) {
+  CHECK(node["id"].as_int64() == data_id);
+  const conduit::float32* values = node["values"].as_float32_ptr();
+  for (int k = 0; k < sample_size; ++k) {
+    CHECK(values[k] == static_cast<float>(data_id + k));
+  }
+}
+
+/** Stores one epoch of samples and reads them back in another order */
+void check_exchange(lbann::lbann_comm& comm, bool node_shared) {
+  lbann::options::get()->set_option("data_store_node_shared", node_shared);
+
+  const int num_ranks = comm.get_procs_per_trainer();
+  const int mb_size = 3 * num_ranks;
+  const int num_samples = 4 * mb_size;
+  lbann::data_reader_synthetic reader(num_samples, sample_size);
+  reader.set_comm(&comm);
+  reader.set_role("train");
+
+  // Every rank shuffles the same way
+  std::vector<int> indices(num_samples);
+  std::iota(indices.begin(), indices.end(), 0);
+  std::mt19937 gen(7);
+  std::shuffle(indices.begin(), indices.end(), gen);
+
+  test_data_store ds(&reader);
+  ds.set_shuffled_indices(&indices);
+  ds.setup(mb_size);
+
+  // Ranks own the samples they read in the first epoch
+  std::vector<int> owned;
+  conduit::Node node;
+  for (int i = 0; i < num_samples; ++i) {
+    if ((i % mb_size) % num_ranks == ds.rank()) {
+      make_sample(indices[i], node);
+      ds.set_conduit_node(indices[i], node);
+      owned.push_back(indices[i]);
+    }
+  }
+
+  // The next epoch reads the samples in another order
+  std::shuffle(indices.begin(), indices.end(), gen);
+  for (int start = 0; start < num_samples; start += mb_size) {
+    ds.exchange_mini_batch_data(start, mb_size);
+    CHECK(ds.has_node_store() == node_shared);
+    size_t node_reads = 0;
+    for (int i = start; i < start + mb_size; ++i) {
+      if ((i % mb_size) % num_ranks != ds.rank()) {
+        continue;
+      }
+      const int owner = ds.get_index_owner(indices[i]);
+      node_reads += (node_shared && ds.owned_on_node(owner));
+      check_sample(indices[i], ds.get_conduit_node(indices[i]));
+    }
+    CHECK(ds.num_node_reads() == node_reads);
+  }
+
+  // The private copies of owned samples are replaced by the shared ones
+  for (auto data_id : owned) {
+    CHECK(ds.in_node_store(data_id) == node_shared);
+  }
+  if (node_shared) {
+    CHECK(ds.num_node_samples() >= owned.size());
+  }
+
+  lbann::options::get()->set_option("data_store_node_shared", false);
+}
+
+} // namespace
+
+TEST_CASE("Testing the node-shared conduit data store", "[data_store]") {
+  auto& comm = unit_test::utilities::current_world_comm();
+
+  SECTION("Samples owned on the node are read from the shared store") {
+    check_exchange(comm, true);
+  }
+
+  SECTION("Without the option every sample is exchanged") {
+    check_exchange(comm, false);
+  }
+}
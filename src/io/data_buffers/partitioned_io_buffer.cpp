@@ -26,6 +26,9 @@
 
 #include "lbann/io/data_buffers/partitioned_io_buffer.hpp"
 #include "lbann/utils/exception.hpp"
+#include "lbann/utils/omp_pragma.hpp"
+
+#include <algorithm>
 
 lbann::partitioned_io_buffer::partitioned_io_buffer(lbann_comm *comm, int num_parallel_readers, std::map<execution_mode, generic_data_reader *> data_readers, int num_child_layers)
   : generic_io_buffer(comm, num_parallel_readers, data_readers) {
@@ -99,13 +102,30 @@ int lbann::partitioned_io_buffer::fetch_to_local_matrix(generic_data_reader *dat
   data_buffer *buf = get_data_buffer(mode);
   buf->m_num_samples_fetched = 0;
   if (m_comm->get_rank_in_trainer() < num_parallel_readers && (buf->m_input_buffers[0]->Height() != 0 && buf->m_input_buffers[0]->Width() != 0)) {
-    for(auto& m : buf->m_input_buffers) {
+    /// Samples in a narrow type (e.g. uint8 pixels) are kept in that
+    /// type until they are distributed to the input layer. This does
+    /// not apply to reconstruction, where samples are also targets.
+    buf->m_sample_storage_type = data_reader->get_sample_storage_type();
+    if (fetch_data_fn->get_target_mode() == data_reader_target_mode::RECONSTRUCTION) {
+      buf->m_sample_storage_type = sample_storage_type::data_type;
+    }
+
+    for(size_t i = 0; i < buf->m_input_buffers.size(); ++i) {
+      auto& m = buf->m_input_buffers[i];
+      if (i == 0 && buf->m_sample_storage_type != sample_storage_type::data_type) {
+        continue;
+      }
       El::Zeros_seq(*m, m->Height(), m->Width());
     }
+    if (buf->m_sample_storage_type == sample_storage_type::uint8) {
+      buf->m_num_samples_fetched = fetch_narrow_samples(*buf, buf->m_uint8_samples, data_reader);
+    } else if (buf->m_sample_storage_type == sample_storage_type::int16) {
+      buf->m_num_samples_fetched = fetch_narrow_samples(*buf, buf->m_int16_samples, data_reader);
+    }
 
     /// Each data reader needs to either have independent / split
     /// data, or take an offset / stride
-    if(buf->m_input_buffers.size() == 2) {
+    else if(buf->m_input_buffers.size() == 2) {
       buf->m_num_samples_fetched = (*fetch_data_fn)(buf->m_input_buffers[0]->Matrix(), buf->m_input_buffers[1]->Matrix(), buf->m_indices_fetched_per_mb, data_reader);
     }else {
       buf->m_num_samples_fetched = (*fetch_data_fn)(buf->m_input_buffers[0]->Matrix(), buf->m_indices_fetched_per_mb, data_reader);
@@ -118,9 +138,80 @@ int lbann::partitioned_io_buffer::fetch_to_local_matrix(generic_data_reader *dat
   return buf->m_num_samples_fetched;
 }
 
+template <typename T>
+int lbann::partitioned_io_buffer::fetch_narrow_samples(data_buffer& buf, El::Matrix<T>& samples, generic_data_reader *data_reader) {
+  const auto& local_buffer = buf.m_input_buffers[0]->LockedMatrix();
+  samples.Resize(local_buffer.Height(), local_buffer.Width());
+  data_reader->get_sample_conversion(buf.m_sample_scale, buf.m_sample_bias);
+  if(buf.m_input_buffers.size() == 2) {
+    return (*fetch_data_fn)(samples, buf.m_input_buffers[1]->Matrix(), buf.m_indices_fetched_per_mb, data_reader);
+  }else {
+    return (*fetch_data_fn)(samples, buf.m_indices_fetched_per_mb, data_reader);
+  }
+}
+
+namespace lbann {
+namespace {
+
+/** Convert fetched samples to DataType, x -> scale*x + bias.
+ *  Columns without a fetched sample are zeroed, as they would be in
+ *  a DataType buffer. */
+template <typename T>
+void convert_samples(const El::Matrix<T>& in, CPUMat& out, El::Int num_samples,
+                     DataType scale, DataType bias) {
+  const El::Int height = in.Height();
+  const El::Int width = std::min(in.Width(), out.Width());
+  LBANN_OMP_PARALLEL_FOR
+  for (El::Int col = 0; col < width; ++col) {
+    DataType* __restrict__ dst = out.Buffer(0, col);
+    if (col < num_samples) {
+      const T* __restrict__ src = in.LockedBuffer(0, col);
+      for (El::Int row = 0; row < height; ++row) {
+        dst[row] = scale * static_cast<DataType>(src[row]) + bias;
+      }
+    } else {
+      std::fill_n(dst, height, DataType(0));
+    }
+  }
+}
+
+} // namespace
+} // namespace lbann
+
+void lbann::partitioned_io_buffer::distribute_samples(data_buffer& buf, AbsDistMat& sample) {
+  if (buf.m_sample_storage_type == sample_storage_type::data_type) {
+    Copy(*buf.m_input_buffers[0], sample);
+    return;
+  }
+
+  // Convert directly into the input layer's samples if they have the
+  // same local layout as the I/O buffer, otherwise stage the converted
+  // samples in the I/O buffer
+  auto& staging = *buf.m_input_buffers[0];
+  const auto dist = sample.DistData();
+  const bool convert_in_place = (dist.colDist == El::STAR
+                                 && dist.rowDist == El::VC
+                                 && dist.device == El::Device::CPU
+                                 && sample.Height() == staging.Height()
+                                 && sample.Width() == staging.Width()
+                                 && sample.RowAlign() == staging.RowAlign());
+  auto& out = convert_in_place ? sample : staging;
+  auto& local_out = static_cast<CPUMat&>(out.Matrix());
+  if (buf.m_sample_storage_type == sample_storage_type::uint8) {
+    convert_samples(buf.m_uint8_samples, local_out, buf.m_num_samples_fetched,
+                    buf.m_sample_scale, buf.m_sample_bias);
+  } else {
+    convert_samples(buf.m_int16_samples, local_out, buf.m_num_samples_fetched,
+                    buf.m_sample_scale, buf.m_sample_bias);
+  }
+  if (!convert_in_place) {
+    Copy(staging, sample);
+  }
+}
+
 void lbann::partitioned_io_buffer::distribute_from_local_matrix(generic_data_reader *data_reader, execution_mode mode, AbsDistMat& sample, AbsDistMat& response) {
   data_buffer *buf = get_data_buffer(mode);
-  Copy(*buf->m_input_buffers[0], sample);
+  distribute_samples(*buf, sample);
   Copy(*buf->m_input_buffers[1], response);
   buf->m_num_samples_fetched = 0;
   return;
@@ -128,7 +219,7 @@ void lbann::partitioned_io_buffer::distribute_from_local_matrix(generic_data_rea
 
 void lbann::partitioned_io_buffer::distribute_from_local_matrix(generic_data_reader *data_reader, execution_mode mode, AbsDistMat& sample) {
   data_buffer *buf = get_data_buffer(mode);
-  Copy(*buf->m_input_buffers[0], sample);
+  distribute_samples(*buf, sample);
   buf->m_num_samples_fetched = 0;
   return;
 }
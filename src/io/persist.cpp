@@ -27,11 +27,17 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <cstdio>
+#include <limits>
+#include <vector>
 
 #include "lbann/utils/exception.hpp"
+#include "lbann/utils/file_utils.hpp"
+#include "lbann/utils/timer.hpp"
+#include "lbann/utils/value_codec.hpp"
 #include "lbann/io/file_io.hpp"
 #include "lbann/io/persist.hpp"
 
@@ -61,27 +67,87 @@ struct layer_header {
   uint64_t ldim;       /**< specifies padding of first dimension in local storage */
 };
 
+namespace {
+
+/** Magic number ("LBANNCMP") at the start of compressed rank matrix
+ *  files, in place of the rank in the uncompressed header */
+constexpr uint64_t compressed_magic = 0x504d434e4e41424cULL;
+
+/** Stores meta data of a compressed rank matrix */
+struct compressed_header {
+  uint64_t magic;
+  uint64_t width;      /**< global width of matrix */
+  uint64_t height;     /**< global height of matrix */
+  uint64_t localwidth; /**< local width of matrix on current process */
+  uint64_t localheight;/**< local height of matrix on current process */
+  uint64_t delta;      /**< whether values are XORed with the base checkpoint */
+  uint64_t size;       /**< bytes of compressed values */
+};
+
+/** Name of the file recording the base of a delta checkpoint */
+const std::string delta_base_filename = "delta_base";
+
+void write_all(int fd, const std::string& filename, const void *buf, size_t size) {
+  const auto *ptr = static_cast<const char *>(buf);
+  while (size > 0) {
+    const ssize_t rc = write(fd, ptr, size);
+    if (rc <= 0) {
+      LBANN_ERROR("failed to write file (" + filename + ")");
+    }
+    ptr += rc;
+    size -= rc;
+  }
+}
+
+void read_all(int fd, const std::string& filename, void *buf, size_t size) {
+  auto *ptr = static_cast<char *>(buf);
+  while (size > 0) {
+    const ssize_t rc = read(fd, ptr, size);
+    if (rc <= 0) {
+      LBANN_ERROR("failed to read file (" + filename + ")");
+    }
+    ptr += rc;
+    size -= rc;
+  }
+}
+
+/** Read a compressed rank matrix file after its magic number */
+void read_compressed_file(int fd, const std::string& filename,
+                          compressed_header& header,
+                          std::vector<unsigned char>& data) {
+  header.magic = compressed_magic;
+  read_all(fd, filename, &header.width, sizeof(header) - sizeof(header.magic));
+  data.resize(header.size);
+  read_all(fd, filename, data.data(), data.size());
+}
+
+} // namespace
+
 /** \brief Given an open file descriptor, file name, and a matrix, write the matrix
  *         to the file descriptor, return the number of bytes written */
 
 bool lbann::persist::write_rank_distmat(persist_type type, const char *name, const AbsDistMat& M) {
   // TODO: store in network order
-  std::string filename = m_checkpoint_dir;
+  std::string key;
   if (type == persist_type::train) {
-    filename += std::string("/train_") + name;
+    key = std::string("train_") + name;
   } else if (type == persist_type::model) {
-    filename += std::string("/model_") + name;
+    key = std::string("model_") + name;
   } else {
     std::stringstream err;
     err << "invalid persist_type (" << static_cast<int>(type) << ")";
     LBANN_ERROR(err.str());
   }
+  const std::string filename = std::string(m_checkpoint_dir) + "/" + key;
   // skip all of this if matrix is not held on rank
   const El::Int localHeight = M.LocalHeight();
   const El::Int localWidth = M.LocalWidth();
   // If this is the case we will try to grab the matrix from model rank 0 on reload
   if(localHeight * localWidth == 0) { return true; }
 
+  if (m_compress) {
+    return write_compressed_rank_distmat(filename, key, M);
+  }
 
   int fd = lbann::openwrite(filename.c_str());
 
@@ -136,19 +202,30 @@ bool lbann::persist::read_rank_distmat(persist_type type, const char *name, AbsD
   std::stringstream err;
 
   // read in the header
-  std::string filename = m_checkpoint_dir;
+  std::string key;
   if (type == persist_type::train) {
-    filename += std::string("/train_") + name;
+    key = std::string("train_") + name;
   } else if (type == persist_type::model) {
-    filename += std::string("/model_") + name;
+    key = std::string("model_") + name;
   } else {
     err << "invalid persist_type (" << static_cast<int>(type) << ")";
     LBANN_ERROR(err.str());
   }
+  const std::string filename = std::string(m_checkpoint_dir) + "/" + key;
   int fd = openread(filename.c_str());
   // file does not exist. we will try to grab matrix from rank 0
    if( fd == -1 ) {return false;}
 
+  // compressed matrices start with a magic number instead of the rank
+  uint64_t magic = 0;
+  if (read(fd, &magic, sizeof(magic)) == sizeof(magic)
+      && magic == compressed_magic) {
+    read_compressed_rank_distmat(fd, filename, key, M);
+    closeread(fd, filename.c_str());
+    return true;
+  }
+  lseek(fd, 0, SEEK_SET);
+
   struct layer_header header;
   ssize_t read_rc = read(fd, &header, sizeof(header));
   if (read_rc != sizeof(header)) {
@@ -228,6 +305,405 @@ bool lbann::persist::read_rank_distmat(persist_type type, const char *name, AbsD
   return true;
 }
 
+/****************************************************
+ * These functions save a libElemental matrix to a single
+ * shared file that every process writes in parallel
+ ****************************************************/
+
+namespace {
+
+/** Identifies files written by write_shared_distmat. Legacy
+ *  El::BINARY files start with the matrix height, which never
+ *  matches this string. */
+constexpr char shared_distmat_magic[8] = {'L','B','D','M','A','T','0','1'};
+
+/** File header, written by rank 0 of the grid. Each process's local
+ *  block follows in order of (col shift + row shift * col stride),
+ *  packed in column-major order without padding. */
+struct shared_distmat_header {
+  char magic[8];
+  uint64_t height;        /**< global height of matrix */
+  uint64_t width;         /**< global width of matrix */
+  uint64_t col_stride;    /**< column stride of the writing distribution */
+  uint64_t row_stride;    /**< row stride of the writing distribution */
+  uint64_t datatype_size; /**< size of a matrix entry in bytes */
+  int32_t col_dist;       /**< El::Dist of columns (informational) */
+  int32_t row_dist;       /**< El::Dist of rows (informational) */
+};
+
+/** Largest transfer handed to a single MPI-IO call. */
+constexpr size_t max_io_chunk = size_t(1) << 30;
+
+/** Height of the block owned by column shift c. */
+El::Int block_height(const shared_distmat_header& header, El::Int c) {
+  return El::Length(El::Int(header.height), c, El::Int(header.col_stride));
+}
+
+/** Width of the block owned by row shift r. */
+El::Int block_width(const shared_distmat_header& header, El::Int r) {
+  return El::Length(El::Int(header.width), r, El::Int(header.row_stride));
+}
+
+/** File offsets of all local blocks. */
+std::vector<MPI_Offset> block_offsets(const shared_distmat_header& header) {
+  const El::Int col_stride = header.col_stride;
+  const El::Int row_stride = header.row_stride;
+  std::vector<MPI_Offset> offsets(col_stride * row_stride);
+  MPI_Offset offset = sizeof(shared_distmat_header);
+  for (El::Int r = 0; r < row_stride; ++r) {
+    for (El::Int c = 0; c < col_stride; ++c) {
+      offsets[c + r * col_stride] = offset;
+      offset += (block_height(header, c) * block_width(header, r)
+                 * header.datatype_size);
+    }
+  }
+  return offsets;
+}
+
+void write_at(MPI_File fh, MPI_Offset offset, const void *buf, size_t size,
+              const std::string& filename) {
+  const auto *ptr = static_cast<const char *>(buf);
+  while (size > 0) {
+    const size_t count = std::min(size, max_io_chunk);
+    MPI_Status status;
+    if (MPI_File_write_at(fh, offset, ptr, int(count), MPI_BYTE, &status)
+        != MPI_SUCCESS) {
+      LBANN_ERROR("failed to write file (" + filename + ")");
+    }
+    offset += count;
+    ptr += count;
+    size -= count;
+  }
+}
+
+void read_at(MPI_File fh, MPI_Offset offset, void *buf, size_t size,
+             const std::string& filename) {
+  auto *ptr = static_cast<char *>(buf);
+  while (size > 0) {
+    const size_t count = std::min(size, max_io_chunk);
+    MPI_Status status;
+    if (MPI_File_read_at(fh, offset, ptr, int(count), MPI_BYTE, &status)
+        != MPI_SUCCESS) {
+      LBANN_ERROR("failed to read file (" + filename + ")");
+    }
+    offset += count;
+    ptr += count;
+    size -= count;
+  }
+}
+
+/** Portion [begin, end) of n entries handled by redundant rank. */
+std::pair<El::Int, El::Int> redundant_range(El::Int n, int rank, int size) {
+  return {(n * rank) / size, (n * (rank + 1)) / size};
+}
+
+/** Whether the shared format can describe M's distribution. */
+bool supports_shared_format(const AbsDistMat& M) {
+  return (M.Wrap() == El::ELEMENT
+          && M.DistData().colDist != El::CIRC
+          && M.DistData().rowDist != El::CIRC);
+}
+
+} // namespace
+
+uint64_t lbann::write_shared_distmat(const std::string& filename,
+                                     const AbsDistMat& M) {
+  if (!supports_shared_format(M)) {
+    // El::Write appends the file extension
+    auto basename = filename;
+    if (basename.size() > 4
+        && basename.compare(basename.size() - 4, 4, ".bin") == 0) {
+      basename.resize(basename.size() - 4);
+    }
+    El::Write(M, basename, El::BINARY, "");
+    return 2 * sizeof(El::Int) + M.Height() * M.Width() * sizeof(DataType);
+  }
+  const auto comm = M.Grid().Comm().GetMPIComm();
+
+  // Describe the distribution
+  shared_distmat_header header;
+  std::memcpy(header.magic, shared_distmat_magic, sizeof(header.magic));
+  header.height        = M.Height();
+  header.width         = M.Width();
+  header.col_stride    = M.ColStride();
+  header.row_stride    = M.RowStride();
+  header.datatype_size = sizeof(DataType);
+  header.col_dist      = M.DistData().colDist;
+  header.row_dist      = M.DistData().rowDist;
+  const auto offsets = block_offsets(header);
+  const MPI_Offset file_size = (offsets.empty() ?
+                                sizeof(header) :
+                                offsets.back()
+                                + (block_height(header, header.col_stride-1)
+                                   * block_width(header, header.row_stride-1)
+                                   * sizeof(DataType)));
+
+  // Create file and truncate any previous contents
+  MPI_File fh;
+  if (MPI_File_open(comm, filename.c_str(),
+                    MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                    MPI_INFO_NULL, &fh) != MPI_SUCCESS) {
+    LBANN_ERROR("failed to open file (" + filename + ") for writing");
+  }
+  MPI_File_set_size(fh, file_size);
+  uint64_t bytes = 0;
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+  if (rank == 0) {
+    write_at(fh, 0, &header, sizeof(header), filename);
+    bytes += sizeof(header);
+  }
+
+  // Write local block, split between redundant copies
+  if (M.Participating()) {
+    const auto& local_mat = M.LockedMatrix();
+    CPUMat packed;
+    const DataType *buf;
+    if (local_mat.GetDevice() == El::Device::CPU
+        && local_mat.LDim() == local_mat.Height()) {
+      buf = local_mat.LockedBuffer();
+    } else {
+      El::Copy(local_mat, packed);
+      buf = packed.LockedBuffer();
+    }
+    const El::Int block = M.ColShift() + M.RowShift() * M.ColStride();
+    const auto range = redundant_range(M.LocalHeight() * M.LocalWidth(),
+                                       M.RedundantRank(),
+                                       M.RedundantSize());
+    const size_t size = (range.second - range.first) * sizeof(DataType);
+    write_at(fh, offsets[block] + range.first * sizeof(DataType),
+             buf + range.first, size, filename);
+    bytes += size;
+  }
+
+  MPI_File_close(&fh);
+  return bytes;
+}
+
+bool lbann::read_shared_distmat(const std::string& filename,
+                                AbsDistMat& M,
+                                uint64_t *bytes) {
+  const auto comm = M.Grid().Comm().GetMPIComm();
+  MPI_File fh;
+  if (MPI_File_open(comm, filename.c_str(), MPI_MODE_RDONLY,
+                    MPI_INFO_NULL, &fh) != MPI_SUCCESS) {
+    return false;
+  }
+
+  // Rank 0 reads header and shares it with the grid
+  shared_distmat_header header;
+  std::memset(&header, 0, sizeof(header));
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+  if (rank == 0) {
+    MPI_Offset file_size;
+    MPI_File_get_size(fh, &file_size);
+    if (file_size >= MPI_Offset(sizeof(header))) {
+      read_at(fh, 0, &header, sizeof(header), filename);
+    }
+  }
+  MPI_Bcast(&header, sizeof(header), MPI_BYTE, 0, comm);
+  if (std::memcmp(header.magic, shared_distmat_magic,
+                  sizeof(header.magic)) != 0) {
+    MPI_File_close(&fh);
+    return false;
+  }
+  if (header.datatype_size != sizeof(DataType)) {
+    MPI_File_close(&fh);
+    LBANN_ERROR("matrix in " + filename + " has "
+                + std::to_string(header.datatype_size) + "-byte entries, "
+                + "but expected " + std::to_string(sizeof(DataType)));
+  }
+  const auto offsets = block_offsets(header);
+  uint64_t bytes_read = (rank == 0 ? sizeof(header) : 0);
+
+  M.Resize(header.height, header.width);
+  if (M.Wrap() == El::ELEMENT
+      && header.col_stride == uint64_t(M.ColStride())
+      && header.row_stride == uint64_t(M.RowStride())) {
+    // Same distribution as writer: each process reads its own block,
+    // with redundant copies reading disjoint pieces and sharing them
+    if (M.Participating()) {
+      CPUMat local_mat(M.LocalHeight(), M.LocalWidth());
+      const El::Int size = M.LocalHeight() * M.LocalWidth();
+      const El::Int block = M.ColShift() + M.RowShift() * M.ColStride();
+      const int redundant_size = M.RedundantSize();
+      const auto range = redundant_range(size, M.RedundantRank(),
+                                         redundant_size);
+      read_at(fh, offsets[block] + range.first * sizeof(DataType),
+              local_mat.Buffer() + range.first,
+              (range.second - range.first) * sizeof(DataType),
+              filename);
+      bytes_read += (range.second - range.first) * sizeof(DataType);
+      if (redundant_size > 1) {
+        if (size > std::numeric_limits<int>::max()) {
+          LBANN_ERROR("local block of " + filename + " is too large "
+                      "to share between redundant processes");
+        }
+        MPI_Datatype entry_type;
+        MPI_Type_contiguous(sizeof(DataType), MPI_BYTE, &entry_type);
+        MPI_Type_commit(&entry_type);
+        std::vector<int> counts(redundant_size), displs(redundant_size);
+        for (int i = 0; i < redundant_size; ++i) {
+          const auto r = redundant_range(size, i, redundant_size);
+          displs[i] = r.first;
+          counts[i] = r.second - r.first;
+        }
+        MPI_Allgatherv(MPI_IN_PLACE, 0, entry_type,
+                       local_mat.Buffer(), counts.data(), displs.data(),
+                       entry_type, M.RedundantComm().GetMPIComm());
+        MPI_Type_free(&entry_type);
+      }
+      El::Copy(local_mat, M.Matrix());
+    }
+  } else {
+    // Different distribution from writer (e.g. restart with a new
+    // process grid): each process assembles whole columns from the
+    // writer's blocks, then the matrix is redistributed
+    El::DistMatrix<DataType, El::STAR, El::VC, El::ELEMENT, El::Device::CPU>
+      cols(header.height, header.width, M.Grid());
+    const El::Int col_stride = header.col_stride;
+    const El::Int row_stride = header.row_stride;
+    std::vector<DataType> buf;
+    for (El::Int jloc = 0; jloc < cols.LocalWidth(); ++jloc) {
+      const El::Int j = cols.GlobalCol(jloc);
+      const El::Int r = j % row_stride;
+      const El::Int jblock = j / row_stride;
+      for (El::Int c = 0; c < col_stride; ++c) {
+        const El::Int height = block_height(header, c);
+        const El::Int block = c + r * col_stride;
+        buf.resize(height);
+        read_at(fh, offsets[block] + jblock * height * sizeof(DataType),
+                buf.data(), height * sizeof(DataType), filename);
+        bytes_read += height * sizeof(DataType);
+        for (El::Int iblock = 0; iblock < height; ++iblock) {
+          cols.SetLocal(c + iblock * col_stride, jloc, buf[iblock]);
+        }
+      }
+    }
+    El::Copy(cols, M);
+  }
+
+  MPI_File_close(&fh);
+  if (bytes != nullptr) { *bytes += bytes_read; }
+  return true;
+}
+
+bool lbann::persist::write_compressed_rank_distmat(const std::string& filename,
+                                                   const std::string& key,
+                                                   const AbsDistMat& M) {
+  const El::Int localHeight = M.LocalHeight();
+  const El::Int localWidth = M.LocalWidth();
+  const size_t size = localHeight * localWidth;
+
+  // compress contiguous local values
+  std::vector<DataType> contiguous;
+  const DataType *values = M.LockedBuffer();
+  if (M.LDim() != localHeight) {
+    contiguous.resize(size);
+    for (El::Int j = 0; j < localWidth; ++j) {
+      std::copy(M.LockedBuffer(0, j), M.LockedBuffer(0, j) + localHeight,
+                contiguous.begin() + j * localHeight);
+    }
+    values = contiguous.data();
+  }
+  const DataType *base = nullptr;
+  if (m_delta_base_dir.empty()) {
+    m_delta_base[key].assign(values, values + size);
+  } else {
+    // matrices missing from the base are written in full
+    const auto it = m_delta_base.find(key);
+    if (it != m_delta_base.end() && it->second.size() == size) {
+      base = it->second.data();
+    }
+  }
+  const EvalType start = get_time();
+  std::vector<unsigned char> data;
+  compress_values(size, values, base, data);
+  m_compression_time += get_time() - start;
+
+  struct compressed_header header;
+  header.magic       = compressed_magic;
+  header.width       = (uint64_t) M.Width();
+  header.height      = (uint64_t) M.Height();
+  header.localwidth  = (uint64_t) localWidth;
+  header.localheight = (uint64_t) localHeight;
+  header.delta       = (base != nullptr) ? 1 : 0;
+  header.size        = data.size();
+
+  int fd = lbann::openwrite(filename.c_str());
+  if (fd < 0) {
+    LBANN_ERROR("failed to open file (" + filename + ")");
+  }
+  write_all(fd, filename, &header, sizeof(header));
+  write_all(fd, filename, data.data(), data.size());
+  close(fd);
+  m_bytes += sizeof(header) + data.size();
+  m_uncompressed_bytes += sizeof(layer_header) + size * sizeof(DataType);
+  return true;
+}
+
+void lbann::persist::read_compressed_rank_distmat(int fd,
+                                                  const std::string& filename,
+                                                  const std::string& key,
+                                                  AbsDistMat& M) {
+  struct compressed_header header;
+  std::vector<unsigned char> data;
+  read_compressed_file(fd, filename, header, data);
+  m_bytes += sizeof(header) + data.size();
+  M.Resize(header.height, header.width);
+  if (header.localheight != (uint64_t) M.LocalHeight()
+      || header.localwidth != (uint64_t) M.LocalWidth()) {
+    LBANN_ERROR("local matrix in file (" + filename + ") "
+                "does not match the process grid");
+  }
+  const size_t size = header.localheight * header.localwidth;
+
+  // base values are in the file of the same name in the base checkpoint
+  std::vector<DataType> base;
+  if (header.delta) {
+    const std::string base_filename = m_restart_base_dir + "/" + key;
+    if (m_restart_base_dir.empty()) {
+      LBANN_ERROR("no base checkpoint for delta-encoded file (" + filename + ")");
+    }
+    int base_fd = openread(base_filename.c_str());
+    uint64_t magic = 0;
+    if (base_fd < 0
+        || read(base_fd, &magic, sizeof(magic)) != sizeof(magic)
+        || magic != compressed_magic) {
+      LBANN_ERROR("failed to read base values from file (" + base_filename + ")");
+    }
+    struct compressed_header base_header;
+    std::vector<unsigned char> base_data;
+    read_compressed_file(base_fd, base_filename, base_header, base_data);
+    closeread(base_fd, base_filename.c_str());
+    m_bytes += sizeof(base_header) + base_data.size();
+    if (base_header.delta
+        || base_header.localheight * base_header.localwidth != size) {
+      LBANN_ERROR("base values in file (" + base_filename + ") "
+                  "do not match file (" + filename + ")");
+    }
+    base.resize(size);
+    const EvalType start = get_time();
+    decompress_values(base_data.size(), base_data.data(), size, nullptr, base.data());
+    m_compression_time += get_time() - start;
+  }
+
+  const EvalType start = get_time();
+  const DataType *base_values = header.delta ? base.data() : nullptr;
+  if (M.LDim() == M.LocalHeight()) {
+    decompress_values(data.size(), data.data(), size, base_values, M.Buffer());
+  } else {
+    std::vector<DataType> contiguous(size);
+    decompress_values(data.size(), data.data(), size, base_values, contiguous.data());
+    El::Matrix<DataType> view(header.localheight, header.localwidth,
+                              contiguous.data(), header.localheight);
+    El::Copy(view, M.Matrix());
+  }
+  m_compression_time += get_time() - start;
+  m_uncompressed_bytes += sizeof(layer_header) + size * sizeof(DataType);
+}
+
 /****************************************************
  * Functions to read/write values to files
  ****************************************************/
@@ -242,6 +718,15 @@ lbann::persist::persist() {
   m_validate_fd = -1;
 }
 
+void lbann::persist::set_compression(bool compress, const std::string& delta_base_dir) {
+  m_compress = compress;
+  m_delta_base_dir = compress ? delta_base_dir : "";
+  // a full checkpoint replaces the base values
+  if (compress && delta_base_dir.empty()) {
+    m_delta_base.clear();
+  }
+}
+
 void lbann::persist::open_checkpoint(const char *dir) {
   // create directory for checkpoint
   lbann::makedir(dir);
@@ -249,6 +734,18 @@ void lbann::persist::open_checkpoint(const char *dir) {
   // copy checkpoint directory
   strcpy(m_checkpoint_dir, dir);
 
+  // record the checkpoint holding base values of delta-encoded matrices
+  if (m_compress && !m_delta_base_dir.empty()) {
+    const std::string base_name = file::extract_base_name(m_delta_base_dir);
+    const std::string filename = std::string(dir) + "/" + delta_base_filename;
+    int fd = lbann::openwrite(filename.c_str());
+    if (fd < 0) {
+      LBANN_ERROR("failed to open file (" + filename + ")");
+    }
+    write_all(fd, filename, base_name.data(), base_name.size());
+    lbann::closewrite(fd, filename.c_str());
+  }
+
   // open the file for writing
   sprintf(m_model_filename, "%s/model", dir);
 
@@ -299,6 +796,14 @@ void lbann::persist::close_checkpoint() {
 void lbann::persist::open_restart(const char *dir) {
   // copy checkpoint directory
   strcpy(m_checkpoint_dir, dir);
+
+  // base checkpoint of delta-encoded matrices, in the same parent directory
+  m_restart_base_dir.clear();
+  std::vector<char> base_name;
+  if (load_file(std::string(dir) + "/" + delta_base_filename, base_name)) {
+    m_restart_base_dir = (file::extract_parent_directory(dir) + "/"
+                          + std::string(base_name.begin(), base_name.end()));
+  }
   // open the file for writing
   sprintf(m_model_filename, "%s/model", dir);
 
@@ -352,11 +857,9 @@ bool lbann::persist::write_distmat(persist_type type, const char *name, AbsDistM
     LBANN_ERROR(err.str());
   }
 
-  El::Write(*M, filename, El::BINARY, "");
-  //Write_MPI(M, filename, BINARY, "");
-
-  uint64_t bytes = 2 * sizeof(El::Int) + M->Height() * M->Width() * sizeof(DataType);
-  m_bytes += bytes;
+  // use the same file name as El::Write
+  filename += ".bin";
+  m_bytes += write_shared_distmat(filename, *M);
 
   return true;
 }
@@ -380,11 +883,11 @@ bool lbann::persist::read_distmat(persist_type type, const char *name, AbsDistMa
     LBANN_ERROR("failed to read distributed matrix from file (" + filename + ")");
     return false;
   }
-  El::Read(*M, filename, El::BINARY, true);
-  //Read_MPI(M, filename, BINARY, 1);
-
-  uint64_t bytes = 2 * sizeof(El::Int) + M->Height() * M->Width() * sizeof(DataType);
-  m_bytes += bytes;
+  // fall back to El::Read for checkpoints in El::BINARY format
+  if (!read_shared_distmat(filename, *M, &m_bytes)) {
+    El::Read(*M, filename, El::BINARY, true);
+    m_bytes += 2 * sizeof(El::Int) + M->Height() * M->Width() * sizeof(DataType);
+  }
 
   return true;
 }
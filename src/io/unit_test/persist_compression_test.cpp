@@ -0,0 +1,112 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/io/persist.hpp>
+
+#include "TestHelpers.hpp"
+#include <lbann/base.hpp>
+
+#include <unistd.h>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using lbann::DataType;
+
+namespace {
+
+void fill_random(lbann::StarMat<El::Device::CPU>& M, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<DataType> dist(-1, 1);
+  for (El::Int j = 0; j < M.LocalWidth(); ++j) {
+    for (El::Int i = 0; i < M.LocalHeight(); ++i) {
+      M.SetLocal(i, j, dist(gen));
+    }
+  }
+}
+
+void check_equal(const lbann::StarMat<El::Device::CPU>& expected,
+                 const lbann::StarMat<El::Device::CPU>& actual) {
+  REQUIRE(actual.Height() == expected.Height());
+  REQUIRE(actual.Width() == expected.Width());
+  for (El::Int j = 0; j < expected.LocalWidth(); ++j) {
+    for (El::Int i = 0; i < expected.LocalHeight(); ++i) {
+      CHECK(actual.GetLocal(i, j) == expected.GetLocal(i, j));
+    }
+  }
+}
+
+void remove_checkpoint(const std::string& dir) {
+  for (const auto& name : {"model", "train", "validate", "delta_base",
+                           "model_weights", "train_moments", "model_extra"}) {
+    std::remove((dir + "/" + name).c_str());
+  }
+  rmdir(dir.c_str());
+}
+
+} // namespace
+
+TEST_CASE("Testing compressed delta checkpoints", "[io][checkpoint]") {
+  unit_test::utilities::current_world_comm();
+  using lbann::persist_type;
+  const std::string full_dir = "persist_compression_test.full";
+  const std::string delta_dir = "persist_compression_test.delta";
+
+  lbann::StarMat<El::Device::CPU> weights(64, 32), moments(64, 32), extra(8, 4);
+  fill_random(weights, 1);
+  fill_random(moments, 2);
+  fill_random(extra, 3);
+
+  // The full checkpoint becomes the base of the delta checkpoint
+  lbann::persist writer;
+  writer.set_cb_type(lbann::callback_type::batch);
+  writer.set_compression(true);
+  writer.open_checkpoint(full_dir.c_str());
+  REQUIRE(writer.write_rank_distmat(persist_type::model, "weights", weights));
+  REQUIRE(writer.write_rank_distmat(persist_type::train, "moments", moments));
+  writer.close_checkpoint();
+  const uint64_t full_bytes = writer.get_bytes();
+  writer.reset_bytes();
+
+  // Only a few values change, and a matrix missing from the base is
+  // written in full
+  const lbann::StarMat<El::Device::CPU> full_weights(weights);
+  weights.SetLocal(3, 5, weights.GetLocal(3, 5) + DataType(0.5));
+  weights.SetLocal(60, 31, DataType(0));
+  writer.set_compression(true, full_dir);
+  writer.open_checkpoint(delta_dir.c_str());
+  REQUIRE(writer.write_rank_distmat(persist_type::model, "weights", weights));
+  REQUIRE(writer.write_rank_distmat(persist_type::train, "moments", moments));
+  REQUIRE(writer.write_rank_distmat(persist_type::model, "extra", extra));
+  writer.close_checkpoint();
+  CHECK(writer.get_bytes() < full_bytes);
+
+  SECTION("Reading the full checkpoint") {
+    lbann::persist reader;
+    reader.open_restart(full_dir.c_str());
+    lbann::StarMat<El::Device::CPU> w, m;
+    REQUIRE(reader.read_rank_distmat(persist_type::model, "weights", w));
+    REQUIRE(reader.read_rank_distmat(persist_type::train, "moments", m));
+    reader.close_restart();
+    check_equal(full_weights, w);
+    check_equal(moments, m);
+  }
+
+  SECTION("Reading the delta checkpoint against its base") {
+    lbann::persist reader;
+    reader.open_restart(delta_dir.c_str());
+    lbann::StarMat<El::Device::CPU> w, m, e;
+    REQUIRE(reader.read_rank_distmat(persist_type::model, "weights", w));
+    REQUIRE(reader.read_rank_distmat(persist_type::train, "moments", m));
+    REQUIRE(reader.read_rank_distmat(persist_type::model, "extra", e));
+    reader.close_restart();
+    check_equal(weights, w);
+    check_equal(moments, m);
+    check_equal(extra, e);
+  }
+
+  remove_checkpoint(delta_dir);
+  remove_checkpoint(full_dir);
+}
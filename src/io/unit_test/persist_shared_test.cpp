@@ -0,0 +1,120 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/io/persist.hpp>
+
+#include "TestHelpers.hpp"
+#include <lbann/base.hpp>
+
+#include <cstdio>
+#include <string>
+
+using lbann::DataType;
+
+namespace {
+
+using MCMRMat = El::DistMatrix<DataType, El::MC, El::MR, El::ELEMENT, El::Device::CPU>;
+using VCStarMat = lbann::VCStarMat<El::Device::CPU>;
+using StarMat = lbann::StarMat<El::Device::CPU>;
+
+DataType entry(El::Int row, El::Int col) {
+  return DataType(row * 100 + col) / DataType(7);
+}
+
+void fill(lbann::AbsDistMat& M) {
+  for (El::Int j = 0; j < M.LocalWidth(); ++j) {
+    for (El::Int i = 0; i < M.LocalHeight(); ++i) {
+      M.SetLocal(i, j, entry(M.GlobalRow(i), M.GlobalCol(j)));
+    }
+  }
+}
+
+void check_entries(const lbann::AbsDistMat& M, El::Int height, El::Int width) {
+  REQUIRE(M.Height() == height);
+  REQUIRE(M.Width() == width);
+  for (El::Int j = 0; j < M.LocalWidth(); ++j) {
+    for (El::Int i = 0; i < M.LocalHeight(); ++i) {
+      CHECK(M.GetLocal(i, j) == entry(M.GlobalRow(i), M.GlobalCol(j)));
+    }
+  }
+}
+
+void remove_file(lbann::lbann_comm& comm, const std::string& filename) {
+  comm.global_barrier();
+  if (comm.am_world_master()) {
+    std::remove(filename.c_str());
+  }
+  comm.global_barrier();
+}
+
+} // namespace
+
+TEST_CASE("Testing shared checkpoint matrices", "[io][checkpoint]") {
+  auto& comm = unit_test::utilities::current_world_comm();
+  const auto& grid = comm.get_trainer_grid();
+  const std::string filename = "persist_shared_test.bin";
+  const El::Int height = 37, width = 23;
+
+  SECTION("Distributed matrix") {
+    MCMRMat M(height, width, grid);
+    fill(M);
+    CHECK(lbann::write_shared_distmat(filename, M) > 0);
+
+    MCMRMat same(grid);
+    REQUIRE(lbann::read_shared_distmat(filename, same));
+    check_entries(same, height, width);
+
+    // Readers with other strides assemble columns
+    StarMat star(grid);
+    REQUIRE(lbann::read_shared_distmat(filename, star));
+    check_entries(star, height, width);
+    VCStarMat vc(grid);
+    REQUIRE(lbann::read_shared_distmat(filename, vc));
+    check_entries(vc, height, width);
+
+    // A process grid with another shape
+    El::Grid row_grid(comm.get_trainer_comm(), 1);
+    MCMRMat other(row_grid);
+    REQUIRE(lbann::read_shared_distmat(filename, other));
+    check_entries(other, height, width);
+    remove_file(comm, filename);
+  }
+
+  SECTION("Redundant matrix") {
+    // Processes split the copy instead of each writing all of it
+    StarMat M(height, width, grid);
+    fill(M);
+    uint64_t bytes = lbann::write_shared_distmat(filename, M);
+    uint64_t total_bytes = 0;
+    comm.trainer_allreduce(&bytes, 1, &total_bytes);
+    const uint64_t matrix_bytes = height * width * sizeof(DataType);
+    CHECK(total_bytes >= matrix_bytes);
+    CHECK(total_bytes < matrix_bytes + 4096);
+
+    MCMRMat dist(grid);
+    REQUIRE(lbann::read_shared_distmat(filename, dist));
+    check_entries(dist, height, width);
+    StarMat star(grid);
+    REQUIRE(lbann::read_shared_distmat(filename, star));
+    check_entries(star, height, width);
+    remove_file(comm, filename);
+  }
+
+  SECTION("Legacy El::BINARY file") {
+    MCMRMat M(height, width, grid);
+    fill(M);
+    El::Write(M, "persist_shared_test", El::BINARY, "");
+    comm.global_barrier();
+    MCMRMat legacy(grid);
+    CHECK_FALSE(lbann::read_shared_distmat(filename, legacy));
+    El::Read(legacy, filename, El::BINARY, true);
+    check_entries(legacy, height, width);
+    remove_file(comm, filename);
+  }
+
+  SECTION("Missing file") {
+    MCMRMat M(grid);
+    CHECK_FALSE(lbann::read_shared_distmat("persist_shared_test.missing", M));
+  }
+}
@@ -36,6 +36,7 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <string>
 
 // Asynchronous memory transfers for input data
@@ -76,7 +77,11 @@ Layer::Layer(const Layer& other) :
   m_update_time(other.m_update_time),
   m_name(other.m_name),
   m_output_dims_list(other.m_output_dims_list),
-  m_hint_layer(other.m_hint_layer) {
+  m_hint_layer(other.m_hint_layer),
+  m_activation_storage_precision(other.m_activation_storage_precision),
+  m_packed_outputs(other.m_packed_outputs),
+  m_fused_activation(other.m_fused_activation),
+  m_fused_into_parent(other.m_fused_into_parent) {
 
   // Deep matrix copies
   m_inputs.reserve(other.m_inputs.size());
@@ -117,6 +122,14 @@ Layer& Layer::operator=(const Layer& other) {
   m_name = other.m_name;
   m_output_dims_list = other.m_output_dims_list;
   m_hint_layer = other.m_hint_layer;
+  m_activation_storage_precision = other.m_activation_storage_precision;
+  m_packed_outputs = other.m_packed_outputs;
+  m_output_placements.clear();
+  m_gradient_wrt_input_placements.clear();
+  m_tensor_placement_target = false;
+  m_fused_activation = other.m_fused_activation;
+  m_fused_into_parent = other.m_fused_into_parent;
+  m_fused_gradient_wrt_output.reset();
 
   // Deep matrix copies
   m_inputs.clear();
@@ -246,16 +259,27 @@ description Layer::get_description() const {
     desc.add("Frozen");
   }
 
+  // Activation storage
+  if (m_activation_storage_precision != storage_precision::full) {
+    desc.add("Activation storage", to_string(m_activation_storage_precision));
+  }
+
   return desc;
 }
 
 void Layer::forward_prop() {
   const auto fp_start = get_time();
+  m_bytes_copy_elided = 0;
 
   // Setup tensors
   const auto& mini_batch_size = m_model->get_current_mini_batch_size();
   fp_setup_inputs(mini_batch_size);
-  fp_setup_outputs(mini_batch_size);
+  if (m_fused_into_parent) {
+    // Parent layer has already applied this layer's activation
+    El::LockedView(get_activations(), get_prev_activations());
+  } else {
+    fp_setup_outputs(mini_batch_size);
+  }
 
 #if defined(LBANN_HAS_GPU) && defined(LBANN_DEBUG)
   // Synchronize GPUs and check for errors
@@ -264,7 +288,7 @@ void Layer::forward_prop() {
 
   // Apply layer's compute function
   const auto fp_compute_start = get_time();
-  fp_compute();
+  if (!m_fused_into_parent) { fp_compute(); }
   m_fp_compute_time += get_time() - fp_compute_start;
 
   // Add this layer as a gradient source for weight optimizers
@@ -287,7 +311,12 @@ void Layer::back_prop() {
   // Setup tensors
   const auto& mini_batch_size = m_model->get_current_mini_batch_size();
   bp_setup_gradient_wrt_outputs(mini_batch_size);
-  bp_setup_gradient_wrt_inputs(mini_batch_size);
+  if (m_fused_into_parent) {
+    // Parent layer applies the activation derivative
+    El::LockedView(get_error_signals(), get_prev_error_signals());
+  } else {
+    bp_setup_gradient_wrt_inputs(mini_batch_size);
+  }
 
 #if defined(LBANN_HAS_GPU) && defined(LBANN_DEBUG)
   // Synchronize GPUs and check for errors
@@ -296,7 +325,7 @@ void Layer::back_prop() {
 
   // Backprop the compute function.
   const auto bp_compute_start = get_time();
-  bp_compute();
+  if (!m_fused_into_parent) { bp_compute(); }
   m_bp_compute_time += get_time() - bp_compute_start;
 
   // Remove this layer as a gradient source for weight optimizers
@@ -600,6 +629,163 @@ void Layer::unfreeze() {
   }
 }
 
+size_t Layer::pack_activations() {
+  // Output tensors of parent layers may be views into this layer's
+  // output tensors
+  if (m_activation_storage_precision == storage_precision::full
+      || m_tensor_placement_target) {
+    return 0;
+  }
+  m_packed_outputs.resize(get_num_children());
+  size_t bytes_freed = 0;
+  for (int i = 0; i < get_num_children(); ++i) {
+    auto& output = *m_outputs[i];
+    auto& packed = m_packed_outputs[i];
+    if (packed.packed
+        || output.Viewing()
+        || output.GetLocalDevice() != El::Device::CPU
+        || is_output_viewed_by_child(i)) {
+      continue;
+    }
+    const size_t local_height = output.LocalHeight();
+    const size_t local_width = output.LocalWidth();
+    packed.data.resize(local_height * local_width);
+    pack_reduced_precision(local_height, local_width,
+                           output.LockedBuffer(), output.LDim(),
+                           packed.data.data(),
+                           m_activation_storage_precision);
+    packed.dist = output.DistData();
+    packed.height = output.Height();
+    packed.width = output.Width();
+    packed.packed = true;
+    bytes_freed += local_height * local_width
+      * (sizeof(DataType) - sizeof(uint16_t));
+    output.Empty(true);
+  }
+  return bytes_freed;
+}
+
+bool Layer::is_output_viewed_by_child(int child_index) const {
+  const auto& output = *m_outputs[child_index];
+  const auto* begin = output.LockedBuffer();
+  const auto* end = begin + output.LDim() * output.LocalWidth();
+  if (begin == nullptr || begin == end) { return false; }
+  const auto& child = *m_child_layers[child_index];
+  for (int i = 0; i < child.get_num_children(); ++i) {
+    const auto& child_output = child.get_activations(i);
+    const auto* buffer = child_output.LockedBuffer();
+    if (child_output.Viewing() && begin <= buffer && buffer < end) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Layer::unpack_activations() {
+  for (size_t i = 0; i < m_packed_outputs.size(); ++i) {
+    auto& packed = m_packed_outputs[i];
+    if (!packed.packed) { continue; }
+    auto& output = *m_outputs[i];
+    output.Empty(false);
+    output.AlignWith(packed.dist);
+    output.Resize(packed.height, packed.width);
+    unpack_reduced_precision(output.LocalHeight(), output.LocalWidth(),
+                             packed.data.data(),
+                             output.Buffer(), output.LDim(),
+                             m_activation_storage_precision);
+    packed.packed = false;
+  }
+}
+
+bool Layer::has_packed_activations() const {
+  for (const auto& packed : m_packed_outputs) {
+    if (packed.packed) { return true; }
+  }
+  return false;
+}
+
+void Layer::refresh_inputs() {
+  fp_setup_inputs(m_model->get_current_mini_batch_size());
+}
+
+bool Layer::may_run_concurrently() const {
+  if (get_data_layout() != data_layout::DATA_PARALLEL) {
+    return false;
+  }
+  // Tensors exchanged with a neighbor that has a different layout or
+  // device are redistributed with collectives
+  const auto& is_mismatched = [this] (const Layer* l) {
+    return (l->get_data_layout() != get_data_layout()
+            || l->get_device_allocation() != get_device_allocation());
+  };
+  return (std::none_of(m_parent_layers.begin(), m_parent_layers.end(),
+                       is_mismatched)
+          && std::none_of(m_child_layers.begin(), m_child_layers.end(),
+                          is_mismatched));
+}
+
+void Layer::clear_tensor_placement() {
+  m_output_placements.clear();
+  m_gradient_wrt_input_placements.clear();
+  m_tensor_placement_target = false;
+}
+
+void Layer::place_activations(Layer& child, El::Int row_offset) {
+  const int child_index = (std::find(m_child_layers.begin(),
+                                     m_child_layers.end(),
+                                     &child)
+                           - m_child_layers.begin());
+  if (child_index >= get_num_children()) {
+    std::stringstream err;
+    err << "attempted to place output tensor of "
+        << "layer \"" << get_name() << "\" "
+        << "in layer \"" << child.get_name() << "\", "
+        << "which is not a child layer";
+    LBANN_ERROR(err.str());
+  }
+  m_output_placements.resize(get_num_children());
+  m_output_placements[child_index].target = &child;
+  m_output_placements[child_index].row_offset = row_offset;
+  child.m_tensor_placement_target = true;
+}
+
+void Layer::place_error_signals(Layer& parent, El::Int row_offset) {
+  const int parent_index = (std::find(m_parent_layers.begin(),
+                                      m_parent_layers.end(),
+                                      &parent)
+                            - m_parent_layers.begin());
+  if (parent_index >= get_num_parents()) {
+    std::stringstream err;
+    err << "attempted to place error signal tensor of "
+        << "layer \"" << get_name() << "\" "
+        << "in layer \"" << parent.get_name() << "\", "
+        << "which is not a parent layer";
+    LBANN_ERROR(err.str());
+  }
+  m_gradient_wrt_input_placements.resize(get_num_parents());
+  m_gradient_wrt_input_placements[parent_index].target = &parent;
+  m_gradient_wrt_input_placements[parent_index].row_offset = row_offset;
+  parent.m_tensor_placement_target = true;
+}
+
+bool Layer::occupies_rows(const AbsDistMat& block,
+                          const AbsDistMat& tensor,
+                          El::Int row_offset) {
+  if (block.DistData() != tensor.DistData()
+      || block.GetLocalDevice() != El::Device::CPU
+      || block.Width() != tensor.Width()
+      || block.LocalWidth() != tensor.LocalWidth()
+      || block.LocalHeight() != block.Height()
+      || tensor.LocalHeight() != tensor.Height()
+      || row_offset < 0
+      || row_offset + block.Height() > tensor.Height()) {
+    return false;
+  }
+  if (block.LocalHeight() < 1 || block.LocalWidth() < 1) { return true; }
+  return (block.LDim() == tensor.LDim()
+          && block.LockedBuffer() == tensor.LockedBuffer(row_offset, 0));
+}
+
 bool Layer::is_frozen() const {
   for(auto& w : m_weights) {
     if (w->is_frozen() != m_frozen) {
@@ -1016,8 +1202,27 @@ void Layer::fp_setup_outputs(El::Int mini_batch_size) {
   for (int i = 0; i < get_num_children(); ++i) {
     auto& output = get_activations(i);
     output.Empty(false);
-    if (align_outputs) { output.AlignWith(alignment_dist); }
-    output.Resize(get_output_size(i), mini_batch_size);
+    auto* target = (i < (int) m_output_placements.size() ?
+                    m_output_placements[i].target : nullptr);
+    if (target != nullptr) {
+      // Output tensor is a block of rows in child's output tensor
+      // Note: The first parent to reach this point allocates the
+      // child's output tensor.
+      auto& buffer = target->get_activations();
+      const auto& buffer_height = target->get_output_size();
+      if (buffer.Height() != buffer_height
+          || buffer.Width() != mini_batch_size) {
+        buffer.Empty(false);
+        buffer.AlignWith(alignment_dist);
+        buffer.Resize(buffer_height, mini_batch_size);
+      }
+      const auto& offset = m_output_placements[i].row_offset;
+      El::View(output, buffer,
+               El::IR(offset, offset + get_output_size(i)), El::ALL);
+    } else {
+      if (align_outputs) { output.AlignWith(alignment_dist); }
+      output.Resize(get_output_size(i), mini_batch_size);
+    }
   }
 
 }
@@ -1067,6 +1272,30 @@ void Layer::bp_setup_gradient_wrt_outputs(El::Int mini_batch_size) {
       LBANN_ERROR(err.str());
     }
 
+    // Convert to gradient w.r.t. input of fused activation
+    // Note: The output tensor holds the activation output.
+    if (m_fused_activation.has_activation()) {
+      const auto& output = get_activations(i);
+      if (m_fused_gradient_wrt_output == nullptr) {
+        m_fused_gradient_wrt_output = construct_matrix(output.Grid(),
+                                                       "gradient_wrt_output",
+                                                       i);
+      }
+      auto& fused_gradient = *m_fused_gradient_wrt_output;
+      fused_gradient.Empty(false);
+      fused_gradient.AlignWith(output);
+      fused_gradient.Resize(height, width);
+      m_fused_activation.apply_backward(output.LocalHeight(),
+                                        output.LocalWidth(),
+                                        output.LockedBuffer(),
+                                        output.LDim(),
+                                        gradient_wrt_output.LockedBuffer(),
+                                        gradient_wrt_output.LDim(),
+                                        fused_gradient.Buffer(),
+                                        fused_gradient.LDim());
+      El::LockedView(gradient_wrt_output, fused_gradient);
+    }
+
   }
 }
 
@@ -1074,9 +1303,112 @@ void Layer::bp_setup_gradient_wrt_inputs(El::Int mini_batch_size) {
   for (int i = 0; i < get_num_parents(); ++i) {
     auto& gradient_wrt_input = get_error_signals(i);
     gradient_wrt_input.Empty(false);
-    gradient_wrt_input.AlignWith(get_prev_activations(i));
-    gradient_wrt_input.Resize(get_input_size(i), mini_batch_size);
+    auto* target = (i < (int) m_gradient_wrt_input_placements.size() ?
+                    m_gradient_wrt_input_placements[i].target : nullptr);
+    if (target != nullptr) {
+      // Gradient w.r.t. input tensor is a block of rows in parent's
+      // gradient w.r.t. input tensor
+      // Note: The first child to reach this point allocates the
+      // parent's gradient w.r.t. input tensor.
+      auto& buffer = target->get_error_signals();
+      const auto& buffer_height = target->get_input_size();
+      if (buffer.Height() != buffer_height
+          || buffer.Width() != mini_batch_size) {
+        buffer.Empty(false);
+        buffer.AlignWith(get_prev_activations(i));
+        buffer.Resize(buffer_height, mini_batch_size);
+      }
+      const auto& offset = m_gradient_wrt_input_placements[i].row_offset;
+      El::View(gradient_wrt_input, buffer,
+               El::IR(offset, offset + get_input_size(i)), El::ALL);
+    } else {
+      gradient_wrt_input.AlignWith(get_prev_activations(i));
+      gradient_wrt_input.Resize(get_input_size(i), mini_batch_size);
+    }
+  }
+}
+
+void Layer::fuse_activation(Layer& child) {
+  std::stringstream err;
+  if (get_num_children() != 1 || m_child_layers[0] != &child) {
+    err << "attempted to fuse the activation of "
+        << "layer \"" << child.get_name() << "\" into "
+        << "layer \"" << get_name() << "\", "
+        << "which is not its only child";
+    LBANN_ERROR(err.str());
+  }
+  if (!supports_fused_activation()
+      || !child.get_fusable_activation().has_activation()) {
+    err << "layer \"" << get_name() << "\" "
+        << "can not apply the activation of "
+        << "layer \"" << child.get_name() << "\"";
+    LBANN_ERROR(err.str());
   }
+  m_fused_activation = child.get_fusable_activation();
+  child.m_fused_into_parent = true;
+}
+
+void Layer::clear_activation_fusion() {
+  m_fused_activation = gemm_epilogue();
+  m_fused_into_parent = false;
+  m_fused_gradient_wrt_output.reset();
+}
+
+void Layer::fold_affine(Layer& child) {
+  std::stringstream err;
+  if (get_num_children() != 1 || m_child_layers[0] != &child
+      || child.get_num_parents() != 1) {
+    err << "attempted to fold layer \"" << child.get_name() << "\" "
+        << "into layer \"" << get_name() << "\", "
+        << "which is not its only parent";
+    LBANN_ERROR(err.str());
+  }
+  std::vector<DataType> scale, shift;
+  if (!child.get_foldable_affine(scale, shift)
+      || !supports_affine_folding(scale.size())) {
+    err << "layer \"" << get_name() << "\" "
+        << "can not fold the parameters of "
+        << "layer \"" << child.get_name() << "\"";
+    LBANN_ERROR(err.str());
+  }
+  clear_int8_quantization();
+  fold_affine_parameters(scale, shift);
+  child.m_fused_into_parent = true;
+}
+
+void Layer::fold_affine_parameters(const std::vector<DataType>& scale,
+                                   const std::vector<DataType>& shift) {
+  std::stringstream err;
+  err << get_type() << " layer \"" << get_name() << "\" "
+      << "does not support folding of affine transforms";
+  LBANN_ERROR(err.str());
+}
+
+void Layer::quantize_int8(const std::vector<DataType>& input_ranges) {
+  std::stringstream err;
+  err << get_type() << " layer \"" << get_name() << "\" "
+      << "does not support int8 quantization";
+  LBANN_ERROR(err.str());
+}
+
+const AbsDistMat& Layer::forward_prop_probe(const AbsDistMat& input) {
+  if (get_num_parents() != 1 || get_num_children() != 1
+      || m_fused_into_parent) {
+    std::stringstream err;
+    err << "can not probe layer \"" << get_name() << "\"";
+    LBANN_ERROR(err.str());
+  }
+  auto& prev_activations = *m_inputs[0];
+  prev_activations.Empty(false);
+  prev_activations.AlignWith(input);
+  if (prev_activations.DistData() == input.DistData()) {
+    El::LockedView(prev_activations, input);
+  } else {
+    El::Copy(input, prev_activations);
+  }
+  fp_setup_outputs(input.Width());
+  fp_compute();
+  return get_activations();
 }
 
 std::string Layer::get_data_layout_string(data_layout d) const {
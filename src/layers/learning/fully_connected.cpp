@@ -26,6 +26,8 @@
 
 #include "lbann/layers/learning/fully_connected.hpp"
 
+#include <algorithm>
+
 namespace lbann {
 
 template <>
@@ -83,16 +85,16 @@ void fully_connected_layer<data_layout::MODEL_PARALLEL, El::Device::CPU>::fp_com
              DataType(0), output);
   }
 
-  // Apply bias if needed
-  if(m_bias_scaling_factor != DataType(0)) {
-    const auto& local_bias = m_weights[1]->get_values().LockedMatrix();
+  // Apply bias and fused activation if needed
+  // Note: Bias is distributed like the output rows.
+  const auto& epilogue = get_fused_activation();
+  DataType bias_scale;
+  const auto* bias = get_epilogue_bias(bias_scale);
+  if (bias != nullptr || epilogue.has_activation()) {
     auto& local_output = output.Matrix();
-    El::IndexDependentMap(local_output,
-                          (std::function<DataType(El::Int,El::Int,const DataType&)>)
-                          ([this,&local_bias](El::Int r, El::Int c,const DataType& z)
-                           ->DataType {
-                            return z + m_bias_scaling_factor * local_bias(r, 0);
-                          }));
+    epilogue.apply_forward(local_output.Height(), local_output.Width(),
+                           local_output.Buffer(), local_output.LDim(),
+                           bias, bias_scale, 1);
   }
 
 }
@@ -182,25 +184,62 @@ template <>
 void fully_connected_layer<data_layout::DATA_PARALLEL, El::Device::CPU>::fp_compute() {
 
   // Matrices
-  const auto& local_input = get_local_prev_activations();
-  auto& local_output = get_local_activations();
-
-  // Apply linearity
+  const auto& local_input = static_cast<const CPUMat&>(get_local_prev_activations());
+  auto& local_output = static_cast<CPUMat&>(get_local_activations());
   const auto& local_linearity = m_weights[0]->get_values().LockedMatrix();
-  El::Gemm(m_transpose ? El::TRANSPOSE : El::NORMAL,
-           El::NORMAL,
-           DataType(1), local_linearity, local_input,
-           DataType(0), local_output);
 
-  // Apply bias if needed
-  if(m_bias_scaling_factor != DataType(0)) {
-    const auto& local_bias = m_weights[1]->get_values().LockedMatrix();
-    El::IndexDependentMap(local_output,
-                          (std::function<DataType(El::Int,El::Int,const DataType&)>)
-                          ([this,&local_bias](El::Int r, El::Int c,const DataType& z)
-                           ->DataType {
-                            return z + m_bias_scaling_factor * local_bias(r, 0);
-                          }));
+  // Bias and fused activation
+  const auto& epilogue = get_fused_activation();
+  DataType bias_scale;
+  const auto* bias = get_epilogue_bias(bias_scale);
+
+  // Apply int8 linearity during inference
+  if (!m_int8_linearity.is_empty()
+      && this->m_model->get_execution_mode() != execution_mode::training) {
+    const El::Int local_width = local_input.Width();
+    m_int8_input.resize(m_int8_linearity.get_width() * local_width);
+    m_int8_linearity.quantize_input(local_width,
+                                    local_input.LockedBuffer(),
+                                    local_input.LDim(),
+                                    false,
+                                    m_int8_input.data());
+    m_int8_linearity.apply(local_width, m_int8_input.data(),
+                           local_output.Buffer(), local_output.LDim(),
+                           false);
+    if (bias != nullptr || epilogue.has_activation()) {
+      epilogue.apply_forward(local_output.Height(), local_output.Width(),
+                             local_output.Buffer(), local_output.LDim(),
+                             bias, bias_scale, 1);
+    }
+    return;
+  }
+
+  // Apply linearity if there is no epilogue
+  if (bias == nullptr && !epilogue.has_activation()) {
+    El::Gemm(m_transpose ? El::TRANSPOSE : El::NORMAL,
+             El::NORMAL,
+             DataType(1), local_linearity, local_input,
+             DataType(0), local_output);
+    return;
+  }
+
+  // Apply linearity, bias, and fused activation to panels of columns
+  // Note: Each output panel is small enough to stay in cache between
+  // the GEMM and the epilogue.
+  const El::Int local_width = local_input.Width();
+  const El::Int panel_width = gemm_epilogue::get_panel_width(local_output.Height());
+  CPUMat input_panel, output_panel;
+  for (El::Int col = 0; col < local_width; col += panel_width) {
+    const auto cols = El::IR(col, std::min(col + panel_width, local_width));
+    El::LockedView(input_panel, local_input, El::ALL, cols);
+    El::View(output_panel, local_output, El::ALL, cols);
+    El::Gemm(m_transpose ? El::TRANSPOSE : El::NORMAL,
+             El::NORMAL,
+             DataType(1), local_linearity, input_panel,
+             DataType(0), output_panel);
+    epilogue.apply_forward(output_panel.Height(), output_panel.Width(),
+                           output_panel.Buffer(), output_panel.LDim(),
+                           bias, bias_scale, 1);
   }
 
 }
@@ -33,30 +33,14 @@ namespace lbann {
 
 namespace {
 
-/** Sparse vector entry. */
-struct entry {
-
-  /** Vector entry value. */
-  DataType value = min_value;
-  /** Vector entry index. */
-  El::Int index = max_index;
-
-  /** Minimum possible value. */
-  static constexpr DataType min_value = -std::numeric_limits<DataType>::infinity();
-  /** Maximum possible index. */
-  static constexpr El::Int max_index = std::numeric_limits<El::Int>::max();
-
-  /** Comparison operation to sort vector entries.
-   *  Entries are sorted by value in decreasing order, with ties
-   *  broken in favor of entries with smaller indices.
-   */
-  static bool compare(const entry& a, const entry& b) {
-    return a.value > b.value || (a.value == b.value && a.index < b.index);
-  }
-
-};
-
-/** CPU implementation of top-k categorical accuracy layer forward prop. */
+/** CPU implementation of top-k categorical accuracy layer forward prop.
+ *  The label entry is in the top-k if fewer than k prediction entries
+ *  rank ahead of it. Entries are ranked by value in decreasing order,
+ *  with ties broken in favor of entries with smaller indices. Counting
+ *  is a single vectorizable pass over each column and only one value
+ *  and one count per column are exchanged across the column
+ *  communicator, instead of k candidate entries from every rank.
+ */
 void fp_cpu(lbann_comm& comm,
             El::Int k,
             const AbsDistMat& predictions,
@@ -92,7 +76,6 @@ void fp_cpu(lbann_comm& comm,
   // Note: This may have race conditions if columns of labels matrix
   // are not one-hot vectors.
   std::vector<El::Int> label_indices(local_width, height);
-  Al::request req;
   LBANN_OMP_PARALLEL_FOR_COLLAPSE2
   for (El::Int col = 0; col < local_width; ++col) {
     for (El::Int row = 0; row < local_height; ++row) {
@@ -101,70 +84,64 @@ void fp_cpu(lbann_comm& comm,
       }
     }
   }
-  comm.nb_allreduce(label_indices.data(),
-                    label_indices.size(),
-                    col_comm,
-                    req,
-                    El::mpi::MIN);
-
-  // Find top-k entries in each column of local prediction matrix
-  std::vector<entry> top_entries(local_width * k);
-  LBANN_OMP_PARALLEL_FOR
+  if (col_comm_size > 1) {
+    comm.allreduce(label_indices.data(),
+                   label_indices.size(),
+                   col_comm,
+                   El::mpi::MIN);
+  }
+
+  // Get predictions corresponding to labels
+  std::vector<DataType> label_values(local_width,
+                                     -std::numeric_limits<DataType>::infinity());
   for (El::Int col = 0; col < local_width; ++col) {
-    std::vector<entry> local_entries(std::max(local_height, k));
-    for (El::Int row = 0; row < local_height; ++row) {
-      local_entries[row].value = local_predictions(row, col);
-      local_entries[row].index = predictions.GlobalRow(row);
+    const auto& label_index = label_indices[col];
+    if (label_index < height && predictions.IsLocalRow(label_index)) {
+      const auto& row = predictions.LocalRow(label_index);
+      label_values[col] = local_predictions(row, col);
     }
-    std::partial_sort_copy(local_entries.begin(),
-                           local_entries.end(),
-                           &top_entries[col*k],
-                           &top_entries[col*k] + k,
-                           entry::compare);
   }
-
-  // Find top-k entries in each column of global prediction matrix
   if (col_comm_size > 1) {
-    if (col_comm_rank != col_comm_root) {
-      comm.gather(reinterpret_cast<El::byte*>(top_entries.data()),
-                  top_entries.size() * sizeof(entry),
-                  col_comm_root,
-                  col_comm, El::SyncInfo<El::Device::CPU>{});
-    } else {
-      std::vector<entry> global_top_entries(col_comm_size * local_width * k);
-      comm.gather(reinterpret_cast<El::byte*>(top_entries.data()),
-                  top_entries.size() * sizeof(entry),
-                  reinterpret_cast<El::byte*>(global_top_entries.data()),
-                  col_comm, El::SyncInfo<El::Device::CPU>{});
-      LBANN_OMP_PARALLEL_FOR
-      for (El::Int col = 0; col < local_width; ++col) {
-        std::vector<entry> col_entries(col_comm_size * k);
-        for (El::Int rank = 0; rank < col_comm_size; ++rank) {
-          const auto* start = &global_top_entries[rank*local_width*k+col*k];
-          std::copy(start, start + k, &col_entries[rank*k]);
-        }
-        std::partial_sort_copy(col_entries.begin(),
-                               col_entries.end(),
-                               &top_entries[col*k],
-                               &top_entries[col*k] + k,
-                               entry::compare);
+    comm.allreduce(label_values.data(),
+                   label_values.size(),
+                   col_comm,
+                   El::mpi::MAX);
+  }
+
+  // Count prediction entries that rank ahead of label entries
+  std::vector<El::Int> num_ahead(local_width, 0);
+  LBANN_OMP_PARALLEL_FOR
+  for (El::Int col = 0; col < local_width; ++col) {
+    const auto& label_index = label_indices[col];
+    const auto& label_value = label_values[col];
+    if (label_index >= height) { continue; }
+    const DataType* values = local_predictions.LockedBuffer(0, col);
+    El::Int count = 0;
+    for (El::Int row = 0; row < local_height; ++row) {
+      count += (values[row] > label_value) ? 1 : 0;
+    }
+    for (El::Int row = 0; row < local_height; ++row) {
+      if (values[row] == label_value
+          && predictions.GlobalRow(row) < label_index) {
+        ++count;
       }
     }
-
+    num_ahead[col] = count;
+  }
+  if (col_comm_size > 1) {
+    comm.allreduce(num_ahead.data(),
+                   num_ahead.size(),
+                   col_comm,
+                   El::mpi::SUM);
   }
 
   // Compute categorical accuracy
   El::Zero(loss);
-  comm.wait(req);
   if (col_comm_rank == col_comm_root) {
-    LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+    LBANN_OMP_PARALLEL_FOR
     for (El::Int col = 0; col < local_width; ++col) {
-      for (El::Int i = 0; i < k; ++i) {
-        const auto& label_index = label_indices[col];
-        if (top_entries[col*k+i].index == label_index
-            && label_index < height) {
-          local_loss(0, col) = DataType(1);
-        }
+      if (label_indices[col] < height && num_ahead[col] < k) {
+        local_loss(0, col) = DataType(1);
       }
     }
   }
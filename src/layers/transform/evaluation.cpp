@@ -25,6 +25,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "lbann/layers/transform/evaluation.hpp"
+#include "lbann/models/model.hpp"
 #include "lbann/utils/exception.hpp"
 #ifdef LBANN_HAS_GPU
 #include "lbann/utils/cublas.hpp"
@@ -34,15 +35,13 @@ namespace lbann {
 
 namespace {
 
-/** CPU implementation of evaluation layer forward prop. */
-void fp_cpu(lbann_comm& comm,
-            const AbsDistMat& input,
-            DataType& value,
-            Al::request& req) {
+/** CPU implementation of evaluation layer forward prop.
+ *  The local sum is reduced by the model's evaluation aggregator.
+ */
+void fp_cpu(const AbsDistMat& input, DataType& value) {
   const auto& local_input = input.LockedMatrix();
   const auto& local_height = local_input.Height();
   const auto& local_width = local_input.Width();
-  const auto& mini_batch_size = input.Width();
   value = 0;
   LBANN_OMP_PARALLEL_FOR_ARGS(reduction(+:value) collapse(2))
   for (El::Int col = 0; col < local_width; ++col) {
@@ -50,14 +49,14 @@ void fp_cpu(lbann_comm& comm,
       value += local_input(row, col);
     }
   }
-  value = value / mini_batch_size;
-  comm.nb_allreduce(&value, 1, input.DistComm(), req);
 }
 
 #ifdef LBANN_HAS_GPU
-/** GPU implementation of evaluation layer forward prop. */
-void fp_gpu(lbann_comm& comm,
-            const AbsDistMat& input,
+/** GPU implementation of evaluation layer forward prop.
+ *  The local sum is copied to host and reduced by the model's
+ *  evaluation aggregator.
+ */
+void fp_gpu(const AbsDistMat& input,
             DataType& value,
             cuda::event_wrapper& copy_event) {
   constexpr DataType zero = 0;
@@ -67,7 +66,6 @@ void fp_gpu(lbann_comm& comm,
   const auto& local_input = input.LockedMatrix();
   const auto& local_height = local_input.Height();
   const auto& local_width = local_input.Width();
-  const auto& mini_batch_size = input.Width();
 
   // GPU objects
   GPUMat sum_d, ones_d;
@@ -120,9 +118,7 @@ void fp_gpu(lbann_comm& comm,
   }
   CHECK_CUBLAS(cublasSetPointerMode(handle, CUBLAS_POINTER_MODE_HOST));
 
-  // Compute average value across mini-batch
-  El::Scale(one / mini_batch_size, sum_d);
-  comm.allreduce(static_cast<AbsMat&>(sum_d), input.DistComm());
+  // Copy local sum to host
   CHECK_CUDA(cudaMemcpyAsync(&value,
                              sum_d.LockedBuffer(),
                              sizeof(DataType),
@@ -136,15 +132,26 @@ void fp_gpu(lbann_comm& comm,
 } // namespace
 
 EvalType abstract_evaluation_layer::get_value(bool scaled) {
+  if (m_slot < 0) {
+    std::stringstream err;
+    err << get_type() << " layer \"" << get_name() << "\" "
+        << "has no slot in the evaluation aggregator";
+    LBANN_ERROR(err.str());
+  }
+  const auto& value = m_model->get_evaluation_aggregator().get_value(m_slot);
+  if (scaled) { return m_scale * value; }
+  else        { return value; }
+}
+
+EvalType abstract_evaluation_layer::get_local_value() {
   switch (get_device_allocation()) {
-  case El::Device::CPU: get_comm()->wait(m_allreduce_req); break;
+  case El::Device::CPU: break;
 #ifdef LBANN_HAS_GPU
   case El::Device::GPU: m_copy_event.synchronize(); break;
 #endif // LBANN_HAS_GPU
   default: LBANN_ERROR("invalid device");
   }
-  if (scaled) { return m_scale * m_value(0, 0); }
-  else        { return m_value(0, 0); }
+  return m_value(0, 0);
 }
 
 abstract_evaluation_layer::abstract_evaluation_layer(lbann_comm *comm)
@@ -179,13 +186,11 @@ void abstract_evaluation_layer::setup_data() {
 void abstract_evaluation_layer::fp_compute() {
   switch (get_device_allocation()) {
   case El::Device::CPU:
-    fp_cpu(*get_comm(), get_prev_activations(), m_value(0, 0),
-           m_allreduce_req);
+    fp_cpu(get_prev_activations(), m_value(0, 0));
     break;
 #ifdef LBANN_HAS_GPU
   case El::Device::GPU:
-    fp_gpu(*get_comm(), get_prev_activations(), m_value(0, 0),
-           m_copy_event);
+    fp_gpu(get_prev_activations(), m_value(0, 0), m_copy_event);
     break;
 #endif // LBANN_HAS_GPU
   default: LBANN_ERROR("invalid device");
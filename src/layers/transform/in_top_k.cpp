@@ -56,6 +56,68 @@ struct entry {
 
 };
 
+/** Number of values in a block for threshold filtering. */
+constexpr El::Int filter_block_size = 64;
+
+/** Find top-k entries in a column of a local matrix.
+ *  Candidates are kept in a bounded heap whose front is the worst
+ *  candidate, so the cost is linear in the column height and
+ *  logarithmic in k. Values are scanned in blocks and a block is
+ *  skipped if its maximum (a vectorizable reduction) does not reach
+ *  the worst candidate. The output is sorted with @c entry::compare
+ *  and padded with default entries if the column has fewer than k
+ *  rows.
+ */
+void find_local_top_k(El::Int k,
+                      const AbsMat& local_input,
+                      const AbsDistMat& input,
+                      El::Int col,
+                      entry* top_entries) {
+  const El::Int local_height = local_input.Height();
+  const DataType* values = local_input.LockedBuffer(0, col);
+
+  // Initialize heap with first k entries
+  const El::Int num_entries = std::min(local_height, k);
+  for (El::Int row = 0; row < num_entries; ++row) {
+    top_entries[row].value = values[row];
+    top_entries[row].index = input.GlobalRow(row);
+  }
+  std::make_heap(top_entries, top_entries + num_entries, entry::compare);
+
+  // Replace worst candidate with better entries
+  if (num_entries == k) {
+    DataType threshold = top_entries[0].value;
+    for (El::Int block_start = k;
+         block_start < local_height;
+         block_start += filter_block_size) {
+      const El::Int block_end = std::min(block_start + filter_block_size,
+                                         local_height);
+      DataType block_max = values[block_start];
+      for (El::Int row = block_start + 1; row < block_end; ++row) {
+        block_max = values[row] > block_max ? values[row] : block_max;
+      }
+      if (block_max < threshold) { continue; }
+      for (El::Int row = block_start; row < block_end; ++row) {
+        if (values[row] < threshold) { continue; }
+        entry candidate;
+        candidate.value = values[row];
+        candidate.index = input.GlobalRow(row);
+        if (entry::compare(candidate, top_entries[0])) {
+          std::pop_heap(top_entries, top_entries + k, entry::compare);
+          top_entries[k-1] = candidate;
+          std::push_heap(top_entries, top_entries + k, entry::compare);
+          threshold = top_entries[0].value;
+        }
+      }
+    }
+  }
+
+  // Sort candidates and pad with default entries
+  std::sort_heap(top_entries, top_entries + num_entries, entry::compare);
+  std::fill(top_entries + num_entries, top_entries + k, entry());
+
+}
+
 /** CPU implementation of in_top_k layer forward prop. */
 void fp_cpu(lbann_comm& comm,
             El::Int k,
@@ -66,7 +128,6 @@ void fp_cpu(lbann_comm& comm,
   const auto& local_input = input.LockedMatrix();
   auto& local_output = output.Matrix();
   const El::Int height = input.Height();
-  const El::Int local_height = local_input.Height();
   const El::Int local_width = local_input.Width();
 
   // Trivial cases
@@ -88,16 +149,7 @@ void fp_cpu(lbann_comm& comm,
   std::vector<entry> top_entries(local_width * k);
   LBANN_OMP_PARALLEL_FOR
   for (El::Int col = 0; col < local_width; ++col) {
-    std::vector<entry> local_entries(std::max(local_height, k));
-    for (El::Int row = 0; row < local_height; ++row) {
-      local_entries[row].value = local_input(row, col);
-      local_entries[row].index = input.GlobalRow(row);
-    }
-    std::partial_sort_copy(local_entries.begin(),
-                           local_entries.end(),
-                           &top_entries[col*k],
-                           &top_entries[col*k] + k,
-                           entry::compare);
+    find_local_top_k(k, local_input, input, col, &top_entries[col*k]);
   }
 
   // Find top-k entries in each column of global input matrix
@@ -26,6 +26,9 @@
 
 #include "lbann/layers/transform/sort.hpp"
 
+#include <algorithm>
+#include <numeric>
+
 namespace lbann {
 
 template <>
@@ -40,24 +43,24 @@ void sort_layer<data_layout::DATA_PARALLEL, El::Device::CPU>
   const auto& local_width = local_input.Width();
 
   // Sort each matrix column
+  // Note: Rows with equal values keep their relative order when
+  // sorting in ascending order and are reversed when sorting in
+  // descending order.
   LBANN_OMP_PARALLEL_FOR
   for (El::Int col = 0; col < local_width; ++col) {
-    std::multimap<DataType, El::Int> sorted_list;
-    for (El::Int row = 0; row < local_height; ++row) {
-      sorted_list.emplace(local_input(row, col), row);
-    }
+    const DataType* values = local_input.LockedBuffer(0, col);
+    std::vector<El::Int> rows(local_height);
+    std::iota(rows.begin(), rows.end(), 0);
+    std::stable_sort(rows.begin(), rows.end(),
+                     [values](const El::Int& a, const El::Int& b) {
+                       return values[a] < values[b];
+                     });
     if (m_descending) {
-      auto&& it = sorted_list.rbegin();
-      for (El::Int row = 0; row < local_height; ++row, ++it) {
-        local_output(row, col) = it->first;
-        local_indices(row, col) = it->second;
-      }
-    } else {
-      auto&& it = sorted_list.begin();
-      for (El::Int row = 0; row < local_height; ++row, ++it) {
-        local_output(row, col) = it->first;
-        local_indices(row, col) = it->second;
-      }
+      std::reverse(rows.begin(), rows.end());
+    }
+    for (El::Int row = 0; row < local_height; ++row) {
+      local_output(row, col) = values[rows[row]];
+      local_indices(row, col) = rows[row];
     }
   }
 
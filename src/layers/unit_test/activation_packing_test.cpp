@@ -0,0 +1,102 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/layers/layer.hpp>
+
+#include "TestHelpers.hpp"
+#include <lbann/layers/activations/activations.hpp>
+#include <lbann/layers/activations/identity.hpp>
+#include <lbann/layers/transform/constant.hpp>
+#include <lbann/layers/transform/split.hpp>
+#include <lbann/models/directed_acyclic_graph.hpp>
+#include <lbann/objective_functions/objective_function.hpp>
+#include <lbann/utils/memory.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using lbann::DataType;
+
+namespace {
+
+using dp_constant = lbann::constant_layer<lbann::data_layout::DATA_PARALLEL, El::Device::CPU>;
+using dp_split = lbann::split_layer<lbann::data_layout::DATA_PARALLEL, El::Device::CPU>;
+using dp_identity = lbann::identity_layer<lbann::data_layout::DATA_PARALLEL, El::Device::CPU>;
+using dp_relu = lbann::relu_layer<lbann::data_layout::DATA_PARALLEL, El::Device::CPU>;
+
+/** Model that exposes forward and back prop */
+class test_model : public lbann::directed_acyclic_graph_model {
+ public:
+  test_model(lbann::lbann_comm* comm, El::Int mini_batch_size)
+    : directed_acyclic_graph_model(comm, mini_batch_size,
+                                   new lbann::objective_function(),
+                                   nullptr) {}
+  using model::forward_prop;
+  using model::backward_prop;
+};
+
+lbann::Layer* add_layer(test_model& m, std::unique_ptr<lbann::Layer> l,
+                        const std::string& name,
+                        const std::vector<lbann::Layer*>& parents) {
+  auto* ptr = l.get();
+  ptr->set_name(name);
+  for (auto* parent : parents) {
+    ptr->add_parent_layer(parent);
+    parent->add_child_layer(ptr);
+  }
+  m.add_layer(std::move(l));
+  return ptr;
+}
+
+void check_values(const lbann::AbsDistMat& x, DataType value) {
+  REQUIRE(x.LocalHeight() > 0);
+  const auto& local = x.LockedMatrix();
+  for (El::Int j = 0; j < local.Width(); ++j) {
+    for (El::Int i = 0; i < local.Height(); ++i) {
+      CHECK(local(i, j) == value);
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("Testing packed activations behind views", "[layer][activations]") {
+  auto& comm = unit_test::utilities::current_world_comm();
+  const El::Int mini_batch_size = 4 * comm.get_procs_per_trainer();
+  test_model m(&comm, mini_batch_size);
+
+  // source -> split -> child (view) -> grandchild
+  //                 -> sibling
+  auto* source = add_layer(m, lbann::make_unique<dp_constant>(&comm, DataType(2), std::vector<int>{6}),
+                           "source", {});
+  auto* split = add_layer(m, lbann::make_unique<dp_split>(&comm), "split", {source});
+  auto* child = add_layer(m, lbann::make_unique<dp_identity>(&comm), "child", {split});
+  auto* grandchild = add_layer(m, lbann::make_unique<dp_relu>(&comm), "grandchild", {child});
+  auto* sibling = add_layer(m, lbann::make_unique<dp_relu>(&comm), "sibling", {split});
+
+  // Owned output of a layer whose only child computes a new tensor
+  auto* other_source = add_layer(m, lbann::make_unique<dp_constant>(&comm, DataType(3), std::vector<int>{6}),
+                                 "other_source", {});
+  auto* other_child = add_layer(m, lbann::make_unique<dp_relu>(&comm), "other_child", {other_source});
+
+  source->set_activation_storage_precision(lbann::storage_precision::bf16);
+  other_source->set_activation_storage_precision(lbann::storage_precision::bf16);
+  m.setup(nullptr);
+
+  m.forward_prop(lbann::execution_mode::training);
+
+  // Outputs read through views further down the graph stay allocated
+  CHECK_FALSE(source->has_packed_activations());
+  check_values(grandchild->get_activations(), DataType(2));
+  check_values(sibling->get_activations(), DataType(2));
+  CHECK(other_source->has_packed_activations());
+
+  m.backward_prop();
+
+  // Packed outputs are restored and views into them set up again
+  CHECK_FALSE(other_source->has_packed_activations());
+  check_values(other_child->get_prev_activations(), DataType(3));
+  check_values(grandchild->get_prev_activations(), DataType(2));
+}
@@ -0,0 +1,108 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/layers/layer.hpp>
+
+#include "TestHelpers.hpp"
+#include <lbann/layers/learning/convolution.hpp>
+#include <lbann/layers/transform/concatenation.hpp>
+#include <lbann/layers/transform/constant.hpp>
+#include <lbann/models/directed_acyclic_graph.hpp>
+#include <lbann/objective_functions/objective_function.hpp>
+#include <lbann/utils/memory.hpp>
+#include <lbann/weights/initializer.hpp>
+#include <lbann/weights/weights.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using lbann::DataType;
+
+namespace {
+
+using dp_constant = lbann::constant_layer<lbann::data_layout::DATA_PARALLEL, El::Device::CPU>;
+using dp_convolution = lbann::convolution_layer<lbann::data_layout::DATA_PARALLEL, El::Device::CPU>;
+using dp_concatenation = lbann::concatenation_layer<lbann::data_layout::DATA_PARALLEL, El::Device::CPU>;
+
+/** Model that exposes forward prop */
+class test_model : public lbann::directed_acyclic_graph_model {
+ public:
+  test_model(lbann::lbann_comm* comm, El::Int mini_batch_size)
+    : directed_acyclic_graph_model(comm, mini_batch_size,
+                                   new lbann::objective_function(),
+                                   nullptr) {}
+  using model::forward_prop;
+};
+
+lbann::Layer* add_layer(test_model& m, std::unique_ptr<lbann::Layer> l,
+                        const std::string& name,
+                        const std::vector<lbann::Layer*>& parents) {
+  auto* ptr = l.get();
+  ptr->set_name(name);
+  for (auto* parent : parents) {
+    ptr->add_parent_layer(parent);
+    parent->add_child_layer(ptr);
+  }
+  m.add_layer(std::move(l));
+  return ptr;
+}
+
+/** Convolution with constant kernel entries */
+lbann::Layer* add_convolution(test_model& m, lbann::lbann_comm& comm,
+                              const std::string& name, DataType value,
+                              lbann::Layer* parent) {
+  auto* w = new lbann::weights(&comm);
+  w->set_name(name + "_kernel");
+  w->set_initializer(lbann::make_unique<lbann::constant_initializer>(value));
+  m.add_weights(w);
+  auto* l = add_layer(m, lbann::make_unique<dp_convolution>(&comm, 2, 2, 3, 1, 1, 1, 1, false),
+                      name, {parent});
+  l->set_weights({w});
+  return l;
+}
+
+/** source -> conv_a, conv_b -> concatenation */
+lbann::Layer* build(test_model& m, lbann::lbann_comm& comm, bool placement) {
+  auto* source = add_layer(m, lbann::make_unique<dp_constant>(&comm, DataType(1), std::vector<int>{1, 4, 4}),
+                           "source", {});
+  auto* conv_a = add_convolution(m, comm, "conv_a", DataType(0.5), source);
+  auto* conv_b = add_convolution(m, comm, "conv_b", DataType(-0.25), source);
+  auto* concat = add_layer(m, lbann::make_unique<dp_concatenation>(&comm, 0),
+                           "concat", {conv_a, conv_b});
+  m.set_use_tensor_placement(placement);
+  m.setup(nullptr);
+  return concat;
+}
+
+} // namespace
+
+TEST_CASE("Testing convolution outputs placed in a concatenation", "[layer][placement]") {
+  auto& comm = unit_test::utilities::current_world_comm();
+  const El::Int mini_batch_size = 2 * comm.get_procs_per_trainer();
+
+  test_model placed(&comm, mini_batch_size), unplaced(&comm, mini_batch_size);
+  auto* placed_concat = build(placed, comm, true);
+  auto* unplaced_concat = build(unplaced, comm, false);
+  REQUIRE(placed_concat->is_tensor_placement_target());
+  CHECK_FALSE(unplaced_concat->is_tensor_placement_target());
+
+  placed.forward_prop(lbann::execution_mode::training);
+  unplaced.forward_prop(lbann::execution_mode::training);
+
+  // Convolutions write straight into the concatenated tensor
+  for (int i = 0; i < placed_concat->get_num_parents(); ++i) {
+    CHECK(placed_concat->get_parent_layers()[i]->get_activations().Viewing());
+  }
+  const auto& expected = unplaced_concat->get_activations().LockedMatrix();
+  const auto& actual = placed_concat->get_activations().LockedMatrix();
+  REQUIRE(actual.Height() == expected.Height());
+  REQUIRE(actual.Width() == expected.Width());
+  REQUIRE(actual.Height() > 0);
+  for (El::Int j = 0; j < expected.Width(); ++j) {
+    for (El::Int i = 0; i < expected.Height(); ++i) {
+      CHECK(actual(i, j) == expected(i, j));
+    }
+  }
+}
@@ -0,0 +1,160 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/layers/loss/top_k_categorical_accuracy.hpp>
+#include <lbann/layers/transform/in_top_k.hpp>
+#include <lbann/layers/transform/sort.hpp>
+
+#include "TestHelpers.hpp"
+#include <lbann/layers/transform/constant.hpp>
+#include <lbann/models/directed_acyclic_graph.hpp>
+#include <lbann/objective_functions/objective_function.hpp>
+#include <lbann/utils/memory.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using lbann::DataType;
+
+namespace {
+
+constexpr auto dp = lbann::data_layout::DATA_PARALLEL;
+constexpr auto mp = lbann::data_layout::MODEL_PARALLEL;
+constexpr auto cpu = El::Device::CPU;
+
+/** Model that exposes forward prop */
+class test_model : public lbann::directed_acyclic_graph_model {
+ public:
+  test_model(lbann::lbann_comm* comm, El::Int mini_batch_size)
+    : directed_acyclic_graph_model(comm, mini_batch_size,
+                                   new lbann::objective_function(),
+                                   nullptr) {}
+  using model::forward_prop;
+};
+
+lbann::Layer* add_layer(test_model& m, std::unique_ptr<lbann::Layer> l,
+                        const std::string& name,
+                        const std::vector<lbann::Layer*>& parents) {
+  auto* ptr = l.get();
+  ptr->set_name(name);
+  for (auto* parent : parents) {
+    ptr->add_parent_layer(parent);
+    parent->add_child_layer(ptr);
+  }
+  m.add_layer(std::move(l));
+  return ptr;
+}
+
+/** Prediction scores with many ties. */
+DataType prediction(El::Int row, El::Int col) {
+  return DataType((row * 37 + col * 11) % 23);
+}
+
+El::Int label(El::Int col, El::Int height) {
+  return (col * 53 + 7) % height;
+}
+
+/** Fill a tensor from its global entry indices. */
+template <typename F>
+void fill(lbann::AbsDistMat& x, F f) {
+  auto& local = x.Matrix();
+  for (El::Int j = 0; j < x.LocalWidth(); ++j) {
+    for (El::Int i = 0; i < x.LocalHeight(); ++i) {
+      local(i, j) = f(x.GlobalRow(i), x.GlobalCol(j));
+    }
+  }
+}
+
+/** Rows of a prediction column ranked by value in decreasing order,
+ *  with ties broken in favor of smaller indices. */
+std::vector<El::Int> rank_rows(El::Int col, El::Int height) {
+  std::vector<El::Int> rows(height);
+  std::iota(rows.begin(), rows.end(), 0);
+  std::stable_sort(rows.begin(), rows.end(),
+                   [col](El::Int a, El::Int b) {
+                     return prediction(a, col) > prediction(b, col);
+                   });
+  return rows;
+}
+
+/** Gather a layer output on every process. */
+lbann::StarMat<El::Device::CPU> gather(const lbann::Layer& l) {
+  lbann::StarMat<El::Device::CPU> x(l.get_activations().Grid());
+  El::Copy(l.get_activations(), x);
+  return x;
+}
+
+} // namespace
+
+TEST_CASE("Testing top-k selection layers", "[layer][top_k]") {
+  auto& comm = unit_test::utilities::current_world_comm();
+  const El::Int height = 200;
+  const El::Int k = 5;
+  const El::Int mini_batch_size = 3 * comm.get_procs_per_trainer();
+  test_model m(&comm, mini_batch_size);
+
+  // Columns are longer than the filter blocks of in_top_k
+  auto* predictions = add_layer(m, lbann::make_unique<lbann::constant_layer<dp, cpu>>(&comm, DataType(0), std::vector<int>{height}),
+                                "predictions", {});
+  auto* labels = add_layer(m, lbann::make_unique<lbann::constant_layer<dp, cpu>>(&comm, DataType(0), std::vector<int>{height}),
+                           "labels", {});
+  std::vector<lbann::Layer*> in_top_k = {
+    add_layer(m, lbann::make_unique<lbann::in_top_k_layer<dp, cpu>>(&comm, k), "in_top_k_dp", {predictions}),
+    add_layer(m, lbann::make_unique<lbann::in_top_k_layer<mp, cpu>>(&comm, k), "in_top_k_mp", {predictions})};
+  std::vector<lbann::Layer*> accuracy = {
+    add_layer(m, lbann::make_unique<lbann::top_k_categorical_accuracy_layer<dp, cpu>>(&comm, k), "accuracy_dp", {predictions, labels}),
+    add_layer(m, lbann::make_unique<lbann::top_k_categorical_accuracy_layer<mp, cpu>>(&comm, k), "accuracy_mp", {predictions, labels})};
+  auto* sorting = add_layer(m, lbann::make_unique<lbann::sort_layer<dp, cpu>>(&comm, true), "sort", {predictions});
+  m.setup(nullptr);
+
+  // Replace constant inputs and recompute
+  m.forward_prop(lbann::execution_mode::training);
+  fill(predictions->get_activations(), prediction);
+  fill(labels->get_activations(), [height](El::Int row, El::Int col) {
+      return DataType(row == label(col, height) ? 1 : 0);
+    });
+  for (auto* l : in_top_k) { l->forward_prop(); }
+  for (auto* l : accuracy) { l->forward_prop(); }
+  sorting->forward_prop();
+
+  for (auto* l : in_top_k) {
+    const auto output = gather(*l);
+    REQUIRE(output.Height() == height);
+    for (El::Int col = 0; col < output.Width(); ++col) {
+      const auto rows = rank_rows(col, height);
+      for (El::Int i = 0; i < height; ++i) {
+        const auto& row = rows[i];
+        CHECK(output.GetLocal(row, col) == DataType(i < k ? 1 : 0));
+      }
+    }
+  }
+
+  for (auto* l : accuracy) {
+    const auto output = gather(*l);
+    REQUIRE(output.Height() == 1);
+    for (El::Int col = 0; col < output.Width(); ++col) {
+      const auto rows = rank_rows(col, height);
+      const auto top_end = rows.begin() + k;
+      const bool in_top = std::find(rows.begin(), top_end, label(col, height)) != top_end;
+      CHECK(output.GetLocal(0, col) == DataType(in_top ? 1 : 0));
+    }
+  }
+
+  // Sorted in decreasing order
+  const auto output = gather(*sorting);
+  for (El::Int col = 0; col < output.Width(); ++col) {
+    std::vector<DataType> expected(height);
+    for (El::Int row = 0; row < height; ++row) {
+      expected[row] = prediction(row, col);
+    }
+    std::sort(expected.begin(), expected.end(), std::greater<DataType>());
+    for (El::Int row = 0; row < height; ++row) {
+      CHECK(output.GetLocal(row, col) == expected[row]);
+    }
+  }
+}
@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/metrics/evaluation_aggregator.hpp"
+#include "lbann/layers/transform/evaluation.hpp"
+#include "lbann/utils/exception.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+namespace lbann {
+
+evaluation_aggregator::evaluation_aggregator(const evaluation_aggregator& other)
+  : m_comm(other.m_comm),
+    m_reduction_interval(other.m_reduction_interval) {}
+
+evaluation_aggregator& evaluation_aggregator::operator=(const evaluation_aggregator& other) {
+  wait();
+  clear_slots();
+  m_comm = other.m_comm;
+  m_reduction_interval = other.m_reduction_interval;
+  return *this;
+}
+
+evaluation_aggregator::~evaluation_aggregator() {
+  wait();
+}
+
+void evaluation_aggregator::clear_slots() {
+  wait();
+  m_layers.clear();
+  m_mode = execution_mode::invalid;
+  m_pending_values.clear();
+  m_num_pending_steps = 0;
+  m_num_pending_samples = 0;
+  m_values.clear();
+  m_num_samples = 0;
+  m_has_values = false;
+}
+
+int evaluation_aggregator::add_slot(abstract_evaluation_layer& l) {
+  m_layers.push_back(&l);
+  m_pending_values.push_back(EvalType(0));
+  return m_layers.size() - 1;
+}
+
+void evaluation_aggregator::finish_step(execution_mode mode,
+                                        int mini_batch_size) {
+  if (m_num_pending_steps > 0 && mode != m_mode) {
+    std::stringstream err;
+    err << "evaluation values from " << to_string(m_mode) << " steps "
+        << "were not reduced before a " << to_string(mode) << " step";
+    LBANN_ERROR(err.str());
+  }
+  m_mode = mode;
+  for (size_t i = 0; i < m_layers.size(); ++i) {
+    m_pending_values[i] += m_layers[i]->get_local_value();
+  }
+  m_num_pending_samples += mini_batch_size;
+  ++m_num_pending_steps;
+  if (m_reduction_interval >= 0
+      && m_num_pending_steps >= m_reduction_interval) {
+    flush();
+  }
+}
+
+void evaluation_aggregator::flush() {
+  if (m_num_pending_steps == 0) { return; }
+
+  // Move pending values into the reduction buffer
+  // Note: Values that were never used are replaced.
+  wait();
+  m_values.assign(m_pending_values.begin(), m_pending_values.end());
+  m_num_samples = m_num_pending_samples;
+  m_has_values = true;
+  std::fill(m_pending_values.begin(), m_pending_values.end(), EvalType(0));
+  m_num_pending_steps = 0;
+  m_num_pending_samples = 0;
+
+  // Reduce all slots at once
+  if (!m_values.empty()) {
+    if (m_comm == nullptr) {
+      LBANN_ERROR("evaluation aggregator has no communicator");
+    }
+    m_comm->nb_allreduce(m_values.data(), m_values.size(),
+                         m_comm->get_trainer_comm(), m_request);
+    m_request_active = true;
+  }
+
+}
+
+EvalType evaluation_aggregator::get_value(int slot) {
+  if (!m_has_values || slot < 0 || slot >= (int) m_values.size()) {
+    std::stringstream err;
+    err << "attempted to get value of evaluation slot " << slot << " "
+        << "with " << (m_has_values ? m_values.size() : 0) << " "
+        << "reduced slots";
+    LBANN_ERROR(err.str());
+  }
+  wait();
+  return m_values[slot] / std::max(m_num_samples, 1);
+}
+
+void evaluation_aggregator::clear_values() {
+  wait();
+  m_has_values = false;
+}
+
+void evaluation_aggregator::wait() {
+  if (m_request_active) {
+    m_comm->wait(m_request);
+    m_request_active = false;
+  }
+}
+
+} // namespace lbann
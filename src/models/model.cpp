@@ -37,6 +37,7 @@
 #include "lbann/utils/random.hpp"
 #include "lbann/utils/omp_diagnostics.hpp"
 #include "lbann/utils/description.hpp"
+#include "lbann/utils/timer.hpp"
 #include "lbann/data_store/data_store_conduit.hpp"
 
 #include <model.pb.h>
@@ -48,6 +49,10 @@
 #include <iomanip>
 #include <queue>
 #include <unordered_set>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace lbann {
 
@@ -64,7 +69,8 @@ model::model(lbann_comm* comm,
     m_max_mini_batch_size(mini_batch_size),
     m_effective_mini_batch_size(mini_batch_size),
     m_default_optimizer(default_optimizer),
-    m_objective_function(obj_fn) {
+    m_objective_function(obj_fn),
+    m_evaluation_aggregator(comm) {
 
   // Default model name
   static El::Int num_models = 0;
@@ -83,7 +89,14 @@ model::model(const model& other) :
   m_current_mini_batch_size(other.m_current_mini_batch_size),
   m_max_mini_batch_size(other.m_max_mini_batch_size),
   m_effective_mini_batch_size(other.m_effective_mini_batch_size),
-  m_background_io_allowed(other.m_background_io_allowed) {
+  m_background_io_allowed(other.m_background_io_allowed),
+  m_use_weights_arena(other.m_use_weights_arena),
+  m_overlap_gradient_updates(other.m_overlap_gradient_updates),
+  m_layer_task_workers(other.m_layer_task_workers),
+  m_layer_task_threads(other.m_layer_task_threads),
+  m_use_tensor_placement(other.m_use_tensor_placement),
+  m_fuse_activations(other.m_fuse_activations),
+  m_folded_for_inference(other.m_folded_for_inference) {
 
   // Deep copies
   m_default_optimizer = (other.m_default_optimizer ?
@@ -122,12 +135,17 @@ model::model(const model& other) :
 
   // Fix pointers
   remap_pointers(layer_map, weights_map);
+  m_evaluation_aggregator = other.m_evaluation_aggregator;
+  setup_evaluation_aggregator();
 
 }
 
 model& model::operator=(const model& other) {
 
   // Delete objects
+  m_weights_arena.reset();
+  m_fp_scheduler.reset();
+  m_bp_scheduler.reset();
   if (m_objective_function != nullptr) { delete m_objective_function; }
   for (const auto& m : m_metrics)      { delete m; }
   for (const auto& cb : m_callbacks)   { delete cb; }
@@ -144,6 +162,13 @@ model& model::operator=(const model& other) {
   m_max_mini_batch_size = other.m_max_mini_batch_size;
   m_effective_mini_batch_size = other.m_effective_mini_batch_size;
   m_background_io_allowed = other.m_background_io_allowed;
+  m_use_weights_arena = other.m_use_weights_arena;
+  m_overlap_gradient_updates = other.m_overlap_gradient_updates;
+  m_layer_task_workers = other.m_layer_task_workers;
+  m_layer_task_threads = other.m_layer_task_threads;
+  m_use_tensor_placement = other.m_use_tensor_placement;
+  m_fuse_activations = other.m_fuse_activations;
+  m_folded_for_inference = other.m_folded_for_inference;
 
   // Deep copies
   m_objective_function = other.m_objective_function;
@@ -175,11 +200,14 @@ model& model::operator=(const model& other) {
     w = weights_map[w] = w->copy();
   }
   remap_pointers(layer_map, weights_map);
+  m_evaluation_aggregator = other.m_evaluation_aggregator;
+  setup_evaluation_aggregator();
 
   return *this;
 }
 
 model::~model() {
+  m_weights_arena.reset();
   if (m_objective_function != nullptr) { delete m_objective_function; }
   if (m_default_optimizer != nullptr)  { delete m_default_optimizer; }
   for (const auto& w : m_weights)      { delete w; }
@@ -449,6 +477,9 @@ void model::replace_weights(std::vector<weights*>& new_weights) {
     throw lbann_exception(err.str());
   }
 
+  // Weights in arena must own their data before any are deleted
+  if (m_weights_arena != nullptr) { m_weights_arena->detach(); }
+
   // Replace weights in list
   std::vector<weights *> old_weights(m_weights.begin(),
                                      m_weights.begin() + new_weights.size());
@@ -601,9 +632,13 @@ void model::setup(std::shared_ptr<thread_pool> io_thread_pool) {
   setup_layer_topology();
   setup_layer_execution_order();
   setup_layers();
+  setup_layer_fusion();
+  setup_tensor_placement();
+  setup_evaluation_aggregator();
 
   // Setup weights
   setup_weights();
+  setup_layer_scheduler();
 
   // Setup objective function
   m_objective_function->setup(*this);
@@ -617,6 +652,22 @@ void model::setup(std::shared_ptr<thread_pool> io_thread_pool) {
   for (const auto& cb : m_callbacks) {
     cb->setup(this);
   }
+
+  // Activations are kept in full precision if callbacks read them,
+  // since packed outputs are empty until back prop
+  if (m_pack_activations) {
+    for (const auto& cb : m_callbacks) {
+      if (cb->reads_activations()) {
+        m_pack_activations = false;
+        if (m_comm->am_world_master()) {
+          LBANN_WARNING("model \"", get_name(), "\" ignores reduced "
+                        "precision activation storage since callback ",
+                        cb->name(), " reads layer outputs");
+        }
+        break;
+      }
+    }
+  }
 }
 
 void model::setup_layer_topology() {
@@ -696,14 +747,194 @@ void model::setup_layer_execution_order() {
 }
 
 void model::setup_layers() {
+  m_pack_activations = false;
   for (El::Int i = 0; i < get_num_layers(); ++i) {
     auto& l = get_layer(i);
     l.set_model(this);
     l.setup();
     l.check_setup();
+    if (l.get_activation_storage_precision() != storage_precision::full) {
+      m_pack_activations = true;
+    }
+  }
+}
+
+void model::setup_evaluation_aggregator() {
+  m_evaluation_aggregator.set_comm(m_comm);
+  m_evaluation_aggregator.clear_slots();
+  for (El::Int i = 0; i < get_num_layers(); ++i) {
+    auto* eval = dynamic_cast<abstract_evaluation_layer*>(&get_layer(i));
+    if (eval != nullptr) {
+      eval->set_evaluation_slot(m_evaluation_aggregator.add_slot(*eval));
+    }
   }
 }
 
+void model::setup_tensor_placement() {
+  for (El::Int i = 0; i < get_num_layers(); ++i) {
+    get_layer(i).clear_tensor_placement();
+  }
+  if (!m_use_tensor_placement) { return; }
+  int num_placed = 0;
+  for (El::Int i = 0; i < get_num_layers(); ++i) {
+    num_placed += get_layer(i).setup_tensor_placement();
+  }
+  if (m_comm->am_world_master()) {
+    std::cout << "model \"" << get_name() << "\" "
+              << "placed " << num_placed << " tensors "
+              << "for zero-copy concatenation and slice" << std::endl;
+  }
+}
+
+void model::setup_layer_fusion() {
+  for (El::Int i = 0; i < get_num_layers(); ++i) {
+    get_layer(i).clear_activation_fusion();
+  }
+  if (!m_fuse_activations) { return; }
+  int num_fused = 0;
+  for (El::Int i = 0; i < get_num_layers(); ++i) {
+    auto& l = get_layer(i);
+    if (!l.supports_fused_activation() || l.get_num_children() != 1) {
+      continue;
+    }
+    auto& child = const_cast<Layer&>(*l.get_child_layers().front());
+    const auto& activation = child.get_fusable_activation();
+    if (!activation.has_activation()
+        || child.get_num_parents() != 1
+        || child.get_data_layout() != l.get_data_layout()
+        || child.get_device_allocation() != l.get_device_allocation()) {
+      continue;
+    }
+
+    // Output tensors in reduced precision storage are unpacked into
+    // new matrices, which would break the activation layer's view
+    if (l.get_activation_storage_precision() != storage_precision::full
+        || child.get_activation_storage_precision() != storage_precision::full) {
+      continue;
+    }
+
+    l.fuse_activation(child);
+    ++num_fused;
+    if (m_comm->am_world_master()) {
+      std::cout << "model \"" << get_name() << "\" "
+                << "fused " << activation.get_activation_name() << " "
+                << "layer \"" << child.get_name() << "\" "
+                << "into " << l.get_type() << " "
+                << "layer \"" << l.get_name() << "\"" << std::endl;
+    }
+  }
+  if (m_comm->am_world_master()) {
+    std::cout << "model \"" << get_name() << "\" "
+              << "fused " << num_fused << " activation layers "
+              << "into GEMM epilogues" << std::endl;
+  }
+}
+
+int model::fold_batch_normalization() {
+  std::stringstream err;
+
+  // Number of layers using each weights
+  std::unordered_map<const weights*,int> weights_users;
+  for (El::Int i = 0; i < get_num_layers(); ++i) {
+    for (const auto* w : get_layer(i).get_weights()) {
+      ++weights_users[w];
+    }
+  }
+
+  // Folded layers are checked with inference semantics
+  const auto mode = get_execution_mode();
+  set_execution_mode(execution_mode::testing);
+  const DataType tolerance
+    = std::sqrt(std::numeric_limits<DataType>::epsilon());
+  const El::Int probe_width = std::min(m_max_mini_batch_size, 8);
+
+  int num_folded = 0;
+  for (El::Int i = 0; i < get_num_layers(); ++i) {
+    auto& l = get_layer(i);
+    if (l.get_num_children() != 1
+        || l.get_fused_activation().has_activation()) {
+      continue;
+    }
+    auto& child = const_cast<Layer&>(*l.get_child_layers().front());
+    std::vector<DataType> scale, shift;
+    if (child.get_num_parents() != 1
+        || child.is_fused_into_parent()
+        || child.get_data_layout() != l.get_data_layout()
+        || child.get_device_allocation() != l.get_device_allocation()
+        || l.get_activation_storage_precision() != storage_precision::full
+        || child.get_activation_storage_precision() != storage_precision::full
+        || !child.get_foldable_affine(scale, shift)
+        || !l.supports_affine_folding(scale.size())) {
+      continue;
+    }
+
+    // Parameters are changed in place, so they must not be shared
+    bool shared_weights = false;
+    for (const auto* w : l.get_weights()) {
+      shared_weights = shared_weights || weights_users[w] > 1;
+    }
+    if (shared_weights) { continue; }
+
+    // Output of the unfolded layers on a random input
+    const auto& input = l.get_prev_activations();
+    std::unique_ptr<AbsDistMat> probe(input.Construct(input.Grid(),
+                                                      input.Root()));
+    gaussian_fill(*probe, l.get_input_size(), probe_width,
+                  DataType(0), DataType(1));
+    std::unique_ptr<AbsDistMat> reference(
+      child.forward_prop_probe(l.forward_prop_probe(*probe)).Copy());
+
+    // Fold and compare with the unfolded output
+    // Note: The difference is the norm of the error relative to the
+    // norm of the unfolded output.
+    l.fold_affine(child);
+    const auto& local_folded = l.forward_prop_probe(*probe).LockedMatrix();
+    const auto& local_reference = reference->LockedMatrix();
+    EvalType sqsums[2] = {EvalType(0), EvalType(0)};
+    for (El::Int col = 0; col < local_reference.Width(); ++col) {
+      for (El::Int row = 0; row < local_reference.Height(); ++row) {
+        const EvalType r = local_reference(row, col);
+        const EvalType f = local_folded(row, col);
+        sqsums[0] += (f - r) * (f - r);
+        sqsums[1] += r * r;
+      }
+    }
+    m_comm->allreduce(sqsums, 2, m_comm->get_trainer_comm(), El::mpi::SUM);
+    const EvalType difference
+      = std::sqrt(sqsums[0])
+      / (std::sqrt(sqsums[1]) + std::numeric_limits<DataType>::epsilon());
+    if (!(difference <= tolerance)) {
+      err << "folding " << child.get_type() << " "
+          << "layer \"" << child.get_name() << "\" "
+          << "into " << l.get_type() << " "
+          << "layer \"" << l.get_name() << "\" "
+          << "changed outputs by a relative difference of " << difference
+          << " (tolerance " << tolerance << ")";
+      LBANN_ERROR(err.str());
+    }
+
+    m_folded_for_inference = true;
+    ++num_folded;
+    if (m_comm->am_world_master()) {
+      std::cout << "model \"" << get_name() << "\" "
+                << "folded " << child.get_type() << " "
+                << "layer \"" << child.get_name() << "\" "
+                << "into " << l.get_type() << " "
+                << "layer \"" << l.get_name() << "\" "
+                << "(relative difference " << difference << ")"
+                << std::endl;
+    }
+  }
+  set_execution_mode(mode);
+
+  if (m_comm->am_world_master()) {
+    std::cout << "model \"" << get_name() << "\" "
+              << "folded " << num_folded << " layers "
+              << "into preceding layers for inference" << std::endl;
+  }
+  return num_folded;
+}
+
 void model::setup_weights() {
 
   // List of used and unused weights
@@ -749,6 +980,140 @@ void model::setup_weights() {
   // Setup weights
   for (auto* w : m_weights) { w->setup(); }
 
+  // Place data-parallel weights in contiguous arena
+  if (m_use_weights_arena) {
+    if (m_weights_arena == nullptr) {
+      m_weights_arena.reset(new weights_arena());
+    }
+    m_weights_arena->setup(m_weights);
+    if (m_comm->am_world_master()) {
+      std::cout << "model \"" << get_name() << "\" "
+                << m_weights_arena->get_summary() << std::endl;
+    }
+  }
+
+}
+
+void model::setup_layer_scheduler() {
+  m_fp_scheduler.reset();
+  m_bp_scheduler.reset();
+  for (auto* w : m_weights) {
+    auto* opt = w->get_optimizer();
+    if (opt != nullptr) { opt->set_defer_gradient_allreduce(false); }
+  }
+  if (m_layer_task_workers <= 1) { return; }
+
+  // Concurrent layers need a thread-safe MPI and host-side kernels
+  std::string fallback;
+  int thread_level = MPI_THREAD_SINGLE;
+  MPI_Query_thread(&thread_level);
+  if (thread_level < MPI_THREAD_MULTIPLE) {
+    fallback = "MPI does not provide MPI_THREAD_MULTIPLE";
+  }
+  for (El::Int i = 0; i < get_num_layers(); ++i) {
+    if (get_layer(i).get_device_allocation() == El::Device::GPU) {
+      fallback = "layer \"" + get_layer(i).get_name() + "\" runs on GPU";
+      break;
+    }
+  }
+  if (!fallback.empty()) {
+    if (m_comm->am_world_master()) {
+      std::cout << "model \"" << get_name() << "\" runs layers serially "
+                << "since " << fallback << std::endl;
+    }
+    return;
+  }
+
+  // Construct layer graph
+  // Note: Each layer depends on its parent layers and its hint
+  // layer. The layers are in topological order, so chaining layers
+  // by index keeps the graph acyclic.
+  const El::Int num_layers = get_num_layers();
+  std::set<El::Int> nodes;
+  std::map<El::Int,std::set<El::Int>> edges;
+  std::unordered_map<const Layer*,El::Int> layer_indices;
+  for (El::Int node = 0; node < num_layers; ++node) {
+    nodes.insert(node);
+    layer_indices[&get_layer(node)] = node;
+  }
+  for (El::Int node = 0; node < num_layers; ++node) {
+    const auto& l = get_layer(node);
+    for (const auto& child : l.get_child_layers()) {
+      edges[node].insert(layer_indices[child]);
+    }
+    if (l.get_hint_layer() != nullptr) {
+      edges[layer_indices[l.get_hint_layer()]].insert(node);
+    }
+  }
+
+  // Layers sharing weights are run one at a time
+  std::unordered_map<const weights*,std::vector<El::Int>> weights_users;
+  for (El::Int node = 0; node < num_layers; ++node) {
+    for (const auto* w : get_layer(node).get_weights()) {
+      weights_users[w].push_back(node);
+    }
+  }
+  for (const auto& users : weights_users) {
+    for (size_t j = 1; j < users.second.size(); ++j) {
+      edges[users.second[j-1]].insert(users.second[j]);
+    }
+  }
+
+  // Communicating layers are run one at a time in topological order
+  std::vector<El::Int> comm_chain;
+  for (El::Int node = 0; node < num_layers; ++node) {
+    if (!get_layer(node).may_run_concurrently()) {
+      comm_chain.push_back(node);
+    }
+  }
+  for (size_t j = 1; j < comm_chain.size(); ++j) {
+    edges[comm_chain[j-1]].insert(comm_chain[j]);
+  }
+  m_fp_scheduler.reset(new dag_scheduler(m_layer_task_workers,
+                                         m_layer_task_threads));
+  m_fp_scheduler->set_graph(nodes, edges);
+
+  // Back prop runs on the transposed graph. Each gradient allreduce
+  // is a node that follows the last layer using the weights. The
+  // allreduces join the chain of communicating layers, ordered by
+  // where that last layer is in back prop, so every process launches
+  // its collectives in the same order.
+  auto bp_edges = graph::transpose(nodes, edges);
+  std::vector<std::pair<El::Int,El::Int>> bp_comm_chain;
+  for (const auto& node : comm_chain) {
+    bp_comm_chain.emplace_back(2 * (num_layers - 1 - node), node);
+  }
+  for (size_t i = 0; i < m_weights.size(); ++i) {
+    const auto& users = weights_users[m_weights[i]];
+    if (users.empty() || m_weights[i]->get_optimizer() == nullptr) {
+      continue;
+    }
+    const El::Int node = num_layers + i;
+    nodes.insert(node);
+    for (const auto& user : users) {
+      bp_edges[user].insert(node);
+    }
+    bp_comm_chain.emplace_back(2 * (num_layers - 1 - users.front()) + 1, node);
+    m_weights[i]->get_optimizer()->set_defer_gradient_allreduce(true);
+  }
+  std::sort(bp_comm_chain.begin(), bp_comm_chain.end());
+  for (size_t j = 1; j < bp_comm_chain.size(); ++j) {
+    bp_edges[bp_comm_chain[j-1].second].insert(bp_comm_chain[j].second);
+  }
+  m_bp_scheduler.reset(new dag_scheduler(m_layer_task_workers,
+                                         m_layer_task_threads));
+  m_bp_scheduler->set_graph(nodes, bp_edges);
+
+  if (m_comm->am_world_master()) {
+    std::cout << "model \"" << get_name() << "\" "
+              << "runs layers on " << m_fp_scheduler->get_num_workers()
+              << " task workers with "
+              << m_fp_scheduler->get_threads_per_task()
+              << " OpenMP threads each, "
+              << comm_chain.size() << " of " << num_layers
+              << " layers run one at a time" << std::endl;
+  }
+
 }
 
 void model::add_evaluation_layers(std::unordered_set<Layer*>& layer_set,
@@ -975,6 +1340,8 @@ void model::evaluate(execution_mode mode, int num_batches) {
   }
 
   // Evaluate on all mini-batches
+  // Note: Deferred values from training steps are reduced first.
+  flush_evaluation();
   reset_epoch_statistics(mode);
   reset_mode_and_model(mode);
   do_evaluate_begin_cbs(mode);
@@ -983,10 +1350,17 @@ void model::evaluate(execution_mode mode, int num_batches) {
   } else {
     while (!evaluate_mini_batch(mode)) {}
   }
+  flush_evaluation();
   do_evaluate_end_cbs(mode);
 }
 
 void model::train(int num_epochs, int num_batches) {
+  if (m_folded_for_inference) {
+    std::stringstream err;
+    err << "attempted to train model \"" << get_name() << "\" "
+        << "after folding layers for inference";
+    LBANN_ERROR(err.str());
+  }
   do_train_begin_cbs();
   for (int epoch = m_epoch; epoch < num_epochs; ++epoch) {
     if (get_terminate_training()) { break; }
@@ -996,6 +1370,7 @@ void model::train(int num_epochs, int num_batches) {
     do_epoch_begin_cbs();
 
     // Training iterations
+    const auto first_step = get_step(execution_mode::training);
     if (num_batches > 0) {
       for (int i = 0; i < num_batches; i++) { train_mini_batch(); }
     } else {
@@ -1003,6 +1378,35 @@ void model::train(int num_epochs, int num_batches) {
     }
 
     // Finalize epoch
+    flush_evaluation();
+    const auto num_steps = std::max(get_step(execution_mode::training) - first_step,
+                                    El::Int(1));
+    if (m_overlap_gradient_updates && m_comm->am_world_master()) {
+      std::cout << "model \"" << get_name() << "\" "
+                << "gradient communication per step on world master: "
+                << m_epoch_hidden_gradient_comm_time / num_steps << "s hidden, "
+                << m_epoch_exposed_gradient_comm_time / num_steps << "s exposed"
+                << std::endl;
+    }
+    if (m_fp_scheduler != nullptr && m_comm->am_world_master()) {
+      const auto& run_time = m_epoch_layer_task_run_time;
+      const auto& work_time = m_epoch_layer_task_work_time;
+      const auto& critical_path_time = m_epoch_layer_task_critical_path_time;
+      std::cout << "model \"" << get_name() << "\" "
+                << "layer tasks per step on world master: "
+                << run_time / num_steps << "s wall clock, "
+                << work_time / num_steps << "s work, "
+                << critical_path_time / num_steps << "s critical path, "
+                << "parallelism "
+                << (run_time > 0 ? work_time / run_time : 0) << " achieved of "
+                << (critical_path_time > 0 ? work_time / critical_path_time : 0)
+                << " available" << std::endl;
+    }
+    m_epoch_hidden_gradient_comm_time = 0;
+    m_epoch_exposed_gradient_comm_time = 0;
+    m_epoch_layer_task_run_time = 0;
+    m_epoch_layer_task_work_time = 0;
+    m_epoch_layer_task_critical_path_time = 0;
     ++m_epoch;
     reconcile_weight_values();
     do_epoch_end_cbs();
@@ -1071,11 +1475,9 @@ bool model::evaluate_mini_batch(execution_mode mode) {
   reset_mode_and_model(mode);
   do_batch_begin_cbs(mode);
   forward_prop(mode);
-  m_objective_function->start_evaluation(mode, get_current_mini_batch_size());
-  m_objective_function->finish_evaluation(mode, get_current_mini_batch_size());
-  for (const auto& m : m_metrics) {
-    m->evaluate(mode, get_current_mini_batch_size());
-  }
+  m_evaluation_aggregator.finish_step(mode, get_current_mini_batch_size());
+  start_evaluation();
+  finish_evaluation();
   const bool finished = update_layers();
 
   // Increment mini-batch step
@@ -1105,18 +1507,23 @@ bool model::train_mini_batch() {
   clear_gradients();
   forward_prop(mode);
   // Result is not needed until the end of the mini-batch.
-  m_objective_function->start_evaluation(mode, get_current_mini_batch_size());
+  m_evaluation_aggregator.finish_step(mode, get_current_mini_batch_size());
+  start_evaluation();
 
   // Backward prop step
+  // Note: Weights may be optimized during back prop when overlapping
+  // gradient updates, so regularization is added beforehand.
   m_objective_function->differentiate();
-  backward_prop();
-  m_objective_function->compute_weight_regularization();
+  if (m_overlap_gradient_updates) {
+    m_objective_function->compute_weight_regularization();
+    backward_prop();
+  } else {
+    backward_prop();
+    m_objective_function->compute_weight_regularization();
+  }
 
   // Finish evaluation.
-  m_objective_function->finish_evaluation(mode, get_current_mini_batch_size());
-  for (const auto& m : m_metrics) {
-    m->evaluate(mode, get_current_mini_batch_size());
-  }
+  finish_evaluation();
 
   // Update step
   update_weights();
@@ -1135,6 +1542,32 @@ bool model::train_mini_batch() {
   return finished;
 }
 
+void model::start_evaluation() {
+  auto& aggregator = m_evaluation_aggregator;
+  if (!aggregator.has_values()) { return; }
+  m_objective_function->start_evaluation(aggregator.get_mode(),
+                                         aggregator.get_num_samples());
+}
+
+void model::finish_evaluation() {
+  auto& aggregator = m_evaluation_aggregator;
+  if (!aggregator.has_values()) { return; }
+  const auto mode = aggregator.get_mode();
+  const auto num_samples = aggregator.get_num_samples();
+  m_objective_function->finish_evaluation(mode, num_samples);
+  for (const auto& m : m_metrics) {
+    m->evaluate(mode, num_samples);
+  }
+  aggregator.clear_values();
+}
+
+void model::flush_evaluation() {
+  if (!m_evaluation_aggregator.has_pending_steps()) { return; }
+  m_evaluation_aggregator.flush();
+  start_evaluation();
+  finish_evaluation();
+}
+
 void model::clear_gradients() {
   for (const auto& w : m_weights) {
     optimizer* opt = w->get_optimizer();
@@ -1144,24 +1577,115 @@ void model::clear_gradients() {
 
 void model::forward_prop(execution_mode mode) {
   do_model_forward_prop_begin_cbs(mode);
-  for (El::Int i = 0; i < get_num_layers(); ++i) {
+
+  // Activations are only packed if they are needed for back prop
+  // Note: A layer's outputs are packed once all of its children have
+  // finished forward prop.
+  const bool pack_activations = (m_pack_activations
+                                 && mode == execution_mode::training);
+  std::unordered_map<const Layer*, int> num_pending_children;
+  size_t bytes_saved = 0;
+
+  auto run_layer = [&](El::Int i) {
     auto& l = get_layer(i);
-    do_layer_forward_prop_begin_cbs(mode, &l);
+    {
+      std::lock_guard<std::mutex> lock(m_layer_task_mutex);
+      do_layer_forward_prop_begin_cbs(mode, &l);
+    }
     l.forward_prop();
-    do_layer_forward_prop_end_cbs(mode, &l);
+    std::vector<Layer*> finished_parents;
+    {
+      std::lock_guard<std::mutex> lock(m_layer_task_mutex);
+      do_layer_forward_prop_end_cbs(mode, &l);
+      if (pack_activations) {
+        for (const auto* parent : l.get_parent_layers()) {
+          if (num_pending_children.count(parent) == 0) {
+            num_pending_children[parent] = parent->get_num_children();
+          }
+          if (--num_pending_children[parent] == 0) {
+            finished_parents.push_back(const_cast<Layer*>(parent));
+          }
+        }
+      }
+    }
+    size_t bytes = 0;
+    for (auto* parent : finished_parents) {
+      bytes += parent->pack_activations();
+    }
+    if (bytes > 0) {
+      std::lock_guard<std::mutex> lock(m_layer_task_mutex);
+      bytes_saved += bytes;
+    }
+  };
+  if (m_fp_scheduler != nullptr) {
+    m_fp_scheduler->run(run_layer);
+    if (mode == execution_mode::training) {
+      m_epoch_layer_task_run_time += m_fp_scheduler->get_run_time();
+      m_epoch_layer_task_work_time += m_fp_scheduler->get_work_time();
+      m_epoch_layer_task_critical_path_time += m_fp_scheduler->get_critical_path_time();
+    }
+  } else {
+    for (El::Int i = 0; i < get_num_layers(); ++i) { run_layer(i); }
   }
+
+  // Report memory savings after first training step
+  if (pack_activations) {
+    if (get_step(execution_mode::training) == 0
+        && m_comm->am_world_master()) {
+      std::cout << "model \"" << get_name() << "\" "
+                << "reduced precision activation storage saves "
+                << bytes_saved / (1024.0 * 1024.0) << " MB "
+                << "on world master" << std::endl;
+    }
+    m_activation_storage_bytes_saved = bytes_saved;
+  }
+
   do_model_forward_prop_end_cbs(mode);
 }
 
 void model::backward_prop() {
   do_model_backward_prop_begin_cbs();
-  for (El::Int i = get_num_layers()-1; i >= 0; --i) {
+  m_weights_stepped.assign(m_weights.size(), false);
+  m_gradient_launch_times.assign(m_weights.size(), EvalType(-1));
+  m_hidden_gradient_comm_time = 0;
+
+  // Run layers as tasks
+  // Note: Nodes past the last layer launch gradient allreduces.
+  if (m_bp_scheduler != nullptr) {
+    const El::Int num_layers = get_num_layers();
+    m_bp_scheduler->run([this,num_layers](El::Int node) {
+        if (node >= num_layers) {
+          std::lock_guard<std::mutex> lock(m_layer_task_mutex);
+          launch_gradient_allreduce(node - num_layers);
+          if (m_overlap_gradient_updates) { step_ready_weights(); }
+          return;
+        }
+        auto& l = get_layer(node);
+        {
+          std::lock_guard<std::mutex> lock(m_layer_task_mutex);
+          if (m_pack_activations) { unpack_activations_for_back_prop(l); }
+          do_layer_backward_prop_begin_cbs(&l);
+        }
+        l.back_prop();
+        std::lock_guard<std::mutex> lock(m_layer_task_mutex);
+        do_layer_backward_prop_end_cbs(&l);
+        if (m_overlap_gradient_updates) { step_ready_weights(); }
+      });
+    m_epoch_layer_task_run_time += m_bp_scheduler->get_run_time();
+    m_epoch_layer_task_work_time += m_bp_scheduler->get_work_time();
+    m_epoch_layer_task_critical_path_time += m_bp_scheduler->get_critical_path_time();
+  }
+
+  El::Int i = (m_bp_scheduler != nullptr) ? -1 : get_num_layers()-1;
+  for (; i >= 0; --i) {
 
     // Perform backward prop step on current layer
     auto& l = get_layer(i);
+    if (m_pack_activations) { unpack_activations_for_back_prop(l); }
     do_layer_backward_prop_begin_cbs(&l);
     l.back_prop();
     do_layer_backward_prop_end_cbs(&l);
+    if (m_overlap_gradient_updates) { step_ready_weights(); }
 
     // Terminate early if all gradients have been computed
     bool all_gradients_computed = true;
@@ -1175,21 +1699,136 @@ void model::backward_prop() {
     if (all_gradients_computed) { break; }
 
   }
+
+  // Restore activations of layers that skipped back prop
+  if (m_pack_activations) {
+    for (El::Int j = i - 1; j >= 0; --j) {
+      unpack_activations_for_back_prop(get_layer(j));
+    }
+  }
+
+  // Report copies avoided by tensor placement after first training
+  // step
+  if (m_use_tensor_placement) {
+    m_bytes_copy_elided = 0;
+    for (El::Int j = 0; j < get_num_layers(); ++j) {
+      m_bytes_copy_elided += get_layer(j).get_bytes_copy_elided();
+    }
+    if (get_step(execution_mode::training) == 0
+        && m_comm->am_world_master()) {
+      std::cout << "model \"" << get_name() << "\" "
+                << "zero-copy concatenation and slice elides "
+                << m_bytes_copy_elided / (1024.0 * 1024.0) << " MB "
+                << "of copies per step on world master" << std::endl;
+    }
+  }
+
   do_model_backward_prop_end_cbs();
 }
 
+void model::unpack_activations_for_back_prop(Layer& l) {
+  l.unpack_activations();
+  bool refresh_inputs = false;
+  for (const auto* parent : l.get_parent_layers()) {
+    if (parent->get_activation_storage_precision()
+        != storage_precision::full) {
+      const_cast<Layer*>(parent)->unpack_activations();
+      refresh_inputs = true;
+    }
+  }
+
+  // Output buffers may have been reallocated by any child of the
+  // parents, so input tensors are set up even if nothing was packed
+  if (refresh_inputs) { l.refresh_inputs(); }
+}
+
+void model::launch_gradient_allreduce(El::Int i) {
+  optimizer* opt = m_weights[i]->get_optimizer();
+  if (opt == nullptr || opt->get_num_gradient_sources() != 0) { return; }
+  opt->is_gradient_ready();
+  m_gradient_launch_times[i] = get_time();
+}
+
+void model::step_ready_weights() {
+  for (size_t i = 0; i < m_weights.size(); ++i) {
+    if (m_weights_stepped[i]) { continue; }
+    auto& w = *m_weights[i];
+    optimizer* opt = w.get_optimizer();
+    if (opt == nullptr
+        || (m_bp_scheduler != nullptr && m_gradient_launch_times[i] < EvalType(0))
+        || opt->get_num_gradient_sources() != 0
+        || (m_weights_arena != nullptr && m_weights_arena->contains(w))) {
+      continue;
+    }
+    const auto now = get_time();
+    if (m_gradient_launch_times[i] < EvalType(0)) {
+      m_gradient_launch_times[i] = now;
+    }
+    if (opt->is_gradient_ready()) {
+      m_hidden_gradient_comm_time += now - m_gradient_launch_times[i];
+      do_weight_optimize_begin_cbs(&w);
+      opt->step();
+      do_weight_optimize_end_cbs(&w);
+      m_weights_stepped[i] = true;
+    }
+  }
+}
+
 void model::update_weights() {
+  const auto start_time = get_time();
   do_model_optimize_begin_cbs();
+
+  // Wait for gradients that were not complete during back prop
+  if (m_overlap_gradient_updates) {
+    const auto wait_start = get_time();
+    for (size_t i = 0; i < m_weights.size(); ++i) {
+      auto& w = *m_weights[i];
+      optimizer* opt = w.get_optimizer();
+      if (opt == nullptr || m_weights_stepped[i]
+          || (m_weights_arena != nullptr && m_weights_arena->contains(w))) {
+        continue;
+      }
+      if (m_gradient_launch_times[i] >= EvalType(0)) {
+        m_hidden_gradient_comm_time += wait_start - m_gradient_launch_times[i];
+      }
+      opt->get_gradient();
+    }
+    m_exposed_gradient_comm_time = get_time() - wait_start;
+    m_epoch_hidden_gradient_comm_time += m_hidden_gradient_comm_time;
+    m_epoch_exposed_gradient_comm_time += m_exposed_gradient_comm_time;
+  }
+
+  if (m_weights_arena != nullptr) {
+
+    // Weights in arena are optimized with one fused step
+    for (El::Int i = m_weights.size()-1; i >= 0; --i) {
+      auto& w = *m_weights[i];
+      if (w.get_optimizer() != nullptr && m_weights_arena->contains(w)) {
+        do_weight_optimize_begin_cbs(&w);
+      }
+    }
+    m_weights_arena->step();
+    for (El::Int i = m_weights.size()-1; i >= 0; --i) {
+      auto& w = *m_weights[i];
+      if (w.get_optimizer() != nullptr && m_weights_arena->contains(w)) {
+        do_weight_optimize_end_cbs(&w);
+      }
+    }
+
+  }
   for (El::Int i = m_weights.size()-1; i >= 0; --i) {
     auto& w = *m_weights[i];
     optimizer* opt = w.get_optimizer();
-    if (opt != nullptr) {
+    if (opt != nullptr
+        && !(m_overlap_gradient_updates && m_weights_stepped[i])
+        && (m_weights_arena == nullptr || !m_weights_arena->contains(w))) {
       do_weight_optimize_begin_cbs(&w);
       opt->step();
       do_weight_optimize_end_cbs(&w);
     }
   }
   do_model_optimize_end_cbs();
+  m_update_weights_time += get_time() - start_time;
 }
 
 bool model::update_layers() {
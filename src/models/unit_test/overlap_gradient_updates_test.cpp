@@ -0,0 +1,151 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/models/model.hpp>
+
+#include "TestHelpers.hpp"
+#include <lbann/layers/learning/fully_connected.hpp>
+#include <lbann/layers/loss/l2_norm2.hpp>
+#include <lbann/layers/transform/constant.hpp>
+#include <lbann/layers/transform/evaluation.hpp>
+#include <lbann/models/directed_acyclic_graph.hpp>
+#include <lbann/objective_functions/layer_term.hpp>
+#include <lbann/objective_functions/objective_function.hpp>
+#include <lbann/optimizers/sgd.hpp>
+#include <lbann/utils/memory.hpp>
+#include <lbann/weights/initializer.hpp>
+#include <lbann/weights/weights.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using lbann::DataType;
+
+namespace {
+
+using dp_constant = lbann::constant_layer<lbann::data_layout::DATA_PARALLEL, El::Device::CPU>;
+using dp_fc = lbann::fully_connected_layer<lbann::data_layout::DATA_PARALLEL, El::Device::CPU>;
+using dp_l2_norm2 = lbann::l2_norm2_layer<lbann::data_layout::DATA_PARALLEL, El::Device::CPU>;
+using dp_evaluation = lbann::evaluation_layer<lbann::data_layout::DATA_PARALLEL, El::Device::CPU>;
+
+/** Model that exposes the steps of a training mini-batch */
+class test_model : public lbann::directed_acyclic_graph_model {
+ public:
+  test_model(lbann::lbann_comm* comm, El::Int mini_batch_size)
+    : directed_acyclic_graph_model(comm, mini_batch_size,
+                                   new lbann::objective_function(),
+                                   new lbann::sgd(comm, DataType(0.1))) {}
+  using model::forward_prop;
+  using model::backward_prop;
+  using model::update_weights;
+};
+
+lbann::Layer* add_layer(test_model& m, std::unique_ptr<lbann::Layer> l,
+                        const std::string& name,
+                        const std::vector<lbann::Layer*>& parents) {
+  auto* ptr = l.get();
+  ptr->set_name(name);
+  for (auto* parent : parents) {
+    ptr->add_parent_layer(parent);
+    parent->add_child_layer(ptr);
+  }
+  m.add_layer(std::move(l));
+  return ptr;
+}
+
+lbann::weights* add_weights(test_model& m, lbann::Layer& l, DataType value) {
+  auto* w = new lbann::weights(m.get_comm());
+  w->set_name(l.get_name() + "_weights");
+  w->set_initializer(lbann::make_unique<lbann::constant_initializer>(value));
+  w->set_optimizer(lbann::make_unique<lbann::sgd>(m.get_comm(), DataType(0.1)));
+  l.set_weights({w});
+  m.add_weights(w);
+  return w;
+}
+
+/** constant -> fc1 -> fc2 -> l2_norm2 -> evaluation */
+struct test_network {
+  test_network(lbann::lbann_comm& comm, bool overlap)
+    : m(&comm, 2 * comm.get_procs_per_trainer()) {
+    auto* input = add_layer(m, lbann::make_unique<dp_constant>(&comm, DataType(1), std::vector<int>{4}),
+                            "input", {});
+    auto* fc1 = add_layer(m, lbann::make_unique<dp_fc>(&comm, 3, false, nullptr, false),
+                          "fc1", {input});
+    auto* fc2 = add_layer(m, lbann::make_unique<dp_fc>(&comm, 2, false, nullptr, false),
+                          "fc2", {fc1});
+    auto* loss = add_layer(m, lbann::make_unique<dp_l2_norm2>(&comm), "loss", {fc2});
+    auto* eval = add_layer(m, lbann::make_unique<dp_evaluation>(&comm), "eval", {loss});
+    w1 = add_weights(m, *fc1, DataType(0.5));
+    w2 = add_weights(m, *fc2, DataType(0.25));
+    auto* term = new lbann::layer_term();
+    term->set_layer(*eval);
+    m.get_objective_function()->add_term(term);
+    m.set_overlap_gradient_updates(overlap);
+    m.setup(nullptr);
+  }
+
+  void forward_and_back_prop() {
+    m.forward_prop(lbann::execution_mode::training);
+    m.get_objective_function()->differentiate();
+    m.get_objective_function()->compute_weight_regularization();
+    m.backward_prop();
+  }
+
+  test_model m;
+  lbann::weights* w1 = nullptr;
+  lbann::weights* w2 = nullptr;
+};
+
+void check_values(const lbann::weights& w, DataType value) {
+  const auto& local = w.get_values().LockedMatrix();
+  for (El::Int j = 0; j < local.Width(); ++j) {
+    for (El::Int i = 0; i < local.Height(); ++i) {
+      CHECK(local(i, j) == Approx(value));
+    }
+  }
+}
+
+void check_equal(const lbann::weights& expected, const lbann::weights& actual) {
+  const auto& e = expected.get_values().LockedMatrix();
+  const auto& a = actual.get_values().LockedMatrix();
+  REQUIRE(a.Height() == e.Height());
+  REQUIRE(a.Width() == e.Width());
+  for (El::Int j = 0; j < e.Width(); ++j) {
+    for (El::Int i = 0; i < e.Height(); ++i) {
+      CHECK(a(i, j) == Approx(e(i, j)));
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("Testing optimization steps during back prop", "[model][optimizer]") {
+  auto& comm = unit_test::utilities::current_world_comm();
+  test_network reference(comm, false);
+  test_network overlapped(comm, true);
+  REQUIRE(overlapped.m.overlapping_gradient_updates());
+
+  for (int step = 0; step < 3; ++step) {
+    reference.forward_and_back_prop();
+    reference.m.update_weights();
+
+    overlapped.forward_and_back_prop();
+    if (step == 0) {
+      // fc1 is the last layer with weights, so its gradient allreduce
+      // is launched but can't be complete when back prop returns
+      check_values(*overlapped.w1, DataType(0.5));
+    }
+    overlapped.m.update_weights();
+    CHECK(overlapped.m.get_hidden_gradient_comm_time() >= 0);
+    CHECK(overlapped.m.get_exposed_gradient_comm_time() >= 0);
+
+    check_equal(*reference.w1, *overlapped.w1);
+    check_equal(*reference.w2, *overlapped.w2);
+  }
+
+  // The steps actually changed the weights
+  const auto& local = overlapped.w2->get_values().LockedMatrix();
+  CHECK(local(0, 0) != Approx(DataType(0.25)));
+}
@@ -176,6 +176,55 @@ void adam::step_compute_cpu(AbsDistMat& values, const AbsDistMat& gradient) {
 
 }
 
+// =============================================
+// Fused optimization steps
+// =============================================
+
+std::vector<AbsDistMat*> adam::get_state_matrices() {
+  return {m_moment1.get(), m_moment2.get()};
+}
+
+bool adam::is_step_fusable(const optimizer& other) const {
+  const auto* other_adam = dynamic_cast<const adam*>(&other);
+  return (other_adam != nullptr
+          && other_adam->get_type() == get_type()
+          && other_adam->get_learning_rate() == get_learning_rate()
+          && other_adam->m_beta1 == m_beta1
+          && other_adam->m_beta2 == m_beta2
+          && other_adam->m_eps == m_eps
+          && other_adam->m_current_beta1 == m_current_beta1
+          && other_adam->m_current_beta2 == m_current_beta2);
+}
+
+void adam::fused_step_begin() {
+  m_current_beta1 *= m_beta1;
+  m_current_beta2 *= m_beta2;
+}
+
+void adam::fused_step_compute(size_t size,
+                              DataType* values,
+                              const DataType* gradient,
+                              const std::vector<DataType*>& state) {
+  constexpr DataType one = 1;
+  const DataType correction = this->get_learning_rate() *
+                              (std::sqrt(one - m_current_beta2)
+                               / (one - m_current_beta1));
+  auto* __restrict__ values_buffer = values;
+  const auto* __restrict__ gradient_buffer = gradient;
+  auto* __restrict__ moment1_buffer = state[0];
+  auto* __restrict__ moment2_buffer = state[1];
+  LBANN_OMP_PARALLEL_FOR
+  for (size_t i = 0; i < size; ++i) {
+    auto& x = values_buffer[i];
+    const auto& g = gradient_buffer[i] + m_eps; // Avoid denormalized floats
+    auto& m1 = moment1_buffer[i];
+    auto& m2 = moment2_buffer[i];
+    m1 = m_beta1 * m1 + (one - m_beta1) * g;
+    m2 = m_beta2 * m2 + (one - m_beta2) * g * g;
+    x -= correction * m1 / (std::sqrt(m2) + m_eps);
+  }
+}
+
 // =============================================
 // Checkpointing
 // =============================================
@@ -58,6 +58,7 @@ optimizer::optimizer(const optimizer& other)
     m_gradient_v(other.m_gradient_v ? other.m_gradient_v->Copy() : nullptr),
     m_gradient_sources(other.m_gradient_sources),
     m_gradient_status(other.m_gradient_status),
+    m_defer_gradient_allreduce(other.m_defer_gradient_allreduce),
     m_learning_rate(other.m_learning_rate),
     m_step_time(other.m_step_time) {
   if (m_gradient_status == optimizer_gradient_status::allreduce_started) {
@@ -73,6 +74,7 @@ optimizer& optimizer::operator=(const optimizer& other) {
   m_gradient_v.reset(other.m_gradient_v ? other.m_gradient_v->Copy() : nullptr);
   m_gradient_sources = other.m_gradient_sources;
   m_gradient_status = other.m_gradient_status;
+  m_defer_gradient_allreduce = other.m_defer_gradient_allreduce;
   m_learning_rate = other.m_learning_rate;
   m_step_time = other.m_step_time;
   if (m_gradient_status == optimizer_gradient_status::allreduce_started) {
@@ -247,6 +249,28 @@ AbsDistMat& optimizer::get_gradient_buffer(DataType& buf_scale,
   return *m_gradient;
 }
 
+bool optimizer::is_gradient_ready() {
+  if (!m_gradient_sources.empty()) { return false; }
+  switch (m_gradient_status) {
+  case optimizer_gradient_status::ready:
+  case optimizer_gradient_status::cleared:
+    return true;
+  case optimizer_gradient_status::allreduce_needed:
+    start_gradient_allreduce();
+    return false;
+  case optimizer_gradient_status::allreduce_started:
+    if (get_comm().test(m_gradient_allreduce_req)) {
+      finish_gradient_allreduce();
+      return true;
+    }
+    return false;
+  default:
+    LBANN_ERROR("unexpected gradient status "
+                "(" + to_string(m_gradient_status) + ")");
+  }
+  return false;
+}
+
 El::Int optimizer::get_num_gradient_sources() const {
   return m_gradient_sources.size();
 }
@@ -260,7 +284,7 @@ void optimizer::add_gradient_source(const void* source) {
 void optimizer::remove_gradient_source(const void* source) {
   m_gradient_sources.erase(nullptr);
   m_gradient_sources.erase(source);
-  if (m_gradient_sources.empty()) {
+  if (m_gradient_sources.empty() && !m_defer_gradient_allreduce) {
     start_gradient_allreduce();
   }
 }
@@ -300,6 +324,13 @@ void optimizer::step() {
   m_step_time += get_time() - start_time;
 }
 
+void optimizer::fused_step_compute(size_t size,
+                                   DataType* values,
+                                   const DataType* gradient,
+                                   const std::vector<DataType*>& state) {
+  LBANN_ERROR(get_type() + " optimizer does not support fused steps");
+}
+
 DataType optimizer::get_learning_rate() const {
   return m_learning_rate;
 }
@@ -109,6 +109,41 @@ void rmsprop::step_compute_cpu(AbsDistMat& values, const AbsDistMat& gradient) {
 
 }
 
+// =============================================
+// Fused optimization steps
+// =============================================
+
+std::vector<AbsDistMat*> rmsprop::get_state_matrices() {
+  return {m_cache.get()};
+}
+
+bool rmsprop::is_step_fusable(const optimizer& other) const {
+  const auto* other_rmsprop = dynamic_cast<const rmsprop*>(&other);
+  return (other_rmsprop != nullptr
+          && other_rmsprop->get_type() == get_type()
+          && other_rmsprop->get_learning_rate() == get_learning_rate()
+          && other_rmsprop->m_decay_rate == m_decay_rate
+          && other_rmsprop->m_eps == m_eps);
+}
+
+void rmsprop::fused_step_compute(size_t size,
+                                 DataType* values,
+                                 const DataType* gradient,
+                                 const std::vector<DataType*>& state) {
+  const auto& learning_rate = get_learning_rate();
+  auto* __restrict__ values_buffer = values;
+  const auto* __restrict__ gradient_buffer = gradient;
+  auto* __restrict__ cache_buffer = state[0];
+  LBANN_OMP_PARALLEL_FOR
+  for (size_t i = 0; i < size; ++i) {
+    auto& x = values_buffer[i];
+    const auto& g = gradient_buffer[i];
+    auto& c = cache_buffer[i];
+    c = m_decay_rate * c + (DataType(1) - m_decay_rate) * g * g;
+    x -= learning_rate * g / (std::sqrt(c) + m_eps);
+  }
+}
+
 // =============================================
 // Checkpointing
 // =============================================
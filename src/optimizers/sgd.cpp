@@ -162,6 +162,57 @@ void sgd::momentum_step_cpu(AbsDistMat& values, const AbsDistMat& gradient) {
 
 }
 
+// =============================================
+// Fused optimization steps
+// =============================================
+
+std::vector<AbsDistMat*> sgd::get_state_matrices() {
+  return {m_velocity.get()};
+}
+
+bool sgd::is_step_fusable(const optimizer& other) const {
+  const auto* other_sgd = dynamic_cast<const sgd*>(&other);
+  return (other_sgd != nullptr
+          && other_sgd->get_type() == get_type()
+          && other_sgd->get_learning_rate() == get_learning_rate()
+          && other_sgd->m_momentum == m_momentum
+          && other_sgd->m_nesterov == m_nesterov);
+}
+
+void sgd::fused_step_compute(size_t size,
+                             DataType* values,
+                             const DataType* gradient,
+                             const std::vector<DataType*>& state) {
+  const auto& learning_rate = this->get_learning_rate();
+  auto* __restrict__ values_buffer = values;
+  const auto* __restrict__ gradient_buffer = gradient;
+  auto* __restrict__ velocity_buffer = state[0];
+  if (m_momentum == DataType(0)) {
+    LBANN_OMP_PARALLEL_FOR
+    for (size_t i = 0; i < size; ++i) {
+      values_buffer[i] -= learning_rate * gradient_buffer[i];
+    }
+  } else if (m_nesterov) {
+    LBANN_OMP_PARALLEL_FOR
+    for (size_t i = 0; i < size; ++i) {
+      auto& x = values_buffer[i];
+      const auto& g = gradient_buffer[i];
+      auto& v = velocity_buffer[i];
+      v = m_momentum * v + g;
+      x -= learning_rate * (m_momentum * v + g);
+    }
+  } else {
+    LBANN_OMP_PARALLEL_FOR
+    for (size_t i = 0; i < size; ++i) {
+      auto& x = values_buffer[i];
+      const auto& g = gradient_buffer[i];
+      auto& v = velocity_buffer[i];
+      v = m_momentum * v + g;
+      x -= learning_rate * v;
+    }
+  }
+}
+
 // =============================================
 // Checkpointing
 // =============================================
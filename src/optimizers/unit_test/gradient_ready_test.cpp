@@ -0,0 +1,49 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/optimizers/optimizer.hpp>
+
+#include "TestHelpers.hpp"
+#include <lbann/optimizers/sgd.hpp>
+#include <lbann/utils/memory.hpp>
+#include <lbann/weights/weights.hpp>
+
+using lbann::DataType;
+
+TEST_CASE("Testing non-blocking gradient polling", "[optimizer]") {
+  auto& comm = unit_test::utilities::current_world_comm();
+
+  lbann::weights w(&comm);
+  w.set_dims(6);
+  w.set_optimizer(lbann::make_unique<lbann::sgd>(&comm, DataType(0.5)));
+  w.setup();
+  auto& opt = *w.get_optimizer();
+  const int source = 0;
+
+  SECTION("A cleared gradient is ready once its sources are done") {
+    opt.add_gradient_source(&source);
+    CHECK_FALSE(opt.is_gradient_ready());
+    opt.remove_gradient_source(&source);
+    CHECK(opt.is_gradient_ready());
+  }
+
+  SECTION("Polling launches and completes the gradient allreduce") {
+    lbann::StarMat<El::Device::CPU> contribution(6, 1);
+    El::Fill(contribution, DataType(1));
+    opt.add_gradient_source(&source);
+    opt.add_to_gradient(contribution, DataType(1), true);
+    CHECK_FALSE(opt.is_gradient_ready());
+    opt.remove_gradient_source(&source);
+
+    // The first poll only launches the allreduce
+    CHECK_FALSE(opt.is_gradient_ready());
+    while (!opt.is_gradient_ready()) {}
+
+    // Every rank contributed ones
+    const auto& local = opt.get_gradient().LockedMatrix();
+    for (El::Int i = 0; i < local.Height(); ++i) {
+      CHECK(local(i, 0) == Approx(comm.get_procs_per_trainer()));
+    }
+  }
+}
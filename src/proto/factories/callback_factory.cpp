@@ -31,6 +31,7 @@
 #include "lbann/callbacks/check_init.hpp"
 #include "lbann/callbacks/check_metric.hpp"
 #include "lbann/callbacks/check_nan.hpp"
+#include "lbann/callbacks/check_numerical_health.hpp"
 #include "lbann/callbacks/check_small.hpp"
 #include "lbann/callbacks/checkpoint.hpp"
 #include "lbann/callbacks/confusion_matrix.hpp"
@@ -45,6 +46,7 @@
 #include "lbann/callbacks/gpu_memory_usage.hpp"
 #include "lbann/callbacks/hang.hpp"
 #include "lbann/callbacks/imcomm.hpp"
+#include "lbann/callbacks/int8_calibration.hpp"
 #include "lbann/callbacks/learning_rate.hpp"
 #include "lbann/callbacks/ltfb.hpp"
 #include "lbann/callbacks/mixup.hpp"
@@ -105,6 +107,8 @@ void register_default_builders(factory_type& factory)
                            build_check_metric_callback_from_pbuf);
   factory.register_builder("CallbackCheckNaN",
                            build_check_nan_callback_from_pbuf);
+  factory.register_builder("CallbackCheckNumericalHealth",
+                           build_check_numerical_health_callback_from_pbuf);
   factory.register_builder("CallbackCheckpoint",
                            build_checkpoint_callback_from_pbuf);
   factory.register_builder("CallbackCheckSmall",
@@ -137,6 +141,8 @@ void register_default_builders(factory_type& factory)
                            build_hang_callback_from_pbuf);
   factory.register_builder("CallbackImComm",
                            build_imcomm_callback_from_pbuf);
+  factory.register_builder("CallbackInt8Calibration",
+                           build_int8_calibration_callback_from_pbuf);
   factory.register_builder(
     "CallbackLinearGrowthLearningRate",
     build_linear_growth_learning_rate_callback_from_pbuf);
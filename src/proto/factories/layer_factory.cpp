@@ -400,20 +400,24 @@ std::unique_ptr<Layer> construct_layer(
       LBANN_ERROR("pooling layer is only supported with "
                   "a data-parallel layout");
     }
+    using pooling_layer_type = pooling_layer<data_layout::DATA_PARALLEL, Device>;
+    std::unique_ptr<pooling_layer_type> layer;
     if (params.has_vectors()) {
       const auto& dims = parse_list<int>(params.pool_dims());
       const auto& pads = parse_list<int>(params.pool_pads());
       const auto& strides = parse_list<int>(params.pool_strides());
-      return lbann::make_unique<pooling_layer<data_layout::DATA_PARALLEL, Device>>(
-               comm, dims.size(), dims, pads, strides, mode);
+      layer = lbann::make_unique<pooling_layer_type>(
+                comm, dims.size(), dims, pads, strides, mode);
     } else {
       const auto& num_dims = params.num_dims();
       const auto& dim = params.pool_dims_i();
       const auto& pad = params.pool_pads_i();
       const auto& stride = params.pool_strides_i();
-      return lbann::make_unique<pooling_layer<data_layout::DATA_PARALLEL, Device>>(
-               comm, num_dims, dim, pad, stride, mode);
+      layer = lbann::make_unique<pooling_layer_type>(
+                comm, num_dims, dim, pad, stride, mode);
     }
+    layer->set_recompute_max_indices(params.recompute_max_indices());
+    return std::move(layer);
   }
   if (proto_layer.has_unpooling()) {
     if (Layout == data_layout::DATA_PARALLEL && Device == El::Device::CPU) {
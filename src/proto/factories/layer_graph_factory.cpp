@@ -266,6 +266,11 @@ std::vector<std::unique_ptr<Layer>> construct_layer_graph(
       #endif
       l->freeze();
     }
+    const auto& precision_str = (proto_layer.storage_precision().empty() ?
+                                 proto_model.activation_storage_precision() :
+                                 proto_layer.storage_precision());
+    l->set_activation_storage_precision(to_storage_precision(precision_str));
+
     // Add layer to list
     layers.emplace_back(std::move(l));
 
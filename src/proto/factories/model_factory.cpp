@@ -290,6 +290,14 @@ std::unique_ptr<model> construct_model(
   if (!name.empty()) {
     m->set_name(name);
   }
+  m->set_use_weights_arena(proto_model.weights_arena());
+  m->set_use_tensor_placement(proto_model.tensor_placement());
+  m->set_fuse_activations(proto_model.fuse_activations());
+  m->set_evaluation_reduction_interval(
+    proto_model.evaluation_reduction_interval());
+  m->set_overlap_gradient_updates(proto_model.overlap_gradient_updates());
+  m->set_layer_task_workers(proto_model.layer_task_workers(),
+                            proto_model.layer_task_threads());
   for (auto t : data_readers) {
     t.second->set_model(m.get());
   }
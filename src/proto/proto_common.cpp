@@ -32,6 +32,7 @@
 #include "lbann/proto/init_image_data_readers.hpp"
 #include "lbann/proto/factories.hpp"
 #include "lbann/utils/file_utils.hpp"
+#include "lbann/utils/timer.hpp"
 
 #include <lbann.pb.h>
 #include <reader.pb.h>
@@ -404,7 +405,12 @@ void init_data_readers(
 
     reader->set_master(master);
 
+    const auto load_start = get_time();
     reader->load();
+    if (master) {
+      std::cout << "Data reader " << name << " (" << reader->get_role() << ") "
+                << "loaded in " << get_time() - load_start << " s" << std::endl;
+    }
 
     if (readme.role() == "train") {
       data_readers[execution_mode::training] = reader;
@@ -847,6 +853,8 @@ void print_help(std::ostream& os)
        "  --saveme=0\n"
        "\n"
        "  To reload from a previous checkpoint you specify --ckpt_dir=<string>\n"
+       "  To fold batch normalization into the preceding layers in lbann_inf,\n"
+       "  specify --fold_batch_norm\n"
        "\n"
        "Some prototext values can be over-riden on the command line;\n"
        "(notes: use '1' or '0' for bool; if no value is given for a flag,\n"
@@ -882,6 +890,16 @@ void print_help(std::ostream& os)
        "      Preloads the data store in-memory structure during data reader load time\n"
        "  --super_node \n"
        "      Enables the data store in-memory structure to use the supernode exchange structure\n"
+       "  --data_store_locality=<int> \n"
+       "      Reorders each epoch so that ranks mostly read samples they own, moving\n"
+       "      samples only within windows of the given number of mini-batches;\n"
+       "      best combined with --super_node, which coalesces the remaining traffic\n"
+       "  --data_store_exchange_stats \n"
+       "      Reports the data store exchange volume per step at the end of each epoch\n"
+       "  --data_store_node_shared \n"
+       "      Keeps the samples owned by the ranks of a compute node, from all trainers,\n"
+       "      once in node-wide shared memory and reads them from there instead of\n"
+       "      exchanging them; all trainers on a node must read the same data set\n"
        "  --write_sample_list \n"
        "      Writes out the sample list that was loaded into the current directory\n"
        "  --ltfb_verbose \n"
@@ -896,6 +914,12 @@ void print_help(std::ostream& os)
        "  --label_filename_train=<string> --label_filename_test=<string>\n"
        "  --data_reader_percent=<float>\n"
        "  --share_testing_data_readers=<bool:[0|1]>\n"
+       "  --metadata_cache\n"
+       "      Caches the metadata parsed at load time (sample lists, line offsets,\n"
+       "      data dims) in a file next to the data, so later runs with unchanged\n"
+       "      inputs skip the parsing\n"
+       "  --metadata_cache_dir=<string>\n"
+       "      Same as --metadata_cache, but keeps the cache files in this directory\n"
        "\n"
        "Callbacks:\n"
        "  --image_dir=<string>\n"
@@ -61,6 +61,21 @@ void transform_pipeline::apply(CPUMat& data, std::vector<size_t>& dims) {
   data = std::move(m.template get<DataType>());
 }
 
+bool transform_pipeline::get_affine_coefficients(DataType& scale,
+                                                 DataType& bias) const {
+  scale = DataType(1);
+  bias = DataType(0);
+  for (const auto& trans : m_transforms) {
+    DataType trans_scale, trans_bias;
+    if (!trans->get_affine_coefficients(trans_scale, trans_bias)) {
+      return false;
+    }
+    scale *= trans_scale;
+    bias = bias * trans_scale + trans_bias;
+  }
+  return true;
+}
+
 void transform_pipeline::apply(El::Matrix<uint8_t>& data, CPUMat& out_data,
                                std::vector<size_t>& dims) {
   utils::type_erased_matrix m = utils::type_erased_matrix(std::move(data));
@@ -0,0 +1,399 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/utils/direct_pooling.hpp"
+#include "lbann/utils/exception.hpp"
+
+#include <algorithm>
+#include <omp.h>
+
+namespace lbann {
+
+namespace {
+
+/// Division rounding towards negative infinity
+inline int floor_div(int a, int b) {
+  return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+/// Update running maxima with the entries in[ox*stride] for ox in
+/// [begin, end), or with zero if in is null
+template <bool track_indices, typename IndexType>
+inline void update_max(DataType *__restrict__ out,
+                       IndexType *__restrict__ indices,
+                       const DataType *__restrict__ in,
+                       int stride,
+                       int begin,
+                       int end,
+                       int k) {
+  if (in == nullptr) {
+    for (int ox = begin; ox < end; ++ox) {
+      const bool greater = DataType(0) > out[ox];
+      out[ox] = greater ? DataType(0) : out[ox];
+      if (track_indices) { indices[ox] = greater ? IndexType(k) : indices[ox]; }
+    }
+  } else if (stride == 1) {
+    for (int ox = begin; ox < end; ++ox) {
+      const DataType val = in[ox];
+      const bool greater = val > out[ox];
+      out[ox] = greater ? val : out[ox];
+      if (track_indices) { indices[ox] = greater ? IndexType(k) : indices[ox]; }
+    }
+  } else {
+    for (int ox = begin; ox < end; ++ox) {
+      const DataType val = in[ox * stride];
+      const bool greater = val > out[ox];
+      out[ox] = greater ? val : out[ox];
+      if (track_indices) { indices[ox] = greater ? IndexType(k) : indices[ox]; }
+    }
+  }
+}
+
+} // namespace
+
+pooling_geometry::pooling_geometry(int num_channels,
+                                   const std::vector<int>& input_dims,
+                                   const std::vector<int>& window_dims,
+                                   const std::vector<int>& pads,
+                                   const std::vector<int>& strides)
+  : m_num_channels(num_channels) {
+  const int num_dims = input_dims.size();
+  if (!is_supported(num_dims)
+      || window_dims.size() != input_dims.size()
+      || pads.size() != input_dims.size()
+      || strides.size() != input_dims.size()) {
+    LBANN_ERROR("direct pooling expects 1D, 2D or 3D tensors with "
+                "matching window, pad and stride dimensions");
+  }
+  const int offset = 3 - num_dims;
+  for (int d = 0; d < 3; ++d) {
+    const bool unit = d < offset;
+    m_input_dims[d] = unit ? 1 : input_dims[d-offset];
+    m_window_dims[d] = unit ? 1 : window_dims[d-offset];
+    m_pads[d] = unit ? 0 : pads[d-offset];
+    m_strides[d] = unit ? 1 : strides[d-offset];
+    const int effective_dim = (m_input_dims[d] + 2 * m_pads[d]
+                               - m_window_dims[d] + 1);
+    m_output_dims[d] = (effective_dim + m_strides[d] - 1) / m_strides[d];
+  }
+}
+
+void pooling_geometry::get_valid_range(int dim, int k, int& begin, int& end) const {
+  // Output o reads input o*stride - pad + k
+  const int shift = m_pads[dim] - k;
+  begin = std::max(-floor_div(-shift, m_strides[dim]), 0);
+  end = std::min(floor_div(m_input_dims[dim] - 1 + shift, m_strides[dim]) + 1,
+                 m_output_dims[dim]);
+  end = std::max(begin, end);
+}
+
+std::vector<DataType> pooling_geometry::get_average_scales(int dim, bool include_pads) const {
+  std::vector<DataType> counts(m_output_dims[dim], DataType(0));
+  for (int k = 0; k < m_window_dims[dim]; ++k) {
+    int begin, end;
+    get_valid_range(dim, k, begin, end);
+    for (int o = 0; o < m_output_dims[dim]; ++o) {
+      if (include_pads || (begin <= o && o < end)) { counts[o] += DataType(1); }
+    }
+  }
+  for (auto& c : counts) { c = (c > DataType(0)) ? DataType(1) / c : DataType(0); }
+  return counts;
+}
+
+template <typename IndexType>
+void pooling_geometry::find_max(const DataType* input,
+                                DataType* output,
+                                IndexType* indices) const {
+  const int output_dim_x = m_output_dims[2];
+  std::vector<int> x_begin(m_window_dims[2]), x_end(m_window_dims[2]);
+  for (int kx = 0; kx < m_window_dims[2]; ++kx) {
+    get_valid_range(2, kx, x_begin[kx], x_end[kx]);
+  }
+  for (int oz = 0; oz < m_output_dims[0]; ++oz) {
+    for (int oy = 0; oy < m_output_dims[1]; ++oy) {
+      const int output_offset = (oz * m_output_dims[1] + oy) * output_dim_x;
+      DataType* out = output + output_offset;
+      IndexType* idx = (indices != nullptr) ? indices + output_offset : nullptr;
+      int k = 0;
+      for (int kz = 0; kz < m_window_dims[0]; ++kz) {
+        const int iz = oz * m_strides[0] - m_pads[0] + kz;
+        for (int ky = 0; ky < m_window_dims[1]; ++ky) {
+          const int iy = oy * m_strides[1] - m_pads[1] + ky;
+          const bool row_valid = (0 <= iz && iz < m_input_dims[0]
+                                  && 0 <= iy && iy < m_input_dims[1]);
+          const DataType* in_row = (row_valid ?
+                                    input + (iz * m_input_dims[1] + iy) * m_input_dims[2] :
+                                    nullptr);
+          for (int kx = 0; kx < m_window_dims[2]; ++kx, ++k) {
+            const int begin = row_valid ? x_begin[kx] : output_dim_x;
+            const int end = row_valid ? x_end[kx] : output_dim_x;
+            const DataType* in = (row_valid ?
+                                  in_row + begin * m_strides[2] - m_pads[2] + kx :
+                                  nullptr);
+            if (k == 0) {
+              // First window entry initializes the maxima
+              std::fill(out, out + output_dim_x, DataType(0));
+              for (int ox = begin; ox < end; ++ox) {
+                out[ox] = in[(ox - begin) * m_strides[2]];
+              }
+              if (idx != nullptr) { std::fill(idx, idx + output_dim_x, IndexType(0)); }
+              continue;
+            }
+            if (idx != nullptr) {
+              update_max<true>(out, idx, nullptr, 1, 0, begin, k);
+              update_max<true>(out + begin, idx + begin, in, m_strides[2], 0, end - begin, k);
+              update_max<true>(out, idx, nullptr, 1, end, output_dim_x, k);
+            } else {
+              update_max<false>(out, idx, nullptr, 1, 0, begin, k);
+              update_max<false>(out + begin, idx, in, m_strides[2], 0, end - begin, k);
+              update_max<false>(out, idx, nullptr, 1, end, output_dim_x, k);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+void pooling_geometry::max_pool_forward(int num_samples,
+                                        const DataType* input, int input_ldim,
+                                        DataType* output, int output_ldim,
+                                        unsigned char* indices) const {
+  if (indices != nullptr && get_window_size() > 256) {
+    LBANN_ERROR("max pooling indices need a window of at most 256 entries");
+  }
+  const int input_channel_size = get_input_channel_size();
+  const int output_channel_size = get_output_channel_size();
+  const int output_size = m_num_channels * output_channel_size;
+  LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+  for (int sample = 0; sample < num_samples; ++sample) {
+    for (int channel = 0; channel < m_num_channels; ++channel) {
+      const int output_offset = channel * output_channel_size;
+      find_max(input + sample * input_ldim + channel * input_channel_size,
+               output + sample * output_ldim + output_offset,
+               (indices != nullptr ?
+                indices + sample * output_size + output_offset :
+                nullptr));
+    }
+  }
+}
+
+void pooling_geometry::max_pool_backward(int num_samples,
+                                         const DataType* input, int input_ldim,
+                                         const unsigned char* indices,
+                                         const DataType* gradient_wrt_output,
+                                         int gradient_wrt_output_ldim,
+                                         DataType* gradient_wrt_input,
+                                         int gradient_wrt_input_ldim) const {
+  const int input_channel_size = get_input_channel_size();
+  const int output_channel_size = get_output_channel_size();
+  const int output_size = m_num_channels * output_channel_size;
+  const int window_yx = m_window_dims[1] * m_window_dims[2];
+
+  // Per-thread workspaces for maxima that were not stored
+  std::vector<std::vector<DataType>> maxima;
+  std::vector<std::vector<int>> recomputed_indices;
+  if (indices == nullptr) {
+    maxima.assign(omp_get_max_threads(),
+                  std::vector<DataType>(output_channel_size));
+    recomputed_indices.assign(omp_get_max_threads(),
+                              std::vector<int>(output_channel_size));
+  }
+
+  LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+  for (int sample = 0; sample < num_samples; ++sample) {
+    for (int channel = 0; channel < m_num_channels; ++channel) {
+      const int output_offset = channel * output_channel_size;
+      const DataType* dy = (gradient_wrt_output
+                            + sample * gradient_wrt_output_ldim
+                            + output_offset);
+      DataType* dx = (gradient_wrt_input
+                      + sample * gradient_wrt_input_ldim
+                      + channel * input_channel_size);
+
+      // Find maxima again if they were not stored
+      const unsigned char* stored_indices = nullptr;
+      int* thread_indices = nullptr;
+      if (indices != nullptr) {
+        stored_indices = indices + sample * output_size + output_offset;
+      } else {
+        const int thread = omp_get_thread_num();
+        thread_indices = recomputed_indices[thread].data();
+        find_max(input + sample * input_ldim + channel * input_channel_size,
+                 maxima[thread].data(),
+                 thread_indices);
+      }
+
+      // Route each output gradient to its maximum
+      std::fill(dx, dx + input_channel_size, DataType(0));
+      int j = 0;
+      for (int oz = 0; oz < m_output_dims[0]; ++oz) {
+        for (int oy = 0; oy < m_output_dims[1]; ++oy) {
+          for (int ox = 0; ox < m_output_dims[2]; ++ox, ++j) {
+            const int k = (stored_indices != nullptr ?
+                           stored_indices[j] :
+                           thread_indices[j]);
+            const int iz = oz * m_strides[0] - m_pads[0] + k / window_yx;
+            const int iy = oy * m_strides[1] - m_pads[1] + (k / m_window_dims[2]) % m_window_dims[1];
+            const int ix = ox * m_strides[2] - m_pads[2] + k % m_window_dims[2];
+            if (0 <= iz && iz < m_input_dims[0]
+                && 0 <= iy && iy < m_input_dims[1]
+                && 0 <= ix && ix < m_input_dims[2]) {
+              dx[(iz * m_input_dims[1] + iy) * m_input_dims[2] + ix] += dy[j];
+            }
+          }
+        }
+      }
+
+    }
+  }
+}
+
+void pooling_geometry::average_pool_forward(int num_samples,
+                                            const DataType* input, int input_ldim,
+                                            DataType* output, int output_ldim,
+                                            bool include_pads) const {
+  const int input_channel_size = get_input_channel_size();
+  const int output_channel_size = get_output_channel_size();
+  const int output_dim_x = m_output_dims[2];
+  const auto& scales_z = get_average_scales(0, include_pads);
+  const auto& scales_y = get_average_scales(1, include_pads);
+  const auto& scales_x = get_average_scales(2, include_pads);
+  std::vector<int> x_begin(m_window_dims[2]), x_end(m_window_dims[2]);
+  for (int kx = 0; kx < m_window_dims[2]; ++kx) {
+    get_valid_range(2, kx, x_begin[kx], x_end[kx]);
+  }
+  LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+  for (int sample = 0; sample < num_samples; ++sample) {
+    for (int channel = 0; channel < m_num_channels; ++channel) {
+      const DataType* x = input + sample * input_ldim + channel * input_channel_size;
+      DataType* y = output + sample * output_ldim + channel * output_channel_size;
+      for (int oz = 0; oz < m_output_dims[0]; ++oz) {
+        for (int oy = 0; oy < m_output_dims[1]; ++oy) {
+          DataType *__restrict__ out = y + (oz * m_output_dims[1] + oy) * output_dim_x;
+          std::fill(out, out + output_dim_x, DataType(0));
+
+          // Sum window entries inside the input
+          for (int kz = 0; kz < m_window_dims[0]; ++kz) {
+            const int iz = oz * m_strides[0] - m_pads[0] + kz;
+            if (iz < 0 || iz >= m_input_dims[0]) { continue; }
+            for (int ky = 0; ky < m_window_dims[1]; ++ky) {
+              const int iy = oy * m_strides[1] - m_pads[1] + ky;
+              if (iy < 0 || iy >= m_input_dims[1]) { continue; }
+              const DataType* in_row = x + (iz * m_input_dims[1] + iy) * m_input_dims[2];
+              for (int kx = 0; kx < m_window_dims[2]; ++kx) {
+                const int begin = x_begin[kx], end = x_end[kx];
+                const DataType *__restrict__ in = in_row + begin * m_strides[2] - m_pads[2] + kx;
+                if (m_strides[2] == 1) {
+                  for (int ox = begin; ox < end; ++ox) { out[ox] += in[ox - begin]; }
+                } else {
+                  for (int ox = begin; ox < end; ++ox) {
+                    out[ox] += in[(ox - begin) * m_strides[2]];
+                  }
+                }
+              }
+            }
+          }
+
+          // Scale by window size
+          const DataType scale_zy = scales_z[oz] * scales_y[oy];
+          for (int ox = 0; ox < output_dim_x; ++ox) {
+            out[ox] *= scale_zy * scales_x[ox];
+          }
+
+        }
+      }
+    }
+  }
+}
+
+void pooling_geometry::average_pool_backward(int num_samples,
+                                             const DataType* gradient_wrt_output,
+                                             int gradient_wrt_output_ldim,
+                                             DataType* gradient_wrt_input,
+                                             int gradient_wrt_input_ldim,
+                                             bool include_pads) const {
+  const int input_channel_size = get_input_channel_size();
+  const int output_channel_size = get_output_channel_size();
+  const int output_dim_x = m_output_dims[2];
+  const auto& scales_z = get_average_scales(0, include_pads);
+  const auto& scales_y = get_average_scales(1, include_pads);
+  const auto& scales_x = get_average_scales(2, include_pads);
+  std::vector<int> x_begin(m_window_dims[2]), x_end(m_window_dims[2]);
+  for (int kx = 0; kx < m_window_dims[2]; ++kx) {
+    get_valid_range(2, kx, x_begin[kx], x_end[kx]);
+  }
+  LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+  for (int sample = 0; sample < num_samples; ++sample) {
+    for (int channel = 0; channel < m_num_channels; ++channel) {
+      const DataType* dy = (gradient_wrt_output
+                            + sample * gradient_wrt_output_ldim
+                            + channel * output_channel_size);
+      DataType* dx = (gradient_wrt_input
+                      + sample * gradient_wrt_input_ldim
+                      + channel * input_channel_size);
+      std::fill(dx, dx + input_channel_size, DataType(0));
+      std::vector<DataType> scaled_row(output_dim_x);
+      for (int oz = 0; oz < m_output_dims[0]; ++oz) {
+        for (int oy = 0; oy < m_output_dims[1]; ++oy) {
+
+          // Scale output gradients by window size
+          const DataType* dy_row = dy + (oz * m_output_dims[1] + oy) * output_dim_x;
+          const DataType scale_zy = scales_z[oz] * scales_y[oy];
+          for (int ox = 0; ox < output_dim_x; ++ox) {
+            scaled_row[ox] = dy_row[ox] * scale_zy * scales_x[ox];
+          }
+          const DataType *__restrict__ grad = scaled_row.data();
+
+          // Spread gradients over window entries inside the input
+          for (int kz = 0; kz < m_window_dims[0]; ++kz) {
+            const int iz = oz * m_strides[0] - m_pads[0] + kz;
+            if (iz < 0 || iz >= m_input_dims[0]) { continue; }
+            for (int ky = 0; ky < m_window_dims[1]; ++ky) {
+              const int iy = oy * m_strides[1] - m_pads[1] + ky;
+              if (iy < 0 || iy >= m_input_dims[1]) { continue; }
+              DataType* dx_row = dx + (iz * m_input_dims[1] + iy) * m_input_dims[2];
+              for (int kx = 0; kx < m_window_dims[2]; ++kx) {
+                const int begin = x_begin[kx], end = x_end[kx];
+                DataType *__restrict__ in = dx_row + begin * m_strides[2] - m_pads[2] + kx;
+                if (m_strides[2] == 1) {
+                  for (int ox = begin; ox < end; ++ox) { in[ox - begin] += grad[ox]; }
+                } else {
+                  for (int ox = begin; ox < end; ++ox) {
+                    in[(ox - begin) * m_strides[2]] += grad[ox];
+                  }
+                }
+              }
+            }
+          }
+
+        }
+      }
+    }
+  }
+}
+
+} // namespace lbann
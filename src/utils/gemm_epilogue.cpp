@@ -0,0 +1,228 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/utils/gemm_epilogue.hpp"
+#include "lbann/utils/exception.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace lbann {
+
+namespace {
+
+/// Bytes of GEMM output per panel, sized for a per-core L2 cache
+constexpr El::Int panel_bytes = 256 * 1024;
+/// Narrower panels make the GEMM bandwidth bound
+constexpr El::Int min_panel_width = 32;
+
+struct identity_epilogue {
+  DataType alpha;
+  inline DataType forward(const DataType& z) const { return z; }
+  inline DataType backward(const DataType& y, const DataType& dy) const { return dy; }
+};
+struct relu_epilogue {
+  DataType alpha;
+  inline DataType forward(const DataType& z) const {
+    return z > DataType(0) ? z : DataType(0);
+  }
+  inline DataType backward(const DataType& y, const DataType& dy) const {
+    return y > DataType(0) ? dy : DataType(0);
+  }
+};
+struct leaky_relu_epilogue {
+  DataType alpha;
+  inline DataType forward(const DataType& z) const {
+    return z > DataType(0) ? z : alpha * z;
+  }
+  inline DataType backward(const DataType& y, const DataType& dy) const {
+    return y > DataType(0) ? dy : alpha * dy;
+  }
+};
+/// The ELU derivative alpha*exp(z) for z <= 0 equals y + alpha
+struct elu_epilogue {
+  DataType alpha;
+  inline DataType forward(const DataType& z) const {
+    return z > DataType(0) ? z : alpha * std::expm1(z);
+  }
+  inline DataType backward(const DataType& y, const DataType& dy) const {
+    return y > DataType(0) ? dy : dy * (y + alpha);
+  }
+};
+
+template <typename Op>
+void forward_kernel(const Op& op,
+                    El::Int height, El::Int width,
+                    DataType* __restrict__ output, El::Int output_ldim,
+                    const DataType* __restrict__ bias, DataType bias_scale,
+                    El::Int rows_per_bias) {
+  if (bias == nullptr) {
+    LBANN_OMP_PARALLEL_FOR
+    for (El::Int col = 0; col < width; ++col) {
+      auto* __restrict__ y = &output[col * output_ldim];
+      for (El::Int row = 0; row < height; ++row) {
+        y[row] = op.forward(y[row]);
+      }
+    }
+  } else if (rows_per_bias == 1) {
+    LBANN_OMP_PARALLEL_FOR
+    for (El::Int col = 0; col < width; ++col) {
+      auto* __restrict__ y = &output[col * output_ldim];
+      for (El::Int row = 0; row < height; ++row) {
+        y[row] = op.forward(y[row] + bias_scale * bias[row]);
+      }
+    }
+  } else {
+    const El::Int num_channels = height / rows_per_bias;
+    LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+    for (El::Int col = 0; col < width; ++col) {
+      for (El::Int channel = 0; channel < num_channels; ++channel) {
+        const DataType b = bias_scale * bias[channel];
+        auto* __restrict__ y = &output[col * output_ldim + channel * rows_per_bias];
+        for (El::Int row = 0; row < rows_per_bias; ++row) {
+          y[row] = op.forward(y[row] + b);
+        }
+      }
+    }
+  }
+}
+
+template <typename Op>
+void backward_kernel(const Op& op,
+                     El::Int height, El::Int width,
+                     const DataType* output, El::Int output_ldim,
+                     const DataType* gradient_wrt_output, El::Int gradient_wrt_output_ldim,
+                     DataType* gradient_wrt_input, El::Int gradient_wrt_input_ldim) {
+  LBANN_OMP_PARALLEL_FOR
+  for (El::Int col = 0; col < width; ++col) {
+    const auto* y = &output[col * output_ldim];
+    const auto* dy = &gradient_wrt_output[col * gradient_wrt_output_ldim];
+    auto* dx = &gradient_wrt_input[col * gradient_wrt_input_ldim];
+    for (El::Int row = 0; row < height; ++row) {
+      dx[row] = op.backward(y[row], dy[row]);
+    }
+  }
+}
+
+} // namespace
+
+gemm_epilogue::gemm_epilogue(epilogue_activation activation, DataType alpha)
+  : m_activation(activation), m_alpha(alpha) {
+  if (!is_supported(activation, alpha)) {
+    std::stringstream err;
+    err << "GEMM epilogue can not apply " << get_activation_name()
+        << " with parameter " << alpha;
+    LBANN_ERROR(err.str());
+  }
+}
+
+bool gemm_epilogue::is_supported(epilogue_activation activation, DataType alpha) {
+  switch (activation) {
+  case epilogue_activation::leaky_relu: return alpha >= DataType(0);
+  case epilogue_activation::elu:        return alpha > DataType(0);
+  default:                              return true;
+  }
+}
+
+std::string gemm_epilogue::get_activation_name() const {
+  std::stringstream ss;
+  switch (m_activation) {
+  case epilogue_activation::none:       ss << "no activation"; break;
+  case epilogue_activation::relu:       ss << "ReLU"; break;
+  case epilogue_activation::leaky_relu: ss << "leaky ReLU (slope " << m_alpha << ")"; break;
+  case epilogue_activation::elu:        ss << "ELU (alpha " << m_alpha << ")"; break;
+  }
+  return ss.str();
+}
+
+El::Int gemm_epilogue::get_panel_width(El::Int height) {
+  const El::Int column_bytes = sizeof(DataType) * std::max(height, El::Int(1));
+  return std::max(min_panel_width, panel_bytes / column_bytes);
+}
+
+void gemm_epilogue::apply_forward(El::Int height, El::Int width,
+                                  DataType* output, El::Int output_ldim,
+                                  const DataType* bias, DataType bias_scale,
+                                  El::Int rows_per_bias) const {
+  if (height <= 0 || width <= 0) { return; }
+  if (bias != nullptr && (rows_per_bias <= 0 || height % rows_per_bias != 0)) {
+    std::stringstream err;
+    err << "GEMM epilogue got " << height << " rows, "
+        << "which is not a multiple of " << rows_per_bias << " rows per bias entry";
+    LBANN_ERROR(err.str());
+  }
+  switch (m_activation) {
+  case epilogue_activation::none:
+    if (bias == nullptr) { return; }
+    forward_kernel(identity_epilogue{m_alpha}, height, width, output, output_ldim,
+                   bias, bias_scale, rows_per_bias);
+    break;
+  case epilogue_activation::relu:
+    forward_kernel(relu_epilogue{m_alpha}, height, width, output, output_ldim,
+                   bias, bias_scale, rows_per_bias);
+    break;
+  case epilogue_activation::leaky_relu:
+    forward_kernel(leaky_relu_epilogue{m_alpha}, height, width, output, output_ldim,
+                   bias, bias_scale, rows_per_bias);
+    break;
+  case epilogue_activation::elu:
+    forward_kernel(elu_epilogue{m_alpha}, height, width, output, output_ldim,
+                   bias, bias_scale, rows_per_bias);
+    break;
+  }
+}
+
+void gemm_epilogue::apply_backward(El::Int height, El::Int width,
+                                   const DataType* output, El::Int output_ldim,
+                                   const DataType* gradient_wrt_output, El::Int gradient_wrt_output_ldim,
+                                   DataType* gradient_wrt_input, El::Int gradient_wrt_input_ldim) const {
+  if (height <= 0 || width <= 0) { return; }
+  switch (m_activation) {
+  case epilogue_activation::none:
+    backward_kernel(identity_epilogue{m_alpha}, height, width, output, output_ldim,
+                    gradient_wrt_output, gradient_wrt_output_ldim,
+                    gradient_wrt_input, gradient_wrt_input_ldim);
+    break;
+  case epilogue_activation::relu:
+    backward_kernel(relu_epilogue{m_alpha}, height, width, output, output_ldim,
+                    gradient_wrt_output, gradient_wrt_output_ldim,
+                    gradient_wrt_input, gradient_wrt_input_ldim);
+    break;
+  case epilogue_activation::leaky_relu:
+    backward_kernel(leaky_relu_epilogue{m_alpha}, height, width, output, output_ldim,
+                    gradient_wrt_output, gradient_wrt_output_ldim,
+                    gradient_wrt_input, gradient_wrt_input_ldim);
+    break;
+  case epilogue_activation::elu:
+    backward_kernel(elu_epilogue{m_alpha}, height, width, output, output_ldim,
+                    gradient_wrt_output, gradient_wrt_output_ldim,
+                    gradient_wrt_input, gradient_wrt_input_ldim);
+    break;
+  }
+}
+
+} // namespace lbann
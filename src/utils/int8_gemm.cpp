@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/utils/int8_gemm.hpp"
+#include "lbann/utils/exception.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace lbann {
+
+namespace {
+
+constexpr DataType max_quantized_value = DataType(127);
+/// Input columns sharing each pass over the weights
+constexpr El::Int block_width = 4;
+
+inline std::int8_t quantize(const DataType& x, const DataType& inv_scale) {
+  const DataType q = std::nearbyint(x * inv_scale);
+  return static_cast<std::int8_t>(std::min(std::max(q, -max_quantized_value),
+                                           max_quantized_value));
+}
+
+inline std::int32_t dot(El::Int size,
+                        const std::int8_t* __restrict__ x,
+                        const std::int8_t* __restrict__ y) {
+  std::int32_t sum = 0;
+  for (El::Int l = 0; l < size; ++l) {
+    sum += std::int32_t(x[l]) * std::int32_t(y[l]);
+  }
+  return sum;
+}
+
+} // namespace
+
+DataType int8_gemm::get_scale(DataType range) {
+  return range > DataType(0) ? range / max_quantized_value : DataType(1);
+}
+
+void int8_gemm::setup(El::Int height, El::Int width,
+                      const DataType* weights, El::Int weights_ldim,
+                      bool transpose_weights,
+                      const std::vector<DataType>& input_scales) {
+  const El::Int num_channels = input_scales.size();
+  if (num_channels == 0 || width % num_channels != 0) {
+    std::stringstream err;
+    err << "can not split " << width << " inputs "
+        << "into " << num_channels << " channels";
+    LBANN_ERROR(err.str());
+  }
+  const El::Int channel_size = width / num_channels;
+  m_height = height;
+  m_width = width;
+  m_input_inv_scales.resize(width);
+  for (El::Int l = 0; l < width; ++l) {
+    m_input_inv_scales[l] = DataType(1) / input_scales[l / channel_size];
+  }
+
+  // Quantize each row of the scaled weights with its own scale
+  m_weights.resize(height * width);
+  m_output_scales.resize(height);
+  m_weights_ranges.resize(height);
+  LBANN_OMP_PARALLEL_FOR
+  for (El::Int i = 0; i < height; ++i) {
+    const auto& get_weight = [&](El::Int l) {
+      const auto& w = (transpose_weights ?
+                       weights[l + i * weights_ldim] :
+                       weights[i + l * weights_ldim]);
+      return w * input_scales[l / channel_size];
+    };
+    DataType range = DataType(0);
+    for (El::Int l = 0; l < width; ++l) {
+      range = std::max(range, std::fabs(get_weight(l)));
+    }
+    const DataType scale = get_scale(range);
+    const DataType inv_scale = DataType(1) / scale;
+    for (El::Int l = 0; l < width; ++l) {
+      m_weights[i * width + l] = quantize(get_weight(l), inv_scale);
+    }
+    m_output_scales[i] = scale;
+    m_weights_ranges[i] = range;
+  }
+
+}
+
+void int8_gemm::clear() {
+  m_height = 0;
+  m_width = 0;
+  m_weights.clear();
+  m_weights.shrink_to_fit();
+  m_output_scales.clear();
+  m_input_inv_scales.clear();
+  m_weights_ranges.clear();
+}
+
+void int8_gemm::quantize_input(El::Int n,
+                               const DataType* input, El::Int input_ldim,
+                               bool transpose_input,
+                               std::int8_t* quantized_input) const {
+  const El::Int width = m_width;
+  if (transpose_input) {
+    LBANN_OMP_PARALLEL_FOR
+    for (El::Int j = 0; j < n; ++j) {
+      for (El::Int l = 0; l < width; ++l) {
+        quantized_input[l + j * width] = quantize(input[j + l * input_ldim],
+                                                  m_input_inv_scales[l]);
+      }
+    }
+  } else {
+    LBANN_OMP_PARALLEL_FOR
+    for (El::Int j = 0; j < n; ++j) {
+      for (El::Int l = 0; l < width; ++l) {
+        quantized_input[l + j * width] = quantize(input[l + j * input_ldim],
+                                                  m_input_inv_scales[l]);
+      }
+    }
+  }
+}
+
+void int8_gemm::apply(El::Int n, const std::int8_t* quantized_input,
+                      DataType* output, El::Int output_ldim,
+                      bool transpose_output) const {
+  const El::Int height = m_height;
+  const El::Int width = m_width;
+  const El::Int num_blocks = (n + block_width - 1) / block_width;
+  const El::Int row_stride = transpose_output ? output_ldim : 1;
+  const El::Int col_stride = transpose_output ? 1 : output_ldim;
+
+  // Each block of input columns stays in cache while the weights rows
+  // stream past it
+  LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+  for (El::Int block = 0; block < num_blocks; ++block) {
+    for (El::Int i = 0; i < height; ++i) {
+      const auto* __restrict__ w = &m_weights[i * width];
+      const auto& scale = m_output_scales[i];
+      const El::Int first = block * block_width;
+      const El::Int last = std::min(first + block_width, n);
+      const auto* __restrict__ x0 = &quantized_input[first * width];
+      auto* y = &output[i * row_stride + first * col_stride];
+      if (last - first == block_width) {
+        const auto* __restrict__ x1 = x0 + width;
+        const auto* __restrict__ x2 = x1 + width;
+        const auto* __restrict__ x3 = x2 + width;
+        std::int32_t sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+        for (El::Int l = 0; l < width; ++l) {
+          const std::int32_t wl = w[l];
+          sum0 += wl * std::int32_t(x0[l]);
+          sum1 += wl * std::int32_t(x1[l]);
+          sum2 += wl * std::int32_t(x2[l]);
+          sum3 += wl * std::int32_t(x3[l]);
+        }
+        y[0] = scale * DataType(sum0);
+        y[col_stride] = scale * DataType(sum1);
+        y[2 * col_stride] = scale * DataType(sum2);
+        y[3 * col_stride] = scale * DataType(sum3);
+      } else {
+        for (El::Int j = 0; j < last - first; ++j) {
+          y[j * col_stride] = scale * DataType(dot(width, w, x0 + j * width));
+        }
+      }
+    }
+  }
+
+}
+
+} // namespace lbann
@@ -29,10 +29,14 @@
 #include "lbann/proto/factories.hpp"
 #include "lbann/utils/omp_diagnostics.hpp"
 #include "lbann/utils/threads/thread_utils.hpp"
+#include "lbann/utils/timer.hpp"
 
 #include <lbann.pb.h>
 #include <model.pb.h>
 
+#include <iomanip>
+#include <utility>
+
 namespace lbann {
 
 /// Setup I/O thread pool that is shared across all models
@@ -76,6 +80,16 @@ std::unique_ptr<model> build_model_from_prototext(
   std::ostringstream err;
   options *opts = options::get();
 
+  // Startup phase timers
+  // Note: Each phase ends when the next one is recorded.
+  std::vector<std::pair<std::string, EvalType>> startup_times;
+  auto phase_start = get_time();
+  auto end_phase = [&startup_times, &phase_start](const std::string& name) {
+    const auto now = get_time();
+    startup_times.emplace_back(name, now - phase_start);
+    phase_start = now;
+  };
+
   // Optionally over-ride some values in prototext
   get_cmdline_overrides(*comm, pb);
 
@@ -158,6 +172,8 @@ std::unique_ptr<model> build_model_from_prototext(
     display_omp_setup();
   }
 
+  end_phase("configuration");
+
   // Update the index lists to accomodate multi-trainer / multi-model specification
   customize_data_readers_index_list(*comm, pb);
 
@@ -181,13 +197,17 @@ std::unique_ptr<model> build_model_from_prototext(
     }
   }
 
+  end_phase("data readers");
+
   // User feedback
   print_parameters(*comm, pb);
 
   // Initalize model
   auto ret_model =
     proto::construct_model(comm, data_readers, pb.optimizer(), pb.model());
+  end_phase("model construction");
   ret_model->setup(std::move(io_thread_pool));
+  end_phase("model setup");
 
   if(opts->get_bool("disable_background_io_activity")) {
     ret_model->allow_background_io_activity(false);
@@ -202,6 +222,26 @@ std::unique_ptr<model> build_model_from_prototext(
       r.second->setup_data_store(pb_model->mini_batch_size());
     }
   }
+  end_phase("data store setup");
+
+  // Report startup time breakdown
+  // Note: Times are maximum over all ranks.
+  std::vector<EvalType> max_times;
+  for (const auto& t : startup_times) { max_times.push_back(t.second); }
+  comm->allreduce(max_times.data(), max_times.size(),
+                  comm->get_world_comm(), El::mpi::MAX);
+  if (master) {
+    EvalType total_time = 0;
+    std::cout << "Startup time breakdown (max over ranks):" << std::endl;
+    for (size_t i = 0; i < startup_times.size(); ++i) {
+      std::cout << "  " << std::left << std::setw(20)
+                << startup_times[i].first
+                << max_times[i] << " s" << std::endl;
+      total_time += max_times[i];
+    }
+    std::cout << "  " << std::left << std::setw(20) << "total"
+              << total_time << " s" << std::endl;
+  }
 
   // restart model from checkpoint if we have one
   //@todo
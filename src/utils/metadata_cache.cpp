@@ -0,0 +1,243 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/utils/metadata_cache.hpp"
+#include "lbann/utils/file_utils.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lbann {
+
+namespace {
+
+/** Cache file layout: magic, version, key text, identity of each
+ *  file (path, size, modification time), payload and payload
+ *  checksum. Integers are 64-bit in host byte order. */
+constexpr char cache_magic[8] = {'L','B','A','N','N','M','D','C'};
+constexpr uint64_t cache_version = 2;
+
+/** Identity of a file on disk. */
+struct file_identity {
+  std::string path;
+  uint64_t size = 0;
+  /** Modification time in nanoseconds, so rewrites within the same
+   *  second are detected. */
+  int64_t mtime = 0;
+};
+
+bool get_identity(const std::string& path, file_identity& id) {
+  struct ::stat buffer;
+  if (::stat(path.c_str(), &buffer) != 0) { return false; }
+  id.path = path;
+  id.size = buffer.st_size;
+  id.mtime = (static_cast<int64_t>(buffer.st_mtim.tv_sec) * 1000000000
+              + buffer.st_mtim.tv_nsec);
+  return true;
+}
+
+/** 64-bit FNV-1a hash. */
+uint64_t hash_bytes(const char* data, size_t size,
+                    uint64_t hash = 14695981039346656037ull) {
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+void write_value(std::ostream& out, uint64_t val) {
+  out.write(reinterpret_cast<const char*>(&val), sizeof(val));
+}
+
+void write_string(std::ostream& out, const std::string& str) {
+  write_value(out, str.size());
+  out.write(str.data(), str.size());
+}
+
+bool read_value(std::istream& in, uint64_t& val) {
+  return bool(in.read(reinterpret_cast<char*>(&val), sizeof(val)));
+}
+
+bool read_string(std::istream& in, std::string& str, uint64_t max_size) {
+  uint64_t size;
+  if (!read_value(in, size) || size > max_size) { return false; }
+  str.resize(size);
+  return bool(in.read(&str[0], size));
+}
+
+} // namespace
+
+metadata_cache::metadata_cache(const std::string& name,
+                               const std::string& cache_dir)
+  : m_name(name), m_cache_dir(cache_dir) {}
+
+void metadata_cache::add_input_file(const std::string& path) {
+  m_input_files.push_back(path);
+}
+
+void metadata_cache::add_dependent_file(const std::string& path) {
+  m_dependent_files.push_back(path);
+}
+
+void metadata_cache::add_parameter(const std::string& name,
+                                   const std::string& value) {
+  m_parameters += name + "=" + value + "\n";
+}
+
+std::string metadata_cache::get_filename() const {
+  std::string key = m_name + "\n" + m_parameters;
+  for (const auto& path : m_input_files) {
+    key += path + "\n";
+  }
+  const uint64_t hash = hash_bytes(key.data(), key.size());
+  char hash_str[17];
+  std::snprintf(hash_str, sizeof(hash_str), "%016llx",
+                static_cast<unsigned long long>(hash));
+
+  std::string dir = m_cache_dir;
+  std::string base = "metadata";
+  if (!m_input_files.empty()) {
+    if (dir.empty()) {
+      dir = file::extract_parent_directory(m_input_files.front());
+    }
+    base = file::extract_base_name(m_input_files.front());
+  }
+  if (!dir.empty() && dir.back() != '/') { dir += '/'; }
+  return dir + base + "." + m_name + "." + hash_str + ".metadata";
+}
+
+bool metadata_cache::read(std::string& payload) const {
+  std::ifstream in(get_filename(), std::ios::binary);
+  if (!in) { return false; }
+  in.seekg(0, std::ios::end);
+  const uint64_t file_size = in.tellg();
+  in.seekg(0, std::ios::beg);
+
+  char magic[sizeof(cache_magic)];
+  uint64_t version;
+  if (!in.read(magic, sizeof(magic))
+      || !std::equal(magic, magic + sizeof(magic), cache_magic)
+      || !read_value(in, version) || version != cache_version) {
+    return false;
+  }
+
+  // The key text guards against hash collisions in the file name
+  std::string key;
+  if (!read_string(in, key, file_size)
+      || key != m_name + "\n" + m_parameters) {
+    return false;
+  }
+
+  // Every input file must be recorded, and every recorded file must
+  // be unchanged
+  uint64_t num_files;
+  if (!read_value(in, num_files) || num_files > file_size) { return false; }
+  std::vector<std::string> paths(num_files);
+  for (auto& path : paths) {
+    file_identity stored, current;
+    uint64_t mtime;
+    if (!read_string(in, path, file_size)
+        || !read_value(in, stored.size)
+        || !read_value(in, mtime)
+        || !get_identity(path, current)
+        || current.size != stored.size
+        || current.mtime != static_cast<int64_t>(mtime)) {
+      return false;
+    }
+  }
+  if (paths.size() < m_input_files.size()
+      || !std::equal(m_input_files.begin(), m_input_files.end(),
+                     paths.begin())) {
+    return false;
+  }
+
+  uint64_t checksum;
+  if (!read_string(in, payload, file_size)
+      || !read_value(in, checksum)
+      || checksum != hash_bytes(payload.data(), payload.size())) {
+    payload.clear();
+    return false;
+  }
+  return true;
+}
+
+bool metadata_cache::write(const std::string& payload) const {
+  // Input files are recorded first, in order, so read can match them
+  std::vector<file_identity> ids;
+  for (const auto* files : {&m_input_files, &m_dependent_files}) {
+    for (const auto& path : *files) {
+      ids.emplace_back();
+      if (!get_identity(path, ids.back())) { return false; }
+    }
+  }
+
+  if (!m_cache_dir.empty()) {
+    try {
+      file::make_directory(m_cache_dir);
+    } catch (const std::exception&) {
+      return false;
+    }
+  }
+  const std::string filename = get_filename();
+  // Note: Jobs on several hosts may write the same cache at once
+  char host[256] = "";
+  ::gethostname(host, sizeof(host) - 1);
+  const std::string tmp_filename
+    = filename + ".tmp." + host + "." + std::to_string(::getpid());
+  {
+    std::ofstream out(tmp_filename, std::ios::binary | std::ios::trunc);
+    if (!out) { return false; }
+    out.write(cache_magic, sizeof(cache_magic));
+    write_value(out, cache_version);
+    write_string(out, m_name + "\n" + m_parameters);
+    write_value(out, ids.size());
+    for (const auto& id : ids) {
+      write_string(out, id.path);
+      write_value(out, id.size);
+      write_value(out, static_cast<uint64_t>(id.mtime));
+    }
+    write_string(out, payload);
+    write_value(out, hash_bytes(payload.data(), payload.size()));
+    if (!out.flush()) {
+      out.close();
+      std::remove(tmp_filename.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+    std::remove(tmp_filename.c_str());
+    return false;
+  }
+  return true;
+}
+
+} // namespace lbann
@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/utils/numerical_health.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace lbann {
+
+numerical_health get_numerical_health(El::Int height, El::Int width,
+                                      const DataType* buffer, El::Int ldim) {
+  numerical_health health;
+  if (height <= 0 || width <= 0) { return health; }
+
+  // Fused pass over all entries
+  // Note: Comparisons with NaN are false, so |x| <= max is false
+  // exactly for NaNs and infinities.
+  constexpr DataType max_finite = std::numeric_limits<DataType>::max();
+  const El::Int size = (ldim == height) ? height * width : height;
+  const El::Int num_cols = (ldim == height) ? 1 : width;
+  El::Int num_nonfinite = 0;
+  DataType max_abs = DataType(0);
+  LBANN_OMP_PARALLEL_FOR_ARGS(reduction(+:num_nonfinite) reduction(max:max_abs))
+  for (El::Int col = 0; col < num_cols; ++col) {
+    const DataType* __restrict__ x = &buffer[col * ldim];
+    El::Int col_nonfinite = 0;
+    DataType col_max_abs = DataType(0);
+#pragma omp simd reduction(+:col_nonfinite) reduction(max:col_max_abs)
+    for (El::Int i = 0; i < size; ++i) {
+      const DataType abs_x = std::fabs(x[i]);
+      const bool finite = abs_x <= max_finite;
+      col_nonfinite += finite ? 0 : 1;
+      col_max_abs = std::max(col_max_abs, finite ? abs_x : DataType(0));
+    }
+    num_nonfinite += col_nonfinite;
+    max_abs = std::max(max_abs, col_max_abs);
+  }
+  health.max_abs = max_abs;
+  if (num_nonfinite == 0) { return health; }
+
+  // Classify and locate non-finite entries
+  for (El::Int col = 0; col < width; ++col) {
+    for (El::Int row = 0; row < height; ++row) {
+      const DataType& x = buffer[row + col * ldim];
+      if (std::isnan(x)) {
+        ++health.num_nans;
+      } else if (std::isinf(x)) {
+        ++health.num_infs;
+      } else {
+        continue;
+      }
+      if (health.row < 0) {
+        health.row = row;
+        health.col = col;
+      }
+    }
+  }
+  return health;
+
+}
+
+} // namespace lbann
@@ -0,0 +1,331 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/utils/output_stream.hpp"
+#include "lbann/utils/exception.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <sstream>
+
+namespace lbann {
+
+namespace {
+
+constexpr char stream_magic[8] = {'L','B','A','N','N','O','U','T'};
+constexpr std::uint32_t stream_version = 1;
+
+template <typename T>
+void write_value(std::ofstream& fs, const T& val) {
+  fs.write(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+template <typename T>
+bool read_value(std::ifstream& fs, T& val) {
+  return bool(fs.read(reinterpret_cast<char*>(&val), sizeof(T)));
+}
+
+/// Bytes of a chunk in the file
+size_t get_chunk_bytes(const output_stream_chunk& chunk) {
+  return (2 * sizeof(std::uint32_t) + 3 * sizeof(std::int64_t)
+          + chunk.indices.size() * sizeof(std::int64_t)
+          + chunk.values.size() * sizeof(DataType));
+}
+
+} // namespace
+
+El::Int output_stream_tensor::get_size() const {
+  El::Int size = 1;
+  for (const auto& d : dims) { size *= d; }
+  return size;
+}
+
+// ---------------------------------------------
+// Writer
+// ---------------------------------------------
+
+output_stream_writer::output_stream_writer(std::string file_prefix,
+                                           std::vector<output_stream_tensor> tensors,
+                                           size_t max_file_size,
+                                           size_t max_queued_bytes)
+  : m_file_prefix(std::move(file_prefix)),
+    m_tensors(std::move(tensors)),
+    m_max_file_size(max_file_size),
+    m_max_queued_bytes(max_queued_bytes) {
+  m_thread = std::thread(&output_stream_writer::run, this);
+}
+
+output_stream_writer::~output_stream_writer() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  m_thread.join();
+}
+
+std::unique_ptr<output_stream_chunk> output_stream_writer::get_chunk() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_free_chunks.empty()) {
+    return std::unique_ptr<output_stream_chunk>(new output_stream_chunk());
+  }
+  auto chunk = std::move(m_free_chunks.back());
+  m_free_chunks.pop_back();
+  chunk->indices.clear();
+  chunk->values.clear();
+  return chunk;
+}
+
+void output_stream_writer::write(std::unique_ptr<output_stream_chunk> chunk) {
+  std::stringstream err;
+  if (chunk->tensor < 0 || chunk->tensor >= (int) m_tensors.size()) {
+    err << "attempted to write invalid tensor " << chunk->tensor << " "
+        << "to output stream \"" << m_file_prefix << "\"";
+    LBANN_ERROR(err.str());
+  }
+  const size_t num_samples = chunk->indices.size();
+  const size_t tensor_size = m_tensors[chunk->tensor].get_size();
+  if (chunk->values.size() != num_samples * tensor_size) {
+    err << "attempted to write " << chunk->values.size() << " values "
+        << "for " << num_samples << " samples of tensor "
+        << "with " << tensor_size << " entries per sample "
+        << "to output stream \"" << m_file_prefix << "\"";
+    LBANN_ERROR(err.str());
+  }
+  const size_t bytes = get_chunk_bytes(*chunk);
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cv.wait(lock, [this] {
+      return (m_queue.empty()
+              || m_queued_bytes < m_max_queued_bytes
+              || !m_error.empty());
+    });
+  check_error();
+  m_queued_bytes += bytes;
+  m_queue.emplace_back(std::move(chunk));
+  lock.unlock();
+  m_cv.notify_all();
+}
+
+void output_stream_writer::flush() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cv.wait(lock, [this] {
+      return (m_queue.empty() && !m_busy) || !m_error.empty();
+    });
+  check_error();
+}
+
+int output_stream_writer::get_num_files() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_num_files;
+}
+
+void output_stream_writer::check_error() const {
+  if (!m_error.empty()) {
+    LBANN_ERROR("output stream \"" + m_file_prefix + "\" failed: " + m_error);
+  }
+}
+
+void output_stream_writer::run() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cv.wait(lock, [this] { return !m_queue.empty() || m_stop; });
+    if (m_queue.empty()) { break; }
+    auto chunk = std::move(m_queue.front());
+    m_queue.pop_front();
+    const bool failed = !m_error.empty();
+    m_busy = true;
+    lock.unlock();
+
+    // Write chunk without holding the lock
+    // Note: The file is flushed once the queue is drained.
+    std::string error;
+    if (!failed) {
+      try {
+        write_chunk(*chunk);
+      } catch (const std::exception& e) {
+        error = e.what();
+      }
+    }
+    lock.lock();
+    m_queued_bytes -= get_chunk_bytes(*chunk);
+    m_free_chunks.emplace_back(std::move(chunk));
+    if (!failed && error.empty() && m_queue.empty()) {
+      lock.unlock();
+      m_file.flush();
+      if (!m_file) { error = "failed to write output file"; }
+      lock.lock();
+    }
+    if (!error.empty()) { m_error = error; }
+    m_busy = false;
+    m_cv.notify_all();
+  }
+  if (m_file.is_open()) { m_file.close(); }
+}
+
+void output_stream_writer::open_file() {
+  if (m_file.is_open()) { m_file.close(); }
+  int part;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    part = m_num_files++;
+  }
+  const std::string file_name = (m_file_prefix
+                                 + "-part" + std::to_string(part)
+                                 + ".bin");
+  m_file.open(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_file.is_open()) {
+    throw std::runtime_error("failed to open " + file_name);
+  }
+
+  // Write header
+  m_file.write(stream_magic, sizeof(stream_magic));
+  write_value(m_file, stream_version);
+  write_value(m_file, std::uint32_t(sizeof(DataType)));
+  write_value(m_file, std::uint32_t(m_tensors.size()));
+  for (const auto& t : m_tensors) {
+    write_value(m_file, std::uint32_t(t.layer_name.size()));
+    m_file.write(t.layer_name.data(), t.layer_name.size());
+    write_value(m_file, std::uint32_t(t.output_index));
+    write_value(m_file, std::uint32_t(t.dims.size()));
+    for (const auto& d : t.dims) { write_value(m_file, std::int32_t(d)); }
+  }
+  m_file_size = m_file.tellp();
+  m_file_num_chunks = 0;
+
+}
+
+void output_stream_writer::write_chunk(const output_stream_chunk& chunk) {
+  const size_t bytes = get_chunk_bytes(chunk);
+  if (!m_file.is_open()
+      || (m_file_num_chunks > 0 && m_file_size + bytes > m_max_file_size)) {
+    open_file();
+  }
+  write_value(m_file, std::uint32_t(chunk.tensor));
+  write_value(m_file, std::uint32_t(chunk.mode));
+  write_value(m_file, std::int64_t(chunk.epoch));
+  write_value(m_file, std::int64_t(chunk.step));
+  write_value(m_file, std::int64_t(chunk.indices.size()));
+  for (const auto& i : chunk.indices) {
+    write_value(m_file, std::int64_t(i));
+  }
+  m_file.write(reinterpret_cast<const char*>(chunk.values.data()),
+               chunk.values.size() * sizeof(DataType));
+  if (!m_file) {
+    throw std::runtime_error("failed to write chunk");
+  }
+  m_file_size += bytes;
+  ++m_file_num_chunks;
+}
+
+// ---------------------------------------------
+// Reader
+// ---------------------------------------------
+
+output_stream_reader::output_stream_reader(const std::string& file_name)
+  : m_file_name(file_name),
+    m_file(file_name, std::ios::in | std::ios::binary) {
+  std::stringstream err;
+  if (!m_file.is_open()) {
+    err << "failed to open output stream file \"" << m_file_name << "\"";
+    LBANN_ERROR(err.str());
+  }
+
+  // Read header
+  char magic[sizeof(stream_magic)];
+  std::uint32_t version = 0, value_size = 0, num_tensors = 0;
+  m_file.read(magic, sizeof(magic));
+  read_value(m_file, version);
+  read_value(m_file, value_size);
+  read_value(m_file, num_tensors);
+  if (!m_file || std::memcmp(magic, stream_magic, sizeof(magic)) != 0) {
+    err << "\"" << m_file_name << "\" is not an output stream file";
+    LBANN_ERROR(err.str());
+  }
+  if (version != stream_version || value_size != sizeof(DataType)) {
+    err << "output stream file \"" << m_file_name << "\" "
+        << "has version " << version << " "
+        << "and " << value_size << " bytes per value "
+        << "(expected version " << stream_version << " "
+        << "and " << sizeof(DataType) << " bytes per value)";
+    LBANN_ERROR(err.str());
+  }
+  m_tensors.resize(num_tensors);
+  for (auto& t : m_tensors) {
+    std::uint32_t name_length = 0, output_index = 0, num_dims = 0;
+    read_value(m_file, name_length);
+    t.layer_name.resize(name_length);
+    m_file.read(&t.layer_name[0], name_length);
+    read_value(m_file, output_index);
+    read_value(m_file, num_dims);
+    t.output_index = output_index;
+    t.dims.resize(num_dims);
+    for (auto& d : t.dims) {
+      std::int32_t dim = 0;
+      read_value(m_file, dim);
+      d = dim;
+    }
+  }
+  if (!m_file) {
+    err << "failed to read header of output stream file "
+        << "\"" << m_file_name << "\"";
+    LBANN_ERROR(err.str());
+  }
+
+}
+
+bool output_stream_reader::read(output_stream_chunk& chunk) {
+  std::uint32_t tensor = 0, mode = 0;
+  if (!read_value(m_file, tensor)) { return false; }
+  std::int64_t epoch = 0, step = 0, num_samples = 0;
+  read_value(m_file, mode);
+  read_value(m_file, epoch);
+  read_value(m_file, step);
+  read_value(m_file, num_samples);
+  if (!m_file || tensor >= m_tensors.size() || num_samples < 0) {
+    LBANN_ERROR("invalid chunk in output stream file "
+                "\"" + m_file_name + "\"");
+  }
+  chunk.tensor = tensor;
+  chunk.mode = static_cast<execution_mode>(mode);
+  chunk.epoch = epoch;
+  chunk.step = step;
+  chunk.indices.resize(num_samples);
+  for (auto& i : chunk.indices) {
+    std::int64_t index = 0;
+    read_value(m_file, index);
+    i = index;
+  }
+  chunk.values.resize(num_samples * m_tensors[tensor].get_size());
+  m_file.read(reinterpret_cast<char*>(chunk.values.data()),
+              chunk.values.size() * sizeof(DataType));
+  if (!m_file) {
+    LBANN_ERROR("truncated chunk in output stream file "
+                "\"" + m_file_name + "\"");
+  }
+  return true;
+}
+
+} // namespace lbann
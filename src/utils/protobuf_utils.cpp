@@ -28,6 +28,8 @@
 
 #include "lbann/utils/protobuf_utils.hpp"
 #include "lbann/proto/proto_common.hpp"
+#include "lbann/comm.hpp"
+#include "lbann/utils/timer.hpp"
 
 #include <lbann.pb.h> // Actually use LbannPB here
 
@@ -189,6 +191,67 @@ load_prototext(
   return models_out;
 }
 
+std::vector<std::unique_ptr<lbann_data::LbannPB>>
+load_prototext(
+  lbann_comm& comm,
+  const int argc,
+  char* const argv[])
+{
+  const bool master = comm.am_world_master();
+  const auto start = get_time();
+
+  // World master parses prototext and serializes the messages
+  // Note: The status is broadcast first so that other ranks do not
+  // wait forever if parsing fails.
+  std::vector<std::unique_ptr<lbann_data::LbannPB>> models_out;
+  std::vector<size_t> sizes;
+  std::vector<char> buffer;
+  int status = 0;
+  if (master) {
+    try {
+      models_out = load_prototext(master, argc, argv);
+      for (const auto& pb : models_out) {
+        std::string bytes;
+        if (!pb->SerializeToString(&bytes)) {
+          LBANN_ERROR("failed to serialize prototext");
+        }
+        sizes.push_back(bytes.size());
+        buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+      }
+    } catch (...) {
+      status = 1;
+      comm.world_broadcast(0, status);
+      throw;
+    }
+  }
+  comm.world_broadcast(0, status);
+  if (status != 0) {
+    LBANN_ERROR("world master failed to load prototext");
+  }
+
+  // Broadcast serialized messages and parse on other ranks
+  comm.world_broadcast(0, sizes);
+  comm.world_broadcast(0, buffer);
+  if (!master) {
+    size_t offset = 0;
+    for (const auto& size : sizes) {
+      auto pb = make_unique<lbann_data::LbannPB>();
+      if (!pb->ParseFromArray(buffer.data() + offset, size)) {
+        LBANN_ERROR("failed to parse prototext broadcast from world master");
+      }
+      offset += size;
+      models_out.emplace_back(std::move(pb));
+    }
+  }
+
+  if (master) {
+    std::cout << "loaded and broadcast " << models_out.size() << " "
+              << "prototext(s) (" << buffer.size() << " bytes) in "
+              << get_time() - start << " s" << std::endl;
+  }
+  return models_out;
+}
+
 void verify_prototext(
   const bool master,
   const std::vector<std::unique_ptr<lbann_data::LbannPB>> &models) {
@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/utils/reduced_precision.hpp"
+#include "lbann/utils/exception.hpp"
+#include "lbann/utils/omp_pragma.hpp"
+
+#include <cstring>
+
+namespace lbann {
+
+storage_precision to_storage_precision(const std::string& str) {
+  if (str.empty() || str == "fp32" || str == "full") {
+    return storage_precision::full;
+  }
+  if (str == "bf16") { return storage_precision::bf16; }
+  if (str == "fp16") { return storage_precision::fp16; }
+  LBANN_ERROR("unknown storage precision (" + str + ")");
+  return storage_precision::full;
+}
+
+std::string to_string(storage_precision precision) {
+  switch (precision) {
+  case storage_precision::full: return "full";
+  case storage_precision::bf16: return "bf16";
+  case storage_precision::fp16: return "fp16";
+  default:                      return "unknown";
+  }
+}
+
+uint16_t float_to_bf16(float x) {
+  uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  if ((bits & 0x7F800000u) == 0x7F800000u && (bits & 0x007FFFFFu) != 0) {
+    // Keep NaNs quiet instead of rounding them to infinity
+    return static_cast<uint16_t>((bits >> 16) | 0x0040u);
+  }
+  const uint32_t rounding_bias = 0x00007FFFu + ((bits >> 16) & 1u);
+  return static_cast<uint16_t>((bits + rounding_bias) >> 16);
+}
+
+float bf16_to_float(uint16_t x) {
+  const uint32_t bits = static_cast<uint32_t>(x) << 16;
+  float y;
+  std::memcpy(&y, &bits, sizeof(y));
+  return y;
+}
+
+uint16_t float_to_fp16(float x) {
+  uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+  const uint32_t abs_bits = bits & 0x7FFFFFFFu;
+
+  // Infinity and NaN
+  if (abs_bits >= 0x7F800000u) {
+    return sign | (abs_bits > 0x7F800000u ? 0x7E00u : 0x7C00u);
+  }
+
+  // Overflow to infinity
+  // Note: 0x477FF000 is the smallest float that rounds up to 2^16.
+  if (abs_bits >= 0x477FF000u) { return sign | 0x7C00u; }
+
+  // Normal numbers
+  if (abs_bits >= 0x38800000u) {
+    const uint32_t mantissa_odd = (abs_bits >> 13) & 1u;
+    const uint32_t rounded = abs_bits + 0x00000FFFu + mantissa_odd;
+    return sign | static_cast<uint16_t>((rounded - 0x38000000u) >> 13);
+  }
+
+  // Subnormal numbers and zero
+  if (abs_bits < 0x33000000u) { return sign; }
+  const uint32_t exponent = abs_bits >> 23;
+  const uint32_t mantissa = (abs_bits & 0x007FFFFFu) | 0x00800000u;
+  const uint32_t shift = 126u - exponent;
+  uint32_t result = mantissa >> shift;
+  const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+  const uint32_t halfway = 1u << (shift - 1u);
+  if (remainder > halfway || (remainder == halfway && (result & 1u))) {
+    ++result;
+  }
+  return sign | static_cast<uint16_t>(result);
+}
+
+float fp16_to_float(uint16_t x) {
+  const uint32_t sign = static_cast<uint32_t>(x & 0x8000u) << 16;
+  const uint32_t exponent = (x >> 10) & 0x1Fu;
+  uint32_t mantissa = x & 0x03FFu;
+  uint32_t bits;
+  if (exponent == 0x1Fu) {
+    bits = sign | 0x7F800000u | (mantissa << 13);
+  } else if (exponent != 0) {
+    bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+  } else if (mantissa == 0) {
+    bits = sign;
+  } else {
+    // Normalize subnormal number
+    uint32_t e = 113u;
+    while ((mantissa & 0x0400u) == 0) {
+      mantissa <<= 1;
+      --e;
+    }
+    bits = sign | (e << 23) | ((mantissa & 0x03FFu) << 13);
+  }
+  float y;
+  std::memcpy(&y, &bits, sizeof(y));
+  return y;
+}
+
+template <typename T>
+void pack_reduced_precision(size_t height, size_t width,
+                            const T* in, size_t in_ldim,
+                            uint16_t* out,
+                            storage_precision precision) {
+  switch (precision) {
+  case storage_precision::bf16:
+    LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+    for (size_t col = 0; col < width; ++col) {
+      for (size_t row = 0; row < height; ++row) {
+        out[row + col * height]
+          = float_to_bf16(static_cast<float>(in[row + col * in_ldim]));
+      }
+    }
+    break;
+  case storage_precision::fp16:
+    LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+    for (size_t col = 0; col < width; ++col) {
+      for (size_t row = 0; row < height; ++row) {
+        out[row + col * height]
+          = float_to_fp16(static_cast<float>(in[row + col * in_ldim]));
+      }
+    }
+    break;
+  default:
+    LBANN_ERROR("invalid storage precision for packing "
+                "(" + to_string(precision) + ")");
+  }
+}
+
+template <typename T>
+void unpack_reduced_precision(size_t height, size_t width,
+                              const uint16_t* in,
+                              T* out, size_t out_ldim,
+                              storage_precision precision) {
+  switch (precision) {
+  case storage_precision::bf16:
+    LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+    for (size_t col = 0; col < width; ++col) {
+      for (size_t row = 0; row < height; ++row) {
+        out[row + col * out_ldim]
+          = static_cast<T>(bf16_to_float(in[row + col * height]));
+      }
+    }
+    break;
+  case storage_precision::fp16:
+    LBANN_OMP_PARALLEL_FOR_COLLAPSE2
+    for (size_t col = 0; col < width; ++col) {
+      for (size_t row = 0; row < height; ++row) {
+        out[row + col * out_ldim]
+          = static_cast<T>(fp16_to_float(in[row + col * height]));
+      }
+    }
+    break;
+  default:
+    LBANN_ERROR("invalid storage precision for unpacking "
+                "(" + to_string(precision) + ")");
+  }
+}
+
+#define PROTO(T)                                                        \
+  template void pack_reduced_precision<T>(                             \
+    size_t, size_t, const T*, size_t, uint16_t*, storage_precision);   \
+  template void unpack_reduced_precision<T>(                           \
+    size_t, size_t, const uint16_t*, T*, size_t, storage_precision)
+PROTO(float);
+PROTO(double);
+#undef PROTO
+
+} // namespace lbann
@@ -0,0 +1,188 @@
+#include "lbann/utils/threads/dag_scheduler.hpp"
+#include "lbann/utils/exception.hpp"
+#include "lbann/utils/timer.hpp"
+
+#include <algorithm>
+#include <omp.h>
+
+namespace lbann {
+
+dag_scheduler::dag_scheduler(int num_workers, int threads_per_task)
+  : m_num_workers(std::max(num_workers, 1)),
+    m_threads_per_task(threads_per_task) {
+  if (m_threads_per_task <= 0) {
+    m_threads_per_task = std::max(omp_get_max_threads() / m_num_workers, 1);
+  }
+  m_threads.reserve(m_num_workers - 1);
+  for (int i = 1; i < m_num_workers; ++i) {
+    m_threads.emplace_back(&dag_scheduler::worker_loop, this);
+  }
+}
+
+dag_scheduler::~dag_scheduler() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_shutdown = true;
+  }
+  m_cv.notify_all();
+  for (auto& t : m_threads) {
+    if (t.joinable()) { t.join(); }
+  }
+}
+
+void dag_scheduler::set_graph(const std::set<El::Int>& nodes,
+                              const std::map<El::Int,std::set<El::Int>>& edges) {
+  m_nodes.assign(nodes.begin(), nodes.end());
+  const size_t num_nodes = m_nodes.size();
+  std::map<El::Int,size_t> ids;
+  for (size_t id = 0; id < num_nodes; ++id) {
+    ids[m_nodes[id]] = id;
+  }
+
+  m_successors.assign(num_nodes, std::vector<size_t>());
+  m_num_predecessors.assign(num_nodes, 0);
+  for (const auto& e : edges) {
+    if (ids.count(e.first) == 0) { continue; }
+    for (const auto& neighbor : e.second) {
+      if (ids.count(neighbor) == 0) { continue; }
+      m_successors[ids[e.first]].push_back(ids[neighbor]);
+      ++m_num_predecessors[ids[neighbor]];
+    }
+  }
+
+  // Kahn's algorithm, both to check for cycles and to order the
+  // critical path computation
+  m_order.clear();
+  m_order.reserve(num_nodes);
+  std::vector<size_t> pending = m_num_predecessors;
+  for (size_t id = 0; id < num_nodes; ++id) {
+    if (pending[id] == 0) { m_order.push_back(id); }
+  }
+  for (size_t i = 0; i < m_order.size(); ++i) {
+    for (const auto& succ : m_successors[m_order[i]]) {
+      if (--pending[succ] == 0) { m_order.push_back(succ); }
+    }
+  }
+  if (m_order.size() != num_nodes) {
+    LBANN_ERROR("dag_scheduler was given a cyclic graph");
+  }
+
+  // Without measurements every task counts the same
+  m_task_times.assign(num_nodes, 1.0);
+  update_priorities();
+}
+
+void dag_scheduler::update_priorities() {
+  m_priorities.assign(m_nodes.size(), 0.0);
+  m_critical_path_time = 0;
+  for (auto it = m_order.rbegin(); it != m_order.rend(); ++it) {
+    double longest = 0;
+    for (const auto& succ : m_successors[*it]) {
+      longest = std::max(longest, m_priorities[succ]);
+    }
+    m_priorities[*it] = m_task_times[*it] + longest;
+    m_critical_path_time = std::max(m_critical_path_time, m_priorities[*it]);
+  }
+}
+
+void dag_scheduler::run(const std::function<void(El::Int)>& task) {
+  if (m_nodes.empty()) { return; }
+  const auto start_time = get_time();
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_task = &task;
+  m_pending = m_num_predecessors;
+  m_ready.clear();
+  const auto compare = [this](size_t a, size_t b) {
+    return m_priorities[a] < m_priorities[b];
+  };
+  for (size_t id = 0; id < m_nodes.size(); ++id) {
+    if (m_pending[id] == 0) { m_ready.push_back(id); }
+  }
+  std::make_heap(m_ready.begin(), m_ready.end(), compare);
+  m_num_remaining = m_nodes.size();
+  m_error = nullptr;
+  ++m_generation;
+  m_cv.notify_all();
+
+  // The calling thread works with the same thread budget as the
+  // workers
+  const int max_threads = omp_get_max_threads();
+  omp_set_num_threads(m_threads_per_task);
+  process_tasks(lock);
+  omp_set_num_threads(max_threads);
+
+  // Tasks hold a reference to the task function until they finish
+  m_cv.wait(lock, [this] {
+      return m_num_running == 0 && m_num_active_workers == 0;
+    });
+  m_task = nullptr;
+
+  m_run_time = get_time() - start_time;
+  m_work_time = 0;
+  for (const auto& t : m_task_times) { m_work_time += t; }
+  update_priorities();
+  if (m_error) {
+    std::rethrow_exception(m_error);
+  }
+}
+
+void dag_scheduler::worker_loop() {
+  omp_set_num_threads(m_threads_per_task);
+  size_t generation = 0;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cv.wait(lock, [this, &generation] {
+        return m_shutdown || m_generation != generation;
+      });
+    if (m_shutdown) { return; }
+    generation = m_generation;
+    ++m_num_active_workers;
+    process_tasks(lock);
+    --m_num_active_workers;
+    m_cv.notify_all();
+  }
+}
+
+void dag_scheduler::process_tasks(std::unique_lock<std::mutex>& lock) {
+  const auto compare = [this](size_t a, size_t b) {
+    return m_priorities[a] < m_priorities[b];
+  };
+  while (true) {
+    m_cv.wait(lock, [this] {
+        return m_num_remaining == 0 || m_error || !m_ready.empty();
+      });
+    if (m_num_remaining == 0 || m_error) { return; }
+    std::pop_heap(m_ready.begin(), m_ready.end(), compare);
+    const size_t id = m_ready.back();
+    m_ready.pop_back();
+    ++m_num_running;
+    lock.unlock();
+
+    std::exception_ptr error;
+    const auto start_time = get_time();
+    try {
+      (*m_task)(m_nodes[id]);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    const auto task_time = get_time() - start_time;
+
+    lock.lock();
+    m_task_times[id] = task_time;
+    --m_num_running;
+    --m_num_remaining;
+    if (error) {
+      if (!m_error) { m_error = error; }
+    } else {
+      for (const auto& succ : m_successors[id]) {
+        if (--m_pending[succ] == 0) {
+          m_ready.push_back(succ);
+          std::push_heap(m_ready.begin(), m_ready.end(), compare);
+        }
+      }
+    }
+    m_cv.notify_all();
+  }
+}
+
+}// namespace lbann
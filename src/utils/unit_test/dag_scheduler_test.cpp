@@ -0,0 +1,73 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/utils/threads/dag_scheduler.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+
+// A diamond with a long branch:  0 -> {1, 2} -> 3, 1 -> 4 -> 3
+std::set<El::Int> diamond_nodes() { return {0, 1, 2, 3, 4}; }
+std::map<El::Int,std::set<El::Int>> diamond_edges() {
+  return {{0, {1, 2}}, {1, {4}}, {2, {3}}, {4, {3}}};
+}
+
+} // namespace
+
+TEST_CASE("Testing dag_scheduler ordering", "[threads][utilities]") {
+  for (int num_workers : {1, 2, 4}) {
+    lbann::dag_scheduler scheduler(num_workers, 1);
+    scheduler.set_graph(diamond_nodes(), diamond_edges());
+
+    // Tasks run once and after their predecessors
+    for (int run = 0; run < 3; ++run) {
+      std::mutex mutex;
+      std::vector<El::Int> order;
+      scheduler.run([&](El::Int node) {
+          std::lock_guard<std::mutex> lock(mutex);
+          order.push_back(node);
+        });
+      REQUIRE(order.size() == 5);
+      std::map<El::Int,size_t> position;
+      for (size_t i = 0; i < order.size(); ++i) {
+        REQUIRE(position.count(order[i]) == 0);
+        position[order[i]] = i;
+      }
+      for (const auto& e : diamond_edges()) {
+        for (const auto& succ : e.second) {
+          REQUIRE(position[e.first] < position[succ]);
+        }
+      }
+    }
+    REQUIRE(scheduler.get_critical_path_time() <= scheduler.get_work_time());
+  }
+}
+
+TEST_CASE("Testing dag_scheduler errors", "[threads][utilities]") {
+  for (int num_workers : {1, 2, 4}) {
+    lbann::dag_scheduler scheduler(num_workers, 1);
+    scheduler.set_graph(diamond_nodes(), diamond_edges());
+
+    // Nodes 4 and 3 depend on the failing node, so they never run
+    std::atomic<int> count(0);
+    REQUIRE_THROWS_AS(
+      scheduler.run([&](El::Int node) {
+          ++count;
+          if (node == 1) { throw std::runtime_error("task failed"); }
+        }),
+      std::runtime_error);
+    REQUIRE(count < 5);
+
+    // The scheduler can be reused after a failure
+    count = 0;
+    scheduler.run([&](El::Int) { ++count; });
+    REQUIRE(count == 5);
+  }
+
+  lbann::dag_scheduler scheduler(2, 1);
+  REQUIRE_THROWS(scheduler.set_graph({0, 1}, {{0, {1}}, {1, {0}}}));
+}
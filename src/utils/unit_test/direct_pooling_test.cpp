@@ -0,0 +1,163 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/utils/direct_pooling.hpp>
+
+#include <vector>
+
+namespace {
+
+// Reference pooling on one channel of a 3D tensor, written like
+// im2col: padding entries are zeros and maxima are found in window
+// order.
+struct reference_pooling {
+  std::vector<int> in, win, pad, stride, out;
+  reference_pooling(std::vector<int> in_, std::vector<int> win_,
+                    std::vector<int> pad_, std::vector<int> stride_)
+    : in(in_), win(win_), pad(pad_), stride(stride_), out(3) {
+    for (int d = 0; d < 3; ++d) {
+      out[d] = (in[d] + 2 * pad[d] - win[d] + 1 + stride[d] - 1) / stride[d];
+    }
+  }
+  int input_size() const { return in[0] * in[1] * in[2]; }
+  int output_size() const { return out[0] * out[1] * out[2]; }
+  // Input index of window entry k of output j, or -1 if it is padding
+  int input_index(int j, int k) const {
+    const int o[3] = {j / (out[1] * out[2]), (j / out[2]) % out[1], j % out[2]};
+    const int w[3] = {k / (win[1] * win[2]), (k / win[2]) % win[1], k % win[2]};
+    int index = 0;
+    for (int d = 0; d < 3; ++d) {
+      const int i = o[d] * stride[d] - pad[d] + w[d];
+      if (i < 0 || i >= in[d]) { return -1; }
+      index = index * in[d] + i;
+    }
+    return index;
+  }
+};
+
+} // namespace
+
+TEST_CASE("Testing direct pooling kernels", "[pooling][utilities]") {
+  using DataType = lbann::DataType;
+  const std::vector<std::vector<int>> configs = {
+    // input dims, window dims, pads, strides
+    {1, 7, 6,  1, 3, 3,  0, 1, 1,  1, 2, 2},
+    {1, 8, 8,  1, 2, 2,  0, 0, 0,  1, 2, 2},
+    {5, 4, 6,  2, 2, 3,  1, 0, 1,  1, 1, 2},
+    {4, 4, 4,  3, 3, 3,  1, 1, 1,  2, 2, 2},
+  };
+  const int num_samples = 3, num_channels = 2;
+
+  for (const auto& c : configs) {
+    reference_pooling ref({c[0], c[1], c[2]}, {c[3], c[4], c[5]},
+                          {c[6], c[7], c[8]}, {c[9], c[10], c[11]});
+    // 2D configurations are passed without the leading unit dimension
+    const int first = (c[0] == 1 && c[3] == 1) ? 1 : 0;
+    lbann::pooling_geometry geom(num_channels,
+                                 {c.begin() + first, c.begin() + 3},
+                                 {c.begin() + 3 + first, c.begin() + 6},
+                                 {c.begin() + 6 + first, c.begin() + 9},
+                                 {c.begin() + 9 + first, c.begin() + 12});
+    const int window_size = c[3] * c[4] * c[5];
+    const int in_size = num_channels * ref.input_size();
+    const int out_size = num_channels * ref.output_size();
+    REQUIRE(geom.get_output_channel_size() == ref.output_size());
+
+    // Inputs with ties and negative values, with padded columns
+    const int in_ldim = in_size + 3, out_ldim = out_size + 2;
+    std::vector<DataType> x(in_ldim * num_samples), dy(out_ldim * num_samples);
+    for (size_t i = 0; i < x.size(); ++i) {
+      x[i] = DataType(int((i * 7919) % 13) - 8) / 4;
+    }
+    for (size_t i = 0; i < dy.size(); ++i) {
+      dy[i] = DataType(int((i * 104729) % 11) - 5);
+    }
+
+    // Reference results
+    std::vector<DataType> max_y(out_size * num_samples), avg_y(out_size * num_samples);
+    std::vector<int> max_k(out_size * num_samples);
+    std::vector<DataType> max_dx(in_size * num_samples, 0), avg_dx(in_size * num_samples, 0);
+    for (int s = 0; s < num_samples; ++s) {
+      for (int ch = 0; ch < num_channels; ++ch) {
+        for (int j = 0; j < ref.output_size(); ++j) {
+          const int o = s * out_size + ch * ref.output_size() + j;
+          DataType sum = 0, best = 0;
+          int best_k = 0;
+          for (int k = 0; k < window_size; ++k) {
+            const int i = ref.input_index(j, k);
+            const DataType val = (i < 0) ? DataType(0) : x[s * in_ldim + ch * ref.input_size() + i];
+            sum += val;
+            if (k == 0 || val > best) { best = val; best_k = k; }
+          }
+          max_y[o] = best;
+          max_k[o] = best_k;
+          avg_y[o] = sum / window_size;
+          const DataType g = dy[s * out_ldim + ch * ref.output_size() + j];
+          const int i_max = ref.input_index(j, best_k);
+          if (i_max >= 0) { max_dx[s * in_size + ch * ref.input_size() + i_max] += g; }
+          for (int k = 0; k < window_size; ++k) {
+            const int i = ref.input_index(j, k);
+            if (i >= 0) { avg_dx[s * in_size + ch * ref.input_size() + i] += g / window_size; }
+          }
+        }
+      }
+    }
+
+    // Max pooling with stored and recomputed indices
+    std::vector<DataType> y(out_ldim * num_samples), dx(in_ldim * num_samples);
+    std::vector<unsigned char> indices(out_size * num_samples);
+    geom.max_pool_forward(num_samples, x.data(), in_ldim, y.data(), out_ldim, indices.data());
+    for (int s = 0; s < num_samples; ++s) {
+      for (int j = 0; j < out_size; ++j) {
+        REQUIRE(y[s * out_ldim + j] == max_y[s * out_size + j]);
+        REQUIRE(indices[s * out_size + j] == max_k[s * out_size + j]);
+      }
+    }
+    for (const unsigned char* idx : {(const unsigned char*) indices.data(),
+                                     (const unsigned char*) nullptr}) {
+      geom.max_pool_backward(num_samples, x.data(), in_ldim, idx,
+                             dy.data(), out_ldim, dx.data(), in_ldim);
+      for (int s = 0; s < num_samples; ++s) {
+        for (int i = 0; i < in_size; ++i) {
+          REQUIRE(dx[s * in_ldim + i] == max_dx[s * in_size + i]);
+        }
+      }
+    }
+
+    // Average pooling
+    geom.average_pool_forward(num_samples, x.data(), in_ldim, y.data(), out_ldim, true);
+    geom.average_pool_backward(num_samples, dy.data(), out_ldim, dx.data(), in_ldim, true);
+    for (int s = 0; s < num_samples; ++s) {
+      for (int j = 0; j < out_size; ++j) {
+        REQUIRE(y[s * out_ldim + j] == Approx(avg_y[s * out_size + j]));
+      }
+      for (int i = 0; i < in_size; ++i) {
+        REQUIRE(dx[s * in_ldim + i] == Approx(avg_dx[s * in_size + i]).margin(1e-5));
+      }
+    }
+  }
+}
+
+TEST_CASE("Testing direct average pooling without pads", "[pooling][utilities]") {
+  using DataType = lbann::DataType;
+  // 1D: windows of 3 over 4 entries with one pad on each side
+  lbann::pooling_geometry geom(1, {4}, {3}, {1}, {1});
+  REQUIRE(geom.get_output_channel_size() == 4);
+  const std::vector<DataType> x = {1, 2, 3, 4};
+  std::vector<DataType> y(4), dx(4);
+  geom.average_pool_forward(1, x.data(), 4, y.data(), 4, false);
+  CHECK(y[0] == Approx(1.5));
+  CHECK(y[1] == Approx(2));
+  CHECK(y[2] == Approx(3));
+  CHECK(y[3] == Approx(3.5));
+  const std::vector<DataType> dy = {2, 3, 3, 2};
+  geom.average_pool_backward(1, dy.data(), 4, dx.data(), 4, false);
+  CHECK(dx[0] == Approx(2));
+  CHECK(dx[1] == Approx(3));
+  CHECK(dx[2] == Approx(3));
+  CHECK(dx[3] == Approx(2));
+
+  REQUIRE_THROWS(lbann::pooling_geometry(1, {2, 2, 2, 2}, {1, 1, 1, 1},
+                                         {0, 0, 0, 0}, {1, 1, 1, 1}));
+}
@@ -0,0 +1,111 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/utils/gemm_epilogue.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+using lbann::DataType;
+using lbann::epilogue_activation;
+
+// Activations and derivatives as computed by the activation layers,
+// from the activation input
+DataType reference_forward(epilogue_activation act, DataType alpha, DataType x) {
+  switch (act) {
+  case epilogue_activation::relu:       return x > 0 ? x : DataType(0);
+  case epilogue_activation::leaky_relu: return x > 0 ? x : alpha * x;
+  case epilogue_activation::elu:        return x > 0 ? x : alpha * std::expm1(x);
+  default:                              return x;
+  }
+}
+DataType reference_backward(epilogue_activation act, DataType alpha,
+                            DataType x, DataType dy) {
+  switch (act) {
+  case epilogue_activation::relu:       return x > 0 ? dy : DataType(0);
+  case epilogue_activation::leaky_relu: return x > 0 ? dy : alpha * dy;
+  case epilogue_activation::elu:        return x > 0 ? dy : dy * alpha * std::exp(x);
+  default:                              return dy;
+  }
+}
+
+} // namespace
+
+TEST_CASE("Testing GEMM epilogue", "[gemm][utilities]") {
+  const std::vector<std::pair<epilogue_activation,DataType>> activations = {
+    {epilogue_activation::none, 0},
+    {epilogue_activation::relu, 0},
+    {epilogue_activation::leaky_relu, 0.1},
+    {epilogue_activation::leaky_relu, 0},
+    {epilogue_activation::elu, 1.5},
+  };
+  const El::Int height = 12, width = 5, ldim = 15;
+  const DataType bias_scale = 0.5;
+
+  for (const auto& a : activations) {
+    const lbann::gemm_epilogue epilogue(a.first, a.second);
+    // One bias entry per row (fully-connected) and per 4 rows (convolution)
+    for (El::Int rows_per_bias : {1, 4}) {
+      std::vector<DataType> z(ldim * width), dy(ldim * width);
+      std::vector<DataType> bias(height / rows_per_bias);
+      for (size_t i = 0; i < z.size(); ++i) {
+        z[i] = DataType(int((i * 7919) % 17) - 8) / 4;
+        dy[i] = DataType(int((i * 104729) % 11) - 5);
+      }
+      for (size_t i = 0; i < bias.size(); ++i) {
+        bias[i] = DataType(int(i % 5) - 2);
+      }
+
+      // Forward epilogue leaves the padding rows alone
+      auto y = z;
+      epilogue.apply_forward(height, width, y.data(), ldim,
+                             bias.data(), bias_scale, rows_per_bias);
+      for (El::Int col = 0; col < width; ++col) {
+        for (El::Int row = 0; row < ldim; ++row) {
+          const auto i = row + col * ldim;
+          if (row >= height) {
+            REQUIRE(y[i] == z[i]);
+            continue;
+          }
+          const DataType x = z[i] + bias_scale * bias[row / rows_per_bias];
+          REQUIRE(y[i] == Approx(reference_forward(a.first, a.second, x)));
+        }
+      }
+
+      // Backward epilogue matches the derivative at the activation input
+      std::vector<DataType> dx(ldim * width, 0);
+      epilogue.apply_backward(height, width, y.data(), ldim,
+                              dy.data(), ldim, dx.data(), ldim);
+      for (El::Int col = 0; col < width; ++col) {
+        for (El::Int row = 0; row < height; ++row) {
+          const auto i = row + col * ldim;
+          const DataType x = z[i] + bias_scale * bias[row / rows_per_bias];
+          REQUIRE(dx[i] == Approx(reference_backward(a.first, a.second, x, dy[i])));
+        }
+      }
+
+      // Gradients may be converted in place
+      epilogue.apply_backward(height, width, y.data(), ldim,
+                              dy.data(), ldim, dy.data(), ldim);
+      for (El::Int col = 0; col < width; ++col) {
+        for (El::Int row = 0; row < height; ++row) {
+          REQUIRE(dy[row + col * ldim] == dx[row + col * ldim]);
+        }
+      }
+    }
+  }
+
+  // Without bias only the activation is applied
+  const lbann::gemm_epilogue relu(epilogue_activation::relu);
+  std::vector<DataType> y = {-1, 2, -3, 4};
+  relu.apply_forward(2, 2, y.data(), 2, nullptr, 1, 1);
+  CHECK(y == std::vector<DataType>({0, 2, 0, 4}));
+
+  // Derivatives can not be found from the output of these activations
+  REQUIRE_THROWS(lbann::gemm_epilogue(epilogue_activation::leaky_relu, -0.5));
+  REQUIRE_THROWS(lbann::gemm_epilogue(epilogue_activation::elu, 0));
+  REQUIRE(lbann::gemm_epilogue::get_panel_width(1 << 30) >= 1);
+}
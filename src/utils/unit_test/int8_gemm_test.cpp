@@ -0,0 +1,98 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/utils/int8_gemm.hpp>
+
+#include <cmath>
+#include <vector>
+
+using lbann::DataType;
+
+TEST_CASE("Testing int8 GEMM", "[gemm][utilities]") {
+  // Sizes cover full and partial column blocks
+  const El::Int height = 5, width = 12, num_channels = 3;
+  for (El::Int n : {1, 4, 7}) {
+
+    // Weights and inputs with different ranges in each input channel
+    std::vector<DataType> w(height * width), x(width * n);
+    for (El::Int l = 0; l < width; ++l) {
+      for (El::Int i = 0; i < height; ++i) {
+        w[i + l * height] = DataType(int((i * 31 + l * 17) % 23) - 11) / 8;
+      }
+      for (El::Int j = 0; j < n; ++j) {
+        const DataType channel_scale = DataType(1 << (l / (width / num_channels)));
+        x[l + j * width] = channel_scale * std::sin(DataType(3 * l + 7 * j));
+      }
+    }
+    std::vector<DataType> input_scales;
+    for (El::Int c = 0; c < num_channels; ++c) {
+      input_scales.push_back(lbann::int8_gemm::get_scale(DataType(1 << c)));
+    }
+
+    lbann::int8_gemm gemm;
+    REQUIRE(gemm.is_empty());
+    gemm.setup(height, width, w.data(), height, false, input_scales);
+    REQUIRE(gemm.get_height() == height);
+    REQUIRE(gemm.get_width() == width);
+    std::vector<std::int8_t> q(width * n);
+    gemm.quantize_input(n, x.data(), width, false, q.data());
+    std::vector<DataType> y(height * n);
+    gemm.apply(n, q.data(), y.data(), height, false);
+
+    // Rounding errors are at most half a quantization step in each
+    // factor
+    const auto& ranges = gemm.get_weights_ranges();
+    for (El::Int i = 0; i < height; ++i) {
+      const DataType tolerance = (ranges[i] / 127) * width * DataType(128);
+      for (El::Int j = 0; j < n; ++j) {
+        DataType ref = 0;
+        for (El::Int l = 0; l < width; ++l) {
+          ref += w[i + l * height] * x[l + j * width];
+        }
+        CHECK(std::fabs(y[i + j * height] - ref) <= tolerance);
+      }
+    }
+
+    // Transposed layouts give the same results
+    std::vector<DataType> wt(width * height), xt(n * width);
+    for (El::Int l = 0; l < width; ++l) {
+      for (El::Int i = 0; i < height; ++i) { wt[l + i * width] = w[i + l * height]; }
+      for (El::Int j = 0; j < n; ++j) { xt[j + l * n] = x[l + j * width]; }
+    }
+    lbann::int8_gemm gemm_t;
+    gemm_t.setup(height, width, wt.data(), width, true, input_scales);
+    std::vector<std::int8_t> qt(width * n);
+    gemm_t.quantize_input(n, xt.data(), n, true, qt.data());
+    REQUIRE(qt == q);
+    std::vector<DataType> yt(n * height);
+    gemm_t.apply(n, qt.data(), yt.data(), n, true);
+    for (El::Int i = 0; i < height; ++i) {
+      for (El::Int j = 0; j < n; ++j) {
+        REQUIRE(yt[j + i * n] == y[i + j * height]);
+      }
+    }
+
+    gemm.clear();
+    REQUIRE(gemm.is_empty());
+  }
+}
+
+TEST_CASE("Testing int8 GEMM quantization limits", "[gemm][utilities]") {
+  // Inputs outside the calibrated range saturate
+  const std::vector<DataType> w = {1, -1};
+  lbann::int8_gemm gemm;
+  gemm.setup(1, 2, w.data(), 1, false, {lbann::int8_gemm::get_scale(1)});
+  const std::vector<DataType> x = {10, -0.5};
+  std::vector<std::int8_t> q(2);
+  gemm.quantize_input(1, x.data(), 2, false, q.data());
+  CHECK(q[0] == 127);
+  CHECK(q[1] == -64);
+  DataType y;
+  gemm.apply(1, q.data(), &y, 1, false);
+  CHECK(y == Approx(1.5).epsilon(0.01));
+
+  // Zero ranges do not divide by zero
+  CHECK(lbann::int8_gemm::get_scale(0) == DataType(1));
+  REQUIRE_THROWS(gemm.setup(1, 3, w.data(), 1, false, {1, 1}));
+}
@@ -0,0 +1,79 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/utils/metadata_cache.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+TEST_CASE("Testing metadata cache validation", "[io][utilities]") {
+  const std::string input = "metadata_cache_test_input.txt";
+  const std::string dependent = "metadata_cache_test_dependent.txt";
+  const std::string cache_dir = "metadata_cache_test_dir";
+  std::ofstream(input) << "a.jpg 0\nb.jpg 1\n";
+  std::ofstream(dependent) << "header\n";
+  std::string payload(1000, '\0');
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<char>(i * 7);
+  }
+
+  lbann::metadata_cache cache("image", cache_dir);
+  cache.add_input_file(input);
+  cache.add_parameter("skip_rows", "0");
+  std::string cached;
+  REQUIRE_FALSE(cache.read(cached));
+  cache.add_dependent_file(dependent);
+  REQUIRE(cache.write(payload));
+
+  // A fresh cache with the same key finds the payload
+  lbann::metadata_cache same("image", cache_dir);
+  same.add_input_file(input);
+  same.add_parameter("skip_rows", "0");
+  REQUIRE(same.get_filename() == cache.get_filename());
+  REQUIRE(same.read(cached));
+  CHECK(cached == payload);
+
+  // Other parameters or readers use other cache files
+  lbann::metadata_cache other("image", cache_dir);
+  other.add_input_file(input);
+  other.add_parameter("skip_rows", "1");
+  CHECK(other.get_filename() != cache.get_filename());
+  CHECK_FALSE(other.read(cached));
+  lbann::metadata_cache csv("csv", cache_dir);
+  csv.add_input_file(input);
+  csv.add_parameter("skip_rows", "0");
+  CHECK_FALSE(csv.read(cached));
+
+  // Changing a dependent file or an input file invalidates the cache
+  std::ofstream(dependent, std::ios::app) << "more\n";
+  CHECK_FALSE(same.read(cached));
+  // Rewriting it with the same size still changes its modification
+  // time
+  std::ofstream(dependent) << "header\n";
+  CHECK_FALSE(same.read(cached));
+  std::ofstream(input, std::ios::app) << "c.jpg 2\n";
+  CHECK_FALSE(same.read(cached));
+  REQUIRE(same.write(payload));
+  CHECK(same.read(cached));
+
+  // A corrupt payload is rejected
+  {
+    std::fstream f(same.get_filename(),
+                   std::ios::in | std::ios::out | std::ios::binary);
+    f.seekp(-20, std::ios::end);
+    f.put('x');
+  }
+  CHECK_FALSE(same.read(cached));
+
+  // Without a cache directory, the cache goes next to the input
+  lbann::metadata_cache local("image", "");
+  local.add_input_file(input);
+  CHECK(local.get_filename().find("./" + input + ".image.") == 0);
+
+  std::remove(same.get_filename().c_str());
+  std::remove(cache_dir.c_str());
+  std::remove(input.c_str());
+  std::remove(dependent.c_str());
+}
@@ -0,0 +1,55 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/utils/numerical_health.hpp>
+
+#include <limits>
+#include <vector>
+
+TEST_CASE("Testing numerical health check", "[utilities]") {
+  using DataType = lbann::DataType;
+  const El::Int height = 37, width = 5;
+
+  for (El::Int ldim : {height, height + 3}) {
+    std::vector<DataType> x(ldim * width, DataType(0));
+    for (El::Int col = 0; col < width; ++col) {
+      for (El::Int row = 0; row < height; ++row) {
+        x[row + col * ldim] = DataType(int((row * 31 + col * 17) % 23) - 11) / 8;
+      }
+    }
+    // Padding entries are ignored
+    for (El::Int col = 0; col < width; ++col) {
+      for (El::Int row = height; row < ldim; ++row) {
+        x[row + col * ldim] = std::numeric_limits<DataType>::quiet_NaN();
+      }
+    }
+    x[4 + 2 * ldim] = DataType(-9);
+
+    // Finite entries
+    auto health = lbann::get_numerical_health(height, width, x.data(), ldim);
+    CHECK(health.is_finite());
+    CHECK(health.num_nans == 0);
+    CHECK(health.num_infs == 0);
+    CHECK(health.max_abs == DataType(9));
+    CHECK(health.row == -1);
+    CHECK(health.col == -1);
+
+    // Non-finite entries
+    x[7 + 1 * ldim] = std::numeric_limits<DataType>::infinity();
+    x[2 + 3 * ldim] = std::numeric_limits<DataType>::quiet_NaN();
+    x[5 + 3 * ldim] = -std::numeric_limits<DataType>::infinity();
+    x[0 + 4 * ldim] = std::numeric_limits<DataType>::quiet_NaN();
+    health = lbann::get_numerical_health(height, width, x.data(), ldim);
+    CHECK(!health.is_finite());
+    CHECK(health.num_nans == 2);
+    CHECK(health.num_infs == 2);
+    CHECK(health.max_abs == DataType(9));
+    CHECK(health.row == 7);
+    CHECK(health.col == 1);
+  }
+
+  const auto health = lbann::get_numerical_health(0, width, nullptr, 1);
+  CHECK(health.is_finite());
+  CHECK(health.max_abs == DataType(0));
+}
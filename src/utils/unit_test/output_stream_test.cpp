@@ -0,0 +1,93 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/utils/output_stream.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+TEST_CASE("Testing output stream round trip", "[io][utilities]") {
+  using DataType = lbann::DataType;
+  const std::string prefix = "output_stream_test";
+  std::vector<lbann::output_stream_tensor> tensors(2);
+  tensors[0].layer_name = "prob";
+  tensors[0].output_index = 0;
+  tensors[0].dims = {3};
+  tensors[1].layer_name = "embedding";
+  tensors[1].output_index = 1;
+  tensors[1].dims = {2, 2};
+
+  // Write chunks of a few samples each
+  // Note: Small file and queue sizes force several files and
+  // blocking submissions.
+  const int num_steps = 20;
+  int num_files = 0;
+  {
+    lbann::output_stream_writer writer(prefix, tensors, 512, 256);
+    for (int step = 0; step < num_steps; ++step) {
+      for (int t = 0; t < 2; ++t) {
+        auto chunk = writer.get_chunk();
+        chunk->tensor = t;
+        chunk->mode = (step % 2 == 0 ?
+                       lbann::execution_mode::testing :
+                       lbann::execution_mode::validation);
+        chunk->epoch = step / 10;
+        chunk->step = step;
+        const int num_samples = 1 + step % 3;
+        for (int s = 0; s < num_samples; ++s) {
+          chunk->indices.push_back(100 * step + s);
+        }
+        for (int i = 0; i < num_samples * tensors[t].get_size(); ++i) {
+          chunk->values.push_back(DataType(step + t) + DataType(i) / 8);
+        }
+        writer.write(std::move(chunk));
+      }
+      if (step == num_steps / 2) { writer.flush(); }
+    }
+    writer.flush();
+    num_files = writer.get_num_files();
+
+    // Invalid chunk
+    auto chunk = writer.get_chunk();
+    chunk->tensor = 1;
+    chunk->indices.push_back(0);
+    REQUIRE_THROWS(writer.write(std::move(chunk)));
+  }
+  REQUIRE(num_files > 1);
+
+  // Read chunks back in order
+  int step = 0, t = 0;
+  for (int part = 0; part < num_files; ++part) {
+    const std::string file_name = prefix + "-part" + std::to_string(part) + ".bin";
+    {
+      lbann::output_stream_reader reader(file_name);
+      REQUIRE(reader.get_tensors().size() == 2);
+      REQUIRE(reader.get_tensors()[1].layer_name == "embedding");
+      REQUIRE(reader.get_tensors()[1].output_index == 1);
+      REQUIRE(reader.get_tensors()[1].dims == tensors[1].dims);
+      lbann::output_stream_chunk chunk;
+      while (reader.read(chunk)) {
+        REQUIRE(chunk.tensor == t);
+        REQUIRE(chunk.step == step);
+        REQUIRE(chunk.epoch == step / 10);
+        REQUIRE(chunk.mode == (step % 2 == 0 ?
+                               lbann::execution_mode::testing :
+                               lbann::execution_mode::validation));
+        const int num_samples = 1 + step % 3;
+        REQUIRE(chunk.indices.size() == size_t(num_samples));
+        REQUIRE(chunk.indices.back() == 100 * step + num_samples - 1);
+        REQUIRE(chunk.values.size() == size_t(num_samples * tensors[t].get_size()));
+        for (size_t i = 0; i < chunk.values.size(); ++i) {
+          REQUIRE(chunk.values[i] == DataType(step + t) + DataType(i) / 8);
+        }
+        if (++t == 2) { t = 0; ++step; }
+      }
+    }
+    std::remove(file_name.c_str());
+  }
+  REQUIRE(step == num_steps);
+
+  REQUIRE_THROWS(lbann::output_stream_reader(prefix + "-missing.bin"));
+}
@@ -0,0 +1,70 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/utils/reduced_precision.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+TEST_CASE("Testing 16-bit storage conversions", "[reduced_precision][utilities]") {
+
+  SECTION("fp16 round trip is exact for all finite values") {
+    for (uint32_t bits = 0; bits < 0x10000u; ++bits) {
+      const auto x = lbann::fp16_to_float(static_cast<uint16_t>(bits));
+      if (std::isnan(x)) { continue; }
+      REQUIRE(lbann::float_to_fp16(x) == bits);
+    }
+  }
+
+  SECTION("bf16 round trip is exact for all finite values") {
+    for (uint32_t bits = 0; bits < 0x10000u; ++bits) {
+      const auto x = lbann::bf16_to_float(static_cast<uint16_t>(bits));
+      if (std::isnan(x)) { continue; }
+      REQUIRE(lbann::float_to_bf16(x) == bits);
+    }
+  }
+
+  SECTION("fp16 rounding and special values") {
+    CHECK(lbann::fp16_to_float(lbann::float_to_fp16(1.0005f)) == Approx(1.0009765625f));
+    CHECK(std::isinf(lbann::fp16_to_float(lbann::float_to_fp16(65520.f))));
+    CHECK(lbann::fp16_to_float(lbann::float_to_fp16(65504.f)) == 65504.f);
+    CHECK(lbann::fp16_to_float(lbann::float_to_fp16(1e-9f)) == 0.f);
+    CHECK(std::isnan(lbann::fp16_to_float(
+      lbann::float_to_fp16(std::numeric_limits<float>::quiet_NaN()))));
+  }
+
+  SECTION("bf16 keeps NaN") {
+    CHECK(std::isnan(lbann::bf16_to_float(
+      lbann::float_to_bf16(std::numeric_limits<float>::quiet_NaN()))));
+  }
+
+  SECTION("Packing strided matrices") {
+    const size_t height = 3, width = 2, ldim = 5;
+    std::vector<float> in(ldim * width, -1.f);
+    for (size_t col = 0; col < width; ++col) {
+      for (size_t row = 0; row < height; ++row) {
+        in[row + col * ldim] = 0.5f * row - 2.f * col;
+      }
+    }
+    for (auto precision : {lbann::storage_precision::bf16,
+                           lbann::storage_precision::fp16}) {
+      std::vector<uint16_t> packed(height * width);
+      std::vector<float> out(ldim * width, 7.f);
+      lbann::pack_reduced_precision(height, width, in.data(), ldim,
+                                    packed.data(), precision);
+      lbann::unpack_reduced_precision(height, width, packed.data(),
+                                      out.data(), ldim, precision);
+      for (size_t col = 0; col < width; ++col) {
+        for (size_t row = 0; row < height; ++row) {
+          CHECK(out[row + col * ldim] == in[row + col * ldim]);
+        }
+        for (size_t row = height; row < ldim; ++row) {
+          CHECK(out[row + col * ldim] == 7.f);
+        }
+      }
+    }
+  }
+
+}
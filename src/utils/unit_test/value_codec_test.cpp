@@ -0,0 +1,74 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/utils/value_codec.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace {
+
+bool same_bits(const std::vector<lbann::DataType>& a,
+               const std::vector<lbann::DataType>& b) {
+  return a.size() == b.size()
+    && std::memcmp(a.data(), b.data(), a.size() * sizeof(lbann::DataType)) == 0;
+}
+
+} // namespace
+
+TEST_CASE("Testing value compression", "[checkpoint][utilities]") {
+  using DataType = lbann::DataType;
+
+  // Several blocks, with a partial last block
+  const size_t size = 200003;
+  std::vector<DataType> base(size), values(size), result(size);
+  for (size_t i = 0; i < size; ++i) {
+    base[i] = std::sin(DataType(i)) / (1 + i % 7);
+    values[i] = base[i];
+  }
+  // Change a small fraction of the values a little
+  for (size_t i = 0; i < size; i += 97) {
+    values[i] += base[i] * DataType(1e-3);
+  }
+  values[5] = std::numeric_limits<DataType>::quiet_NaN();
+  values[6] = -std::numeric_limits<DataType>::infinity();
+  values[7] = -0.0;
+  values[8] = std::numeric_limits<DataType>::denorm_min();
+
+  std::vector<unsigned char> data;
+  SECTION("Full values") {
+    lbann::compress_values(size, values.data(), nullptr, data);
+    lbann::decompress_values(data.size(), data.data(), size, nullptr, result.data());
+    CHECK(same_bits(values, result));
+  }
+  SECTION("Delta against a base") {
+    lbann::compress_values(size, values.data(), base.data(), data);
+    CHECK(data.size() < size * sizeof(DataType) / 10);
+    lbann::decompress_values(data.size(), data.data(), size, base.data(), result.data());
+    CHECK(same_bits(values, result));
+  }
+  SECTION("Unchanged values") {
+    lbann::compress_values(size, base.data(), base.data(), data);
+    CHECK(data.size() < 100);
+    lbann::decompress_values(data.size(), data.data(), size, base.data(), result.data());
+    CHECK(same_bits(base, result));
+  }
+  SECTION("Empty and small arrays") {
+    lbann::compress_values(0, values.data(), nullptr, data);
+    lbann::decompress_values(data.size(), data.data(), 0, nullptr, result.data());
+    std::vector<DataType> small = {0, 1, 0, 0, 2}, small_result(5);
+    lbann::compress_values(5, small.data(), nullptr, data);
+    lbann::decompress_values(data.size(), data.data(), 5, nullptr, small_result.data());
+    CHECK(same_bits(small, small_result));
+  }
+  SECTION("Invalid data") {
+    lbann::compress_values(size, values.data(), nullptr, data);
+    CHECK_THROWS(lbann::decompress_values(data.size() - 1, data.data(), size,
+                                          nullptr, result.data()));
+    CHECK_THROWS(lbann::decompress_values(data.size(), data.data(), size - 1,
+                                          nullptr, result.data()));
+  }
+}
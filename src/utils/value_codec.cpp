@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/utils/value_codec.hpp"
+#include "lbann/utils/exception.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace lbann {
+
+namespace {
+
+/** Values per independently encoded block. */
+constexpr size_t block_size = size_t(1) << 16;
+
+/** Control bytes: literal runs of 1-128 bytes, zero runs of 1-127
+ *  bytes, and zero runs with a variable-length count. */
+constexpr unsigned char max_literal_control = 127;
+constexpr unsigned char long_zero_run_control = 255;
+
+void write_varint(std::vector<unsigned char>& out, uint64_t val) {
+  while (val >= 0x80) {
+    out.push_back(static_cast<unsigned char>(val | 0x80));
+    val >>= 7;
+  }
+  out.push_back(static_cast<unsigned char>(val));
+}
+
+uint64_t read_varint(const unsigned char* in, size_t in_size, size_t& pos) {
+  uint64_t val = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (pos >= in_size) { break; }
+    const unsigned char byte = in[pos++];
+    val |= uint64_t(byte & 0x7F) << shift;
+    if (byte < 0x80) { return val; }
+  }
+  LBANN_ERROR("invalid compressed values");
+  return 0;
+}
+
+/** Run-length encode zeros in a byte plane. */
+void encode_plane(const unsigned char* plane, size_t size,
+                  std::vector<unsigned char>& out) {
+  size_t i = 0;
+  while (i < size) {
+    if (plane[i] == 0) {
+      size_t run = 1;
+      while (i + run < size && plane[i + run] == 0) { ++run; }
+      if (run <= long_zero_run_control - max_literal_control - 1) {
+        out.push_back(static_cast<unsigned char>(max_literal_control + run));
+      } else {
+        out.push_back(long_zero_run_control);
+        write_varint(out, run);
+      }
+      i += run;
+    } else {
+      // Literal runs end at pairs of zeros
+      const size_t start = i;
+      const size_t max_end = std::min(size, start + max_literal_control + 1);
+      while (i < max_end
+             && !(plane[i] == 0 && i + 1 < size && plane[i + 1] == 0)) {
+        ++i;
+      }
+      out.push_back(static_cast<unsigned char>(i - start - 1));
+      out.insert(out.end(), plane + start, plane + i);
+    }
+  }
+}
+
+/** Decode a byte plane. Returns the position after its data. */
+size_t decode_plane(const unsigned char* in, size_t in_size, size_t pos,
+                    unsigned char* plane, size_t size) {
+  size_t i = 0;
+  while (i < size) {
+    if (pos >= in_size) {
+      LBANN_ERROR("truncated compressed values");
+    }
+    const unsigned char control = in[pos++];
+    if (control <= max_literal_control) {
+      const size_t run = size_t(control) + 1;
+      if (i + run > size || pos + run > in_size) {
+        LBANN_ERROR("invalid compressed values");
+      }
+      std::memcpy(plane + i, in + pos, run);
+      pos += run;
+      i += run;
+    } else {
+      const size_t run = (control == long_zero_run_control
+                          ? read_varint(in, in_size, pos)
+                          : size_t(control) - max_literal_control);
+      if (i + run > size) {
+        LBANN_ERROR("invalid compressed values");
+      }
+      std::memset(plane + i, 0, run);
+      i += run;
+    }
+  }
+  return pos;
+}
+
+void encode_block(size_t size, const DataType* values, const DataType* base,
+                  std::vector<unsigned char>& out) {
+  constexpr size_t width = sizeof(DataType);
+  std::vector<unsigned char> bytes(size * width), plane(size);
+  std::memcpy(bytes.data(), values, bytes.size());
+  if (base != nullptr) {
+    const auto* base_bytes = reinterpret_cast<const unsigned char*>(base);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+      bytes[i] ^= base_bytes[i];
+    }
+  }
+  out.clear();
+  for (size_t b = 0; b < width; ++b) {
+    for (size_t i = 0; i < size; ++i) {
+      plane[i] = bytes[i * width + b];
+    }
+    encode_plane(plane.data(), size, out);
+  }
+}
+
+void decode_block(size_t in_size, const unsigned char* in,
+                  size_t size, const DataType* base, DataType* values) {
+  constexpr size_t width = sizeof(DataType);
+  std::vector<unsigned char> bytes(size * width), plane(size);
+  size_t pos = 0;
+  for (size_t b = 0; b < width; ++b) {
+    pos = decode_plane(in, in_size, pos, plane.data(), size);
+    for (size_t i = 0; i < size; ++i) {
+      bytes[i * width + b] = plane[i];
+    }
+  }
+  if (pos != in_size) {
+    LBANN_ERROR("invalid compressed values");
+  }
+  if (base != nullptr) {
+    const auto* base_bytes = reinterpret_cast<const unsigned char*>(base);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+      bytes[i] ^= base_bytes[i];
+    }
+  }
+  std::memcpy(values, bytes.data(), bytes.size());
+}
+
+} // namespace
+
+void compress_values(size_t size,
+                     const DataType* values,
+                     const DataType* base,
+                     std::vector<unsigned char>& data) {
+  // Encode blocks in parallel
+  const size_t num_blocks = (size + block_size - 1) / block_size;
+  std::vector<std::vector<unsigned char>> blocks(num_blocks);
+  LBANN_OMP_PARALLEL_FOR_ARGS(schedule(dynamic))
+  for (size_t k = 0; k < num_blocks; ++k) {
+    const size_t offset = k * block_size;
+    encode_block(std::min(block_size, size - offset),
+                 values + offset,
+                 base != nullptr ? base + offset : nullptr,
+                 blocks[k]);
+  }
+
+  // Block sizes are stored first, so blocks can be decoded in
+  // parallel
+  data.clear();
+  write_varint(data, size);
+  for (const auto& block : blocks) {
+    write_varint(data, block.size());
+  }
+  for (const auto& block : blocks) {
+    data.insert(data.end(), block.begin(), block.end());
+  }
+}
+
+void decompress_values(size_t data_size,
+                       const unsigned char* data,
+                       size_t size,
+                       const DataType* base,
+                       DataType* values) {
+  size_t pos = 0;
+  if (read_varint(data, data_size, pos) != size) {
+    LBANN_ERROR("compressed values have the wrong size");
+  }
+  const size_t num_blocks = (size + block_size - 1) / block_size;
+  std::vector<size_t> offsets(num_blocks + 1);
+  for (size_t k = 0; k < num_blocks; ++k) {
+    offsets[k+1] = offsets[k] + read_varint(data, data_size, pos);
+  }
+  if (pos + offsets[num_blocks] != data_size) {
+    LBANN_ERROR("invalid compressed values");
+  }
+
+  // Exceptions cannot leave the parallel region
+  std::atomic<bool> valid(true);
+  LBANN_OMP_PARALLEL_FOR_ARGS(schedule(dynamic))
+  for (size_t k = 0; k < num_blocks; ++k) {
+    const size_t offset = k * block_size;
+    try {
+      decode_block(offsets[k+1] - offsets[k],
+                   data + pos + offsets[k],
+                   std::min(block_size, size - offset),
+                   base != nullptr ? base + offset : nullptr,
+                   values + offset);
+    } catch (...) {
+      valid = false;
+    }
+  }
+  if (!valid) {
+    LBANN_ERROR("invalid compressed values");
+  }
+}
+
+} // namespace lbann
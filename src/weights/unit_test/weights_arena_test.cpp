@@ -0,0 +1,94 @@
+// MUST include this
+#include <catch2/catch.hpp>
+
+// File being tested
+#include <lbann/weights/weights_arena.hpp>
+
+#include "TestHelpers.hpp"
+#include <lbann/optimizers/sgd.hpp>
+#include <lbann/utils/memory.hpp>
+#include <lbann/weights/weights.hpp>
+
+#include <memory>
+#include <vector>
+
+using lbann::DataType;
+
+namespace {
+
+void add_gradient(lbann::weights& w, DataType value) {
+  const auto& values = w.get_values();
+  lbann::StarMat<El::Device::CPU> gradient(values.Height(), values.Width());
+  El::Fill(gradient, value);
+  w.get_optimizer()->clear_gradient();
+  w.get_optimizer()->add_to_gradient(gradient);
+}
+
+void check_values(const lbann::weights& w, DataType value) {
+  const auto& local = w.get_values().LockedMatrix();
+  for (El::Int j = 0; j < local.Width(); ++j) {
+    for (El::Int i = 0; i < local.Height(); ++i) {
+      CHECK(local(i, j) == Approx(value));
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("Testing weights arena", "[weights][optimizer]") {
+  auto& comm = unit_test::utilities::current_world_comm();
+
+  lbann::weights w1(&comm), w2(&comm);
+  w1.set_dims(10);
+  w2.set_dims(5);
+  w1.set_optimizer(lbann::make_unique<lbann::sgd>(&comm, DataType(0.5), DataType(0.9)));
+  w2.set_optimizer(lbann::make_unique<lbann::sgd>(&comm, DataType(0.5), DataType(0.9)));
+  w1.setup();
+  w2.setup();
+  El::Fill(w1.get_values(), DataType(1));
+  El::Fill(w2.get_values(), DataType(1));
+
+  lbann::weights_arena arena;
+  arena.setup({&w1, &w2});
+  REQUIRE(arena.get_num_weights() == 2u);
+  CHECK(arena.contains(w1));
+  CHECK(arena.contains(w2));
+  CHECK(w1.get_values().Viewing());
+
+  // v = g, x -= lr * v
+  add_gradient(w1, DataType(1));
+  add_gradient(w2, DataType(1));
+  arena.step();
+  check_values(w1, DataType(0.5));
+  check_values(w2, DataType(0.5));
+
+  SECTION("Stepping after an optimizer is replaced") {
+    // The replaced optimizer and its matrices are deallocated, so
+    // the arena is rebuilt from the new one
+    w1.set_optimizer(lbann::make_unique<lbann::sgd>(&comm, DataType(0.25)));
+    w1.get_optimizer()->setup(&w1);
+    add_gradient(w1, DataType(1));
+    add_gradient(w2, DataType(1));
+    arena.step();
+    REQUIRE(arena.get_num_weights() == 2u);
+    check_values(w1, DataType(0.25));
+    check_values(w2, DataType(0.5 - 0.5 * 1.9));
+
+    // Setting up again keeps the data
+    arena.setup({&w1, &w2});
+    REQUIRE(arena.get_num_weights() == 2u);
+    check_values(w1, DataType(0.25));
+    check_values(w2, DataType(0.5 - 0.5 * 1.9));
+  }
+
+  SECTION("Detaching after an optimizer is replaced") {
+    w1.set_optimizer(lbann::make_unique<lbann::sgd>(&comm, DataType(0.25)));
+    w1.get_optimizer()->setup(&w1);
+    arena.detach();
+    CHECK(arena.get_num_weights() == 0u);
+    CHECK_FALSE(w1.get_values().Viewing());
+    CHECK_FALSE(w2.get_values().Viewing());
+    check_values(w1, DataType(0.5));
+    check_values(w2, DataType(0.5));
+  }
+}
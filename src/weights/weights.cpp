@@ -501,7 +501,9 @@ bool weights::load_from_save(std::string const& ckpt_dir, std::vector<std::strin
       throw lbann_exception(std::string("Failed to read weight matrix: ") + full_path);
       return false;
     }
-    El::Read(*m_values,full_path, El::BINARY, true);
+    if (!read_shared_distmat(full_path, *m_values)) {
+      El::Read(*m_values,full_path, El::BINARY, true);
+    }
   }
   return true;
 }
@@ -0,0 +1,261 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2014-2019, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+// Written by the LBANN Research Team (B. Van Essen, et al.) listed in
+// the CONTRIBUTORS file. <lbann-dev@llnl.gov>
+//
+// LLNL-CODE-697807.
+// All rights reserved.
+//
+// This file is part of LBANN: Livermore Big Artificial Neural Network
+// Toolkit. For details, see http://software.llnl.gov/LBANN or
+// https://github.com/LLNL/LBANN.
+//
+// Licensed under the Apache License, Version 2.0 (the "Licensee"); you
+// may not use this file except in compliance with the License.  You may
+// obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+// implied. See the License for the specific language governing
+// permissions and limitations under the license.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "lbann/weights/weights_arena.hpp"
+#include "lbann/weights/weights.hpp"
+#include "lbann/optimizers/optimizer.hpp"
+#include "lbann/utils/exception.hpp"
+#include "lbann/utils/timer.hpp"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+namespace lbann {
+
+namespace {
+
+/** Members are padded to a multiple of a 64-byte cache line. */
+constexpr size_t arena_alignment = 64 / sizeof(DataType);
+
+size_t pad_size(size_t size) {
+  return ((size + arena_alignment - 1) / arena_alignment) * arena_alignment;
+}
+
+/** Whether weights can be placed in an arena. */
+bool is_arena_eligible(const weights& w, const optimizer* opt) {
+  if (opt == nullptr || !opt->supports_fused_step()) { return false; }
+  const auto& dist = w.get_matrix_distribution();
+  return (dist.device == El::Device::CPU
+          && dist.colDist == El::STAR
+          && dist.rowDist == El::STAR);
+}
+
+/** Copy local data into an arena buffer and attach the matrix to it. */
+void attach_to_buffer(AbsDistMat& mat, DataType* buffer) {
+  const El::Int local_height = mat.LocalHeight();
+  const El::Int local_width = mat.LocalWidth();
+  const El::Int ldim = std::max(local_height, El::Int(1));
+  El::Matrix<DataType, El::Device::CPU> view(local_height, local_width,
+                                             buffer, ldim);
+  El::Copy(static_cast<const CPUMat&>(mat.LockedMatrix()), view);
+  mat.Attach(mat.Height(), mat.Width(), mat.Grid(),
+             mat.ColAlign(), mat.RowAlign(),
+             buffer, ldim, mat.Root());
+}
+
+/** Make a matrix own a copy of its data if it is still attached to
+ *  an arena buffer.
+ */
+void detach_matrix(AbsDistMat* mat, const DataType* buffer) {
+  if (mat != nullptr && mat->Viewing() && mat->LockedBuffer() == buffer) {
+    std::unique_ptr<AbsDistMat> copy(mat->Copy());
+    mat->Empty();
+    El::Copy(*copy, *mat);
+  }
+}
+
+} // namespace
+
+weights_arena::~weights_arena() {
+  detach();
+}
+
+void weights_arena::setup(const std::vector<weights*>& weights_list) {
+  detach();
+
+  // Group eligible weights by optimizer type
+  std::map<std::pair<std::string, size_t>, std::vector<member>> groups;
+  for (auto* w : weights_list) {
+    if (w == nullptr) { continue; }
+    auto* opt = w->get_optimizer();
+    if (!is_arena_eligible(*w, opt)) { continue; }
+    const auto& values = w->get_values();
+    const size_t size = values.LocalHeight() * values.LocalWidth();
+    const size_t num_states = opt->get_state_matrices().size();
+    auto& members = groups[std::make_pair(opt->get_type(), num_states)];
+    const size_t offset = (members.empty() ?
+                           0 :
+                           members.back().offset
+                           + pad_size(members.back().size));
+    members.push_back({w, opt, offset, size});
+    m_members.insert(w);
+  }
+
+  // Allocate buffers and attach matrices
+  // Note: Groups are constructed in place so the buffers are never
+  // moved after matrices are attached to them.
+  m_groups.resize(groups.size());
+  size_t group_index = 0;
+  for (auto& key_members : groups) {
+    auto& g = m_groups[group_index++];
+    g.type = key_members.first.first;
+    g.members = std::move(key_members.second);
+    const auto& last = g.members.back();
+    const El::Int buffer_size = last.offset + pad_size(last.size);
+    El::Zeros(g.values, buffer_size, 1);
+    El::Zeros(g.gradient, buffer_size, 1);
+    g.state.resize(key_members.first.second);
+    for (auto& s : g.state) { El::Zeros(s, buffer_size, 1); }
+    for (auto& m : g.members) {
+      attach_to_buffer(*m.w->m_values, g.values.Buffer() + m.offset);
+      attach_to_buffer(*m.opt->m_gradient, g.gradient.Buffer() + m.offset);
+      auto state_mats = m.opt->get_state_matrices();
+      for (size_t i = 0; i < state_mats.size(); ++i) {
+        attach_to_buffer(*state_mats[i], g.state[i].Buffer() + m.offset);
+      }
+    }
+  }
+
+}
+
+void weights_arena::detach() {
+  for (auto& g : m_groups) {
+    for (auto& m : g.members) {
+      detach_matrix(m.w->m_values.get(), g.values.LockedBuffer() + m.offset);
+      // Note: The optimizer recorded at setup may have been replaced
+      // and deallocated, so only the current one is accessed.
+      auto* opt = m.w->get_optimizer();
+      if (opt == nullptr || opt != m.opt) { continue; }
+      detach_matrix(opt->m_gradient.get(), g.gradient.LockedBuffer() + m.offset);
+      const auto state_mats = opt->get_state_matrices();
+      for (size_t i = 0; i < state_mats.size() && i < g.state.size(); ++i) {
+        detach_matrix(state_mats[i], g.state[i].LockedBuffer() + m.offset);
+      }
+    }
+  }
+  m_groups.clear();
+  m_members.clear();
+}
+
+bool weights_arena::contains(const weights& w) const {
+  return m_members.count(&w) > 0;
+}
+
+bool weights_arena::is_attached() const {
+  for (const auto& g : m_groups) {
+    for (const auto& m : g.members) {
+      if (m.w->m_values == nullptr
+          || m.opt != m.w->get_optimizer()
+          || m.opt->m_gradient == nullptr
+          || m.w->m_values->LockedBuffer() != g.values.LockedBuffer() + m.offset
+          || m.opt->m_gradient->LockedBuffer() != g.gradient.LockedBuffer() + m.offset) {
+        return false;
+      }
+      const auto state_mats = m.opt->get_state_matrices();
+      for (size_t i = 0; i < state_mats.size(); ++i) {
+        if (state_mats[i]->LockedBuffer() != g.state[i].LockedBuffer() + m.offset) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void weights_arena::step() {
+
+  // Rebuild arena if any matrices have been reallocated
+  if (!is_attached()) {
+    std::vector<weights*> weights_list;
+    for (const auto& g : m_groups) {
+      for (const auto& m : g.members) {
+        weights_list.push_back(m.w);
+      }
+    }
+    setup(weights_list);
+  }
+
+  for (auto& g : m_groups) {
+    const auto start_time = get_time();
+
+    // Make sure gradients are ready
+    // Note: Waits for any outstanding allreduces and zeros out
+    // cleared gradients.
+    for (auto& m : g.members) {
+      m.opt->get_gradient();
+      m.opt->fused_step_begin();
+    }
+
+    // Sweep over runs of members with identical hyperparameters
+    std::vector<DataType*> state(g.state.size());
+    size_t run_begin = 0;
+    while (run_begin < g.members.size()) {
+      auto& leader = *g.members[run_begin].opt;
+      size_t run_end = run_begin + 1;
+      while (run_end < g.members.size()
+             && leader.is_step_fusable(*g.members[run_end].opt)) {
+        ++run_end;
+      }
+      const auto& offset = g.members[run_begin].offset;
+      const auto& size = (run_end < g.members.size() ?
+                          g.members[run_end].offset - offset :
+                          g.values.Height() - offset);
+      for (size_t i = 0; i < state.size(); ++i) {
+        state[i] = g.state[i].Buffer() + offset;
+      }
+      leader.fused_step_compute(size,
+                                g.values.Buffer() + offset,
+                                g.gradient.LockedBuffer() + offset,
+                                state);
+      run_begin = run_end;
+    }
+
+    // Attribute step time to members in proportion to their size
+    const auto step_time = get_time() - start_time;
+    const auto total_size = std::max(g.values.Height(), El::Int(1));
+    for (auto& m : g.members) {
+      m.opt->add_step_time(step_time * m.size / total_size);
+    }
+
+  }
+
+}
+
+size_t weights_arena::get_num_weights() const {
+  return m_members.size();
+}
+
+size_t weights_arena::get_size() const {
+  size_t size = 0;
+  for (const auto& g : m_groups) { size += g.values.Height(); }
+  return size;
+}
+
+std::string weights_arena::get_summary() const {
+  std::ostringstream ss;
+  ss << "weights arena: " << get_num_weights() << " weights in "
+     << m_groups.size() << " group(s)";
+  for (const auto& g : m_groups) {
+    ss << ", " << g.type
+       << " (" << g.members.size() << " weights, "
+       << g.values.Height() << " entries, "
+       << g.state.size() << " state buffers)";
+  }
+  return ss.str();
+}
+
+} // namespace lbann
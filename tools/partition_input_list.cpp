@@ -6,13 +6,49 @@
 #include <algorithm>
 #include <random>
 #include <chrono>
+#include "lbann/data_readers/sample_list_hdf5.hpp"
 
 using namespace std;
 
+/** Convert a conduit/HDF5 sample list into a binary sample list, and
+ *  optionally split it into partitions of interleaved files in the
+ *  same way that ranks load their part of a list.
+ */
+int convert_sample_list(const std::string& input_file, const std::string& output_file, int num_partition)
+{
+  std::cout << "Loading sample list " << input_file << std::endl;
+  {
+    lbann::sample_list_hdf5<std::string> sample_list;
+    sample_list.load(input_file);
+    std::cout << "A total of " << sample_list.size() << " samples in "
+              << sample_list.get_num_files() << " files" << std::endl;
+    sample_list.write_binary(output_file);
+  }
+  std::cout << "Binary sample list saved as: " << output_file << std::endl;
+
+  // Partitions are read back from the binary list, which does not
+  // require opening the data files again
+  for(int p = 0; p < num_partition; p++) {
+    std::string partition_file = output_file + ".p" + to_string(p);
+    std::cout << "Partitioned file name " << partition_file << std::endl;
+    lbann::sample_list_hdf5<std::string> partition;
+    partition.load(output_file, num_partition, p);
+    partition.write_binary(partition_file);
+  }
+
+  std::cout << "DONE!" << std::endl;
+  return 0;
+}
+
 int main( int argc, char** argv)
 {
+  if(argc >= 4 && std::string(argv[1]) == "--binary_sample_list") {
+    return convert_sample_list(argv[2], argv[3], (argc > 4)? atoi(argv[4]) : 0);
+  }
+
   if(argc < 4) { 
     cout << "Usage .... exec input_file output_file_basename num_partitions" << endl;
+    cout << "      or   exec --binary_sample_list sample_list_file output_file [num_partitions]" << endl;
     exit(-1);
   }
     
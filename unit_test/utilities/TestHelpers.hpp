@@ -0,0 +1,31 @@
+#ifndef LBANN_UNIT_TEST_UTILITIES_TEST_HELPERS_HPP_INCLUDED
+#define LBANN_UNIT_TEST_UTILITIES_TEST_HELPERS_HPP_INCLUDED
+
+#include <lbann/base.hpp>
+#include <lbann/comm.hpp>
+
+namespace unit_test {
+namespace utilities {
+
+/** @brief World communicator shared by all tests.
+ *
+ *  LBANN and Elemental are initialized on first use and finalized at
+ *  exit, since MPI cannot be initialized twice in one process.
+ */
+inline lbann::lbann_comm& current_world_comm() {
+  struct environment {
+    environment() {
+      int argc = 0;
+      char** argv = nullptr;
+      comm = lbann::initialize(argc, argv, 42);
+    }
+    lbann::world_comm_ptr comm{nullptr, &lbann::finalize};
+  };
+  static environment env;
+  return *env.comm;
+}
+
+} // namespace utilities
+} // namespace unit_test
+
+#endif // LBANN_UNIT_TEST_UTILITIES_TEST_HELPERS_HPP_INCLUDED